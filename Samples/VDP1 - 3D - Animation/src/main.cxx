@@ -1,5 +1,5 @@
 #include <srl.hpp>
-#include "animatedObject.hpp"
+#include "modelObject.hpp"
 
 // Using to shorten names for Vector and HighColor
 using namespace SRL::Types;
@@ -52,7 +52,13 @@ int main()
 
     // Load buddy
     // Model was converted with ModelConverter (see https://github.com/ReyeMe/ModelConverter-linux), command parameters were: ModelConverter -i "D:\frame_01.obj" "D:\frame_02.obj" -o "D:\BUD.NYA" -t smooth
-    AnimatedObject bud = AnimatedObject("BUD.NYA", 0);
+    ModelObject* keyframes = new ModelObject("BUD.NYA", 0);
+
+    // Build compressed animation, keyframes are not needed afterwards
+    SRL::Types::AnimatedMesh* bud = keyframes->IsSmooth() ?
+        new SRL::Types::AnimatedMesh(keyframes->GetMesh<SmoothMesh>(0), keyframes->GetMeshCount()) :
+        new SRL::Types::AnimatedMesh(keyframes->GetMesh<Mesh>(0), keyframes->GetMeshCount());
+    delete keyframes;
 
     // Setup camera location
     Vector3D cameraLocation = Vector3D(0.0, -30.0, -30.0);
@@ -69,18 +75,22 @@ int main()
     Angle rotationStep = Angle::FromDegrees(1);
 
     // Initialize shading table and work table
-    uint32_t polygons = bud.GetFaceCount();
-    SRL::Types::HighColor workTable[bud.GetFaceCount() <<2];
-    uint8_t vertWork[bud.GetVertexCount()];
+    uint32_t polygons = bud->GetFaceCount();
+    SRL::Types::HighColor workTable[bud->GetFaceCount() <<2];
+    uint8_t vertWork[bud->GetVertexCount()];
 
-    // Initializes gouraud table work area
-    SRL::Scene3D::LightInitGouraudTable(0, vertWork, workTable, polygons);
+    // Gouraud shading is used only by smooth meshes
+    if (bud->IsSmooth())
+    {
+        // Initializes gouraud table work area
+        SRL::Scene3D::LightInitGouraudTable(0, vertWork, workTable, polygons);
 
-    // Sets current light shading table
-    SRL::Scene3D::LightSetGouraudTable(shadingTable);
+        // Sets current light shading table
+        SRL::Scene3D::LightSetGouraudTable(shadingTable);
 
-    // Setups copy event at each vblank
-    SRL::Core::OnVblank += SRL::Scene3D::LightCopyGouraudTable;
+        // Setups copy event at each vblank
+        SRL::Core::OnVblank += SRL::Scene3D::LightCopyGouraudTable;
+    }
 
     // Current animation time
     Fxp time = 0.0;
@@ -101,10 +111,17 @@ int main()
             rotation += rotationStep;
 
             // Draw buddy
-            bud.Draw(lightDirection);
-
-            // Process next animation frame
-            bud.ProcessFrame(time += 0.1);
+            if (bud->IsSmooth())
+            {
+                bud->Draw(lightDirection);
+            }
+            else
+            {
+                bud->Draw();
+            }
+
+            // Process next animation frame, vertex interpolation is split with slave CPU
+            bud->ProcessFrame(time += 0.1, true);
             if (time >= 11.0) time = 0.0;
         }
         SRL::Scene3D::PopMatrix();
@@ -39,20 +39,13 @@ int main()
         Vector2D(0.0, -50.0) + second[3]
     };
     
-    // Get pointer to gouraud table
-    HighColor* table = SRL::VDP1::GetGouraudTable();
-
     // First gouraud table entry
-    table[0] = HighColor::Colors::Blue;
-    table[1] = HighColor::Colors::Red;
-    table[2] = HighColor::Colors::Red;
-    table[3] = HighColor::Colors::Blue;
+    const HighColor blueRed[4] = { HighColor::Colors::Blue, HighColor::Colors::Red, HighColor::Colors::Red, HighColor::Colors::Blue };
+    const int16_t firstEntry = SRL::GouraudTable::Allocate(blueRed);
 
     // Second gouraud table entry
-    table[4] = HighColor::Colors::Magenta;
-    table[5] = HighColor::Colors::Green;
-    table[6] = HighColor::Colors::Green;
-    table[7] = HighColor::Colors::Magenta;
+    const HighColor magentaGreen[4] = { HighColor::Colors::Magenta, HighColor::Colors::Green, HighColor::Colors::Green, HighColor::Colors::Magenta };
+    const int16_t secondEntry = SRL::GouraudTable::Allocate(magentaGreen);
 
 	while(1)
 	{
@@ -65,7 +58,7 @@ int main()
         SRL::Scene2D::DrawSprite(textureIndex, Vector3D(-50.0, -50.0, 500.0));
         
         // Enable gouraud and use first gouraud table entry
-        SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Gouraud, 0);
+        SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Gouraud, firstEntry);
 
         // Draw second set of shapes
         SRL::Scene2D::DrawPolygon(second, false, HighColor::Colors::White, 500.0);
@@ -73,7 +66,7 @@ int main()
         SRL::Scene2D::DrawSprite(textureIndex, Vector3D(-50.0, 0.0, 500.0));
 
         // Enable gouraud and use second gouraud table entry
-        SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Gouraud, 1);
+        SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Gouraud, secondEntry);
 
         // Draw third set of shapes
         SRL::Scene2D::DrawPolygon(third, false, HighColor::Colors::White, 500.0);
@@ -0,0 +1,104 @@
+#include <srl.hpp>
+
+// Using to shorten names for Vector and HighColor
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+
+// Number of sprites drawn by each method
+#define SPRITE_COUNT 200
+
+// Rotated sprite drawn the old way, through full matrix and per corner transformation
+static bool DrawSpriteWithMatrix(const uint16_t texture, const Vector3D& location, const Angle& angle)
+{
+    const Vector2D halfSize = Vector2D(
+        Fxp((int16_t)SRL::VDP1::Textures[texture].Width) >> 1,
+        Fxp((int16_t)SRL::VDP1::Textures[texture].Height) >> 1);
+
+    SRL::Math::Matrix43 rotMat = SRL::Math::Matrix43::Identity();
+    rotMat.RotateZ(angle);
+
+    const Vector3D points[4]
+    {
+        Vector3D(-halfSize.X, -halfSize.Y, 0.0),
+        Vector3D(halfSize.X, -halfSize.Y, 0.0),
+        Vector3D(halfSize.X, halfSize.Y, 0.0),
+        Vector3D(-halfSize.X, halfSize.Y, 0.0)
+    };
+
+    const Vector2D realPoints[4] = {
+        Vector2D(location + rotMat.TransformPoint(points[0])),
+        Vector2D(location + rotMat.TransformPoint(points[1])),
+        Vector2D(location + rotMat.TransformPoint(points[2])),
+        Vector2D(location + rotMat.TransformPoint(points[3]))
+    };
+
+    return SRL::Scene2D::DrawSprite(texture, realPoints, location.Z);
+}
+
+// Main program entry
+int main()
+{
+    // Initialize library
+    SRL::Core::Initialize(HighColor::Colors::Black);
+    SRL::Debug::Print(1, 1, "VDP1 Rotated sprite benchmark");
+
+    // Load texture
+    SRL::Bitmap::TGA *tga = new SRL::Bitmap::TGA("TEST.TGA"); // Loads TGA file into main RAM
+    int32_t textureIndex = SRL::VDP1::TryLoadTexture(tga);    // Loads TGA into VDP1
+    delete tga;                                               // Frees main RAM
+
+    // Free running timer counts every 128 CPU clocks
+    TIM_FRT_INIT(TIM_CKS_128);
+
+    // Sprites are spread over the screen, left half is drawn the old way, right half by the batch
+    Vector3D oldLocations[SPRITE_COUNT];
+    Vector3D newLocations[SPRITE_COUNT];
+    Angle angles[SPRITE_COUNT];
+    SRL::Scene3D::SinCos rotations[SPRITE_COUNT];
+
+    for (int16_t sprite = 0; sprite < SPRITE_COUNT; sprite++)
+    {
+        const Fxp x = Fxp((int16_t)((sprite % 10) * 14));
+        const Fxp y = Fxp((int16_t)((sprite / 10) * 10));
+        oldLocations[sprite] = Vector3D(x - 150.0, y - 90.0, 500.0);
+        newLocations[sprite] = Vector3D(x + 20.0, y - 90.0, 500.0);
+    }
+
+    uint16_t frame = 0;
+
+    // Main program loop
+    while (1)
+    {
+        for (int16_t sprite = 0; sprite < SPRITE_COUNT; sprite++)
+        {
+            angles[sprite] = Angle::BuildRaw((uint16_t)((frame << 7) + (sprite << 9)));
+        }
+
+        frame++;
+
+        // Old path, full matrix and four 3D transformations per sprite
+        uint16_t start = TIM_FRT_GET_16();
+
+        for (int16_t sprite = 0; sprite < SPRITE_COUNT; sprite++)
+        {
+            DrawSpriteWithMatrix(textureIndex, oldLocations[sprite], angles[sprite]);
+        }
+
+        const uint16_t oldTicks = TIM_FRT_GET_16() - start;
+
+        // New path, one table pass for all angles and 2D rotate-scale kernel
+        start = TIM_FRT_GET_16();
+        SRL::Scene3D::CalculateSinCos(angles, rotations, SPRITE_COUNT);
+        SRL::Scene2D::DrawSprites(textureIndex, nullptr, newLocations, rotations, SPRITE_COUNT);
+        const uint16_t newTicks = TIM_FRT_GET_16() - start;
+
+        SRL::Debug::Print(1, 24, "Matrix path: %d us   ", (int32_t)TIM_FRT_CNT_TO_MCR(oldTicks));
+        SRL::Debug::Print(1, 25, "Kernel path: %d us   ", (int32_t)TIM_FRT_CNT_TO_MCR(newTicks));
+        SRL::Debug::Print(1, 26, "Speedup: %d%%   ", newTicks > 0 ? (oldTicks * 100) / newTicks : 0);
+
+        // Refresh screen
+        SRL::Core::Synchronize();
+    }
+
+    return 0;
+}
@@ -0,0 +1,3 @@
+:; "../../tools/scripts/run.sh" yabause; exit;
+@ECHO Off
+"../../tools/scripts/run.bat" yabause
@@ -0,0 +1,112 @@
+#include <srl.hpp>
+
+// Using to shorten names for Vector and HighColor
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+
+// Textures stored in both RAW.BIN and PACK.SRP, in the same order (FOG.TGA, LOGO.TGA, ELF_S.TGA)
+#define TEXTURE_COUNT 3
+
+static const uint16_t textureWidths[TEXTURE_COUNT] = { 128, 192, 64 };
+static const uint16_t textureHeights[TEXTURE_COUNT] = { 128, 192, 148 };
+static const SRL::CRAM::TextureColorMode textureModes[TEXTURE_COUNT] = {
+    SRL::CRAM::TextureColorMode::RGB555,
+    SRL::CRAM::TextureColorMode::Paletted256,
+    SRL::CRAM::TextureColorMode::Paletted256
+};
+
+// Number of v-blanks since start, CD reads are too long for the free running timer
+static volatile uint32_t vblankCounter = 0;
+
+/** @brief Static function that gets called each v-blank
+ */
+void VblankCounter()
+{
+    vblankCounter++;
+}
+
+// Load uncompressed textures, whole file is read into RAM and then sent to VRAM
+static uint32_t LoadRaw(const uint16_t firstTexture)
+{
+    const uint32_t start = vblankCounter;
+    SRL::Cd::File file = SRL::Cd::File("RAW.BIN");
+    uint8_t* data = new uint8_t[file.Size.Bytes];
+    file.LoadBytes(0, file.Size.Bytes, data);
+
+    uint8_t* texture = data;
+
+    for (uint16_t index = 0; index < TEXTURE_COUNT; index++)
+    {
+        SRL::VDP1::TryLoadTexture(textureWidths[index], textureHeights[index], textureModes[index], 0, texture);
+        texture += ((textureWidths[index] * textureHeights[index]) << 2) >> SRL::VDP1::GetSizeShifter(textureModes[index]);
+    }
+
+    delete[] data;
+    SRL::VDP1::ResetTextureHeap(firstTexture);
+    return vblankCounter - start;
+}
+
+// Load compressed textures, pack is read into RAM and decompressed straight into VRAM
+static uint32_t LoadPack(const uint16_t firstTexture)
+{
+    const uint32_t start = vblankCounter;
+    SRL::Types::TexturePack pack("PACK.SRP");
+    SRL::VDP1::ResetTextureHeap(firstTexture);
+    return vblankCounter - start;
+}
+
+// Main program entry
+int main()
+{
+    // Initialize library
+    SRL::Core::Initialize(HighColor::Colors::Black);
+    SRL::Debug::Print(1, 1, "VDP1 Texture pack benchmark");
+    SRL::Core::OnVblank += VblankCounter;
+
+    const uint16_t firstTexture = SRL::VDP1::GetTextureCount();
+
+    // Measure loading from CD, time is in v-blanks
+    const uint32_t rawVblanks = LoadRaw(firstTexture);
+    const uint32_t packVblanks = LoadPack(firstTexture);
+    SRL::Cd::File rawFile = SRL::Cd::File("RAW.BIN");
+    SRL::Cd::File packFile = SRL::Cd::File("PACK.SRP");
+    const int32_t rawBytes = rawFile.Size.Bytes;
+    const int32_t packBytes = packFile.Size.Bytes;
+
+    SRL::Debug::Print(1, 3, "Raw:  %d bytes, %d vblanks", rawBytes, rawVblanks);
+    SRL::Debug::Print(1, 4, "Pack: %d bytes, %d vblanks", packBytes, packVblanks);
+
+    // Keep compressed pack in RAM to measure decoding alone
+    uint8_t* packData = new uint8_t[packBytes];
+    packFile.LoadBytes(0, packBytes, packData);
+
+    // Free running timer counts every 128 CPU clocks
+    TIM_FRT_INIT(TIM_CKS_128);
+
+    // Texture pack loaded last stays in VRAM and is displayed
+    int32_t fogTexture = -1;
+
+    // Main program loop
+    while (1)
+    {
+        SRL::VDP1::ResetTextureHeap(firstTexture);
+
+        const uint16_t start = TIM_FRT_GET_16();
+        SRL::Types::TexturePack pack(packData);
+        const int32_t decodeTime = (int32_t)TIM_FRT_CNT_TO_MCR((uint16_t)(TIM_FRT_GET_16() - start));
+        fogTexture = pack.GetFirstTextureIndex();
+
+        SRL::Debug::Print(1, 6, "Decode: %d us   ", decodeTime);
+        SRL::Debug::Print(1, 7, "Decode: %d KB/s   ", decodeTime > 0 ? (int32_t)((rawBytes * 1000LL) / decodeTime) : 0);
+
+        if (fogTexture >= 0)
+        {
+            SRL::Scene2D::DrawSprite(fogTexture, Vector3D(0.0, 40.0, 500.0));
+        }
+
+        // Refresh screen
+        SRL::Core::Synchronize();
+    }
+
+    return 0;
+}
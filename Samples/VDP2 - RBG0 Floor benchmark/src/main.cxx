@@ -0,0 +1,95 @@
+/*VDP2 RBG0 Floor benchmark:
+Perspective floor drawn by RBG0 with a generated per line coefficient table.
+Time of a full table generation is compared with incremental update, where only lines
+whose coefficient changed are written to VRAM. Table can be generated on the slave SH2.
+*/
+#include <srl.hpp>
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Input;
+
+// Main program entry
+int main()
+{
+    // Initialize library
+    SRL::Core::Initialize(HighColor(20, 10, 50));
+    SRL::Debug::Print(1, 1, "VDP2 RBG0 Floor benchmark");
+
+    Digital port0(0); // Initialize gamepad on port 0
+
+    // Load floor tilemap, coefficient table gets its own bank afterwards
+    SRL::Tilemap::Interfaces::CubeTile* floorTiles = new SRL::Tilemap::Interfaces::CubeTile("FOGRGB.BIN");
+    SRL::VDP2::RBG0::LoadTilemap(*floorTiles);
+    SRL::VDP2::RBG0::SetRotationMode(SRL::VDP2::RotationMode::OneAxis);
+    slBMPaletteRbg0(9);
+    delete floorTiles;
+
+    SRL::VDP2::CoefficientTable* floor = new SRL::VDP2::CoefficientTable();
+    SRL::VDP2::RBG0::SetCoefficientTable(floor);
+    SRL::VDP2::RBG0::ScrollEnable();
+
+    SRL::Debug::Print(1, 3, "<Up [Height] Down>");
+    SRL::Debug::Print(1, 4, "<L [Horizon] R>");
+    SRL::Debug::Print(1, 5, "<Left [Turn] Right>");
+    SRL::Debug::Print(1, 6, "A: Full  B: Incremental");
+    SRL::Debug::Print(1, 7, "C: Toggle slave");
+
+    // Camera pose
+    Fxp height = 16.0;
+    int16_t horizon = 40;
+    int16_t yaw = 0;
+    bool incremental = true;
+    bool onSlave = false;
+
+    // Free running timer counts every 128 CPU clocks
+    TIM_FRT_INIT(TIM_CKS_128);
+
+    // Main program loop
+    while (1)
+    {
+        // Handle user inputs
+        if (port0.IsConnected())
+        {
+            if (port0.IsHeld(Digital::Button::Up)) height += 0.25;
+            else if (port0.IsHeld(Digital::Button::Down) && height > 1.0) height -= 0.25;
+
+            if (port0.IsHeld(Digital::Button::R)) horizon++;
+            else if (port0.IsHeld(Digital::Button::L)) horizon--;
+
+            if (port0.IsHeld(Digital::Button::Right)) yaw += DEGtoANG(1.0);
+            else if (port0.IsHeld(Digital::Button::Left)) yaw -= DEGtoANG(1.0);
+
+            if (port0.WasPressed(Digital::Button::A)) incremental = false;
+            else if (port0.WasPressed(Digital::Button::B)) incremental = true;
+
+            if (port0.WasPressed(Digital::Button::C)) onSlave = !onSlave;
+        }
+
+        // Full generation rewrites every line of the back buffer
+        if (!incremental) floor->Invalidate();
+
+        const uint16_t start = TIM_FRT_GET_16();
+        floor->Update(height, horizon, onSlave);
+        floor->Wait();
+        const int32_t updateTime = (int32_t)TIM_FRT_CNT_TO_MCR((uint16_t)(TIM_FRT_GET_16() - start));
+
+        SRL::Debug::Print(1, 9, "Mode:   %s %s   ", incremental ? "Incremental" : "Full", onSlave ? "(slave)" : "       ");
+        SRL::Debug::Print(1, 10, "Update: %d us   ", updateTime);
+        SRL::Debug::Print(1, 11, "Lines:  %d/%d   ", floor->GetWrittenLines(), floor->GetLineCount());
+
+        // Floor rotation, coefficient table takes care of perspective
+        slPushMatrix();
+        {
+            slTranslate(toFIXED(0.0), toFIXED(0.0), MsScreenDist);
+            slRotZ(yaw);
+            SRL::VDP2::RBG0::SetCurrentTransform();
+        }
+        slPopMatrix();
+
+        // Refresh screen
+        SRL::Core::Synchronize();
+    }
+
+    return 0;
+}
@@ -20,6 +20,28 @@
 #include "testsMemoryLWRam.hpp"   // Include the header for memory LWRam tests
 #include "testsMemoryCartRam.hpp" // Include the header for memory Cart Ram tests
 #include "testsString.hpp"        // Include the header for string tests
+#include "testsSceneGraph.hpp"    // Include the header for scene graph tests
+#include "testsAnimation.hpp"     // Include the header for animation tests
+#include "testsGouraudLightCache.hpp" // Include the header for gouraud light cache tests
+#include "testsModel.hpp"         // Include the header for model file tests
+#include "testsGovernor.hpp"      // Include the header for load governor tests
+#include "testsRotation.hpp"      // Include the header for rotation tests
+#include "testsLevelGrid.hpp"     // Include the header for level grid tests
+#include "testsSpriteBatch.hpp"   // Include the header for sprite batch tests
+#include "testsAtlas.hpp"         // Include the header for texture atlas tests
+#include "testsTextureCache.hpp"  // Include the header for texture cache tests
+#include "testsParticles.hpp"     // Include the header for particle tests
+#include "testsTexturePack.hpp"   // Include the header for texture pack tests
+#include "testsVdp1Stats.hpp"     // Include the header for VDP1 statistics tests
+#include "testsAnimatedSprite.hpp" // Include the header for animated sprite tests
+#include "testsGouraudTable.hpp"   // Include the header for gouraud table tests
+#include "testsClipStack.hpp"     // Include the header for clipping stack tests
+#include "testsVdp2Shadow.hpp"    // Include the header for VDP2 shadow tests
+#include "testsTileStream.hpp"    // Include the header for tile streaming tests
+#include "testsTileDedup.hpp"     // Include the header for tile deduplication tests
+#include "testsCyclePlanner.hpp"  // Include the header for VDP2 cycle planner tests
+#include "testsScrollTable.hpp"   // Include the header for scroll table tests
+#include "testsCoefficientTable.hpp" // Include the header for RBG0 coefficient table tests
 
 // Using to shorten names for Vector and HighColor
 using namespace SRL::Types;
@@ -117,6 +139,72 @@ int main()
   // // Run Memory CartRam test suite
   RUN_AND_DISPLAY_SUITE(memory_CartRam_test_suite);
 
+  // Run Scene graph test suite
+  RUN_AND_DISPLAY_SUITE(scene_graph_test_suite);
+
+  // Run Animation test suite
+  RUN_AND_DISPLAY_SUITE(animation_test_suite);
+
+  // Run Gouraud light cache test suite
+  RUN_AND_DISPLAY_SUITE(light_cache_test_suite);
+
+  // Run Model file test suite
+  RUN_AND_DISPLAY_SUITE(model_test_suite);
+
+  // Run Load governor test suite
+  RUN_AND_DISPLAY_SUITE(governor_test_suite);
+
+  // Run Rotation test suite
+  RUN_AND_DISPLAY_SUITE(rotation_test_suite);
+
+  // Run Level grid test suite
+  RUN_AND_DISPLAY_SUITE(level_grid_test_suite);
+
+  // Run Sprite batch test suite
+  RUN_AND_DISPLAY_SUITE(sprite_batch_test_suite);
+
+  // Run Texture atlas test suite
+  RUN_AND_DISPLAY_SUITE(atlas_test_suite);
+
+  // Run Texture cache test suite
+  RUN_AND_DISPLAY_SUITE(texture_cache_test_suite);
+
+  // Run Particles test suite
+  RUN_AND_DISPLAY_SUITE(particles_test_suite);
+
+  // Run Texture pack test suite
+  RUN_AND_DISPLAY_SUITE(texture_pack_test_suite);
+
+  // Run VDP1 statistics test suite
+  RUN_AND_DISPLAY_SUITE(vdp1_stats_test_suite);
+
+  // Run Animated sprite test suite
+  RUN_AND_DISPLAY_SUITE(animated_sprite_test_suite);
+
+  // Run Gouraud table test suite
+  RUN_AND_DISPLAY_SUITE(gouraud_table_test_suite);
+
+  // Run Clipping stack test suite
+  RUN_AND_DISPLAY_SUITE(clip_stack_test_suite);
+
+  // Run VDP2 shadow test suite
+  RUN_AND_DISPLAY_SUITE(vdp2_shadow_test_suite);
+
+  // Run Tile streaming test suite
+  RUN_AND_DISPLAY_SUITE(tile_stream_test_suite);
+
+  // Run Tile deduplication test suite
+  RUN_AND_DISPLAY_SUITE(tile_dedup_test_suite);
+
+  // Run VDP2 cycle planner test suite
+  RUN_AND_DISPLAY_SUITE(cycle_planner_test_suite);
+
+  // Run Scroll table test suite
+  RUN_AND_DISPLAY_SUITE(scroll_table_test_suite);
+
+  // Run RBG0 coefficient table test suite
+  RUN_AND_DISPLAY_SUITE(coefficient_table_test_suite);
+
   // // Generate tests report
   MU_REPORT();
 
@@ -0,0 +1,148 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    uint16_t animated_sprite_first_texture = 0;
+    uint16_t animated_sprite_sheet[16 * 8] = { 0 };
+
+    void animated_sprite_test_setup(void)
+    {
+        animated_sprite_first_texture = SRL::VDP1::GetTextureCount();
+
+        // Every pixel holds its index in the sheet
+        for (uint16_t pixel = 0; pixel < 16 * 8; pixel++)
+        {
+            animated_sprite_sheet[pixel] = pixel;
+        }
+    }
+
+    // UT teardown function, called after every tests
+    void animated_sprite_test_teardown(void)
+    {
+        SRL::VDP1::ResetTextureHeap(animated_sprite_first_texture);
+    }
+
+    // UT output header function, called on the first test failure
+    void animated_sprite_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_ANIMATED_SPRITE****");
+            }
+            else
+            {
+                LogInfo("****UT_ANIMATED_SPRITE_ERROR(S)****");
+            }
+        }
+    }
+
+    // Play clip right after v-blank, so test knows v-blank count the clip started at
+    uint32_t animated_sprite_play(SRL::Scene2D::AnimatedSprite& sprite, const uint16_t first, const uint16_t count, const bool loop)
+    {
+        const uint32_t previous = SRL::Core::GetVblankCount();
+
+        while (SRL::Core::GetVblankCount() == previous);
+
+        sprite.Play(first, count, loop);
+        return SRL::Core::GetVblankCount();
+    }
+
+    // Test that frames are cut from the sheet into a single block using two texture slots
+    MU_TEST(animated_sprite_test_load)
+    {
+        SRL::Scene2D::AnimatedSprite sprite(16, 8, SRL::CRAM::TextureColorMode::RGB555, 0, animated_sprite_sheet, 8, 4);
+
+        snprintf(buffer, buffer_size, "Load failed: %d != 4", sprite.GetFrameCount());
+        mu_assert(sprite.IsLoaded() && sprite.GetFrameCount() == 4, buffer);
+
+        snprintf(buffer, buffer_size, "Slot count failed: %d != 2", SRL::VDP1::GetTextureCount() - animated_sprite_first_texture);
+        mu_assert(SRL::VDP1::GetTextureCount() - animated_sprite_first_texture == 2, buffer);
+
+        // Each frame is 64 bytes, so frames are 8 address units apart
+        snprintf(buffer, buffer_size, "Address failed: %d != %d", sprite.GetFrameAddress(3), sprite.GetFrameAddress(0) + 24);
+        mu_assert(sprite.GetFrameAddress(0) == SRL::VDP1::Textures[sprite.GetTextureIndex()].Address &&
+            sprite.GetFrameAddress(3) == sprite.GetFrameAddress(0) + 24, buffer);
+
+        // Last frame starts in the middle of the fifth row of the sheet
+        const uint16_t* frame = (const uint16_t*)(SpriteVRAM + (sprite.GetFrameAddress(3) << 3));
+        snprintf(buffer, buffer_size, "Copy failed: %d,%d != 72,127", frame[0], frame[31]);
+        mu_assert(frame[0] == 72 && frame[8] == 88 && frame[31] == 127, buffer);
+    }
+
+    // Test that frames advance by their durations and clip loops
+    MU_TEST(animated_sprite_test_timing)
+    {
+        SRL::Scene2D::AnimatedSprite sprite(16, 8, SRL::CRAM::TextureColorMode::RGB555, 0, animated_sprite_sheet, 8, 4);
+        sprite.SetDuration(1, 3);
+
+        const uint32_t start = animated_sprite_play(sprite, 0, 0, true);
+        sprite.Update(start + 1);
+        const uint16_t second = sprite.GetCurrentFrame();
+        sprite.Update(start + 3);
+        const uint16_t held = sprite.GetCurrentFrame();
+        sprite.Update(start + 5);
+        const uint16_t last = sprite.GetCurrentFrame();
+
+        snprintf(buffer, buffer_size, "Durations failed: %d,%d,%d != 1,1,3", second, held, last);
+        mu_assert(second == 1 && held == 1 && last == 3, buffer);
+
+        // Clip is 6 v-blanks long, so after 100 loops animation is back on the first frame
+        sprite.Update(start + 6 + 600);
+
+        snprintf(buffer, buffer_size, "Loop failed: %d != 0", sprite.GetCurrentFrame());
+        mu_assert(sprite.GetCurrentFrame() == 0 && sprite.IsPlaying(), buffer);
+    }
+
+    // Test that clip without loop stops on its last frame
+    MU_TEST(animated_sprite_test_once)
+    {
+        SRL::Scene2D::AnimatedSprite sprite(16, 8, SRL::CRAM::TextureColorMode::RGB555, 0, animated_sprite_sheet, 8, 4);
+
+        const uint32_t start = animated_sprite_play(sprite, 1, 2, false);
+        sprite.Update(start + 10);
+
+        snprintf(buffer, buffer_size, "Stop failed: %d != 2", sprite.GetCurrentFrame());
+        mu_assert(sprite.GetCurrentFrame() == 2 && !sprite.IsPlaying(), buffer);
+    }
+
+    // Test that sprite batch takes current frame of an animated sprite
+    MU_TEST(animated_sprite_test_batch)
+    {
+        SRL::Scene2D::AnimatedSprite sprite(16, 8, SRL::CRAM::TextureColorMode::RGB555, 0, animated_sprite_sheet, 8, 4);
+        SRL::Scene2D::SpriteBatch<4> batch;
+        sprite.SetFrame(2);
+
+        uint16_t index = batch.Add(Vector2D(), sprite);
+
+        snprintf(buffer, buffer_size, "Batch frame failed: %d != %d", batch.Source[index], sprite.GetFrameAddress(2));
+        mu_assert(index == 0 && batch.Texture[index] == sprite.GetTextureIndex() && batch.Source[index] == sprite.GetFrameAddress(2), buffer);
+    }
+
+    MU_TEST_SUITE(animated_sprite_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&animated_sprite_test_setup,
+                                       &animated_sprite_test_teardown,
+                                       &animated_sprite_test_output_header);
+
+        MU_RUN_TEST(animated_sprite_test_load);
+        MU_RUN_TEST(animated_sprite_test_timing);
+        MU_RUN_TEST(animated_sprite_test_once);
+        MU_RUN_TEST(animated_sprite_test_batch);
+    }
+}
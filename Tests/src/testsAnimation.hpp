@@ -0,0 +1,174 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void animation_test_setup(void)
+    {
+        // Nothing to do here
+    }
+
+    // UT teardown function, called after every tests
+    void animation_test_teardown(void)
+    {
+        /* Nothing */
+    }
+
+    // UT output header function, called on the first test failure
+    void animation_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_ANIMATION****");
+            }
+            else
+            {
+                LogInfo("****UT_ANIMATION_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test interpolation kernel on raw values
+    MU_TEST(animation_test_interpolate_kernel)
+    {
+        int32_t base[3] = { 0, 0x10000, -0x10000 };
+        int16_t from[3] = { 0, 0, 0 };
+        int16_t to[3] = { 100, -100, 1000 };
+        int32_t result[3] = { };
+
+        AnimatedMesh::Interpolate(base, from, to, 0x8000, 2, result, 1);
+
+        snprintf(buffer, buffer_size, "Kernel X failed: %d != 200", result[0]);
+        mu_assert(result[0] == 200, buffer);
+
+        snprintf(buffer, buffer_size, "Kernel Y failed: %d != %d", result[1], 0x10000 - 200);
+        mu_assert(result[1] == 0x10000 - 200, buffer);
+
+        snprintf(buffer, buffer_size, "Kernel Z failed: %d != %d", result[2], -0x10000 + 2000);
+        mu_assert(result[2] == -0x10000 + 2000, buffer);
+    }
+
+    // Test interpolation between two keyframes
+    MU_TEST(animation_test_keyframes)
+    {
+        Mesh* keyframes = new Mesh[2];
+
+        for (size_t frame = 0; frame < 2; frame++)
+        {
+            keyframes[frame] = Mesh(2, 1);
+            keyframes[frame].Faces[0].Normal = Vector3D(0.0, 1.0, 0.0);
+        }
+
+        keyframes[0].Vertices[0] = Vector3D(0.0, 0.0, 0.0);
+        keyframes[0].Vertices[1] = Vector3D(10.0, 10.0, 10.0);
+        keyframes[1].Vertices[0] = Vector3D(100.0, -50.0, 2.0);
+        keyframes[1].Vertices[1] = Vector3D(10.0, 10.0, 10.0);
+
+        AnimatedMesh animation(keyframes, 2);
+        delete[] keyframes;
+
+        animation.ProcessFrame(0.5);
+        Vector3D* vertices = animation.GetMesh()->Vertices;
+
+        snprintf(buffer, buffer_size, "Interpolation X failed: %d != 50", vertices[0].X.As<int32_t>());
+        mu_assert(SRL::Math::Abs(vertices[0].X - Fxp(50.0)) < Fxp(0.01), buffer);
+
+        snprintf(buffer, buffer_size, "Interpolation Y failed: %d != -25", vertices[0].Y.As<int32_t>());
+        mu_assert(SRL::Math::Abs(vertices[0].Y - Fxp(-25.0)) < Fxp(0.01), buffer);
+
+        snprintf(buffer, buffer_size, "Static vertex failed: %d != 10", vertices[1].Z.As<int32_t>());
+        mu_assert(vertices[1].Z == 10.0, buffer);
+
+        animation.ProcessFrame(5.0);
+
+        snprintf(buffer, buffer_size, "Last frame failed: %d != 100", vertices[0].X.As<int32_t>());
+        mu_assert(SRL::Math::Abs(vertices[0].X - Fxp(100.0)) < Fxp(0.01), buffer);
+
+        Vector3D normal = animation.GetMesh()->Faces[0].Normal;
+
+        snprintf(buffer, buffer_size, "Normal failed: %d", normal.Y.RawValue());
+        mu_assert(SRL::Math::Abs(normal.Y - Fxp(1.0)) < Fxp(0.01), buffer);
+    }
+
+    // Test sampling of rigid bone clip
+    MU_TEST(animation_test_clip_sample)
+    {
+        // 2 bones, 2 keyframes, each key has 3 rotations and 3 translations
+        uint16_t data[] = {
+            2, 2,
+            0x0000, 0, 0xf000, 0, 0, 0,
+            0x0000, 0, 0, 0, 0, 0,
+            0x4000, 0, 0x1000, 16, 0, 0,
+            0x0000, 0, 0, 0, 0, (uint16_t)-32 };
+
+        AnimationClip clip(data);
+        BonePose pose[2];
+        clip.Sample(0.5, false, pose);
+
+        snprintf(buffer, buffer_size, "Rotation failed: %d != %d", pose[0].Rotation[0].RawValue(), 0x2000);
+        mu_assert(pose[0].Rotation[0].RawValue() == 0x2000, buffer);
+
+        snprintf(buffer, buffer_size, "Shortest path failed: %d != 0", pose[0].Rotation[2].RawValue());
+        mu_assert(pose[0].Rotation[2].RawValue() == 0, buffer);
+
+        snprintf(buffer, buffer_size, "Translation failed: %d != %d", pose[0].Translation.X.RawValue(), 0x8000);
+        mu_assert(pose[0].Translation.X == 0.5, buffer);
+
+        snprintf(buffer, buffer_size, "Translation failed: %d != %d", pose[1].Translation.Z.RawValue(), -0x10000);
+        mu_assert(pose[1].Translation.Z == -1.0, buffer);
+
+        clip.Sample(3.0, true, pose);
+
+        snprintf(buffer, buffer_size, "Loop failed: %d != %d", pose[0].Rotation[0].RawValue(), 0x4000);
+        mu_assert(pose[0].Rotation[0].RawValue() == 0x4000, buffer);
+    }
+
+    // Test blending of two clip poses
+    MU_TEST(animation_test_clip_blend)
+    {
+        uint16_t idle[] = { 1, 1, 0, 0, 0, 0, 0, 0 };
+        uint16_t wave[] = { 1, 1, 0x4000, 0, 0, 32, 0, 0 };
+
+        AnimationClip idleClip(idle);
+        AnimationClip waveClip(wave);
+
+        Skeleton skeleton(1);
+        skeleton.Sample(idleClip, 0.0);
+        skeleton.Blend(waveClip, 0.0, 0.5);
+
+        BonePose& pose = skeleton.GetPose(0);
+
+        snprintf(buffer, buffer_size, "Blend rotation failed: %d != %d", pose.Rotation[0].RawValue(), 0x2000);
+        mu_assert(pose.Rotation[0].RawValue() == 0x2000, buffer);
+
+        snprintf(buffer, buffer_size, "Blend translation failed: %d != %d", pose.Translation.X.RawValue(), 0x10000);
+        mu_assert(pose.Translation.X == 1.0, buffer);
+    }
+
+    MU_TEST_SUITE(animation_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&animation_test_setup,
+                                       &animation_test_teardown,
+                                       &animation_test_output_header);
+
+        MU_RUN_TEST(animation_test_interpolate_kernel);
+        MU_RUN_TEST(animation_test_keyframes);
+        MU_RUN_TEST(animation_test_clip_sample);
+        MU_RUN_TEST(animation_test_clip_blend);
+    }
+}
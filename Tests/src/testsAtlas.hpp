@@ -0,0 +1,201 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    uint16_t atlas_first_texture = 0;
+
+    void atlas_test_setup(void)
+    {
+        atlas_first_texture = SRL::VDP1::GetTextureCount();
+    }
+
+    // UT teardown function, called after every tests
+    void atlas_test_teardown(void)
+    {
+        while (SRL::Scene2D::GetClippingDepth() > 0)
+        {
+            SRL::Scene2D::PopClippingRectangle(500.0);
+        }
+
+        SRL::VDP1::ResetTextureHeap(atlas_first_texture);
+    }
+
+    // UT output header function, called on the first test failure
+    void atlas_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_ATLAS****");
+            }
+            else
+            {
+                LogInfo("****UT_ATLAS_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that images are placed on shelves and image too big for the atlas is rejected
+    MU_TEST(atlas_test_pack)
+    {
+        uint16_t pixels[20 * 10] = { 0 };
+        TextureAtlas atlas(32, 32);
+        mu_assert(atlas.IsLoaded(), "Atlas allocation failed");
+
+        int32_t first = atlas.Add(8, 8, pixels);
+        int32_t second = atlas.Add(6, 4, pixels);
+        int32_t third = atlas.Add(20, 10, pixels);
+        int32_t tooBig = atlas.Add(40, 4, pixels);
+
+        snprintf(buffer, buffer_size, "First region failed: %d,%d != 0,0", atlas.GetRegion(first).X, atlas.GetRegion(first).Y);
+        mu_assert(first == 0 && atlas.GetRegion(first).X == 0 && atlas.GetRegion(first).Y == 0, buffer);
+
+        snprintf(buffer, buffer_size, "Second region failed: %d,%d != 8,0", atlas.GetRegion(second).X, atlas.GetRegion(second).Y);
+        mu_assert(second == 1 && atlas.GetRegion(second).X == 8 && atlas.GetRegion(second).Y == 0, buffer);
+
+        snprintf(buffer, buffer_size, "Third region failed: %d,%d != 0,8", atlas.GetRegion(third).X, atlas.GetRegion(third).Y);
+        mu_assert(third == 2 && atlas.GetRegion(third).X == 0 && atlas.GetRegion(third).Y == 8, buffer);
+
+        snprintf(buffer, buffer_size, "Too big image failed: %d != -1", tooBig);
+        mu_assert(tooBig == -1 && atlas.GetRegionCount() == 3, buffer);
+
+        snprintf(buffer, buffer_size, "Used area failed: %d != 288", atlas.GetUsedArea());
+        mu_assert(atlas.GetUsedArea() == 288, buffer);
+    }
+
+    // Test that image pixels are copied into the atlas rows
+    MU_TEST(atlas_test_copy)
+    {
+        const uint16_t pixels[4 * 2] = { 0x8001, 0x8002, 0x8003, 0x8004, 0x8005, 0x8006, 0x8007, 0x8008 };
+        TextureAtlas atlas(16, 16);
+        mu_assert(atlas.IsLoaded(), "Atlas allocation failed");
+
+        atlas.Add(4, 2, pixels);
+        int32_t region = atlas.Add(4, 2, pixels);
+        const uint16_t* data = (const uint16_t*)SRL::VDP1::Textures[atlas.GetTexture()].GetData();
+
+        snprintf(buffer, buffer_size, "First row failed: %x != 8001", data[4]);
+        mu_assert(region == 1 && data[4] == 0x8001 && data[7] == 0x8004, buffer);
+
+        snprintf(buffer, buffer_size, "Second row failed: %x != 8005", data[16 + 4]);
+        mu_assert(data[16 + 4] == 0x8005 && data[16 + 7] == 0x8008, buffer);
+    }
+
+    // Test that atlas file is loaded and images can be added under the packed ones
+    MU_TEST(atlas_test_load)
+    {
+        // Header, single 16x2 region and pixel data
+        uint32_t file[(24 + 8 + (16 * 2 * 2)) / 4] = { 0 };
+        TextureAtlas::Header* header = (TextureAtlas::Header*)file;
+        header->Magic[0] = 'S';
+        header->Magic[1] = 'R';
+        header->Magic[2] = 'L';
+        header->Magic[3] = 'A';
+        header->Version = TextureAtlas::Version;
+        header->ColorMode = (uint16_t)SRL::CRAM::TextureColorMode::RGB555;
+        header->Width = 16;
+        header->Height = 8;
+        header->RegionCount = 1;
+        header->RegionOffset = 24;
+        header->DataOffset = 32;
+
+        TextureAtlas::Region* region = (TextureAtlas::Region*)(((uint8_t*)file) + 24);
+        region->X = 0;
+        region->Y = 0;
+        region->Width = 16;
+        region->Height = 2;
+
+        TextureAtlas atlas((const void*)file, 0, 1);
+        mu_assert(atlas.IsLoaded(), "Atlas loading failed");
+
+        uint16_t pixels[4] = { 0 };
+        int32_t added = atlas.Add(2, 2, pixels);
+
+        snprintf(buffer, buffer_size, "Loaded regions failed: %d != 2", atlas.GetRegionCount());
+        mu_assert(atlas.GetRegionCount() == 2 && atlas.GetRegion(0).Width == 16, buffer);
+
+        snprintf(buffer, buffer_size, "Added region failed: %d,%d != 0,2", atlas.GetRegion(added).X, atlas.GetRegion(added).Y);
+        mu_assert(added == 1 && atlas.GetRegion(added).X == 0 && atlas.GetRegion(added).Y == 2, buffer);
+    }
+
+    // Test that atlas with region reaching outside of the atlas is rejected before texture is allocated
+    MU_TEST(atlas_test_load_bounds)
+    {
+        uint32_t file[(24 + 8 + (16 * 2 * 2)) / 4] = { 0 };
+        TextureAtlas::Header* header = (TextureAtlas::Header*)file;
+        header->Magic[0] = 'S';
+        header->Magic[1] = 'R';
+        header->Magic[2] = 'L';
+        header->Magic[3] = 'A';
+        header->Version = TextureAtlas::Version;
+        header->ColorMode = (uint16_t)SRL::CRAM::TextureColorMode::RGB555;
+        header->Width = 16;
+        header->Height = 2;
+        header->RegionCount = 1;
+        header->RegionOffset = 24;
+        header->DataOffset = 32;
+
+        TextureAtlas::Region* region = (TextureAtlas::Region*)(((uint8_t*)file) + 24);
+        region->X = 8;
+        region->Y = 0;
+        region->Width = 16;
+        region->Height = 2;
+
+        const uint16_t textures = SRL::VDP1::GetTextureCount();
+        TextureAtlas atlas((const void*)file);
+
+        snprintf(buffer, buffer_size, "Bounds check failed: %d", SRL::VDP1::GetTextureCount() - textures);
+        mu_assert(!atlas.IsLoaded() && SRL::VDP1::GetTextureCount() == textures, buffer);
+    }
+
+    // Test that clipped images can read the clipping stack rectangle they must stay in
+    MU_TEST(atlas_test_clip_window)
+    {
+        Vector2D topLeft;
+        Vector2D bottomRight;
+
+        snprintf(buffer, buffer_size, "Empty stack failed");
+        mu_assert(!SRL::Scene2D::GetClippingRectangle(topLeft, bottomRight), buffer);
+
+        SRL::Scene2D::PushClippingRectangle(Vector3D(10.0, 20.0, 500.0), Vector2D(99.0, 49.0));
+        const bool window = SRL::Scene2D::GetClippingRectangle(topLeft, bottomRight);
+
+        snprintf(buffer, buffer_size, "Window failed: %d,%d,%d,%d",
+            topLeft.X.As<int16_t>(), topLeft.Y.As<int16_t>(), bottomRight.X.As<int16_t>(), bottomRight.Y.As<int16_t>());
+        mu_assert(window && topLeft.X == 10.0 && topLeft.Y == 20.0 && bottomRight.X == 109.0 && bottomRight.Y == 69.0, buffer);
+
+        // Rectangle drawing only its outside does not limit the image rectangle
+        SRL::Scene2D::PushClippingRectangle(Vector3D(30.0, 30.0, 500.0), Vector2D(9.0, 9.0), SRL::Scene2D::ClippingEffect::ClipInside);
+
+        snprintf(buffer, buffer_size, "Inside mode failed");
+        mu_assert(!SRL::Scene2D::GetClippingRectangle(topLeft, bottomRight), buffer);
+    }
+
+    MU_TEST_SUITE(atlas_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&atlas_test_setup,
+                                       &atlas_test_teardown,
+                                       &atlas_test_output_header);
+
+        MU_RUN_TEST(atlas_test_pack);
+        MU_RUN_TEST(atlas_test_copy);
+        MU_RUN_TEST(atlas_test_load);
+        MU_RUN_TEST(atlas_test_load_bounds);
+        MU_RUN_TEST(atlas_test_clip_window);
+    }
+}
@@ -0,0 +1,133 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void clip_stack_test_setup(void)
+    {
+        SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Clipping);
+    }
+
+    // UT teardown function, called after every tests
+    void clip_stack_test_teardown(void)
+    {
+        while (SRL::Scene2D::GetClippingDepth() > 0)
+        {
+            SRL::Scene2D::PopClippingRectangle(500.0);
+        }
+
+        SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Clipping);
+    }
+
+    // UT output header function, called on the first test failure
+    void clip_stack_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_CLIP_STACK****");
+            }
+            else
+            {
+                LogInfo("****UT_CLIP_STACK_ERROR(S)****");
+            }
+        }
+    }
+
+    // Get area relative to the top left corner of the screen, as tested areas are relative to the center of the screen
+    SRL::Scene2D::ClipTest clip_stack_test(const int16_t left, const int16_t top, const int16_t right, const int16_t bottom)
+    {
+        const int16_t centerX = SRL::TV::Width >> 1;
+        const int16_t centerY = SRL::TV::Height >> 1;
+
+        return SRL::Scene2D::TestClipping(
+            Vector2D((int16_t)(left - centerX), (int16_t)(top - centerY)),
+            Vector2D((int16_t)(right - centerX), (int16_t)(bottom - centerY)));
+    }
+
+    // Test that push and pop nest rectangles and restore clipping mode
+    MU_TEST(clip_stack_test_nesting)
+    {
+        bool pushed = SRL::Scene2D::PushClippingRectangle(Vector3D(0.0, 0.0, 500.0), Vector2D(100.0, 100.0));
+        pushed &= SRL::Scene2D::PushClippingRectangle(Vector3D(10.0, 10.0, 500.0), Vector2D(20.0, 20.0), SRL::Scene2D::ClippingEffect::ClipInside);
+
+        snprintf(buffer, buffer_size, "Push failed: %d,%d", SRL::Scene2D::GetClippingDepth(), SRL::Scene2D::GetEffect(SRL::Scene2D::SpriteEffect::Clipping));
+        mu_assert(pushed && SRL::Scene2D::GetClippingDepth() == 2 &&
+            SRL::Scene2D::GetEffect(SRL::Scene2D::SpriteEffect::Clipping) == SRL::Scene2D::ClippingEffect::ClipInside, buffer);
+
+        SRL::Scene2D::PopClippingRectangle(500.0);
+
+        snprintf(buffer, buffer_size, "Pop failed: %d,%d", SRL::Scene2D::GetClippingDepth(), SRL::Scene2D::GetEffect(SRL::Scene2D::SpriteEffect::Clipping));
+        mu_assert(SRL::Scene2D::GetClippingDepth() == 1 &&
+            SRL::Scene2D::GetEffect(SRL::Scene2D::SpriteEffect::Clipping) == SRL::Scene2D::ClippingEffect::ClipOutside, buffer);
+
+        SRL::Scene2D::PopClippingRectangle(500.0);
+
+        snprintf(buffer, buffer_size, "Mode restore failed: %d", SRL::Scene2D::GetEffect(SRL::Scene2D::SpriteEffect::Clipping));
+        mu_assert(SRL::Scene2D::GetClippingDepth() == 0 &&
+            SRL::Scene2D::GetEffect(SRL::Scene2D::SpriteEffect::Clipping) == SRL::Scene2D::ClippingEffect::NoClipping, buffer);
+    }
+
+    // Test areas against rectangle drawing only its inside
+    MU_TEST(clip_stack_test_outside)
+    {
+        snprintf(buffer, buffer_size, "Empty stack failed");
+        mu_assert(clip_stack_test(500, 500, 510, 510) == SRL::Scene2D::ClipTest::Visible, buffer);
+
+        SRL::Scene2D::PushClippingRectangle(Vector3D(50.0, 50.0, 500.0), Vector2D(49.0, 49.0));
+
+        snprintf(buffer, buffer_size, "Inside failed");
+        mu_assert(clip_stack_test(50, 50, 99, 99) == SRL::Scene2D::ClipTest::Visible, buffer);
+
+        snprintf(buffer, buffer_size, "Edge failed");
+        mu_assert(clip_stack_test(40, 60, 50, 70) == SRL::Scene2D::ClipTest::Partial &&
+            clip_stack_test(90, 90, 120, 120) == SRL::Scene2D::ClipTest::Partial, buffer);
+
+        snprintf(buffer, buffer_size, "Outside failed");
+        mu_assert(clip_stack_test(0, 0, 49, 200) == SRL::Scene2D::ClipTest::Hidden &&
+            clip_stack_test(100, 60, 120, 70) == SRL::Scene2D::ClipTest::Hidden &&
+            clip_stack_test(60, 100, 70, 120) == SRL::Scene2D::ClipTest::Hidden, buffer);
+    }
+
+    // Test areas against rectangle drawing only its outside
+    MU_TEST(clip_stack_test_inside)
+    {
+        SRL::Scene2D::PushClippingRectangle(Vector3D(50.0, 50.0, 500.0), Vector2D(49.0, 49.0), SRL::Scene2D::ClippingEffect::ClipInside);
+
+        snprintf(buffer, buffer_size, "Inverted failed");
+        mu_assert(clip_stack_test(60, 60, 70, 70) == SRL::Scene2D::ClipTest::Hidden &&
+            clip_stack_test(40, 60, 50, 70) == SRL::Scene2D::ClipTest::Partial &&
+            clip_stack_test(0, 0, 10, 10) == SRL::Scene2D::ClipTest::Visible, buffer);
+
+        // Clipping turned off by effect does not reject anything
+        SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Clipping);
+
+        snprintf(buffer, buffer_size, "Disabled clipping failed");
+        mu_assert(clip_stack_test(60, 60, 70, 70) == SRL::Scene2D::ClipTest::Visible, buffer);
+    }
+
+    MU_TEST_SUITE(clip_stack_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&clip_stack_test_setup,
+                                       &clip_stack_test_teardown,
+                                       &clip_stack_test_output_header);
+
+        MU_RUN_TEST(clip_stack_test_nesting);
+        MU_RUN_TEST(clip_stack_test_outside);
+        MU_RUN_TEST(clip_stack_test_inside);
+    }
+}
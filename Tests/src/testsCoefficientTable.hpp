@@ -0,0 +1,100 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void coefficient_table_test_setup(void)
+    {
+        // Table needs an empty VRAM bank
+        SRL::VDP2::ClearVRAM();
+    }
+
+    // UT teardown function, called after every tests
+    void coefficient_table_test_teardown(void)
+    {
+        SRL::VDP2::ClearVRAM();
+    }
+
+    // UT output header function, called on the first test failure
+    void coefficient_table_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_COEFFICIENT_TABLE****");
+            }
+            else
+            {
+                LogInfo("****UT_COEFFICIENT_TABLE_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that lines below horizon get height divided by distance and lines above are transparent
+    MU_TEST(coefficient_table_test_values)
+    {
+        SRL::VDP2::CoefficientTable table;
+        table.Update(8.0, 10);
+
+        snprintf(buffer, buffer_size, "Table not swapped");
+        mu_assert(table.Swap(), buffer);
+
+        int32_t* front = table.GetFront();
+
+        snprintf(buffer, buffer_size, "Coefficients failed: %d %d %d", (int)front[10], (int)front[11], (int)front[14]);
+        mu_assert(front[10] == (int32_t)0x80000000 && front[11] == Fxp(8.0).RawValue() && front[14] == Fxp(2.0).RawValue(), buffer);
+    }
+
+    // Test that only changed lines are written
+    MU_TEST(coefficient_table_test_incremental)
+    {
+        SRL::VDP2::CoefficientTable table;
+        table.Update(8.0, 10);
+        table.Swap();
+        table.Update(8.0, 10);
+        table.Swap();
+
+        snprintf(buffer, buffer_size, "Full update wrote %d lines", table.GetWrittenLines());
+        mu_assert(table.GetWrittenLines() == table.GetLineCount() - 11, buffer);
+
+        table.Update(8.0, 10);
+
+        snprintf(buffer, buffer_size, "Unchanged pose wrote %d lines", table.GetWrittenLines());
+        mu_assert(table.GetWrittenLines() == 0, buffer);
+
+        table.Update(8.0, 20);
+
+        snprintf(buffer, buffer_size, "Horizon shift wrote %d lines", table.GetWrittenLines());
+        mu_assert(table.GetWrittenLines() == table.GetLineCount() - 11, buffer);
+
+        table.Invalidate();
+        table.Update(8.0, 20);
+
+        snprintf(buffer, buffer_size, "Invalidated update wrote %d lines", table.GetWrittenLines());
+        mu_assert(table.GetWrittenLines() == table.GetLineCount(), buffer);
+    }
+
+    MU_TEST_SUITE(coefficient_table_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&coefficient_table_test_setup,
+                                       &coefficient_table_test_teardown,
+                                       &coefficient_table_test_output_header);
+
+        MU_RUN_TEST(coefficient_table_test_values);
+        MU_RUN_TEST(coefficient_table_test_incremental);
+    }
+}
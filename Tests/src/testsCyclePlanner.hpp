@@ -0,0 +1,117 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void cycle_planner_test_setup(void)
+    {
+        // Start with debug text layer only
+        SRL::VDP2::CyclePlanner::Reset();
+    }
+
+    // UT teardown function, called after every tests
+    void cycle_planner_test_teardown(void)
+    {
+        SRL::VDP2::CyclePlanner::SetReduction(scnNBG0, SRL::VDP2::ScaleLimit::Full);
+        SRL::VDP2::CyclePlanner::Reset();
+    }
+
+    // UT output header function, called on the first test failure
+    void cycle_planner_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_CYCLE_PLANNER****");
+            }
+            else
+            {
+                LogInfo("****UT_CYCLE_PLANNER_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that debug text only uses pattern name and one character read of bank B1
+    MU_TEST(cycle_planner_test_ascii)
+    {
+        uint8_t freeA0 = SRL::VDP2::CyclePlanner::GetFreeTimings(SRL::VDP2::VramBank::A0);
+        uint8_t freeB1 = SRL::VDP2::CyclePlanner::GetFreeTimings(SRL::VDP2::VramBank::B1);
+
+        snprintf(buffer, buffer_size, "Free timings failed: A0 %d, B1 %d", freeA0, freeB1);
+        mu_assert(freeA0 == 8 && freeB1 == 6, buffer);
+    }
+
+    // Test that reads of several screens share a bank until it is full
+    MU_TEST(cycle_planner_test_bank_full)
+    {
+        // NBG0 and NBG1 RGB cells in B0, maps in A0
+        SRL::VDP2::CyclePlanner::Assign(scnNBG0, 0, 1 << 2, 4);
+
+        snprintf(buffer, buffer_size, "Second RGB screen rejected");
+        mu_assert(SRL::VDP2::CyclePlanner::CanPlace(scnNBG1, 0, 1 << 2, 4), buffer);
+
+        SRL::VDP2::CyclePlanner::Assign(scnNBG1, 0, 1 << 2, 4);
+
+        snprintf(buffer, buffer_size, "Full bank accepted");
+        mu_assert(!SRL::VDP2::CyclePlanner::CanPlace(scnNBG2, 0, 1 << 2, 1), buffer);
+
+        snprintf(buffer, buffer_size, "Other bank rejected");
+        mu_assert(SRL::VDP2::CyclePlanner::CanPlace(scnNBG2, 0, 1 << 1, 1), buffer);
+    }
+
+    // Test that scale limit multiplies character reads
+    MU_TEST(cycle_planner_test_reduction)
+    {
+        SRL::VDP2::CyclePlanner::Assign(scnNBG0, 0, 1 << 2, 2);
+
+        snprintf(buffer, buffer_size, "Full scale rejected");
+        mu_assert(SRL::VDP2::CyclePlanner::CanPlace(scnNBG0, -1, 0, 0), buffer);
+
+        SRL::VDP2::CyclePlanner::SetReduction(scnNBG0, SRL::VDP2::ScaleLimit::Quarter);
+
+        snprintf(buffer, buffer_size, "Quarter scale accepted");
+        mu_assert(!SRL::VDP2::CyclePlanner::CanPlace(scnNBG0, -1, 0, 0), buffer);
+    }
+
+    // Test that banks reserved by RBG0 are kept out of the plan
+    MU_TEST(cycle_planner_test_rotation)
+    {
+        snprintf(buffer, buffer_size, "Reserve failed");
+        mu_assert(SRL::VDP2::CyclePlanner::ReserveRotationBank(SRL::VDP2::VramBank::A1), buffer);
+
+        snprintf(buffer, buffer_size, "Debug text bank reserved");
+        mu_assert(!SRL::VDP2::CyclePlanner::ReserveRotationBank(SRL::VDP2::VramBank::B1), buffer);
+
+        snprintf(buffer, buffer_size, "Rotation bank accepted for NBG2");
+        mu_assert(!SRL::VDP2::CyclePlanner::CanPlace(scnNBG2, 1, 0, 0), buffer);
+
+        snprintf(buffer, buffer_size, "Rotation bank has free timings");
+        mu_assert(SRL::VDP2::CyclePlanner::GetFreeTimings(SRL::VDP2::VramBank::A1) == 0, buffer);
+    }
+
+    MU_TEST_SUITE(cycle_planner_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&cycle_planner_test_setup,
+                                       &cycle_planner_test_teardown,
+                                       &cycle_planner_test_output_header);
+
+        MU_RUN_TEST(cycle_planner_test_ascii);
+        MU_RUN_TEST(cycle_planner_test_bank_full);
+        MU_RUN_TEST(cycle_planner_test_reduction);
+        MU_RUN_TEST(cycle_planner_test_rotation);
+    }
+}
@@ -0,0 +1,153 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // Gouraud table block used by the test mesh, freed in teardown even if test fails
+    int16_t light_cache_block = -1;
+    HighColor light_cache_shading[32];
+
+    // UT setup function, called before every tests
+    void light_cache_test_setup(void)
+    {
+        light_cache_block = SRL::GouraudTable::Reserve(2);
+
+        for (uint8_t color = 0; color < 32; color++)
+        {
+            light_cache_shading[color] = HighColor::FromRGB555(color, color, color);
+        }
+    }
+
+    // UT teardown function, called after every tests
+    void light_cache_test_teardown(void)
+    {
+        if (light_cache_block >= 0)
+        {
+            SRL::GouraudTable::Free(light_cache_block, 2);
+            light_cache_block = -1;
+        }
+    }
+
+    // UT output header function, called on the first test failure
+    void light_cache_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_LIGHT_CACHE****");
+            }
+            else
+            {
+                LogInfo("****UT_LIGHT_CACHE_ERROR(S)****");
+            }
+        }
+    }
+
+    // Build 2 face mesh lit by the reserved gouraud table block
+    void light_cache_test_mesh(SmoothMesh& mesh)
+    {
+        for (uint8_t vertex = 0; vertex < 4; vertex++)
+        {
+            mesh.Vertices[vertex] = Vector3D();
+            mesh.Normals[vertex] = Vector3D(0.0, 0.0, 1.0);
+        }
+
+        for (uint8_t face = 0; face < 2; face++)
+        {
+            for (uint8_t vertex = 0; vertex < 4; vertex++)
+            {
+                mesh.Faces[face].Vertices[vertex] = vertex;
+            }
+
+            mesh.Attributes[face].Sort |= UseGouraud;
+            mesh.Attributes[face].Gouraud = 0xe000 + light_cache_block + face;
+        }
+    }
+
+    // Test that light cache copies only entries changed since the last copy
+    MU_TEST(light_cache_test_copy)
+    {
+        snprintf(buffer, buffer_size, "Reserve failed: %d", light_cache_block);
+        mu_assert(light_cache_block >= 0, buffer);
+
+        SmoothMesh mesh(4, 2);
+        light_cache_test_mesh(mesh);
+
+        // Mark entries in VRAM to see which ones were copied
+        uint16_t* vram = (uint16_t*)(SRL::VDP1::GetGouraudTable() + (light_cache_block << 2));
+
+        for (uint8_t color = 0; color < 8; color++)
+        {
+            vram[color] = 0x1234;
+        }
+
+        GouraudLightCache cache(mesh, light_cache_shading);
+        cache.SetLight(Vector3D(0.0, 0.0, 1.0));
+        cache.Update(1);
+
+        // Copy might have already run in v-blank, range is empty then
+        const uint32_t mask = get_imask();
+        set_imask(15);
+        cache.CopyToVRAM();
+        set_imask(mask);
+
+        snprintf(buffer, buffer_size, "First copy failed: %x,%x", vram[0], vram[4]);
+        mu_assert(vram[0] == *(uint16_t*)&light_cache_shading[31] && vram[4] == 0x1234 && cache.IsPending(), buffer);
+
+        cache.Update();
+        set_imask(15);
+        cache.CopyToVRAM();
+        set_imask(mask);
+
+        snprintf(buffer, buffer_size, "Second copy failed: %x,%x", vram[3], vram[7]);
+        mu_assert(vram[3] == *(uint16_t*)&light_cache_shading[31] && vram[7] == *(uint16_t*)&light_cache_shading[31] && !cache.IsPending(), buffer);
+    }
+
+    // Test that mesh color calculation mode is restored when cache is destroyed
+    MU_TEST(light_cache_test_restore)
+    {
+        snprintf(buffer, buffer_size, "Reserve failed: %d", light_cache_block);
+        mu_assert(light_cache_block >= 0, buffer);
+
+        SmoothMesh mesh(4, 2);
+        light_cache_test_mesh(mesh);
+        mesh.Attributes[1].Display |= CL_Gouraud;
+        const uint16_t original = mesh.Attributes[0].Display;
+
+        {
+            GouraudLightCache cache(mesh, light_cache_shading);
+
+            snprintf(buffer, buffer_size, "Switch failed: %x", mesh.Attributes[0].Display);
+            mu_assert((mesh.Attributes[0].Display & CL_Gouraud) != 0, buffer);
+        }
+
+        snprintf(buffer, buffer_size, "Restore failed: %x != %x", mesh.Attributes[0].Display, original);
+        mu_assert(mesh.Attributes[0].Display == original, buffer);
+
+        snprintf(buffer, buffer_size, "Preset mode failed: %x", mesh.Attributes[1].Display);
+        mu_assert((mesh.Attributes[1].Display & CL_Gouraud) != 0, buffer);
+    }
+
+    MU_TEST_SUITE(light_cache_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&light_cache_test_setup,
+                                       &light_cache_test_teardown,
+                                       &light_cache_test_output_header);
+
+        MU_RUN_TEST(light_cache_test_copy);
+        MU_RUN_TEST(light_cache_test_restore);
+    }
+}
@@ -0,0 +1,151 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    const HighColor gouraud_table_colors[4] = { HighColor::Colors::Red, HighColor::Colors::Green, HighColor::Colors::Blue, HighColor::Colors::White };
+    const HighColor gouraud_table_other[4] = { HighColor::Colors::Blue, HighColor::Colors::Blue, HighColor::Colors::Red, HighColor::Colors::Red };
+    uint16_t gouraud_table_free = 0;
+
+    void gouraud_table_test_setup(void)
+    {
+        gouraud_table_free = SRL::GouraudTable::GetFreeCount();
+    }
+
+    // UT teardown function, called after every tests
+    void gouraud_table_test_teardown(void)
+    {
+        // Do nothing
+    }
+
+    // UT output header function, called on the first test failure
+    void gouraud_table_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_GOURAUD_TABLE****");
+            }
+            else
+            {
+                LogInfo("****UT_GOURAUD_TABLE_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that identical tables share one entry
+    MU_TEST(gouraud_table_test_dedup)
+    {
+        int16_t first = SRL::GouraudTable::Allocate(gouraud_table_colors);
+        int16_t second = SRL::GouraudTable::Allocate(gouraud_table_colors);
+        int16_t other = SRL::GouraudTable::Allocate(gouraud_table_other);
+
+        snprintf(buffer, buffer_size, "Dedup failed: %d,%d,%d", first, second, other);
+        mu_assert(first >= 0 && first == second && other >= 0 && other != first, buffer);
+
+        snprintf(buffer, buffer_size, "Reference count failed: %d != 2", SRL::GouraudTable::GetReferenceCount(first));
+        mu_assert(SRL::GouraudTable::GetReferenceCount(first) == 2 && SRL::GouraudTable::GetFreeCount() == gouraud_table_free - 2, buffer);
+
+        HighColor* colors = SRL::GouraudTable::GetEntry(other);
+
+        snprintf(buffer, buffer_size, "Entry colors failed");
+        mu_assert(colors[0] == HighColor::Colors::Blue && colors[3] == HighColor::Colors::Red, buffer);
+
+        SRL::GouraudTable::Release(first);
+        SRL::GouraudTable::Release(first);
+        SRL::GouraudTable::Release(other);
+    }
+
+    // Test that entry is freed with its last reference and found again after other entries were freed
+    MU_TEST(gouraud_table_test_release)
+    {
+        int16_t first = SRL::GouraudTable::Allocate(gouraud_table_colors);
+        int16_t other = SRL::GouraudTable::Allocate(gouraud_table_other);
+        SRL::GouraudTable::AddReference(other);
+        SRL::GouraudTable::Release(first);
+
+        snprintf(buffer, buffer_size, "Release failed: %d,%d", SRL::GouraudTable::GetReferenceCount(first), SRL::GouraudTable::GetFreeCount());
+        mu_assert(SRL::GouraudTable::GetReferenceCount(first) == 0 && SRL::GouraudTable::GetFreeCount() == gouraud_table_free - 1, buffer);
+
+        // Lookup must pass over the freed entry
+        int16_t again = SRL::GouraudTable::Allocate(gouraud_table_other);
+
+        snprintf(buffer, buffer_size, "Lookup failed: %d != %d", again, other);
+        mu_assert(again == other && SRL::GouraudTable::GetReferenceCount(other) == 3, buffer);
+
+        SRL::GouraudTable::Release(other);
+        SRL::GouraudTable::Release(other);
+        SRL::GouraudTable::Release(other);
+
+        snprintf(buffer, buffer_size, "Free count failed: %d != %d", SRL::GouraudTable::GetFreeCount(), gouraud_table_free);
+        mu_assert(SRL::GouraudTable::GetFreeCount() == gouraud_table_free, buffer);
+    }
+
+    // Test that reserved blocks are aligned and not shared
+    MU_TEST(gouraud_table_test_reserve)
+    {
+        int16_t shared = SRL::GouraudTable::Allocate(gouraud_table_colors);
+        int16_t block = SRL::GouraudTable::Reserve(8, 4);
+
+        snprintf(buffer, buffer_size, "Reserve failed: %d", block);
+        mu_assert(block >= 0 && (block & 3) == 0 && (shared < block || shared >= block + 8), buffer);
+
+        // Reserved entries are not deduplicated and do not count references
+        SRL::GouraudTable::AddReference(block);
+        SRL::GouraudTable::Release(block);
+
+        snprintf(buffer, buffer_size, "Reserved reference failed: %d != 1", SRL::GouraudTable::GetReferenceCount(block));
+        mu_assert(SRL::GouraudTable::GetReferenceCount(block) == 1, buffer);
+
+        SRL::GouraudTable::Free(block, 8);
+        SRL::GouraudTable::Release(shared);
+
+        snprintf(buffer, buffer_size, "Free failed: %d != %d", SRL::GouraudTable::GetFreeCount(), gouraud_table_free);
+        mu_assert(SRL::GouraudTable::GetFreeCount() == gouraud_table_free && SRL::GouraudTable::GetReferenceCount(block) == 0, buffer);
+    }
+
+    // Test that dynamic entries alternate between buffers each frame
+    MU_TEST(gouraud_table_test_dynamic)
+    {
+        int16_t first = SRL::GouraudTable::AllocateDynamic(gouraud_table_colors);
+        int16_t second = SRL::GouraudTable::AllocateDynamic(gouraud_table_colors);
+
+        snprintf(buffer, buffer_size, "Dynamic failed: %d,%d", first, second);
+        mu_assert(first >= SRL::GouraudTable::StaticCount && second == first + 1 && SRL::GouraudTable::GetDynamicCount() >= 2, buffer);
+
+        SRL::Core::Synchronize();
+        int16_t next = SRL::GouraudTable::AllocateDynamic(gouraud_table_other);
+
+        snprintf(buffer, buffer_size, "Dynamic swap failed: %d,%d", first, next);
+        mu_assert(SRL::GouraudTable::GetDynamicCount() == 1 &&
+            next != first &&
+            (next - SRL::GouraudTable::StaticCount) % SRL::GouraudTable::DynamicCount == 0 &&
+            SRL::GouraudTable::GetEntry(first)[0] == HighColor::Colors::Red, buffer);
+    }
+
+    MU_TEST_SUITE(gouraud_table_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&gouraud_table_test_setup,
+                                       &gouraud_table_test_teardown,
+                                       &gouraud_table_test_output_header);
+
+        MU_RUN_TEST(gouraud_table_test_dedup);
+        MU_RUN_TEST(gouraud_table_test_release);
+        MU_RUN_TEST(gouraud_table_test_reserve);
+        MU_RUN_TEST(gouraud_table_test_dynamic);
+    }
+}
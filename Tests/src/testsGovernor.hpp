@@ -0,0 +1,121 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void governor_test_setup(void)
+    {
+        // Start every test at full quality with nothing used yet
+        SRL::Governor::Disable();
+        SRL::Governor::SetMaxBudget(400, 200);
+        SRL::Governor::AfterSync();
+    }
+
+    // UT teardown function, called after every tests
+    void governor_test_teardown(void)
+    {
+        SRL::Governor::Disable();
+        SRL::VDP1::Stats::Disable();
+        SRL::Governor::SetMaxBudget(SGL_MAX_POLYGONS, SGL_MAX_POLYGONS);
+        SRL::Governor::AfterSync();
+    }
+
+    // UT output header function, called on the first test failure
+    void governor_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_GOVERNOR****");
+            }
+            else
+            {
+                LogInfo("****UT_GOVERNOR_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that counts and distances are scaled by quality
+    MU_TEST(governor_test_scale)
+    {
+        snprintf(buffer, buffer_size, "Full quality failed: %d != 1000", (int)SRL::Governor::Scale((uint32_t)1000));
+        mu_assert(SRL::Governor::GetQuality() == 1.0 && SRL::Governor::Scale((uint32_t)1000) == 1000, buffer);
+
+        // Frame spanning more v-blanks than the target is late, quality drops by 1/8
+        SRL::Governor::Enable();
+
+        for (uint8_t vblank = 0; vblank < 8; vblank++)
+        {
+            SRL::Governor::Vblank();
+        }
+
+        SRL::Governor::AfterSync();
+
+        snprintf(buffer, buffer_size, "Late frame failed: %d != 875", (int)SRL::Governor::Scale((uint32_t)1000));
+        mu_assert(SRL::Governor::Scale((uint32_t)1000) == 875 && SRL::Governor::GetDroppedFrames() == 1, buffer);
+
+        const Fxp distance = SRL::Governor::Scale(Fxp(8.0));
+
+        snprintf(buffer, buffer_size, "Distance failed: %d != 7", distance.As<int32_t>());
+        mu_assert(distance == 7.0, buffer);
+    }
+
+    // Test that budgets are scaled and used counts are subtracted
+    MU_TEST(governor_test_budget)
+    {
+        snprintf(buffer, buffer_size, "Budget failed: %d,%d", SRL::Governor::GetPolygonBudget(), SRL::Governor::GetSpriteBudget());
+        mu_assert(SRL::Governor::GetPolygonBudget() == 400 && SRL::Governor::GetSpriteBudget() == 200, buffer);
+
+        // Two consumers share one frame budget
+        SRL::Governor::ConsumeSprites(50);
+        SRL::Governor::ConsumeSprites(30);
+        SRL::Governor::ConsumePolygons(100);
+
+        snprintf(buffer, buffer_size, "Remaining failed: %d,%d", SRL::Governor::GetRemainingPolygons(), SRL::Governor::GetRemainingSprites());
+        mu_assert(SRL::Governor::GetRemainingPolygons() == 300 && SRL::Governor::GetRemainingSprites() == 120, buffer);
+
+        SRL::Governor::ConsumeSprites(500);
+
+        snprintf(buffer, buffer_size, "Overused failed: %d != 0", SRL::Governor::GetRemainingSprites());
+        mu_assert(SRL::Governor::GetRemainingSprites() == 0, buffer);
+    }
+
+    // Test that used counts are reset after synchronization
+    MU_TEST(governor_test_frame_reset)
+    {
+        SRL::Governor::ConsumePolygons(150);
+        SRL::Governor::ConsumeSprites(75);
+        SRL::Core::Synchronize();
+
+        snprintf(buffer, buffer_size, "Used failed: %d,%d", (int)SRL::Governor::GetUsedPolygons(), (int)SRL::Governor::GetUsedSprites());
+        mu_assert(SRL::Governor::GetUsedPolygons() == 0 && SRL::Governor::GetUsedSprites() == 0, buffer);
+
+        snprintf(buffer, buffer_size, "Reset failed: %d,%d", SRL::Governor::GetRemainingPolygons(), SRL::Governor::GetRemainingSprites());
+        mu_assert(SRL::Governor::GetRemainingPolygons() == 400 && SRL::Governor::GetRemainingSprites() == 200, buffer);
+    }
+
+    MU_TEST_SUITE(governor_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&governor_test_setup,
+                                       &governor_test_teardown,
+                                       &governor_test_output_header);
+
+        MU_RUN_TEST(governor_test_scale);
+        MU_RUN_TEST(governor_test_budget);
+        MU_RUN_TEST(governor_test_frame_reset);
+    }
+}
@@ -0,0 +1,122 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void level_grid_test_setup(void)
+    {
+        // Nothing to do here
+    }
+
+    // UT teardown function, called after every tests
+    void level_grid_test_teardown(void)
+    {
+        /* Nothing */
+    }
+
+    // UT output header function, called on the first test failure
+    void level_grid_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_LEVEL_GRID****");
+            }
+            else
+            {
+                LogInfo("****UT_LEVEL_GRID_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that points map to cells and points outside of the grid have no cell
+    MU_TEST(level_grid_test_cell)
+    {
+        using Grid = SRL::Scene3D::LevelGrid<4, 4, 4>;
+        Grid level(Vector3D(-20.0, 0.0, -20.0), 10.0);
+        uint16_t first = level.GetCell(Vector3D(-15.0, 0.0, -15.0));
+        uint16_t last = level.GetCell(Vector3D(19.0, 0.0, 19.0));
+        uint16_t outside = level.GetCell(Vector3D(25.0, 0.0, 0.0));
+
+        snprintf(buffer, buffer_size, "First cell failed: %d != 0", first);
+        mu_assert(first == 0, buffer);
+
+        snprintf(buffer, buffer_size, "Last cell failed: %d != 15", last);
+        mu_assert(last == 15, buffer);
+
+        snprintf(buffer, buffer_size, "Outside cell failed: %d", outside);
+        mu_assert(outside == Grid::NoCell, buffer);
+    }
+
+    // Test that visible cells are ordered from the nearest and cells behind camera are rejected
+    MU_TEST(level_grid_test_order)
+    {
+        Mesh mesh;
+        SRL::Scene3D::LevelGrid<4, 1, 4> level(Vector3D(0.0, 0.0, 0.0), 10.0);
+        level.Add(mesh, Vector3D(31.0, 0.0, 1.0), Vector3D(39.0, 1.0, 9.0));
+        level.Add(mesh, Vector3D(11.0, 0.0, 1.0), Vector3D(19.0, 1.0, 9.0));
+        level.Add(mesh, Vector3D(21.0, 0.0, 1.0), Vector3D(29.0, 1.0, 9.0));
+
+        // Camera in the second cell looks towards positive X, so the first cell is behind it
+        level.Add(mesh, Vector3D(1.0, 0.0, 1.0), Vector3D(5.0, 1.0, 9.0));
+        uint16_t visible = level.Cull(Vector3D(10.0, 0.0, 5.0), Vector3D(20.0, 0.0, 5.0));
+
+        snprintf(buffer, buffer_size, "Visible count failed: %d != 3", visible);
+        mu_assert(visible == 3, buffer);
+
+        for (uint16_t index = 0; index < visible; index++)
+        {
+            snprintf(buffer, buffer_size, "Order failed: %d != %d", level.GetVisibleCell(index), index + 1);
+            mu_assert(level.GetVisibleCell(index) == index + 1, buffer);
+        }
+    }
+
+    // Test that potentially visible set and distance limit hide cells
+    MU_TEST(level_grid_test_visibility)
+    {
+        Mesh mesh;
+        SRL::Scene3D::LevelGrid<4, 1, 4> level(Vector3D(0.0, 0.0, 0.0), 10.0);
+
+        for (uint8_t cell = 0; cell < 4; cell++)
+        {
+            Fxp start = Fxp::Convert(cell * 10);
+            level.Add(mesh, Vector3D(start + 1.0, 0.0, 1.0), Vector3D(start + 9.0, 1.0, 9.0));
+        }
+
+        level.SetVisible(0, 2, false);
+        uint16_t visible = level.Cull(Vector3D(5.0, 0.0, 5.0), Vector3D(15.0, 0.0, 5.0));
+
+        snprintf(buffer, buffer_size, "Visibility set failed: %d != 3", visible);
+        mu_assert(visible == 3 && level.GetVisibleCell(2) == 3, buffer);
+
+        visible = level.Cull(Vector3D(5.0, 0.0, 5.0), Vector3D(15.0, 0.0, 5.0), 10.0);
+
+        snprintf(buffer, buffer_size, "Distance limit failed: %d != 2", visible);
+        mu_assert(visible == 2, buffer);
+    }
+
+    MU_TEST_SUITE(level_grid_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&level_grid_test_setup,
+                                       &level_grid_test_teardown,
+                                       &level_grid_test_output_header);
+
+        MU_RUN_TEST(level_grid_test_cell);
+        MU_RUN_TEST(level_grid_test_order);
+        MU_RUN_TEST(level_grid_test_visibility);
+    }
+}
@@ -0,0 +1,159 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // Model file image, rebuilt before every test since mapping modifies it in place
+    uint32_t model_data[32];
+
+    // Offsets of the tables inside the model file image
+    const uint32_t model_mesh_offset = sizeof(Model::Header);
+    const uint32_t model_vertex_offset = model_mesh_offset + sizeof(Mesh);
+    const uint32_t model_face_offset = model_vertex_offset + sizeof(Vector3D);
+    const uint32_t model_attribute_offset = model_face_offset + sizeof(Polygon);
+
+    // UT setup function, called before every tests
+    void model_test_setup(void)
+    {
+        static_assert(model_attribute_offset + sizeof(Attribute) <= sizeof(model_data), "Model image does not fit");
+
+        uint8_t* data = (uint8_t*)model_data;
+        memset(data, 0, sizeof(model_data));
+
+        // Flat model with one mesh, no textures and two gouraud table entries
+        Model::Header* header = (Model::Header*)data;
+        header->Magic[0] = 'S';
+        header->Magic[1] = 'R';
+        header->Magic[2] = 'L';
+        header->Magic[3] = 'M';
+        header->Version = Model::Version;
+        header->Type = 0;
+        header->MeshCount = 1;
+        header->GouraudCount = 2;
+        header->MeshOffset = model_mesh_offset;
+        header->TextureOffset = model_attribute_offset + sizeof(Attribute);
+
+        // Pointers in the file are offsets from its start, mesh is never constructed or destroyed
+        Mesh* mesh = (Mesh*)(data + model_mesh_offset);
+        mesh->Vertices = (Vector3D*)model_vertex_offset;
+        mesh->VertexCount = 1;
+        mesh->Faces = (Polygon*)model_face_offset;
+        mesh->FaceCount = 1;
+        mesh->Attributes = (Attribute*)model_attribute_offset;
+
+        Attribute* attribute = (Attribute*)(data + model_attribute_offset);
+        attribute->Gouraud = 0xe001;
+    }
+
+    // UT teardown function, called after every tests
+    void model_test_teardown(void)
+    {
+        // Do nothing
+    }
+
+    // UT output header function, called on the first test failure
+    void model_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_MODEL****");
+            }
+            else
+            {
+                LogInfo("****UT_MODEL_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that header is parsed and mesh pointers are rebased
+    MU_TEST(model_test_map)
+    {
+        uint8_t* data = (uint8_t*)model_data;
+        Model model(data, 5);
+
+        snprintf(buffer, buffer_size, "Load failed");
+        mu_assert(model.IsLoaded() && !model.IsSmooth(), buffer);
+
+        snprintf(buffer, buffer_size, "Counts failed: %d,%d,%d", (int)model.GetMeshCount(), (int)model.GetGouraudCount(), (int)model.GetFirstTextureIndex());
+        mu_assert(model.GetMeshCount() == 1 && model.GetGouraudCount() == 2 && model.GetFirstTextureIndex() == -1, buffer);
+
+        Mesh* mesh = model.GetMesh(0);
+
+        snprintf(buffer, buffer_size, "Mesh failed: %p", mesh);
+        mu_assert(mesh == (Mesh*)(data + model_mesh_offset) && model.GetMesh(1) == nullptr && model.GetSmoothMesh(0) == nullptr, buffer);
+
+        snprintf(buffer, buffer_size, "Rebase failed: %p,%p,%p", mesh->Vertices, mesh->Faces, mesh->Attributes);
+        mu_assert(mesh->Vertices == (Vector3D*)(data + model_vertex_offset) &&
+            mesh->Faces == (Polygon*)(data + model_face_offset) &&
+            mesh->Attributes == (Attribute*)(data + model_attribute_offset), buffer);
+
+        snprintf(buffer, buffer_size, "Gouraud failed: %x != e006", mesh->Attributes[0].Gouraud);
+        mu_assert(mesh->Attributes[0].Gouraud == 0xe006, buffer);
+    }
+
+    // Test that file with wrong identifier is rejected
+    MU_TEST(model_test_magic)
+    {
+        ((Model::Header*)model_data)->Magic[3] = 'X';
+        Model model(model_data);
+
+        snprintf(buffer, buffer_size, "Wrong magic was accepted");
+        mu_assert(!model.IsLoaded() && model.GetMeshCount() == 0 && model.GetMesh(0) == nullptr, buffer);
+    }
+
+    // Test that file with other format version is rejected
+    MU_TEST(model_test_version)
+    {
+        ((Model::Header*)model_data)->Version = Model::Version + 1;
+        Model model(model_data);
+
+        snprintf(buffer, buffer_size, "Wrong version was accepted");
+        mu_assert(!model.IsLoaded(), buffer);
+    }
+
+    // Test that file with unknown mesh type is rejected
+    MU_TEST(model_test_type)
+    {
+        ((Model::Header*)model_data)->Type = 2;
+        Model model(model_data);
+
+        snprintf(buffer, buffer_size, "Wrong mesh type was accepted");
+        mu_assert(!model.IsLoaded() && !model.IsSmooth(), buffer);
+    }
+
+    // Test that missing file is reported as not loaded
+    MU_TEST(model_test_missing_file)
+    {
+        Model model("NOMODEL.SRM");
+
+        snprintf(buffer, buffer_size, "Missing file was loaded");
+        mu_assert(!model.IsLoaded() && model.GetMeshCount() == 0, buffer);
+    }
+
+    MU_TEST_SUITE(model_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&model_test_setup,
+                                       &model_test_teardown,
+                                       &model_test_output_header);
+
+        MU_RUN_TEST(model_test_map);
+        MU_RUN_TEST(model_test_magic);
+        MU_RUN_TEST(model_test_version);
+        MU_RUN_TEST(model_test_type);
+        MU_RUN_TEST(model_test_missing_file);
+    }
+}
@@ -0,0 +1,120 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void particles_test_setup(void)
+    {
+        // Nothing to do here
+    }
+
+    // UT teardown function, called after every tests
+    void particles_test_teardown(void)
+    {
+        // Nothing to do here
+    }
+
+    // UT output header function, called on the first test failure
+    void particles_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_PARTICLES****");
+            }
+            else
+            {
+                LogInfo("****UT_PARTICLES_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that integration applies gravity before moving particles
+    MU_TEST(particles_test_integrate)
+    {
+        Fxp x[2] = { 0.0, 10.0 };
+        Fxp y[2] = { 0.0, 10.0 };
+        Fxp velocityX[2] = { 1.0, -1.0 };
+        Fxp velocityY[2] = { 0.0, 2.0 };
+
+        SRL::Particles::Integrate(x, y, velocityX, velocityY, 2, Vector2D(0.0, 0.5));
+
+        snprintf(buffer, buffer_size, "First particle failed: %d,%d != 1,0", x[0].As<int32_t>(), y[0].As<int32_t>());
+        mu_assert(x[0] == 1.0 && y[0] == 0.5 && velocityY[0] == 0.5, buffer);
+
+        snprintf(buffer, buffer_size, "Second particle failed: %d,%d != 9,12", x[1].As<int32_t>(), y[1].As<int32_t>());
+        mu_assert(x[1] == 9.0 && y[1] == 12.5, buffer);
+    }
+
+    // Test that dead particles are removed and alive ones stay packed
+    MU_TEST(particles_test_lifetime)
+    {
+        SRL::Particles::System<16> system;
+        SRL::Particles::Emitter emitter;
+        emitter.Velocity = Vector2D(1.0, 0.0);
+        emitter.Lifetime = 2;
+        int32_t index = system.AddEmitter(emitter);
+
+        system.Update();
+
+        snprintf(buffer, buffer_size, "First frame failed: %d != 1", system.GetAliveCount());
+        mu_assert(index == 0 && system.GetAliveCount() == 1 && system.X[0] == 1.0, buffer);
+
+        system.Update();
+
+        snprintf(buffer, buffer_size, "Second frame failed: %d != 1", system.GetAliveCount());
+        mu_assert(system.GetAliveCount() == 1 && system.X[0] == 1.0 && system.Life[0] == 1, buffer);
+
+        snprintf(buffer, buffer_size, "Emitter count failed: %d != 1", system.GetEmitter(0).Alive);
+        mu_assert(system.GetEmitter(0).Alive == 1, buffer);
+    }
+
+    // Test that emitter cannot take more slots than it is allowed to
+    MU_TEST(particles_test_pool)
+    {
+        SRL::Particles::System<8> system;
+        SRL::Particles::Emitter limited;
+        limited.MaxParticles = 3;
+        limited.Active = false;
+
+        SRL::Particles::Emitter unlimited;
+        unlimited.Active = false;
+
+        system.AddEmitter(limited);
+        system.AddEmitter(unlimited);
+
+        uint16_t first = system.Burst(0, 10);
+        uint16_t second = system.Burst(1, 10);
+
+        snprintf(buffer, buffer_size, "Limited burst failed: %d != 3", first);
+        mu_assert(first == 3, buffer);
+
+        snprintf(buffer, buffer_size, "Pool burst failed: %d != 5", second);
+        mu_assert(second == 5 && system.GetAliveCount() == 8, buffer);
+    }
+
+    MU_TEST_SUITE(particles_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&particles_test_setup,
+                                       &particles_test_teardown,
+                                       &particles_test_output_header);
+
+        MU_RUN_TEST(particles_test_integrate);
+        MU_RUN_TEST(particles_test_lifetime);
+        MU_RUN_TEST(particles_test_pool);
+    }
+}
@@ -0,0 +1,109 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void rotation_test_setup(void)
+    {
+        // Nothing to do here
+    }
+
+    // UT teardown function, called after every tests
+    void rotation_test_teardown(void)
+    {
+        /* Nothing */
+    }
+
+    // UT output header function, called on the first test failure
+    void rotation_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_ROTATION****");
+            }
+            else
+            {
+                LogInfo("****UT_ROTATION_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that batch sinus and cosine match known values
+    MU_TEST(rotation_test_sin_cos)
+    {
+        const Angle angles[4] = { Angle(), Angle::FromDegrees(90.0), Angle::FromDegrees(180.0), Angle::FromDegrees(270.0) };
+        const int32_t sines[4] = { 0, 65536, 0, -65536 };
+        const int32_t cosines[4] = { 65536, 0, -65536, 0 };
+        SRL::Scene3D::SinCos values[4];
+        SRL::Scene3D::CalculateSinCos(angles, values, 4);
+
+        for (uint8_t index = 0; index < 4; index++)
+        {
+            snprintf(buffer, buffer_size, "Sin %d failed: %d != %d", index, values[index].Sin.RawValue(), sines[index]);
+            mu_assert(values[index].Sin.RawValue() == sines[index], buffer);
+
+            snprintf(buffer, buffer_size, "Cos %d failed: %d != %d", index, values[index].Cos.RawValue(), cosines[index]);
+            mu_assert(values[index].Cos.RawValue() == cosines[index], buffer);
+        }
+    }
+
+    // Test that rotation matrix matches rotating identity matrix by slRotX(), slRotY() and slRotZ()
+    MU_TEST(rotation_test_build)
+    {
+        // Angles sit on sine table steps, so both sides look up the same values
+        const Angle angles[3] = { Angle::BuildRaw(0x0100), Angle::BuildRaw(0x2000), Angle::BuildRaw(0xeac0) };
+        SRL::Scene3D::SinCos values[3];
+        SRL::Scene3D::CalculateSinCos(angles, values, 3);
+
+        SRL::Math::Matrix43 rotation;
+        SRL::Scene3D::BuildRotation(values, &rotation);
+
+        SRL::Math::Matrix43 reference;
+        SRL::Scene3D::PushMatrix();
+        {
+            SRL::Scene3D::LoadIdentity();
+            SRL::Scene3D::RotateX(angles[0]);
+            SRL::Scene3D::RotateY(angles[1]);
+            SRL::Scene3D::RotateZ(angles[2]);
+            SRL::Scene3D::GetMatrix(&reference);
+        }
+        SRL::Scene3D::PopMatrix();
+
+        const FIXED* matrix = (const FIXED*)&rotation;
+        const FIXED* expected = (const FIXED*)&reference;
+
+        // Only rounding of the chained multiplications may differ, a transposed element would be off by more than 20000
+        for (uint8_t index = 0; index < 12; index++)
+        {
+            const int32_t difference = matrix[index] - expected[index];
+
+            snprintf(buffer, buffer_size, "Element %d failed: %d != %d", index, matrix[index], expected[index]);
+            mu_assert(difference >= -8 && difference <= 8, buffer);
+        }
+    }
+
+    MU_TEST_SUITE(rotation_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&rotation_test_setup,
+                                       &rotation_test_teardown,
+                                       &rotation_test_output_header);
+
+        MU_RUN_TEST(rotation_test_sin_cos);
+        MU_RUN_TEST(rotation_test_build);
+    }
+}
@@ -0,0 +1,194 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void scene_graph_test_setup(void)
+    {
+        // Nothing to do here
+    }
+
+    // UT teardown function, called after every tests
+    void scene_graph_test_teardown(void)
+    {
+        /* Nothing */
+    }
+
+    // UT output header function, called on the first test failure
+    void scene_graph_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_SCENE_GRAPH****");
+            }
+            else
+            {
+                LogInfo("****UT_SCENE_GRAPH_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that nodes are added in order and parent must exist
+    MU_TEST(scene_graph_test_add)
+    {
+        SRL::Scene3D::SceneGraph<3> graph;
+        uint16_t root = graph.Add();
+        uint16_t child = graph.Add(root);
+
+        snprintf(buffer, buffer_size, "Add failed: %d != 0", root);
+        mu_assert(root == 0, buffer);
+
+        snprintf(buffer, buffer_size, "Add failed: %d != 1", child);
+        mu_assert(child == 1, buffer);
+
+        snprintf(buffer, buffer_size, "Parent failed: %d != %d", graph[child].GetParent(), root);
+        mu_assert(graph[child].GetParent() == root, buffer);
+
+        snprintf(buffer, buffer_size, "Count failed: %d != 2", graph.Count());
+        mu_assert(graph.Count() == 2, buffer);
+    }
+
+    // Test that static graph does not recalculate anything
+    MU_TEST(scene_graph_test_static)
+    {
+        SRL::Scene3D::SceneGraph<4> graph;
+        uint16_t root = graph.Add();
+        graph.Add(root);
+        graph.Add(root);
+
+        uint16_t first = graph.Update();
+        uint16_t second = graph.Update();
+
+        snprintf(buffer, buffer_size, "First update failed: %d != 3", first);
+        mu_assert(first == 3, buffer);
+
+        snprintf(buffer, buffer_size, "Second update failed: %d != 0", second);
+        mu_assert(second == 0, buffer);
+    }
+
+    // Test that changed node updates only its own subtree
+    MU_TEST(scene_graph_test_subtree)
+    {
+        SRL::Scene3D::SceneGraph<4> graph;
+        uint16_t root = graph.Add();
+        uint16_t arm = graph.Add(root);
+        graph.Add(arm);
+        graph.Add(root);
+        graph.Update();
+
+        graph[arm].SetPosition(Vector3D(10.0, 0.0, 0.0));
+        uint16_t armUpdate = graph.Update();
+
+        snprintf(buffer, buffer_size, "Subtree update failed: %d != 2", armUpdate);
+        mu_assert(armUpdate == 2, buffer);
+
+        graph[root].SetRotation(Angle::FromDegrees(90.0), Angle(), Angle());
+        uint16_t rootUpdate = graph.Update();
+
+        snprintf(buffer, buffer_size, "Root update failed: %d != 4", rootUpdate);
+        mu_assert(rootUpdate == 4, buffer);
+    }
+
+    // Test that child world matrix contains parent translation
+    MU_TEST(scene_graph_test_world_translation)
+    {
+        SRL::Scene3D::SceneGraph<2> graph;
+        uint16_t root = graph.Add();
+        uint16_t child = graph.Add(root);
+
+        graph[root].SetPosition(Vector3D(10.0, 20.0, 30.0));
+        graph[child].SetPosition(Vector3D(1.0, 2.0, 3.0));
+        graph.Update();
+
+        // Matrix is stored in SGL layout, translation is in the last row
+        const FIXED* matrix = (const FIXED*)&graph[child].GetWorldMatrix();
+        Fxp x = Fxp::BuildRaw(matrix[9]);
+        Fxp y = Fxp::BuildRaw(matrix[10]);
+        Fxp z = Fxp::BuildRaw(matrix[11]);
+
+        snprintf(buffer, buffer_size, "World X failed: %d != 11", x.As<int32_t>());
+        mu_assert(x == 11.0, buffer);
+
+        snprintf(buffer, buffer_size, "World Y failed: %d != 22", y.As<int32_t>());
+        mu_assert(y == 22.0, buffer);
+
+        snprintf(buffer, buffer_size, "World Z failed: %d != 33", z.As<int32_t>());
+        mu_assert(z == 33.0, buffer);
+    }
+
+    // Test that node changed through a held reference is updated
+    MU_TEST(scene_graph_test_held_reference)
+    {
+        SRL::Scene3D::SceneGraph<2> graph;
+        uint16_t root = graph.Add();
+        graph.Add(root);
+        SRL::Scene3D::Node& node = graph[root];
+        graph.Update();
+
+        node.SetPosition(Vector3D(5.0, 0.0, 0.0));
+        uint16_t rebuilt = graph.Update();
+
+        snprintf(buffer, buffer_size, "Held reference update failed: %d != 2", rebuilt);
+        mu_assert(rebuilt == 2, buffer);
+
+        const FIXED* matrix = (const FIXED*)&graph[root].GetWorldMatrix();
+        Fxp x = Fxp::BuildRaw(matrix[9]);
+
+        snprintf(buffer, buffer_size, "World X failed: %d != 5", x.As<int32_t>());
+        mu_assert(x == 5.0, buffer);
+    }
+
+    // Test that child world translation is rotated by its parent
+    MU_TEST(scene_graph_test_world_rotated_parent)
+    {
+        SRL::Scene3D::SceneGraph<2> graph;
+        uint16_t root = graph.Add();
+        uint16_t child = graph.Add(root);
+
+        // Half turn around Y axis negates X and Z regardless of the rotation direction
+        graph[root].SetPosition(Vector3D(10.0, 20.0, 30.0));
+        graph[root].SetRotation(Angle(), Angle::FromDegrees(180.0), Angle());
+        graph[child].SetPosition(Vector3D(1.0, 2.0, 3.0));
+        graph.Update();
+
+        const FIXED* matrix = (const FIXED*)&graph[child].GetWorldMatrix();
+        const int32_t expected[3] = { Fxp(9.0).RawValue(), Fxp(22.0).RawValue(), Fxp(27.0).RawValue() };
+
+        for (uint8_t axis = 0; axis < 3; axis++)
+        {
+            const int32_t difference = matrix[9 + axis] - expected[axis];
+
+            snprintf(buffer, buffer_size, "World %d failed: %d != %d", axis, matrix[9 + axis], expected[axis]);
+            mu_assert(difference >= -4 && difference <= 4, buffer);
+        }
+    }
+
+    MU_TEST_SUITE(scene_graph_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&scene_graph_test_setup,
+                                       &scene_graph_test_teardown,
+                                       &scene_graph_test_output_header);
+
+        MU_RUN_TEST(scene_graph_test_add);
+        MU_RUN_TEST(scene_graph_test_static);
+        MU_RUN_TEST(scene_graph_test_subtree);
+        MU_RUN_TEST(scene_graph_test_world_translation);
+        MU_RUN_TEST(scene_graph_test_held_reference);
+        MU_RUN_TEST(scene_graph_test_world_rotated_parent);
+    }
+}
@@ -0,0 +1,101 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // Generator writing line index as horizontal scroll
+    static void scroll_table_test_lines(SRL::VDP2::LineScrollTable& table, void* context)
+    {
+        for (uint16_t line = 0; line < table.GetLineCount(); line++)
+        {
+            table.SetHorizontal(line, Fxp::BuildRaw(line << 16));
+        }
+    }
+
+    // UT setup function, called before every tests
+    void scroll_table_test_setup(void)
+    {
+        SRL::VDP2::Shadow::Flush();
+    }
+
+    // UT teardown function, called after every tests
+    void scroll_table_test_teardown(void)
+    {
+        SRL::VDP2::NBG0::SetLineScroll(nullptr);
+        SRL::VDP2::Shadow::Flush();
+    }
+
+    // UT output header function, called on the first test failure
+    void scroll_table_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_SCROLL_TABLE****");
+            }
+            else
+            {
+                LogInfo("****UT_SCROLL_TABLE_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that generated table is displayed only after flush
+    MU_TEST(scroll_table_test_swap)
+    {
+        SRL::VDP2::LineScrollTable table(scroll_table_test_lines, nullptr, true, false, true);
+        SRL::VDP2::NBG0::SetLineScroll(&table);
+        int32_t* front = table.GetFront();
+
+        snprintf(buffer, buffer_size, "Initial zoom failed: %d", (int)front[1]);
+        mu_assert(front[1] == Fxp(1.0).RawValue(), buffer);
+
+        table.Update();
+
+        snprintf(buffer, buffer_size, "Front changed before flush");
+        mu_assert(table.GetFront() == front && front[2] == 0, buffer);
+
+        SRL::VDP2::Shadow::Flush();
+
+        snprintf(buffer, buffer_size, "Swap failed: line 1 = %d", (int)table.GetFront()[2]);
+        mu_assert(table.GetFront() != front && table.GetFront()[2] == Fxp(1.0).RawValue() && SRL::VDP2::NBG0::LineAddress == table.GetFront(), buffer);
+
+        SRL::VDP2::Shadow::Flush();
+
+        snprintf(buffer, buffer_size, "Swapped without update");
+        mu_assert(table.GetFront() != front, buffer);
+    }
+
+    // Test that values of both screens alternate in each column
+    MU_TEST(scroll_table_test_columns)
+    {
+        SRL::VDP2::CellScrollTable table(nullptr, nullptr, NBG0ON | NBG1ON);
+        table.SetColumn(3, 5.0, 1);
+
+        snprintf(buffer, buffer_size, "Column layout failed: %d columns", table.GetColumnCount());
+        mu_assert(table.GetSize() == table.GetColumnCount() * 2 && table.GetBack()[7] == Fxp(5.0).RawValue() && table.GetBack()[6] == 0, buffer);
+    }
+
+    MU_TEST_SUITE(scroll_table_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&scroll_table_test_setup,
+                                       &scroll_table_test_teardown,
+                                       &scroll_table_test_output_header);
+
+        MU_RUN_TEST(scroll_table_test_swap);
+        MU_RUN_TEST(scroll_table_test_columns);
+    }
+}
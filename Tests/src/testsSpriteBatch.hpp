@@ -0,0 +1,140 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    int32_t sprite_batch_texture = -1;
+
+    void sprite_batch_test_setup(void)
+    {
+        sprite_batch_texture = SRL::VDP1::TryAllocateTexture(16, 16, SRL::CRAM::TextureColorMode::RGB555, 0);
+    }
+
+    // UT teardown function, called after every tests
+    void sprite_batch_test_teardown(void)
+    {
+        if (sprite_batch_texture >= 0)
+        {
+            SRL::VDP1::ResetTextureHeap(sprite_batch_texture);
+        }
+    }
+
+    // UT output header function, called on the first test failure
+    void sprite_batch_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_SPRITE_BATCH****");
+            }
+            else
+            {
+                LogInfo("****UT_SPRITE_BATCH_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that sprites are stored in order and batch does not overflow
+    MU_TEST(sprite_batch_test_add)
+    {
+        SRL::Scene2D::SpriteBatch<2> batch;
+        uint16_t first = batch.Add(Vector2D(1.0, 2.0), 3, 2.0);
+        batch.Add(Vector2D(), 0);
+        uint16_t overflow = batch.Add(Vector2D(), 0);
+
+        snprintf(buffer, buffer_size, "Add failed: %d != 0", first);
+        mu_assert(first == 0 && batch.X[0] == 1 && batch.Y[0] == 2 && batch.Texture[0] == 3, buffer);
+
+        snprintf(buffer, buffer_size, "Scale failed: %d != 512", batch.Scale[0]);
+        mu_assert(batch.Scale[0] == 512, buffer);
+
+        snprintf(buffer, buffer_size, "Overflow failed: %d != 2", overflow);
+        mu_assert(overflow == 2 && batch.Count() == 2, buffer);
+    }
+
+    // Test that sprites outside of the cull rectangle are not emitted
+    MU_TEST(sprite_batch_test_cull)
+    {
+        mu_assert(sprite_batch_texture >= 0, "Texture allocation failed");
+
+        SRL::Scene2D::SpriteBatch<4> batch;
+        batch.SetCullRectangle(Vector2D(-100.0, -100.0), Vector2D(200.0, 200.0));
+
+        // Fully inside, fully outside, partially inside and scaled down just outside
+        batch.Add(Vector2D(), sprite_batch_texture);
+        batch.Add(Vector2D(500.0, 0.0), sprite_batch_texture);
+        batch.Add(Vector2D(-107.0, 0.0), sprite_batch_texture);
+        batch.Add(Vector2D(-106.0, 0.0), sprite_batch_texture, 0.5);
+
+        uint16_t emitted = batch.Draw(100.0);
+
+        snprintf(buffer, buffer_size, "Emitted failed: %d != 2", emitted);
+        mu_assert(emitted == 2 && batch.GetEmittedCount() == 2, buffer);
+
+        snprintf(buffer, buffer_size, "Culled failed: %d != 2", batch.GetCulledCount());
+        mu_assert(batch.GetCulledCount() == 2, buffer);
+
+        snprintf(buffer, buffer_size, "Dropped failed: %d != 0", batch.GetDroppedCount());
+        mu_assert(batch.GetDroppedCount() == 0, buffer);
+    }
+
+    // Test that rotated corners of a sprite are calculated from its center
+    MU_TEST(sprite_batch_test_rotate_corners)
+    {
+        SRL::Scene3D::SinCos rotation;
+        rotation.Sin = 1.0;
+        rotation.Cos = 0.0;
+
+        Vector2D corners[4];
+        SRL::Scene2D::RotateScaleCorners(Vector2D(), Vector2D(10.0, 5.0), rotation, SRL::Scene2D::ZoomPoint::Center, corners);
+
+        snprintf(buffer, buffer_size, "Rotated corner failed: %d,%d != 5,-10", corners[0].X.As<int32_t>(), corners[0].Y.As<int32_t>());
+        mu_assert(corners[0].X == 5.0 && corners[0].Y == -10.0, buffer);
+
+        snprintf(buffer, buffer_size, "Rotated corner failed: %d,%d != -5,10", corners[2].X.As<int32_t>(), corners[2].Y.As<int32_t>());
+        mu_assert(corners[2].X == -5.0 && corners[2].Y == 10.0, buffer);
+    }
+
+    // Test that zoom point offsets the sprite by its half size
+    MU_TEST(sprite_batch_test_zoom_point)
+    {
+        SRL::Scene3D::SinCos rotation;
+        rotation.Sin = 0.0;
+        rotation.Cos = 1.0;
+
+        Vector2D corners[4];
+        SRL::Scene2D::RotateScaleCorners(Vector2D(), Vector2D(10.0, 5.0), rotation, SRL::Scene2D::ZoomPoint::UpperLeft, corners);
+
+        snprintf(buffer, buffer_size, "Upper left failed: %d,%d != -20,-10", corners[0].X.As<int32_t>(), corners[0].Y.As<int32_t>());
+        mu_assert(corners[0].X == -20.0 && corners[0].Y == -10.0, buffer);
+
+        snprintf(buffer, buffer_size, "Lower right failed: %d,%d != 0,0", corners[2].X.As<int32_t>(), corners[2].Y.As<int32_t>());
+        mu_assert(corners[2].X == 0.0 && corners[2].Y == 0.0, buffer);
+    }
+
+    MU_TEST_SUITE(sprite_batch_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&sprite_batch_test_setup,
+                                       &sprite_batch_test_teardown,
+                                       &sprite_batch_test_output_header);
+
+        MU_RUN_TEST(sprite_batch_test_add);
+        MU_RUN_TEST(sprite_batch_test_cull);
+        MU_RUN_TEST(sprite_batch_test_rotate_corners);
+        MU_RUN_TEST(sprite_batch_test_zoom_point);
+    }
+}
@@ -0,0 +1,124 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    uint16_t texture_cache_first_texture = 0;
+    uint16_t texture_cache_pixels[8 * 8] = { 0 };
+
+    void texture_cache_test_setup(void)
+    {
+        texture_cache_first_texture = SRL::VDP1::GetTextureCount();
+    }
+
+    // UT teardown function, called after every tests
+    void texture_cache_test_teardown(void)
+    {
+        SRL::VDP1::ResetTextureHeap(texture_cache_first_texture);
+    }
+
+    // UT output header function, called on the first test failure
+    void texture_cache_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_TEXTURE_CACHE****");
+            }
+            else
+            {
+                LogInfo("****UT_TEXTURE_CACHE_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that texture kept in RAM is loaded on first use and hit afterwards
+    MU_TEST(texture_cache_test_hit)
+    {
+        TextureCache cache(2, 8, 8);
+        int32_t id = cache.Add(texture_cache_pixels, 8, 4);
+
+        int32_t first = cache.Get(id);
+        int32_t second = cache.Get(id);
+
+        snprintf(buffer, buffer_size, "Miss failed: %d < 0", first);
+        mu_assert(first >= 0 && first == second && cache.IsResident(id), buffer);
+
+        snprintf(buffer, buffer_size, "Resized slot failed: %d != 4", SRL::VDP1::Textures[first].Height);
+        mu_assert(SRL::VDP1::Textures[first].Width == 8 && SRL::VDP1::Textures[first].Height == 4, buffer);
+
+        snprintf(buffer, buffer_size, "Statistics failed: %d,%d != 1,1", (int32_t)cache.GetStatistics().Hits, (int32_t)cache.GetStatistics().Misses);
+        mu_assert(cache.GetStatistics().Hits == 1 && cache.GetStatistics().Misses == 1 && cache.GetStatistics().BytesFromRam == 64, buffer);
+    }
+
+    // Test that least recently used texture is evicted, but never one used in the last two frames
+    MU_TEST(texture_cache_test_evict)
+    {
+        TextureCache cache(2, 8, 8);
+        int32_t a = cache.Add(texture_cache_pixels, 8, 8);
+        int32_t b = cache.Add(texture_cache_pixels, 8, 8);
+        int32_t c = cache.Add(texture_cache_pixels, 8, 8);
+
+        cache.Get(a);
+        cache.Get(b);
+
+        // Both slots were used this frame, so third texture has to wait
+        int32_t waiting = cache.Get(c);
+
+        snprintf(buffer, buffer_size, "Busy slots failed: %d != -1", waiting);
+        mu_assert(waiting == TextureCache::NotResident && cache.IsLoading(), buffer);
+
+        // Texture used in the previous frame is kept, so the other one is evicted
+        cache.Update();
+        cache.Get(a);
+        cache.Update();
+
+        snprintf(buffer, buffer_size, "Eviction failed: %d != 1", (int32_t)cache.GetStatistics().Evictions);
+        mu_assert(cache.IsResident(a) && !cache.IsResident(b) && cache.IsResident(c) && cache.GetStatistics().Evictions == 1, buffer);
+
+        snprintf(buffer, buffer_size, "Resident count failed: %d != 2", cache.GetResidentCount());
+        mu_assert(cache.GetResidentCount() == 2 && !cache.IsLoading(), buffer);
+    }
+
+    // Test that texture allocated after the cache does not overlap a slot holding a smaller texture
+    MU_TEST(texture_cache_test_reserve)
+    {
+        TextureCache cache(2, 8, 8);
+        const uint16_t lastSlot = cache.GetFirstTexture() + 1;
+        const uint16_t reserveEnd = SRL::VDP1::Textures[lastSlot].Address + ((8 * 8 * 2) >> 3);
+
+        // Fill both slots so the last one holds the small texture
+        cache.Get(cache.Add(texture_cache_pixels, 8, 8));
+        cache.Get(cache.Add(texture_cache_pixels, 8, 2));
+
+        int32_t next = SRL::VDP1::TryAllocateTexture(8, 8, CRAM::TextureColorMode::RGB555, 0);
+
+        snprintf(buffer, buffer_size, "Reserve overlap: %d < %d", next >= 0 ? SRL::VDP1::Textures[next].Address : -1, reserveEnd);
+        mu_assert(cache.GetFirstTexture() == texture_cache_first_texture && next >= 0 && SRL::VDP1::Textures[next].Address >= reserveEnd, buffer);
+    }
+
+    MU_TEST_SUITE(texture_cache_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&texture_cache_test_setup,
+                                       &texture_cache_test_teardown,
+                                       &texture_cache_test_output_header);
+
+        MU_RUN_TEST(texture_cache_test_hit);
+        MU_RUN_TEST(texture_cache_test_evict);
+        MU_RUN_TEST(texture_cache_test_reserve);
+    }
+}
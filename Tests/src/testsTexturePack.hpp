@@ -0,0 +1,95 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    uint8_t texture_pack_output[64] __attribute__((aligned(4))) = { 0 };
+
+    void texture_pack_test_setup(void)
+    {
+        for (uint8_t index = 0; index < sizeof(texture_pack_output); index++)
+        {
+            texture_pack_output[index] = 0;
+        }
+    }
+
+    // UT teardown function, called after every tests
+    void texture_pack_test_teardown(void)
+    {
+        // Nothing to do here
+    }
+
+    // UT output header function, called on the first test failure
+    void texture_pack_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_TEXTURE_PACK****");
+            }
+            else
+            {
+                LogInfo("****UT_TEXTURE_PACK_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that LZ matches, overlapping matches and extended lengths are decoded
+    MU_TEST(texture_pack_test_lz)
+    {
+        // "abcd" + match(4, 8), then "X" + match(1, 15 + 5 + 4)
+        const uint8_t data[] = {
+            0x44, 'a', 'b', 'c', 'd', 0x00, 0x04,
+            0x1f, 'X', 0x00, 0x01, 0x05 };
+
+        size_t size = TexturePack::Decompress(TexturePack::Compression::Lz, data, sizeof(data), texture_pack_output, 37);
+
+        snprintf(buffer, buffer_size, "Size failed: %d != 37", (int32_t)size);
+        mu_assert(size == 37, buffer);
+
+        snprintf(buffer, buffer_size, "Match failed: %c%c != dX", texture_pack_output[11], texture_pack_output[12]);
+        mu_assert(texture_pack_output[0] == 'a' && texture_pack_output[8] == 'a' && texture_pack_output[11] == 'd' && texture_pack_output[12] == 'X', buffer);
+
+        snprintf(buffer, buffer_size, "Extended match failed: %c != X", texture_pack_output[36]);
+        mu_assert(texture_pack_output[36] == 'X' && texture_pack_output[37] == 0, buffer);
+    }
+
+    // Test that RLE runs and literals are decoded and output is never overrun
+    MU_TEST(texture_pack_test_rle)
+    {
+        // Run of four 7, literals 1 and 2, run of 128 9 cut at the end of output
+        const uint8_t data[] = { 0x83, 7, 0x01, 1, 2, 0xff, 9 };
+
+        size_t size = TexturePack::Decompress(TexturePack::Compression::Rle, data, sizeof(data), texture_pack_output, 16);
+
+        snprintf(buffer, buffer_size, "Size failed: %d != 16", (int32_t)size);
+        mu_assert(size == 16, buffer);
+
+        snprintf(buffer, buffer_size, "Data failed: %d,%d,%d,%d", texture_pack_output[3], texture_pack_output[4], texture_pack_output[5], texture_pack_output[6]);
+        mu_assert(texture_pack_output[3] == 7 && texture_pack_output[4] == 1 && texture_pack_output[5] == 2 && texture_pack_output[6] == 9, buffer);
+    }
+
+    MU_TEST_SUITE(texture_pack_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&texture_pack_test_setup,
+                                       &texture_pack_test_teardown,
+                                       &texture_pack_test_output_header);
+
+        MU_RUN_TEST(texture_pack_test_lz);
+        MU_RUN_TEST(texture_pack_test_rle);
+    }
+}
@@ -0,0 +1,124 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+// Test bitmap of three 16x16 tiles: pattern, its horizontal mirror (or the pattern when not mirrored) and the pattern again
+struct TileDedupBitmap : public SRL::Bitmap::IBitmap
+{
+    uint16_t pixels[48 * 16];
+
+    TileDedupBitmap(bool mirror = true)
+    {
+        for (uint16_t y = 0; y < 16; y++)
+        {
+            for (uint16_t x = 0; x < 16; x++)
+            {
+                uint16_t color = (x * 3) + (y * 50) + 1;
+                pixels[(y * 48) + x] = color;
+                pixels[(y * 48) + (mirror ? 31 - x : 16 + x)] = color;
+                pixels[(y * 48) + 32 + x] = color;
+            }
+        }
+    }
+
+    uint8_t* GetData() override
+    {
+        return (uint8_t*)pixels;
+    }
+
+    SRL::Bitmap::BitmapInfo GetInfo() const override
+    {
+        return SRL::Bitmap::BitmapInfo(48, 16);
+    }
+};
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void tile_dedup_test_setup(void)
+    {
+        // Nothing to setup
+    }
+
+    // UT teardown function, called after every tests
+    void tile_dedup_test_teardown(void)
+    {
+        // Nothing to clean up
+    }
+
+    // UT output header function, called on the first test failure
+    void tile_dedup_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_TILE_DEDUP****");
+            }
+            else
+            {
+                LogInfo("****UT_TILE_DEDUP_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that duplicate and mirrored tiles are stored once
+    MU_TEST(tile_dedup_test_unique)
+    {
+        TileDedupBitmap bitmap;
+        SRL::Tilemap::Interfaces::Bmp2Tile tilemap(bitmap);
+
+        snprintf(buffer, buffer_size, "Dedup failed: %d unique, %d duplicate, %d flipped", tilemap.GetUniqueCells(), tilemap.GetDuplicateCells(), tilemap.GetFlippedCells());
+        mu_assert(tilemap.GetUniqueCells() == 1 && tilemap.GetDuplicateCells() == 2 && tilemap.GetFlippedCells() == 1, buffer);
+
+        // Both duplicates are left out, only the empty tile and a single RGB 16x16 tile are stored
+        snprintf(buffer, buffer_size, "Saved bytes failed: %d saved, %d stored", tilemap.GetSavedBytes(), tilemap.GetInfo().CellByteSize);
+        mu_assert(tilemap.GetSavedBytes() == 1024 && tilemap.GetInfo().CellByteSize == 1024, buffer);
+    }
+
+    // Test that mirrored tile is referenced through flip bit
+    MU_TEST(tile_dedup_test_flip)
+    {
+        TileDedupBitmap bitmap;
+        SRL::Tilemap::Interfaces::Bmp2Tile tilemap(bitmap);
+        uint16_t* map = (uint16_t*)tilemap.GetMapData();
+
+        snprintf(buffer, buffer_size, "Flip failed: %x %x %x", map[0], map[1], map[2]);
+        mu_assert(map[0] == 4 && map[1] == (4 | 0x400) && map[2] == 4, buffer);
+    }
+
+    // Test that flip bits are only reserved when a mirrored tile was found
+    MU_TEST(tile_dedup_test_map_mode)
+    {
+        TileDedupBitmap mirrored;
+        TileDedupBitmap repeated(false);
+        SRL::Tilemap::Interfaces::Bmp2Tile flipped(mirrored);
+        SRL::Tilemap::Interfaces::Bmp2Tile plain(repeated);
+
+        snprintf(buffer, buffer_size, "Map mode failed: %x %x", flipped.GetInfo().MapMode, plain.GetInfo().MapMode);
+        mu_assert(flipped.GetInfo().MapMode == (PNB_1WORD | CN_10BIT) && plain.GetInfo().MapMode == (PNB_1WORD | CN_12BIT) &&
+            plain.GetFlippedCells() == 0 && plain.GetDuplicateCells() == 2, buffer);
+    }
+
+    MU_TEST_SUITE(tile_dedup_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&tile_dedup_test_setup,
+                                       &tile_dedup_test_teardown,
+                                       &tile_dedup_test_output_header);
+
+        MU_RUN_TEST(tile_dedup_test_unique);
+        MU_RUN_TEST(tile_dedup_test_flip);
+        MU_RUN_TEST(tile_dedup_test_map_mode);
+    }
+}
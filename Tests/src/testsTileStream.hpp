@@ -0,0 +1,119 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void tile_stream_test_setup(void)
+    {
+        // Nothing to setup
+    }
+
+    // UT teardown function, called after every tests
+    void tile_stream_test_teardown(void)
+    {
+        // Nothing to clean up
+    }
+
+    // UT output header function, called on the first test failure
+    void tile_stream_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_TILE_STREAM****");
+            }
+            else
+            {
+                LogInfo("****UT_TILE_STREAM_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that tile already in the cache is shared and not loaded again
+    MU_TEST(tile_stream_test_reuse)
+    {
+        SRL::Tilemap::CellCache cache(4, 16);
+        bool load;
+
+        int32_t first = cache.Acquire(3, load);
+        snprintf(buffer, buffer_size, "First acquire failed: slot %d", first);
+        mu_assert(first == 0 && load, buffer);
+
+        int32_t second = cache.Acquire(3, load);
+        snprintf(buffer, buffer_size, "Reuse failed: slot %d", second);
+        mu_assert(second == first && !load && cache.GetReferenceCount(first) == 2, buffer);
+
+        cache.Release(first);
+        cache.Release(first);
+        second = cache.Acquire(3, load);
+        snprintf(buffer, buffer_size, "Released tile reuse failed: slot %d", second);
+        mu_assert(second == first && !load && cache.GetReferenceCount(first) == 1, buffer);
+    }
+
+    // Test that least recently released tile is evicted first and referenced tiles are kept
+    MU_TEST(tile_stream_test_eviction)
+    {
+        SRL::Tilemap::CellCache cache(3, 16);
+        bool load;
+
+        int32_t a = cache.Acquire(1, load);
+        int32_t b = cache.Acquire(2, load);
+        int32_t c = cache.Acquire(3, load);
+
+        cache.Release(b);
+        cache.Release(a);
+
+        int32_t d = cache.Acquire(4, load);
+        snprintf(buffer, buffer_size, "Eviction order failed: slot %d", d);
+        mu_assert(d == b && load && cache.Find(2) == -1 && cache.GetTile(d) == 4, buffer);
+
+        int32_t e = cache.Acquire(5, load);
+        snprintf(buffer, buffer_size, "Second eviction failed: slot %d", e);
+        mu_assert(e == a && load && cache.Find(1) == -1 && cache.Find(3) == c, buffer);
+
+        int32_t f = cache.Acquire(6, load);
+        snprintf(buffer, buffer_size, "Full cache failed: slot %d", f);
+        mu_assert(f == -1 && !load, buffer);
+    }
+
+    // Test that memory source reads rows and columns
+    MU_TEST(tile_stream_test_memory_source)
+    {
+        const uint16_t map[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+        SRL::Tilemap::MemoryStreamSource source(map, 4, 3);
+        uint16_t line[3];
+
+        source.Read(1, 1, 3, false, line);
+        snprintf(buffer, buffer_size, "Row read failed: %d %d %d", line[0], line[1], line[2]);
+        mu_assert(line[0] == 5 && line[1] == 6 && line[2] == 7, buffer);
+
+        source.Read(2, 0, 3, true, line);
+        snprintf(buffer, buffer_size, "Column read failed: %d %d %d", line[0], line[1], line[2]);
+        mu_assert(line[0] == 2 && line[1] == 6 && line[2] == 10, buffer);
+    }
+
+    MU_TEST_SUITE(tile_stream_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&tile_stream_test_setup,
+                                       &tile_stream_test_teardown,
+                                       &tile_stream_test_output_header);
+
+        MU_RUN_TEST(tile_stream_test_reuse);
+        MU_RUN_TEST(tile_stream_test_eviction);
+        MU_RUN_TEST(tile_stream_test_memory_source);
+    }
+}
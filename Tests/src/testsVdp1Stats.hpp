@@ -0,0 +1,132 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // Build command with corners given as (x, y) pairs
+    SPRITE vdp1_stats_command(const uint16_t control, const int16_t corners[8])
+    {
+        SPRITE command = {};
+        command.CTRL = control;
+        command.XA = corners[0];
+        command.YA = corners[1];
+        command.XB = corners[2];
+        command.YB = corners[3];
+        command.XC = corners[4];
+        command.YC = corners[5];
+        command.XD = corners[6];
+        command.YD = corners[7];
+        return command;
+    }
+
+    // UT setup function, called before every tests
+    void vdp1_stats_test_setup(void)
+    {
+        SRL::VDP1::Stats::Enable();
+    }
+
+    // UT teardown function, called after every tests
+    void vdp1_stats_test_teardown(void)
+    {
+        SRL::VDP1::Stats::Disable();
+    }
+
+    // UT output header function, called on the first test failure
+    void vdp1_stats_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_VDP1_STATS****");
+            }
+            else
+            {
+                LogInfo("****UT_VDP1_STATS_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test pixel estimates of lines, scaled sprites, polygons and normal sprites
+    MU_TEST(vdp1_stats_test_estimate)
+    {
+        const int16_t line[8] = { 0, 0, 9, 3, 0, 0, 0, 0 };
+        const int16_t rectangle[8] = { 0, 0, 0, 0, 15, 7, 0, 0 };
+        const int16_t square[8] = { 0, 0, 10, 0, 10, 10, 0, 10 };
+
+        uint32_t pixels = SRL::VDP1::Stats::EstimatePixels(vdp1_stats_command(0x6, line));
+        snprintf(buffer, buffer_size, "Line failed: %d != 10", (int32_t)pixels);
+        mu_assert(pixels == 10, buffer);
+
+        pixels = SRL::VDP1::Stats::EstimatePixels(vdp1_stats_command(0x1, rectangle));
+        snprintf(buffer, buffer_size, "Scaled sprite failed: %d != 128", (int32_t)pixels);
+        mu_assert(pixels == 128, buffer);
+
+        pixels = SRL::VDP1::Stats::EstimatePixels(vdp1_stats_command(0x4, square));
+        snprintf(buffer, buffer_size, "Polygon failed: %d != 100", (int32_t)pixels);
+        mu_assert(pixels == 100, buffer);
+
+        SPRITE sprite = vdp1_stats_command(0x0, square);
+        sprite.SIZE = ((16 >> 3) << 8) | 8;
+        pixels = SRL::VDP1::Stats::EstimatePixels(sprite);
+        snprintf(buffer, buffer_size, "Normal sprite failed: %d != 128", (int32_t)pixels);
+        mu_assert(pixels == 128, buffer);
+    }
+
+    // Test that counters of the submitted list move into history after it was drawn
+    MU_TEST(vdp1_stats_test_history)
+    {
+        const int16_t line[8] = { 0, 0, 9, 3, 0, 0, 0, 0 };
+        const int16_t square[8] = { 0, 0, 10, 0, 10, 10, 0, 10 };
+
+        SRL::VDP1::Stats::Count(vdp1_stats_command(0x6, line));
+        SRL::VDP1::Stats::Count(vdp1_stats_command(0x4, square));
+        SRL::VDP1::Stats::Count(SRL::VDP1::Stats::Command::MeshFace, 0, 5);
+
+        const SRL::VDP1::Stats::Frame& current = SRL::VDP1::Stats::GetCurrentFrame();
+        snprintf(buffer, buffer_size, "Current frame failed: %d,%d != 7,110", (int32_t)current.GetCommandCount(), (int32_t)current.Pixels);
+        mu_assert(current.GetCommandCount() == 7 && current.Pixels == 110, buffer);
+
+        // First frame change starts drawing the list, second one finishes it
+        SRL::VDP1::Stats::AfterSync();
+        SRL::VDP1::Stats::AfterSync();
+
+        const SRL::VDP1::Stats::Frame& drawn = SRL::VDP1::Stats::GetFrame(0);
+        snprintf(buffer, buffer_size, "History failed: %d != 2", SRL::VDP1::Stats::GetHistoryLength());
+        mu_assert(SRL::VDP1::Stats::GetHistoryLength() == 2 && SRL::VDP1::Stats::GetFrame(1).GetCommandCount() == 0, buffer);
+
+        snprintf(buffer, buffer_size, "Drawn frame failed: %d,%d,%d != 1,1,5",
+            drawn.Commands[(uint8_t)SRL::VDP1::Stats::Command::LineSegment],
+            drawn.Commands[(uint8_t)SRL::VDP1::Stats::Command::Polygon],
+            drawn.Commands[(uint8_t)SRL::VDP1::Stats::Command::MeshFace]);
+        mu_assert(drawn.Commands[(uint8_t)SRL::VDP1::Stats::Command::LineSegment] == 1 &&
+            drawn.Commands[(uint8_t)SRL::VDP1::Stats::Command::Polygon] == 1 &&
+            drawn.Commands[(uint8_t)SRL::VDP1::Stats::Command::MeshFace] == 5 &&
+            drawn.Pixels == 110, buffer);
+
+        snprintf(buffer, buffer_size, "Current frame reset failed: %d != 0", (int32_t)SRL::VDP1::Stats::GetCurrentFrame().GetCommandCount());
+        mu_assert(SRL::VDP1::Stats::GetCurrentFrame().GetCommandCount() == 0, buffer);
+    }
+
+    MU_TEST_SUITE(vdp1_stats_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&vdp1_stats_test_setup,
+                                       &vdp1_stats_test_teardown,
+                                       &vdp1_stats_test_output_header);
+
+        MU_RUN_TEST(vdp1_stats_test_estimate);
+        MU_RUN_TEST(vdp1_stats_test_history);
+    }
+}
@@ -0,0 +1,105 @@
+#include <srl.hpp>
+#include <srl_log.hpp>
+
+// https://github.com/siu/minunit
+#include "minunit.h"
+
+using namespace SRL::Types;
+using namespace SRL::Math::Types;
+using namespace SRL::Logger;
+
+extern "C"
+{
+
+    extern const uint8_t buffer_size;
+    extern char buffer[];
+    extern uint32_t suite_error_counter;
+
+    // UT setup function, called before every tests
+    void vdp2_shadow_test_setup(void)
+    {
+        // Start from empty shadow
+        SRL::VDP2::Shadow::Flush();
+    }
+
+    // UT teardown function, called after every tests
+    void vdp2_shadow_test_teardown(void)
+    {
+        SRL::VDP2::NBG3::SetPriority(SRL::VDP2::Priority::Layer7);
+        SRL::VDP2::Shadow::Flush();
+    }
+
+    // UT output header function, called on the first test failure
+    void vdp2_shadow_test_output_header(void)
+    {
+        if (!suite_error_counter++)
+        {
+            if (Log::GetLogLevel() == Logger::LogLevels::TESTING)
+            {
+                LogDebug("****UT_VDP2_SHADOW****");
+            }
+            else
+            {
+                LogInfo("****UT_VDP2_SHADOW_ERROR(S)****");
+            }
+        }
+    }
+
+    // Test that repeated changes within a frame are written once
+    MU_TEST(vdp2_shadow_test_collapse)
+    {
+        SRL::VDP2::NBG3::SetPriority(SRL::VDP2::Priority::Layer5);
+        SRL::VDP2::NBG3::SetPriority(SRL::VDP2::Priority::Layer6);
+        SRL::VDP2::NBG3::SetPriority(SRL::VDP2::Priority::Layer2);
+
+        snprintf(buffer, buffer_size, "Dirty failed");
+        mu_assert(SRL::VDP2::Shadow::IsDirty(), buffer);
+
+        SRL::VDP2::Shadow::Flush();
+
+        snprintf(buffer, buffer_size, "Collapse failed: %d writes, %d requests", SRL::VDP2::Shadow::GetWriteCount(), SRL::VDP2::Shadow::GetRequestCount());
+        mu_assert(!SRL::VDP2::Shadow::IsDirty() && SRL::VDP2::Shadow::GetWriteCount() == 1 && SRL::VDP2::Shadow::GetRequestCount() == 3, buffer);
+    }
+
+    // Test that values equal to the applied ones are not written again
+    MU_TEST(vdp2_shadow_test_unchanged)
+    {
+        SRL::VDP2::NBG3::SetPriority(SRL::VDP2::Priority::Layer2);
+        SRL::VDP2::Shadow::Flush();
+        SRL::VDP2::NBG3::SetPriority(SRL::VDP2::Priority::Layer2);
+
+        snprintf(buffer, buffer_size, "Unchanged value marked dirty");
+        mu_assert(!SRL::VDP2::Shadow::IsDirty(), buffer);
+
+        SRL::VDP2::Shadow::Flush();
+
+        snprintf(buffer, buffer_size, "Unchanged failed: %d writes, %d requests", SRL::VDP2::Shadow::GetWriteCount(), SRL::VDP2::Shadow::GetRequestCount());
+        mu_assert(SRL::VDP2::Shadow::GetWriteCount() == 0 && SRL::VDP2::Shadow::GetRequestCount() == 1, buffer);
+    }
+
+    // Test that different settings are written separately
+    MU_TEST(vdp2_shadow_test_batch)
+    {
+        SRL::Math::Types::Vector2D position(12.0, 34.0);
+        SRL::Math::Types::Vector2D offset(1.0, 2.0);
+        SRL::VDP2::NBG3::SetPriority(SRL::VDP2::Priority::Layer4);
+        SRL::VDP2::NBG0::SetPosition(position);
+        SRL::VDP2::NBG1::SetPosition(position);
+        SRL::VDP2::NBG0::SetPosition(offset);
+        SRL::VDP2::Shadow::Flush();
+
+        snprintf(buffer, buffer_size, "Batch failed: %d writes, %d requests", SRL::VDP2::Shadow::GetWriteCount(), SRL::VDP2::Shadow::GetRequestCount());
+        mu_assert(SRL::VDP2::Shadow::GetWriteCount() == 3 && SRL::VDP2::Shadow::GetRequestCount() == 4, buffer);
+    }
+
+    MU_TEST_SUITE(vdp2_shadow_test_suite)
+    {
+        MU_SUITE_CONFIGURE_WITH_HEADER(&vdp2_shadow_test_setup,
+                                       &vdp2_shadow_test_teardown,
+                                       &vdp2_shadow_test_output_header);
+
+        MU_RUN_TEST(vdp2_shadow_test_collapse);
+        MU_RUN_TEST(vdp2_shadow_test_unchanged);
+        MU_RUN_TEST(vdp2_shadow_test_batch);
+    }
+}
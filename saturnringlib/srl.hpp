@@ -15,6 +15,14 @@ static_assert(SGL_MAX_POLYGONS > 4,
 #include "srl_tga.hpp"
 #include "srl_scene2d.hpp"
 #include "srl_scene3d.hpp"
+#include "srl_animation.hpp"
+#include "srl_gouraud.hpp"
+#include "srl_model.hpp"
+#include "srl_atlas.hpp"
+#include "srl_texture_cache.hpp"
+#include "srl_particles.hpp"
+#include "srl_texture_pack.hpp"
+#include "srl_tilemap_stream.hpp"
 
 
 #if SRL_USE_SGL_SOUND_DRIVER == 1
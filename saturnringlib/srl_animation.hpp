@@ -0,0 +1,873 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_mesh.hpp"
+#include "srl_slave.hpp"
+#include "srl_cd.hpp"
+#include "srl_scene3d.hpp"
+
+namespace SRL::Types
+{
+    /** @brief Keyframe vertex animation
+     * @details Keyframes are stored as quantized 16-bit deltas from the base pose (first keyframe) and normals as 8-bit vectors.
+     * Each frame vertices are interpolated between two keyframes into a single output mesh, which can be drawn as any other mesh.
+     * Normals are not interpolated, they are unpacked only when nearest keyframe changes.
+     * @code {.cpp}
+     * // Keyframes can be released after animation is built from them
+     * SRL::Types::AnimatedMesh* animation = new SRL::Types::AnimatedMesh(keyframes, keyframeCount);
+     * delete[] keyframes;
+     *
+     * // In game loop
+     * animation->ProcessFrame(time, true);
+     * animation->Draw(light);
+     * @endcode
+     */
+    class AnimatedMesh
+    {
+    private:
+
+        /** @brief Vertex interpolation task
+         */
+        class InterpolationTask : public ITask
+        {
+        public:
+
+            /** @brief Base pose
+             */
+            const int32_t* Base;
+
+            /** @brief Deltas of the start keyframe
+             */
+            const int16_t* From;
+
+            /** @brief Deltas of the end keyframe
+             */
+            const int16_t* To;
+
+            /** @brief Interpolation result
+             */
+            int32_t* Result;
+
+            /** @brief Number of vertices to process
+             */
+            size_t Count;
+
+            /** @brief Interpolation weight (16-bit fraction)
+             */
+            int32_t Weight;
+
+            /** @brief Delta quantization shift
+             */
+            uint8_t Shift;
+
+            /** @brief Interpolate assigned vertices
+             */
+            void Do() override
+            {
+                // Slave cache might hold weight and pointers from the previous frame
+                slCashPurge();
+                AnimatedMesh::Interpolate(this->Base, this->From, this->To, this->Weight, this->Shift, this->Result, this->Count);
+            }
+        };
+
+        /** @brief Scale between 16.16 fixed point unit vector and quantized 8-bit unit vector
+         */
+        static constexpr int32_t NormalScale = 516;
+
+        /** @brief Minimal number of vertices for which interpolation is split between CPUs
+         */
+        static constexpr size_t SlaveThreshold = 64;
+
+        /** @brief Output flat mesh
+         */
+        Mesh* flat;
+
+        /** @brief Output smooth mesh
+         */
+        SmoothMesh* smooth;
+
+        /** @brief Output vertices
+         */
+        SRL::Math::Types::Vector3D* vertices;
+
+        /** @brief Output faces
+         */
+        Polygon* faces;
+
+        /** @brief Output vertex normals (smooth mesh only)
+         */
+        SRL::Math::Types::Vector3D* normals;
+
+        /** @brief Number of vertices
+         */
+        size_t vertexCount;
+
+        /** @brief Number of faces
+         */
+        size_t faceCount;
+
+        /** @brief Number of keyframes
+         */
+        size_t frameCount;
+
+        /** @brief Base pose (first keyframe)
+         */
+        SRL::Math::Types::Vector3D* base;
+
+        /** @brief Quantized vertex deltas from base pose for every keyframe
+         */
+        int16_t* deltas;
+
+        /** @brief Quantized face normals for every keyframe
+         */
+        int8_t* faceNormals;
+
+        /** @brief Quantized vertex normals for every keyframe (smooth mesh only)
+         */
+        int8_t* vertexNormals;
+
+        /** @brief Delta quantization shift
+         */
+        uint8_t shift;
+
+        /** @brief Keyframe currently used for normals
+         */
+        size_t normalFrame;
+
+        /** @brief Slave CPU task
+         */
+        InterpolationTask task;
+
+        /** @brief Quantize unit vector
+         * @param vector Unit vector
+         * @param result Quantized vector
+         */
+        static void QuantizeNormal(const SRL::Math::Types::Vector3D& vector, int8_t* result)
+        {
+            const int32_t* raw = (const int32_t*)&vector;
+
+            for (uint8_t axis = 0; axis < 3; axis++)
+            {
+                result[axis] = (int8_t)SRL::Math::Clamp(raw[axis] / AnimatedMesh::NormalScale, (int32_t)-127, (int32_t)127);
+            }
+        }
+
+        /** @brief Unpack quantized unit vectors
+         * @param data Quantized vectors
+         * @param result Unpacked vectors
+         * @param count Number of vectors
+         */
+        static void UnpackNormals(const int8_t* data, SRL::Math::Types::Vector3D* result, const size_t count)
+        {
+            int32_t* raw = (int32_t*)result;
+
+            for (size_t value = 0; value < count * 3; value++)
+            {
+                raw[value] = data[value] * AnimatedMesh::NormalScale;
+            }
+        }
+
+        /** @brief Build animation from keyframes
+         * @tparam T SRL::Types::Mesh or SRL::Types::SmoothMesh
+         * @param keyframes Keyframe meshes, all must have same topology
+         * @param count Number of keyframes
+         * @param output Output mesh
+         */
+        template<typename T>
+        void Build(const T* keyframes, const size_t count, T* output)
+        {
+            this->frameCount = count;
+            this->vertexCount = keyframes[0].VertexCount;
+            this->faceCount = keyframes[0].FaceCount;
+            this->vertices = output->Vertices;
+            this->faces = output->Faces;
+            this->normalFrame = count;
+
+            // Topology is shared by all keyframes
+            for (size_t face = 0; face < this->faceCount; face++)
+            {
+                for (uint8_t vertex = 0; vertex < 4; vertex++)
+                {
+                    output->Faces[face].Vertices[vertex] = keyframes[0].Faces[face].Vertices[vertex];
+                }
+
+                output->Attributes[face] = keyframes[0].Attributes[face];
+            }
+
+            // Base pose is the first keyframe
+            this->base = new SRL::Math::Types::Vector3D[this->vertexCount];
+            const int32_t* base = (const int32_t*)keyframes[0].Vertices;
+
+            for (size_t vertex = 0; vertex < this->vertexCount; vertex++)
+            {
+                this->base[vertex] = keyframes[0].Vertices[vertex];
+            }
+
+            // Find smallest shift all deltas fit into 16 bits with
+            int32_t largest = 0;
+
+            for (size_t frame = 1; frame < count; frame++)
+            {
+                const int32_t* current = (const int32_t*)keyframes[frame].Vertices;
+
+                for (size_t value = 0; value < this->vertexCount * 3; value++)
+                {
+                    largest = SRL::Math::Max(largest, SRL::Math::Abs(current[value] - base[value]));
+                }
+            }
+
+            this->shift = 0;
+
+            while ((largest >> this->shift) > 32767)
+            {
+                this->shift++;
+            }
+
+            // Quantize deltas
+            this->deltas = new int16_t[count * this->vertexCount * 3];
+            const int32_t rounding = this->shift > 0 ? 1 << (this->shift - 1) : 0;
+
+            for (size_t frame = 0; frame < count; frame++)
+            {
+                const int32_t* current = (const int32_t*)keyframes[frame].Vertices;
+                int16_t* delta = this->deltas + (frame * this->vertexCount * 3);
+
+                for (size_t value = 0; value < this->vertexCount * 3; value++)
+                {
+                    int32_t quantized = (current[value] - base[value] + rounding) >> this->shift;
+                    delta[value] = (int16_t)SRL::Math::Clamp(quantized, (int32_t)-32768, (int32_t)32767);
+                }
+            }
+
+            // Quantize face normals
+            this->faceNormals = new int8_t[count * this->faceCount * 3];
+
+            for (size_t frame = 0; frame < count; frame++)
+            {
+                for (size_t face = 0; face < this->faceCount; face++)
+                {
+                    AnimatedMesh::QuantizeNormal(
+                        keyframes[frame].Faces[face].Normal,
+                        this->faceNormals + (((frame * this->faceCount) + face) * 3));
+                }
+            }
+        }
+
+    public:
+
+        /** @brief Construct animation of a flat mesh
+         * @note Keyframes are not referenced after construction and can be freed
+         * @param keyframes Keyframe meshes, all must have same topology
+         * @param count Number of keyframes
+         */
+        AnimatedMesh(const Mesh* keyframes, const size_t count) : smooth(nullptr), normals(nullptr), vertexNormals(nullptr)
+        {
+            this->flat = new Mesh(keyframes[0].VertexCount, keyframes[0].FaceCount);
+            this->Build(keyframes, count, this->flat);
+            this->ProcessFrame(0.0);
+        }
+
+        /** @brief Construct animation of a smooth mesh
+         * @note Keyframes are not referenced after construction and can be freed
+         * @param keyframes Keyframe meshes, all must have same topology
+         * @param count Number of keyframes
+         */
+        AnimatedMesh(const SmoothMesh* keyframes, const size_t count) : flat(nullptr)
+        {
+            this->smooth = new SmoothMesh(keyframes[0].VertexCount, keyframes[0].FaceCount);
+            this->normals = this->smooth->Normals;
+            this->Build(keyframes, count, this->smooth);
+
+            // Quantize vertex normals
+            this->vertexNormals = new int8_t[count * this->vertexCount * 3];
+
+            for (size_t frame = 0; frame < count; frame++)
+            {
+                for (size_t vertex = 0; vertex < this->vertexCount; vertex++)
+                {
+                    AnimatedMesh::QuantizeNormal(
+                        keyframes[frame].Normals[vertex],
+                        this->vertexNormals + (((frame * this->vertexCount) + vertex) * 3));
+                }
+            }
+
+            this->ProcessFrame(0.0);
+        }
+
+        /** @brief Disable copy constructor
+         */
+        AnimatedMesh(const AnimatedMesh&) = delete;
+
+        /** @brief Disable assignment operator
+         */
+        AnimatedMesh& operator=(const AnimatedMesh&) = delete;
+
+        /** @brief Destroy the animated mesh
+         */
+        ~AnimatedMesh()
+        {
+            delete this->flat;
+            delete this->smooth;
+            delete[] this->base;
+            delete[] this->deltas;
+            delete[] this->faceNormals;
+            delete[] this->vertexNormals;
+        }
+
+        /** @brief Interpolate vertices between two keyframes
+         * @param base Base pose (raw 16.16 values)
+         * @param from Quantized deltas of the start keyframe
+         * @param to Quantized deltas of the end keyframe
+         * @param weight Interpolation weight as 16-bit fraction (0 to 0xffff)
+         * @param shift Delta quantization shift
+         * @param result Interpolated vertices (raw 16.16 values)
+         * @param count Number of vertices
+         */
+        static void Interpolate(const int32_t* base, const int16_t* from, const int16_t* to, const int32_t weight, const uint8_t shift, int32_t* result, const size_t count)
+        {
+            // Weight is reduced to 15 bits, so product of 16-bit delta difference and weight does not overflow
+            const int32_t fraction = weight >> 1;
+            const int32_t* end = result + (count * 3);
+
+            while (result < end)
+            {
+                const int32_t start = *from++;
+                const int32_t delta = start + (((*to++ - start) * fraction) >> 15);
+                *result++ = *base++ + (delta << shift);
+            }
+        }
+
+        /** @brief Process animation frame
+         * @param time Frame time, where number before the decimal place indicates current keyframe, and number after decimal place indicates interpolation to next keyframe
+         * @param useSlave Value indicating whether to split vertex interpolation between master and slave CPU
+         */
+        void ProcessFrame(const SRL::Math::Types::Fxp& time, const bool useSlave = false)
+        {
+            const size_t last = this->frameCount - 1;
+            const size_t frame = SRL::Math::Min((size_t)SRL::Math::Max(time.As<int32_t>(), (int32_t)0), last);
+            const size_t nextFrame = SRL::Math::Min(frame + 1, last);
+            const int32_t weight = time.RawValue() < 0 ? 0 : time.RawValue() & 0xffff;
+
+            const int32_t* base = (const int32_t*)this->base;
+            const int16_t* from = this->deltas + (frame * this->vertexCount * 3);
+            const int16_t* to = this->deltas + (nextFrame * this->vertexCount * 3);
+            int32_t* result = (int32_t*)this->vertices;
+
+            if (useSlave && this->vertexCount >= AnimatedMesh::SlaveThreshold)
+            {
+                // Second half is processed by slave CPU
+                const size_t half = this->vertexCount >> 1;
+                const size_t offset = half * 3;
+
+                this->task.Base = base + offset;
+                this->task.From = from + offset;
+                this->task.To = to + offset;
+                this->task.Result = result + offset;
+                this->task.Count = this->vertexCount - half;
+                this->task.Weight = weight;
+                this->task.Shift = this->shift;
+                SRL::Slave::ExecuteOnSlave(this->task);
+
+                AnimatedMesh::Interpolate(base, from, to, weight, this->shift, result, half);
+
+                while (!this->task.IsDone());
+
+                // Make sure master does not see stale vertices written by slave
+                slCashPurge();
+            }
+            else
+            {
+                AnimatedMesh::Interpolate(base, from, to, weight, this->shift, result, this->vertexCount);
+            }
+
+            // Normals change only when nearest keyframe changes
+            const size_t nearest = weight < 0x8000 ? frame : nextFrame;
+
+            if (nearest != this->normalFrame)
+            {
+                this->normalFrame = nearest;
+                const int8_t* faceNormals = this->faceNormals + (nearest * this->faceCount * 3);
+
+                for (size_t face = 0; face < this->faceCount; face++)
+                {
+                    AnimatedMesh::UnpackNormals(faceNormals + (face * 3), &this->faces[face].Normal, 1);
+                }
+
+                if (this->normals != nullptr)
+                {
+                    AnimatedMesh::UnpackNormals(this->vertexNormals + (nearest * this->vertexCount * 3), this->normals, this->vertexCount);
+                }
+            }
+        }
+
+        /** @brief Draw current animation frame
+         * @note Used only with flat type mesh data
+         * @param slaveOnly Value indicates whether processing of the mesh should be handled only on the slave CPU
+         */
+        void Draw(const bool slaveOnly = false)
+        {
+            if (this->flat != nullptr)
+            {
+                SRL::Scene3D::DrawMesh(*this->flat, slaveOnly);
+            }
+        }
+
+        /** @brief Draw current animation frame
+         * @note Used only with smooth type mesh data
+         * @param light Light direction
+         */
+        void Draw(SRL::Math::Types::Vector3D& light)
+        {
+            if (this->smooth != nullptr)
+            {
+                SRL::Scene3D::DrawSmoothMesh(*this->smooth, light);
+            }
+        }
+
+        /** @brief Get current frame of flat mesh animation
+         * @return Current mesh state or nullptr if animation is of smooth mesh
+         */
+        Mesh* GetMesh()
+        {
+            return this->flat;
+        }
+
+        /** @brief Get current frame of smooth mesh animation
+         * @return Current mesh state or nullptr if animation is of flat mesh
+         */
+        SmoothMesh* GetSmoothMesh()
+        {
+            return this->smooth;
+        }
+
+        /** @brief Gets number of keyframes
+         * @return Number of keyframes
+         */
+        size_t GetFrameCount() const
+        {
+            return this->frameCount;
+        }
+
+        /** @brief Gets number of mesh faces
+         * @return Number of mesh faces
+         */
+        size_t GetFaceCount() const
+        {
+            return this->faceCount;
+        }
+
+        /** @brief Gets number of mesh vertices
+         * @return Number of mesh vertices
+         */
+        size_t GetVertexCount() const
+        {
+            return this->vertexCount;
+        }
+
+        /** @brief Get a value indicating whether we are dealing with smooth mesh
+         * @return true if its a smooth mesh
+         */
+        bool IsSmooth() const
+        {
+            return this->smooth != nullptr;
+        }
+    };
+
+    /** @brief Pose of a single rigid bone
+     */
+    struct BonePose
+    {
+        /** @brief Rotation around X, Y and Z axis (applied in that order)
+         */
+        SRL::Math::Types::Angle Rotation[3];
+
+        /** @brief Translation relative to the bone rest position
+         */
+        SRL::Math::Types::Vector3D Translation;
+    };
+
+    /** @brief Rigid bone animation clip
+     * @details Clip is stored in a binary format which is used in memory as is, so it can be loaded from CD with a single read.
+     * All values are big-endian.
+     * Offset | Type                                | Description
+     * -------|-------------------------------------|-----------------------------------------------
+     * 0      | uint16_t                            | Number of bones
+     * 2      | uint16_t                            | Number of keyframes
+     * 4      | SRL::Types::AnimationClip::Key[]    | Keys of all bones of the first keyframe, followed by keys of the next keyframe
+     */
+    class AnimationClip
+    {
+    public:
+
+        /** @brief Clip header
+         */
+        struct Header
+        {
+            /** @brief Number of bones
+             */
+            uint16_t BoneCount;
+
+            /** @brief Number of keyframes
+             */
+            uint16_t KeyframeCount;
+        };
+
+        /** @brief Bone keyframe
+         */
+        struct Key
+        {
+            /** @brief Raw rotation angles around X, Y and Z axis
+             */
+            uint16_t Rotation[3];
+
+            /** @brief Translation in 12.4 fixed point format
+             */
+            int16_t Translation[3];
+        };
+
+    private:
+
+        /** @brief Clip data
+         */
+        Header* header;
+
+        /** @brief Value indicating whether clip data is owned by this object
+         */
+        bool owned;
+
+    public:
+
+        /** @brief Load clip from a file
+         * @param fileName Clip file name
+         */
+        AnimationClip(const char* fileName) : header(nullptr), owned(true)
+        {
+            SRL::Cd::File file = SRL::Cd::File(fileName);
+
+            if (!file.Exists())
+            {
+                SRL::Debug::Assert("Animation clip '%s' not found", fileName);
+                return;
+            }
+
+            this->header = (Header*)new uint8_t[file.Size.Bytes];
+            file.LoadBytes(0, file.Size.Bytes, this->header);
+        }
+
+        /** @brief Use clip data already in memory
+         * @note Data is not copied and must stay valid for the lifetime of the clip
+         * @param data Clip data
+         */
+        AnimationClip(void* data) : header((Header*)data), owned(false) { }
+
+        /** @brief Destroy the clip
+         */
+        ~AnimationClip()
+        {
+            if (this->owned)
+            {
+                delete[] (uint8_t*)this->header;
+            }
+        }
+
+        /** @brief Get number of bones the clip animates
+         * @return Number of bones
+         */
+        uint16_t GetBoneCount() const
+        {
+            return this->header != nullptr ? this->header->BoneCount : 0;
+        }
+
+        /** @brief Get number of keyframes
+         * @return Number of keyframes
+         */
+        uint16_t GetKeyframeCount() const
+        {
+            return this->header != nullptr ? this->header->KeyframeCount : 0;
+        }
+
+        /** @brief Get keys of all bones for a keyframe
+         * @param keyframe Keyframe index
+         * @return Bone keys
+         */
+        const Key* GetKeys(const uint16_t keyframe) const
+        {
+            return ((const Key*)(this->header + 1)) + (keyframe * this->header->BoneCount);
+        }
+
+        /** @brief Interpolate pose of all bones
+         * @param time Clip time, where number before the decimal place indicates current keyframe, and number after decimal place indicates interpolation to next keyframe
+         * @param loop Value indicating whether last keyframe interpolates back to first keyframe
+         * @param result Bone poses, must have space for SRL::Types::AnimationClip::GetBoneCount() entries
+         */
+        void Sample(const SRL::Math::Types::Fxp& time, const bool loop, BonePose* result) const
+        {
+            const int32_t keyframes = this->GetKeyframeCount();
+
+            if (keyframes == 0)
+            {
+                return;
+            }
+
+            int32_t frame = SRL::Math::Max(time.As<int32_t>(), (int32_t)0);
+            int32_t nextFrame;
+
+            if (loop)
+            {
+                frame %= keyframes;
+                nextFrame = (frame + 1) % keyframes;
+            }
+            else
+            {
+                frame = SRL::Math::Min(frame, keyframes - 1);
+                nextFrame = SRL::Math::Min(frame + 1, keyframes - 1);
+            }
+
+            // Weight is reduced to 15 bits, so it can be multiplied by 16-bit differences
+            const int32_t weight = time.RawValue() < 0 ? 0 : (time.RawValue() & 0xffff) >> 1;
+            const Key* from = this->GetKeys(frame);
+            const Key* to = this->GetKeys(nextFrame);
+
+            for (uint16_t bone = 0; bone < this->header->BoneCount; bone++)
+            {
+                int32_t* translation = (int32_t*)&result[bone].Translation;
+
+                for (uint8_t axis = 0; axis < 3; axis++)
+                {
+                    // Rotation takes the shortest path
+                    const int32_t start = from[bone].Rotation[axis];
+                    const int32_t delta = (int16_t)(to[bone].Rotation[axis] - start);
+                    result[bone].Rotation[axis] = SRL::Math::Types::Angle::BuildRaw((uint16_t)(start + ((delta * weight) >> 15)));
+
+                    const int32_t position = from[bone].Translation[axis];
+                    const int32_t offset = to[bone].Translation[axis] - position;
+                    translation[axis] = (position + ((offset * weight) >> 15)) << 12;
+                }
+            }
+        }
+    };
+
+    /** @brief Rigid bone hierarchy of a segmented model
+     * @details Every bone owns a mesh part, which is drawn with the bone transformation pushed onto the SGL matrix stack.
+     * Parent of a bone must have lower index than the bone itself, so whole hierarchy is processed in a single pass.
+     * @code {.cpp}
+     * SRL::Types::Skeleton skeleton(3);
+     * skeleton[0].Mesh = &body;
+     * skeleton[1] = { 0, SRL::Math::Types::Vector3D(0.0, -10.0, 0.0), &head };
+     * skeleton[2] = { 0, SRL::Math::Types::Vector3D(5.0, -8.0, 0.0), &arm };
+     *
+     * SRL::Types::AnimationClip walk("WALK.ANI");
+     * SRL::Types::AnimationClip wave("WAVE.ANI");
+     *
+     * // In game loop
+     * skeleton.Sample(walk, walkTime);
+     * skeleton.Blend(wave, waveTime, 0.5);
+     * skeleton.Draw();
+     * @endcode
+     */
+    class Skeleton
+    {
+    public:
+
+        /** @brief Parent index of the root bones
+         */
+        static constexpr uint16_t NoParent = 0xffff;
+
+        /** @brief Single bone of the hierarchy
+         */
+        struct Bone
+        {
+            /** @brief Index of the parent bone, or SRL::Types::Skeleton::NoParent
+             */
+            uint16_t Parent;
+
+            /** @brief Rest position relative to the parent bone
+             */
+            SRL::Math::Types::Vector3D Offset;
+
+            /** @brief Mesh part owned by the bone (can be nullptr)
+             */
+            Types::Mesh* Mesh;
+        };
+
+    private:
+
+        /** @brief Bones of the hierarchy
+         */
+        Bone* bones;
+
+        /** @brief Current pose of each bone
+         */
+        BonePose* pose;
+
+        /** @brief Work pose used when blending
+         */
+        BonePose* blend;
+
+        /** @brief Bone matrices of the last drawn frame
+         */
+        SRL::Math::Matrix43* matrices;
+
+        /** @brief Number of bones
+         */
+        uint16_t count;
+
+        /** @brief Check whether clip fits the skeleton
+         * @param clip Animation clip
+         * @return True if clip animates same number of bones
+         */
+        bool IsCompatible(const AnimationClip& clip) const
+        {
+            if (clip.GetBoneCount() != this->count)
+            {
+                SRL::Debug::Assert("Clip has %d bones, skeleton has %d", clip.GetBoneCount(), this->count);
+                return false;
+            }
+
+            return true;
+        }
+
+    public:
+
+        /** @brief Construct new skeleton with all bones at origin and without parent
+         * @param boneCount Number of bones
+         */
+        Skeleton(const uint16_t boneCount) : count(boneCount)
+        {
+            this->bones = new Bone[boneCount];
+            this->pose = new BonePose[boneCount];
+            this->blend = new BonePose[boneCount];
+            this->matrices = new SRL::Math::Matrix43[boneCount];
+
+            for (uint16_t bone = 0; bone < boneCount; bone++)
+            {
+                this->bones[bone] = { Skeleton::NoParent, SRL::Math::Types::Vector3D(), nullptr };
+            }
+        }
+
+        /** @brief Destroy the skeleton, bone meshes are not freed
+         */
+        ~Skeleton()
+        {
+            delete[] this->bones;
+            delete[] this->pose;
+            delete[] this->blend;
+            delete[] this->matrices;
+        }
+
+        /** @brief Access bone by index
+         * @param index Bone index
+         * @return Bone at the index
+         */
+        Bone& operator[](const uint16_t index)
+        {
+            return this->bones[index];
+        }
+
+        /** @brief Get number of bones
+         * @return Number of bones
+         */
+        uint16_t GetBoneCount() const
+        {
+            return this->count;
+        }
+
+        /** @brief Get current pose of a bone
+         * @param index Bone index
+         * @return Bone pose
+         */
+        BonePose& GetPose(const uint16_t index)
+        {
+            return this->pose[index];
+        }
+
+        /** @brief Get bone matrix calculated during last SRL::Types::Skeleton::Draw() call
+         * @details Can be used to attach other objects to the bone
+         * @param index Bone index
+         * @return Bone matrix
+         */
+        const SRL::Math::Matrix43& GetMatrix(const uint16_t index) const
+        {
+            return this->matrices[index];
+        }
+
+        /** @brief Set current pose from animation clip
+         * @param clip Animation clip
+         * @param time Clip time in keyframes
+         * @param loop Value indicating whether clip loops
+         */
+        void Sample(const AnimationClip& clip, const SRL::Math::Types::Fxp& time, const bool loop = true)
+        {
+            if (this->IsCompatible(clip))
+            {
+                clip.Sample(time, loop, this->pose);
+            }
+        }
+
+        /** @brief Blend animation clip into current pose
+         * @param clip Animation clip
+         * @param time Clip time in keyframes
+         * @param weight Blend weight (0.0 keeps current pose, 1.0 uses pose from the clip)
+         * @param loop Value indicating whether clip loops
+         */
+        void Blend(const AnimationClip& clip, const SRL::Math::Types::Fxp& time, const SRL::Math::Types::Fxp& weight, const bool loop = true)
+        {
+            if (!this->IsCompatible(clip))
+            {
+                return;
+            }
+
+            clip.Sample(time, loop, this->blend);
+            const int32_t fraction = SRL::Math::Clamp(weight.RawValue(), (int32_t)0, (int32_t)0x10000) >> 1;
+
+            for (uint16_t bone = 0; bone < this->count; bone++)
+            {
+                int32_t* translation = (int32_t*)&this->pose[bone].Translation;
+                const int32_t* target = (const int32_t*)&this->blend[bone].Translation;
+
+                for (uint8_t axis = 0; axis < 3; axis++)
+                {
+                    const int32_t start = this->pose[bone].Rotation[axis].RawValue();
+                    const int32_t delta = (int16_t)(this->blend[bone].Rotation[axis].RawValue() - start);
+                    this->pose[bone].Rotation[axis] = SRL::Math::Types::Angle::BuildRaw((uint16_t)(start + ((delta * fraction) >> 15)));
+
+                    // Split multiplication, so large translations do not overflow
+                    const int32_t offset = target[axis] - translation[axis];
+                    translation[axis] += ((offset >> 15) * fraction) + (((offset & 0x7fff) * fraction) >> 15);
+                }
+            }
+        }
+
+        /** @brief Draw all bone meshes, current matrix is used as model transformation
+         * @param slaveOnly Value indicates whether processing of the meshes should be handled only on the slave CPU
+         */
+        void Draw(const bool slaveOnly = false)
+        {
+            for (uint16_t index = 0; index < this->count; index++)
+            {
+                const Bone& bone = this->bones[index];
+                const BonePose& pose = this->pose[index];
+
+                SRL::Scene3D::PushMatrix();
+                {
+                    if (bone.Parent != Skeleton::NoParent)
+                    {
+                        SRL::Scene3D::SetMatrix(this->matrices[bone.Parent]);
+                    }
+
+                    SRL::Scene3D::Translate(bone.Offset + pose.Translation);
+                    SRL::Scene3D::RotateX(pose.Rotation[0]);
+                    SRL::Scene3D::RotateY(pose.Rotation[1]);
+                    SRL::Scene3D::RotateZ(pose.Rotation[2]);
+                    SRL::Scene3D::GetMatrix(&this->matrices[index]);
+
+                    if (bone.Mesh != nullptr)
+                    {
+                        SRL::Scene3D::DrawMesh(*bone.Mesh, slaveOnly);
+                    }
+                }
+                SRL::Scene3D::PopMatrix();
+            }
+        }
+    };
+}
@@ -0,0 +1,588 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_debug.hpp"
+#include "srl_cd.hpp"
+#include "srl_tv.hpp"
+#include "srl_vdp1.hpp"
+#include "srl_scene2d.hpp"
+
+namespace SRL::Types
+{
+    /** @brief Texture atlas packing many small images into a single VDP1 texture
+     * @details Every texture loaded by SRL::VDP1::TryLoadTexture() uses one of 'SRL_MAX_TEXTURES' slots and its width is padded to a multiple of 8,
+     * so lots of small sprites waste both texture slots and sprite VRAM. Atlas allocates one texture slot and packs images into it with shelf packing,
+     * each image is then referenced by its region index.
+     *
+     * VDP1 reads texture rows with stride equal to the sprite width, so a region is drawn as a strip of full atlas width
+     * starting at the first row of the region, which is narrowed to the region by user clipping.
+     * Regions spanning whole atlas width are drawn without clipping.
+     *
+     * Atlas can be also loaded from a file created by tools/scripts/atlas_packer.py, with pixel data ready to be copied into VRAM with a single DMA transfer.
+     * All values are big-endian.
+     * Offset                | Type                                      | Description
+     * ----------------------|-------------------------------------------|---------------------------------------------------
+     * 0                     | SRL::Types::TextureAtlas::Header          | File header
+     * Header::RegionOffset  | SRL::Types::TextureAtlas::Region[]        | Region table
+     * Header::DataOffset    | uint8_t[]                                 | Pixel data of the whole atlas
+     * @code {.cpp}
+     * SRL::Types::TextureAtlas atlas(128, 128);
+     * int32_t coin = atlas.Add(coinBitmap);
+     *
+     * // In game loop
+     * atlas.Draw(coin, SRL::Math::Types::Vector3D(10.0, 20.0, 500.0));
+     * @endcode
+     */
+    class TextureAtlas
+    {
+    public:
+
+        /** @brief Current file format version
+         */
+        static constexpr uint16_t Version = 1;
+
+        /** @brief Atlas width must be multiple of this value, so every row starts on 8 byte boundary in all color modes
+         */
+        static constexpr uint16_t WidthAlignment = 16;
+
+        /** @brief Horizontal position of every region is aligned to this number of pixels, so rows can be copied by 16-bit words in all color modes
+         */
+        static constexpr uint16_t PositionAlignment = 4;
+
+        /** @brief Maximal number of shelves
+         */
+        static constexpr uint8_t MaxShelves = 32;
+
+        /** @brief Atlas file header
+         */
+        struct Header
+        {
+            /** @brief File identifier, always 'SRLA'
+             */
+            char Magic[4];
+
+            /** @brief File format version
+             */
+            uint16_t Version;
+
+            /** @brief Color mode of the pixel data (SRL::CRAM::TextureColorMode)
+             */
+            uint16_t ColorMode;
+
+            /** @brief Atlas width
+             */
+            uint16_t Width;
+
+            /** @brief Atlas height
+             */
+            uint16_t Height;
+
+            /** @brief Number of regions
+             */
+            uint16_t RegionCount;
+
+            /** @brief Reserved, always 0
+             */
+            uint16_t Reserved;
+
+            /** @brief Offset of the region table
+             */
+            uint32_t RegionOffset;
+
+            /** @brief Offset of the pixel data
+             */
+            uint32_t DataOffset;
+        };
+
+        /** @brief Image placed in the atlas
+         */
+        struct Region
+        {
+            /** @brief Left edge of the image in the atlas
+             */
+            uint16_t X;
+
+            /** @brief Top edge of the image in the atlas
+             */
+            uint16_t Y;
+
+            /** @brief Image width
+             */
+            uint16_t Width;
+
+            /** @brief Image height
+             */
+            uint16_t Height;
+        };
+
+    private:
+
+        /** @brief Row of images with the same maximal height
+         */
+        struct Shelf
+        {
+            /** @brief Top edge of the shelf
+             */
+            uint16_t Y;
+
+            /** @brief Shelf height
+             */
+            uint16_t Height;
+
+            /** @brief Width used by images on the shelf
+             */
+            uint16_t Used;
+        };
+
+        /** @brief Index of the atlas texture
+         */
+        int32_t texture;
+
+        /** @brief Placed images
+         */
+        Region* regions;
+
+        /** @brief Number of placed images
+         */
+        uint16_t regionCount;
+
+        /** @brief Maximal number of placed images
+         */
+        uint16_t maxRegions;
+
+        /** @brief Shelves
+         */
+        Shelf shelves[TextureAtlas::MaxShelves];
+
+        /** @brief Number of shelves
+         */
+        uint8_t shelfCount;
+
+        /** @brief Area covered by placed images
+         */
+        uint32_t usedArea;
+
+        /** @brief Allocate atlas texture
+         * @param width Atlas width
+         * @param height Atlas height
+         * @param colorMode Color mode
+         * @param palette Palette identifier (not used in RGB555 mode)
+         * @param maxRegions Maximal number of images
+         * @return True on success
+         */
+        bool Allocate(const uint16_t width, const uint16_t height, const CRAM::TextureColorMode colorMode, const uint16_t palette, const uint16_t maxRegions)
+        {
+            if ((width % TextureAtlas::WidthAlignment) != 0 || width > 496 || height > 255)
+            {
+                SRL::Debug::Assert("Atlas size %dx%d is not supported", width, height);
+                return false;
+            }
+
+            this->texture = SRL::VDP1::TryAllocateTexture(width, height, colorMode, palette);
+
+            if (this->texture < 0)
+            {
+                SRL::Debug::Assert("Not enough texture memory for atlas");
+                return false;
+            }
+
+            this->regions = new Region[maxRegions];
+            this->maxRegions = maxRegions;
+            return true;
+        }
+
+        /** @brief Get number of bytes of pixel data
+         * @param width Number of pixels
+         * @return Number of bytes
+         */
+        size_t GetByteCount(const uint32_t width) const
+        {
+            return (width << 2) >> SRL::VDP1::GetSizeShifter(SRL::VDP1::Metadata[this->texture].ColorMode);
+        }
+
+        /** @brief Find place for an image
+         * @details Image is placed on the shelf wasting least height, top shelf grows if needed. New shelf is opened only if image fits on none of the existing ones.
+         * @param width Image width aligned to SRL::Types::TextureAtlas::PositionAlignment
+         * @param height Image height
+         * @param region Placed image
+         * @return True if image fits into the atlas
+         */
+        bool Place(const uint16_t width, const uint16_t height, Region& region)
+        {
+            const VDP1::Texture& atlas = SRL::VDP1::Textures[this->texture];
+            int16_t best = -1;
+
+            for (uint8_t shelf = 0; shelf < this->shelfCount; shelf++)
+            {
+                if (this->shelves[shelf].Height >= height &&
+                    atlas.Width - this->shelves[shelf].Used >= width &&
+                    (best < 0 || this->shelves[shelf].Height < this->shelves[best].Height))
+                {
+                    best = shelf;
+                }
+            }
+
+            if (best < 0 && this->shelfCount > 0)
+            {
+                // Top shelf can grow until it hits bottom of the atlas
+                Shelf& top = this->shelves[this->shelfCount - 1];
+
+                if (atlas.Width - top.Used >= width && top.Y + height <= atlas.Height)
+                {
+                    top.Height = SRL::Math::Max(top.Height, height);
+                    best = this->shelfCount - 1;
+                }
+            }
+
+            if (best < 0)
+            {
+                const uint16_t y = this->shelfCount > 0 ? this->shelves[this->shelfCount - 1].Y + this->shelves[this->shelfCount - 1].Height : 0;
+
+                if (this->shelfCount >= TextureAtlas::MaxShelves || y + height > atlas.Height || width > atlas.Width)
+                {
+                    return false;
+                }
+
+                this->shelves[this->shelfCount] = { y, height, 0 };
+                best = this->shelfCount++;
+            }
+
+            region.X = this->shelves[best].Used;
+            region.Y = this->shelves[best].Y;
+            this->shelves[best].Used += width;
+            return true;
+        }
+
+        /** @brief Load atlas from file data
+         * @param header Loaded file
+         * @param palette Palette identifier (not used in RGB555 mode)
+         * @param extraRegions Number of images that can be added to the atlas after it was loaded
+         * @return True on success
+         */
+        bool Map(const Header* header, const uint16_t palette, const uint16_t extraRegions)
+        {
+            if (header->Magic[0] != 'S' || header->Magic[1] != 'R' ||
+                header->Magic[2] != 'L' || header->Magic[3] != 'A' ||
+                header->Version != TextureAtlas::Version)
+            {
+                SRL::Debug::Assert("Unsupported atlas file");
+                return false;
+            }
+
+            const Region* regions = (const Region*)(((uint8_t*)header) + header->RegionOffset);
+
+            for (uint16_t region = 0; region < header->RegionCount; region++)
+            {
+                if (regions[region].X + regions[region].Width > header->Width ||
+                    regions[region].Y + regions[region].Height > header->Height)
+                {
+                    SRL::Debug::Assert("Atlas region %d is outside of the atlas", region);
+                    return false;
+                }
+            }
+
+            if (!this->Allocate(header->Width, header->Height, (CRAM::TextureColorMode)header->ColorMode, palette, header->RegionCount + extraRegions))
+            {
+                return false;
+            }
+
+            // Whole atlas is copied in one go
+            slDMACopy(
+                (void*)(((uint8_t*)header) + header->DataOffset),
+                SRL::VDP1::Textures[this->texture].GetData(),
+                this->GetByteCount(header->Width * header->Height));
+
+            uint16_t bottom = 0;
+
+            for (uint16_t region = 0; region < header->RegionCount; region++)
+            {
+                this->regions[region] = regions[region];
+                this->usedArea += regions[region].Width * regions[region].Height;
+                bottom = SRL::Math::Max(bottom, (uint16_t)(regions[region].Y + regions[region].Height));
+            }
+
+            this->regionCount = header->RegionCount;
+
+            // Images added later go under the packed ones
+            if (bottom > 0)
+            {
+                this->shelves[0] = { 0, bottom, header->Width };
+                this->shelfCount = 1;
+            }
+
+            slDMAWait();
+            return true;
+        }
+
+    public:
+
+        /** @brief Create an empty atlas
+         * @param width Atlas width (must be multiple of 16, at most 496)
+         * @param height Atlas height (at most 255)
+         * @param colorMode Color mode of all images in the atlas
+         * @param palette Palette identifier (not used in RGB555 mode)
+         * @param maxRegions Maximal number of images
+         */
+        TextureAtlas(
+            const uint16_t width,
+            const uint16_t height,
+            const CRAM::TextureColorMode colorMode = CRAM::TextureColorMode::RGB555,
+            const uint16_t palette = 0,
+            const uint16_t maxRegions = 64) : texture(-1), regions(nullptr), regionCount(0), maxRegions(0), shelfCount(0), usedArea(0)
+        {
+            this->Allocate(width, height, colorMode, palette, maxRegions);
+        }
+
+        /** @brief Load atlas from a file
+         * @param fileName Atlas file name
+         * @param palette Palette identifier (not used in RGB555 mode)
+         * @param extraRegions Number of images that can be added to the atlas after it was loaded
+         */
+        TextureAtlas(const char* fileName, const uint16_t palette = 0, const uint16_t extraRegions = 0) :
+            texture(-1), regions(nullptr), regionCount(0), maxRegions(0), shelfCount(0), usedArea(0)
+        {
+            SRL::Cd::File file = SRL::Cd::File(fileName);
+
+            if (!file.Exists())
+            {
+                SRL::Debug::Assert("Atlas '%s' not found", fileName);
+                return;
+            }
+
+            uint8_t* data = new uint8_t[file.Size.Bytes];
+            file.LoadBytes(0, file.Size.Bytes, data);
+            this->Map((const Header*)data, palette, extraRegions);
+            delete[] data;
+        }
+
+        /** @brief Load atlas already loaded in memory
+         * @param data Atlas file data (must be 4 byte aligned), can be freed after the atlas was created
+         * @param palette Palette identifier (not used in RGB555 mode)
+         * @param extraRegions Number of images that can be added to the atlas after it was loaded
+         */
+        TextureAtlas(const void* data, const uint16_t palette = 0, const uint16_t extraRegions = 0) :
+            texture(-1), regions(nullptr), regionCount(0), maxRegions(0), shelfCount(0), usedArea(0)
+        {
+            this->Map((const Header*)data, palette, extraRegions);
+        }
+
+        /** @brief Destroy the atlas, texture must be freed separately
+         */
+        ~TextureAtlas()
+        {
+            delete[] this->regions;
+        }
+
+        /** @brief Get a value indicating whether atlas texture was allocated
+         * @return True if atlas can be used
+         */
+        bool IsLoaded() const
+        {
+            return this->texture >= 0;
+        }
+
+        /** @brief Get index of the atlas texture
+         * @return Texture index or -1 if atlas was not allocated
+         */
+        int32_t GetTexture() const
+        {
+            return this->texture;
+        }
+
+        /** @brief Get number of images in the atlas
+         * @return Number of regions
+         */
+        uint16_t GetRegionCount() const
+        {
+            return this->regionCount;
+        }
+
+        /** @brief Get image placement
+         * @param index Region index
+         * @return Image placement
+         */
+        const Region& GetRegion(const uint16_t index) const
+        {
+            return this->regions[index];
+        }
+
+        /** @brief Get area covered by images
+         * @return Number of used pixels, padding excluded
+         */
+        uint32_t GetUsedArea() const
+        {
+            return this->usedArea;
+        }
+
+        /** @brief Remove all images, atlas texture stays allocated
+         */
+        void Clear()
+        {
+            this->regionCount = 0;
+            this->shelfCount = 0;
+            this->usedArea = 0;
+        }
+
+        /** @brief Add image to the atlas
+         * @param width Image width (multiple of 2 in 8bpp modes, multiple of 4 in 4bpp mode)
+         * @param height Image height
+         * @param data Image data in color mode of the atlas (must be 2 byte aligned)
+         * @return Region index or -1 if image does not fit
+         */
+        int32_t Add(const uint16_t width, const uint16_t height, const void* data)
+        {
+            if (this->texture < 0 || this->regionCount >= this->maxRegions)
+            {
+                return -1;
+            }
+
+            // Row of the image must be whole number of 16-bit words
+            const uint8_t shifter = SRL::VDP1::GetSizeShifter(SRL::VDP1::Metadata[this->texture].ColorMode);
+
+            if (((width << 2) & ((2 << shifter) - 1)) != 0)
+            {
+                SRL::Debug::Assert("Atlas image width %d is not supported", width);
+                return -1;
+            }
+
+            Region& region = this->regions[this->regionCount];
+            const uint16_t alignedWidth = (width + (TextureAtlas::PositionAlignment - 1)) & ~(TextureAtlas::PositionAlignment - 1);
+
+            if (!this->Place(alignedWidth, height, region))
+            {
+                return -1;
+            }
+
+            region.Width = width;
+            region.Height = height;
+
+            // Row stride of the atlas differs from the image width, so image is copied row by row
+            const size_t rowWords = this->GetByteCount(width) >> 1;
+            const size_t strideWords = this->GetByteCount(SRL::VDP1::Textures[this->texture].Width) >> 1;
+            const uint16_t* source = (const uint16_t*)data;
+            uint16_t* target = ((uint16_t*)SRL::VDP1::Textures[this->texture].GetData()) + (region.Y * strideWords) + (this->GetByteCount(region.X) >> 1);
+
+            for (uint16_t row = 0; row < height; row++)
+            {
+                for (size_t word = 0; word < rowWords; word++)
+                {
+                    target[word] = source[word];
+                }
+
+                source += rowWords;
+                target += strideWords;
+            }
+
+            this->usedArea += width * height;
+            return this->regionCount++;
+        }
+
+        /** @brief Add image to the atlas
+         * @param bitmap Image in color mode of the atlas
+         * @return Region index or -1 if image does not fit
+         */
+        int32_t Add(SRL::Bitmap::IBitmap* bitmap)
+        {
+            const SRL::Bitmap::BitmapInfo info = bitmap->GetInfo();
+
+            if (this->texture < 0 || info.ColorMode != SRL::VDP1::Metadata[this->texture].ColorMode)
+            {
+                SRL::Debug::Assert("Atlas image color mode does not match");
+                return -1;
+            }
+
+            return this->Add(info.Width, info.Height, bitmap->GetData());
+        }
+
+        /** @brief Draw image from the atlas
+         * @details Current sprite effects are applied, except for flip and clipping.
+         * Image not spanning whole atlas width changes user clipping rectangle, which is then used by all later sprites with SRL::Scene2D::ClippingEffect enabled,
+         * unless clipping stack (see SRL::Scene2D::PushClippingRectangle()) is in use, then image rectangle is limited to the stack rectangle and the stack rectangle is written again after the image.
+         * @param region Region index
+         * @param location Center of the image in screen coordinates, Z is depth sort value
+         * @param scale Image scale
+         * @return True on success
+         */
+        bool Draw(const uint16_t region, const SRL::Math::Types::Vector3D& location, const SRL::Math::Types::Fxp& scale = 1.0)
+        {
+            const Region& area = this->regions[region];
+            const VDP1::Texture& atlas = SRL::VDP1::Textures[this->texture];
+            const int32_t factor = scale.RawValue() >> 8;
+            const int32_t width = (area.Width * factor) >> 8;
+            const int32_t height = (area.Height * factor) >> 8;
+
+            if (width <= 0 || height <= 0)
+            {
+                return false;
+            }
+
+            const int32_t left = location.X.As<int16_t>() - (width >> 1);
+            const int32_t top = location.Y.As<int16_t>() - (height >> 1);
+            const int32_t stripLeft = left - ((area.X * factor) >> 8);
+            const int32_t stripWidth = (atlas.Width * factor) >> 8;
+            const bool clipped = area.X != 0 || area.Width != atlas.Width;
+
+            if (Scene2D::TestClipping(
+                SRL::Math::Types::Vector2D((int16_t)left, (int16_t)top),
+                SRL::Math::Types::Vector2D((int16_t)(left + width - 1), (int16_t)(top + height - 1))) == Scene2D::ClipTest::Hidden)
+            {
+                return true;
+            }
+
+            if (clipped)
+            {
+                // Clipping rectangle is in screen coordinates, where top left corner of the screen is (0,0)
+                int32_t clipLeft = left + (SRL::TV::Width >> 1);
+                int32_t clipTop = top + (SRL::TV::Height >> 1);
+                int32_t clipRight = clipLeft + width - 1;
+                int32_t clipBottom = clipTop + height - 1;
+                SRL::Math::Types::Vector2D windowTopLeft;
+                SRL::Math::Types::Vector2D windowBottomRight;
+
+                // Image rectangle replaces the stack rectangle for this draw, so it must not reach outside of it
+                if (Scene2D::GetClippingRectangle(windowTopLeft, windowBottomRight))
+                {
+                    clipLeft = SRL::Math::Max(clipLeft, (int32_t)windowTopLeft.X.As<int16_t>());
+                    clipTop = SRL::Math::Max(clipTop, (int32_t)windowTopLeft.Y.As<int16_t>());
+                    clipRight = SRL::Math::Min(clipRight, (int32_t)windowBottomRight.X.As<int16_t>());
+                    clipBottom = SRL::Math::Min(clipBottom, (int32_t)windowBottomRight.Y.As<int16_t>());
+
+                    if (clipLeft > clipRight || clipTop > clipBottom)
+                    {
+                        return true;
+                    }
+                }
+
+                const SRL::Math::Types::Vector3D corner((int16_t)clipLeft, (int16_t)clipTop, location.Z);
+
+                if (!Scene2D::SetClippingRectangle(corner, SRL::Math::Types::Vector2D((int16_t)(clipRight - clipLeft), (int16_t)(clipBottom - clipTop))))
+                {
+                    return false;
+                }
+            }
+
+            const SPR_ATTR attribute = Scene2D::GetSpriteAttribute(this->texture, nullptr);
+            SPRITE command = Scene2D::GetSpriteCommand(Scene2D::CommandType::RectangleSprite, Types::HighColor());
+            command.CTRL = (uint16_t)Scene2D::CommandType::RectangleSprite;
+            command.PMOD = (attribute.atrb & ~(3 << 9)) | (clipped ? (Scene2D::ClippingEffect::ClipOutside << 9) : 0);
+            command.COLR = attribute.colno;
+            command.GRDA = attribute.gstb;
+
+            // Strip of full atlas width starts at the first row of the image
+            command.SRCA = atlas.Address + (this->GetByteCount(area.Y * atlas.Width) >> 3);
+            command.SIZE = (atlas.Size & 0x3f00) | area.Height;
+            command.XA = stripLeft;
+            command.YA = top;
+            command.XC = stripLeft + stripWidth - 1;
+            command.YC = top + height - 1;
+
+            if (!Scene2D::Draw(&command, location.Z))
+            {
+                return false;
+            }
+
+            // Atlas image replaced user clipping rectangle, put back the one from clipping stack
+            return !clipped || Scene2D::RestoreClippingRectangle(location.Z);
+        }
+    };
+}
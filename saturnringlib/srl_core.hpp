@@ -9,6 +9,7 @@
 #include "srl_vdp2.hpp"
 #include "srl_input.hpp"
 #include "srl_slave.hpp"
+#include "srl_governor.hpp"
 #include "srl_scene3d.hpp"
 
 #if SRL_USE_SGL_SOUND_DRIVER == 1
@@ -49,12 +50,20 @@ namespace SRL
 
     private:
 
+        /** @brief Number of v-blanks since start
+         */
+        inline static volatile uint32_t vblankCount = 0;
+
         /** @brief Handle V-Blank events
          */
         inline static void VblankHandling()
         {
+            Core::vblankCount++;
             slGetStatus();
             SRL::Input::Gun::VblankRefresh();
+            SRL::VDP2::RBG0::VblankRefresh();
+            SRL::VDP1::Stats::Poll();
+            SRL::Governor::Vblank();
             Core::OnVblank.Invoke();
         }
         
@@ -95,6 +104,7 @@ namespace SRL
 
             // Initialize VDP2
             VDP2::Initialize(backColor);
+            VDP2::Shadow::Flush();
 #ifndef SRL_HIGH_RES
             // Set window size to 512 (this allows us to have VDP1 render outside of the visible area)
             *(uint16_t*)(SpriteVRAM+20)=511;
@@ -111,13 +121,26 @@ namespace SRL
             SRL::TV::TVOn();
         }
 
+        /** @brief Get number of v-blanks since start
+         * @return V-blank count, wraps around after 2^32 v-blanks
+         */
+        inline static uint32_t GetVblankCount()
+        {
+            return Core::vblankCount;
+        }
+
         /** @brief Wait until graphic processing time is reached
          *  @note Graphic processing time is set by 'SRL_FRAMERATE' in makefile
          */
         inline static void Synchronize()
         {
             Core::OnBeforeSync.Invoke();
+            SRL::VDP2::Shadow::Flush();
+            SRL::VDP1::Stats::Poll();
+            SRL::Governor::BeforeSync();
             slSynch();
+            SRL::VDP1::Stats::AfterSync();
+            SRL::Governor::AfterSync();
             SRL::Input::Management::RefreshPeripherals();
             SRL::Input::Gun::Synchronize();
             Core::OnAfterSync.Invoke();
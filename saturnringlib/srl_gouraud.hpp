@@ -0,0 +1,758 @@
+#pragma once
+
+#include "srl_core.hpp"
+#include "srl_mesh.hpp"
+
+namespace SRL
+{
+    /** @brief Allocator of gouraud table entries in SRL::VDP1::GetGouraudTable()
+     * @details Each entry holds 4 colors, one for each corner of a sprite or polygon. Entry index is what SRL::Scene2D::SetEffect() with SRL::Scene2D::SpriteEffect::Gouraud,
+     * emitters of SRL::Particles and gouraud offsets of SRL::Scene3D expect, face attributes of a mesh use 0xe000 + entry.
+     * Shared entries are reference counted and deduplicated, allocating a table with the same colors as an existing one returns the existing entry.
+     * Blocks of entries for SGL light or depth tables and for SRL::Types::GouraudLightCache meshes are reserved with SRL::GouraudTable::Reserve().
+     * Dynamic entries live only for a single frame and come from two alternating buffers, so entries written for the next frame never overwrite entries VDP1 is still drawing with.
+     * @code {.cpp}
+     * const SRL::Types::HighColor fade[4] = { HighColor::Colors::Red, HighColor::Colors::Red, HighColor::Colors::Blue, HighColor::Colors::Blue };
+     * int16_t entry = SRL::GouraudTable::Allocate(fade);
+     *
+     * // In game loop
+     * SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Gouraud, entry);
+     * SRL::Scene2D::DrawSprite(texture, location);
+     *
+     * // Colors computed this frame
+     * SRL::Scene2D::SetEffect(SRL::Scene2D::SpriteEffect::Gouraud, SRL::GouraudTable::AllocateDynamic(flash));
+     * SRL::Scene2D::DrawSprite(texture, otherLocation);
+     *
+     * // When no longer needed
+     * SRL::GouraudTable::Release(entry);
+     * @endcode
+     */
+    class GouraudTable
+    {
+        /** @brief Disable constructor
+         */
+        GouraudTable() = delete;
+
+        /** @brief Disable destructor
+         */
+        ~GouraudTable() = delete;
+
+    public:
+
+        /** @brief Number of entries managed by the allocator
+         */
+        static constexpr uint16_t EntryCount = 1024;
+
+        /** @brief Number of dynamic entries available each frame
+         */
+        static constexpr uint16_t DynamicCount = 128;
+
+        /** @brief Number of shared and reserved entries, dynamic entries follow them
+         */
+        static constexpr uint16_t StaticCount = GouraudTable::EntryCount - (GouraudTable::DynamicCount << 1);
+
+        /** @brief Returned when there is no free entry
+         */
+        static constexpr int16_t Invalid = -1;
+
+    private:
+
+        /** @brief Number of hash buckets (must be power of 2)
+         */
+        static constexpr uint16_t BucketCount = 2048;
+
+        /** @brief Bucket holding no entry
+         */
+        static constexpr uint16_t EmptyBucket = 0;
+
+        /** @brief Bucket whose entry was freed, lookup continues past it
+         */
+        static constexpr uint16_t DeletedBucket = 0xffff;
+
+        /** @brief Reference count flag of entries reserved in a block, which are not deduplicated
+         */
+        static constexpr uint16_t ReservedFlag = 0x8000;
+
+        /** @brief Reference count of each entry, 0 is free
+         */
+        inline static uint16_t references[GouraudTable::StaticCount];
+
+        /** @brief Hash of colors of each shared entry
+         */
+        inline static uint32_t hashes[GouraudTable::StaticCount];
+
+        /** @brief Hash buckets holding entry + 1
+         */
+        inline static uint16_t buckets[GouraudTable::BucketCount];
+
+        /** @brief Entry where search for a free entry starts
+         */
+        inline static uint16_t searchStart = 0;
+
+        /** @brief Number of free entries
+         */
+        inline static uint16_t freeCount = GouraudTable::StaticCount;
+
+        /** @brief Dynamic buffer used for the frame being built
+         */
+        inline static uint8_t dynamicBuffer = 0;
+
+        /** @brief Number of dynamic entries used in the frame being built
+         */
+        inline static uint16_t dynamicUsed = 0;
+
+        /** @brief Value indicating whether buffer swap is hooked to SRL::Core::Synchronize()
+         */
+        inline static bool swapHooked = false;
+
+        /** @brief Hash 4 colors
+         * @param colors Colors of the entry
+         * @return Hash value
+         */
+        inline static uint32_t Hash(const Types::HighColor colors[4])
+        {
+            const uint32_t* words = (const uint32_t*)colors;
+            uint32_t hash = words[0] * 0x9e3779b1;
+            hash ^= words[1] + 0x7f4a7c15 + (hash << 6) + (hash >> 2);
+            return hash ^ (hash >> 15);
+        }
+
+        /** @brief Compare colors of an entry
+         * @param entry Entry index
+         * @param colors Colors to compare with
+         * @return True if entry holds the same colors
+         */
+        inline static bool Equals(const uint16_t entry, const Types::HighColor colors[4])
+        {
+            const uint32_t* words = (const uint32_t*)colors;
+            const uint32_t* stored = (const uint32_t*)GouraudTable::GetEntry(entry);
+            return stored[0] == words[0] && stored[1] == words[1];
+        }
+
+        /** @brief Write colors of an entry into VRAM
+         * @param entry Entry index
+         * @param colors Colors of the entry
+         */
+        inline static void Write(const uint16_t entry, const Types::HighColor colors[4])
+        {
+            // Entry is 4 colors, so it is written as two 32-bit words
+            const uint32_t* words = (const uint32_t*)colors;
+            uint32_t* target = (uint32_t*)GouraudTable::GetEntry(entry);
+            target[0] = words[0];
+            target[1] = words[1];
+        }
+
+        /** @brief Find a free entry
+         * @return Entry index or SRL::GouraudTable::Invalid
+         */
+        inline static int16_t FindFree()
+        {
+            for (uint16_t step = 0; step < GouraudTable::StaticCount; step++)
+            {
+                const uint16_t entry = (GouraudTable::searchStart + step) % GouraudTable::StaticCount;
+
+                if (GouraudTable::references[entry] == 0)
+                {
+                    GouraudTable::searchStart = entry + 1;
+                    return entry;
+                }
+            }
+
+            return GouraudTable::Invalid;
+        }
+
+        /** @brief Swap dynamic buffers, called by SRL::Core::Synchronize()
+         */
+        inline static void Swap()
+        {
+            GouraudTable::dynamicBuffer ^= 1;
+            GouraudTable::dynamicUsed = 0;
+        }
+
+    public:
+
+        /** @name Shared entries
+         * @{
+         */
+
+        /** @brief Allocate entry with given colors
+         * @details If an entry with the same colors already exists, its reference count is increased and it is returned instead.
+         * @param colors Colors of the entry
+         * @return Entry index or SRL::GouraudTable::Invalid if table is full
+         */
+        inline static int16_t Allocate(const Types::HighColor colors[4])
+        {
+            const uint32_t hash = GouraudTable::Hash(colors);
+            int32_t insert = -1;
+
+            for (uint16_t probe = 0; probe < GouraudTable::BucketCount; probe++)
+            {
+                const uint16_t bucket = (hash + probe) & (GouraudTable::BucketCount - 1);
+                const uint16_t stored = GouraudTable::buckets[bucket];
+
+                if (stored == GouraudTable::EmptyBucket)
+                {
+                    insert = insert < 0 ? bucket : insert;
+                    break;
+                }
+                else if (stored == GouraudTable::DeletedBucket)
+                {
+                    insert = insert < 0 ? bucket : insert;
+                }
+                else if (GouraudTable::hashes[stored - 1] == hash && GouraudTable::Equals(stored - 1, colors))
+                {
+                    GouraudTable::references[stored - 1]++;
+                    return stored - 1;
+                }
+            }
+
+            const int16_t entry = GouraudTable::FindFree();
+
+            if (entry < 0 || insert < 0)
+            {
+                return GouraudTable::Invalid;
+            }
+
+            GouraudTable::Write(entry, colors);
+            GouraudTable::references[entry] = 1;
+            GouraudTable::hashes[entry] = hash;
+            GouraudTable::buckets[insert] = entry + 1;
+            GouraudTable::freeCount--;
+            return entry;
+        }
+
+        /** @brief Add reference to an allocated entry
+         * @param entry Entry index
+         */
+        inline static void AddReference(const int16_t entry)
+        {
+            if (entry >= 0 && entry < GouraudTable::StaticCount && GouraudTable::references[entry] != 0 &&
+                (GouraudTable::references[entry] & GouraudTable::ReservedFlag) == 0)
+            {
+                GouraudTable::references[entry]++;
+            }
+        }
+
+        /** @brief Release reference to an allocated entry, entry is freed with its last reference
+         * @param entry Entry index
+         */
+        inline static void Release(const int16_t entry)
+        {
+            if (entry < 0 || entry >= GouraudTable::StaticCount || GouraudTable::references[entry] == 0 ||
+                (GouraudTable::references[entry] & GouraudTable::ReservedFlag) != 0 ||
+                --GouraudTable::references[entry] != 0)
+            {
+                return;
+            }
+
+            // Remove entry from its hash chain, so lookups of other entries still pass over it
+            for (uint16_t probe = 0; probe < GouraudTable::BucketCount; probe++)
+            {
+                const uint16_t bucket = (GouraudTable::hashes[entry] + probe) & (GouraudTable::BucketCount - 1);
+
+                if (GouraudTable::buckets[bucket] == entry + 1)
+                {
+                    GouraudTable::buckets[bucket] = GouraudTable::DeletedBucket;
+                    break;
+                }
+            }
+
+            GouraudTable::freeCount++;
+        }
+
+        /** @brief Get reference count of an entry
+         * @param entry Entry index
+         * @return Number of references, 0 if entry is free, 1 for reserved entries
+         */
+        inline static uint16_t GetReferenceCount(const int16_t entry)
+        {
+            if (entry < 0 || entry >= GouraudTable::StaticCount)
+            {
+                return 0;
+            }
+
+            return GouraudTable::references[entry] & ~GouraudTable::ReservedFlag;
+        }
+
+        /** @} */
+
+        /** @name Reserved blocks
+         * @{
+         */
+
+        /** @brief Reserve block of consecutive entries
+         * @details Block is not deduplicated, its entries can be written freely, e.g. by SGL light and depth tables or by SRL::Types::GouraudLightCache.
+         * SRL::Scene3D gouraud offsets count in groups of 4 entries, blocks for them are reserved with alignment of 4 and their first entry is divided by 4.
+         * @param count Number of entries
+         * @param alignment First entry of the block is multiple of this value
+         * @return First entry of the block or SRL::GouraudTable::Invalid if there is no free block large enough
+         */
+        inline static int16_t Reserve(const uint16_t count, const uint16_t alignment = 1)
+        {
+            uint16_t run = 0;
+
+            for (uint16_t entry = 0; entry < GouraudTable::StaticCount && count > 0; entry++)
+            {
+                // Block can start only on aligned entry
+                run = GouraudTable::references[entry] == 0 && (run > 0 || alignment <= 1 || entry % alignment == 0) ? run + 1 : 0;
+
+                if (run == count)
+                {
+                    const uint16_t first = (entry + 1) - count;
+
+                    for (uint16_t reserved = first; reserved <= entry; reserved++)
+                    {
+                        GouraudTable::references[reserved] = GouraudTable::ReservedFlag | 1;
+                    }
+
+                    GouraudTable::freeCount -= count;
+                    return first;
+                }
+            }
+
+            return GouraudTable::Invalid;
+        }
+
+        /** @brief Free block of entries reserved by SRL::GouraudTable::Reserve()
+         * @param first First entry of the block
+         * @param count Number of entries
+         */
+        inline static void Free(const int16_t first, const uint16_t count)
+        {
+            for (int32_t entry = first; entry >= 0 && entry < first + count && entry < GouraudTable::StaticCount; entry++)
+            {
+                if ((GouraudTable::references[entry] & GouraudTable::ReservedFlag) != 0)
+                {
+                    GouraudTable::references[entry] = 0;
+                    GouraudTable::freeCount++;
+                }
+            }
+        }
+
+        /** @} */
+
+        /** @name Dynamic entries
+         * @{
+         */
+
+        /** @brief Allocate entry valid only for the frame being built
+         * @details Dynamic entries are returned on the next SRL::Core::Synchronize(), they do not need to be released.
+         * @param colors Colors of the entry
+         * @return Entry index or SRL::GouraudTable::Invalid if all dynamic entries of this frame are used
+         */
+        inline static int16_t AllocateDynamic(const Types::HighColor colors[4])
+        {
+            if (!GouraudTable::swapHooked)
+            {
+                SRL::Core::OnAfterSync += GouraudTable::Swap;
+                GouraudTable::swapHooked = true;
+            }
+
+            if (GouraudTable::dynamicUsed >= GouraudTable::DynamicCount)
+            {
+                return GouraudTable::Invalid;
+            }
+
+            const uint16_t entry = GouraudTable::StaticCount + (GouraudTable::dynamicBuffer * GouraudTable::DynamicCount) + GouraudTable::dynamicUsed++;
+            GouraudTable::Write(entry, colors);
+            return entry;
+        }
+
+        /** @brief Get number of dynamic entries used in the frame being built
+         * @return Used dynamic entry count
+         */
+        inline static uint16_t GetDynamicCount()
+        {
+            return GouraudTable::dynamicUsed;
+        }
+
+        /** @} */
+
+        /** @brief Get number of free shared entries
+         * @return Free entry count
+         */
+        inline static uint16_t GetFreeCount()
+        {
+            return GouraudTable::freeCount;
+        }
+
+        /** @brief Get colors of an entry
+         * @param entry Entry index
+         * @return Pointer to the 4 colors of the entry in VRAM
+         */
+        inline static Types::HighColor* GetEntry(const uint16_t entry)
+        {
+            return SRL::VDP1::GetGouraudTable() + (entry << 2);
+        }
+    };
+}
+
+namespace SRL::Types
+{
+    /** @brief Cached gouraud light of a smooth mesh
+     * @details SRL::Scene3D::DrawSmoothMesh() evaluates light of every vertex each frame, even if neither light nor the mesh orientation changed.
+     * This cache evaluates vertex light only when light direction in the mesh space changes, keeps result in a RAM copy of the mesh gouraud table entries
+     * and copies only entries that actually changed to VDP1 VRAM during v-blank. Recalculation can be spread over multiple frames.
+     * Mesh is then drawn as a flat mesh with gouraud tables, so no light is evaluated while drawing.
+     * @note Faces with SRL::Types::Attribute::DisplayOption::EnableGouraud option set must each point to a gouraud table entry in SRL::VDP1::GetGouraudTable()
+     * @code {.cpp}
+     * SRL::Types::GouraudLightCache cache(mesh, shadingTable);
+     *
+     * // In game loop
+     * SRL::Scene3D::PushMatrix();
+     * {
+     *     SRL::Scene3D::RotateY(rotation);
+     *     cache.SetLightFromMatrix(light);
+     *     cache.Update(100);
+     *     cache.Draw();
+     * }
+     * SRL::Scene3D::PopMatrix();
+     * @endcode
+     */
+    class GouraudLightCache
+    {
+    private:
+
+        /** @brief Number of low bits of light direction ignored when comparing with cached light
+         */
+        static constexpr uint8_t KeyShift = 8;
+
+        /** @brief Lit mesh
+         */
+        SmoothMesh* mesh;
+
+        /** @brief Light shading table from darkest to brightest color
+         */
+        HighColor table[32];
+
+        /** @brief RAM copy of the gouraud table entries used by the mesh
+         */
+        HighColor* shadow;
+
+        /** @brief Bit mask of faces switched to gouraud color calculation by the cache, restored when cache is destroyed
+         */
+        uint8_t* switched;
+
+        /** @brief First gouraud table entry used by the mesh
+         */
+        uint16_t firstEntry;
+
+        /** @brief Number of gouraud table entries used by the mesh
+         */
+        uint16_t entryCount;
+
+        /** @brief Light direction in mesh space
+         */
+        SRL::Math::Types::Vector3D light;
+
+        /** @brief Index of the next face to recalculate
+         */
+        size_t cursor;
+
+        /** @brief Value indicating whether some faces still need to be recalculated
+         */
+        bool pending;
+
+        /** @brief First changed entry not yet copied into VRAM
+         * @details Range is widened by Update() with interrupts masked, and copied and reset by CopyToVRAM() from v-blank interrupt,
+         * so the copy always sees a consistent range and never drops entries widened during it.
+         */
+        volatile uint16_t dirtyFirst;
+
+        /** @brief Entry after the last changed entry not yet copied into VRAM
+         */
+        volatile uint16_t dirtyEnd;
+
+        /** @brief V-blank copy proxy
+         */
+        MemberProxy<> vblank = MemberProxy<>(this, &GouraudLightCache::CopyToVRAM);
+
+        /** @brief Check whether face uses gouraud table
+         * @param attribute Face attribute
+         * @return True if face is lit by the cache
+         */
+        static bool IsLit(const Attribute& attribute)
+        {
+            return (attribute.Sort & UseGouraud) != 0 && attribute.Gouraud >= 0xe000;
+        }
+
+        /** @brief Add entry to the range copied during next v-blank
+         * @details V-blank interrupt is masked, so CopyToVRAM() cannot reset the range between its read and write.
+         * @param entry Changed entry
+         */
+        void MarkDirty(const uint16_t entry)
+        {
+            const uint32_t mask = get_imask();
+            set_imask(15);
+
+            if (this->dirtyFirst == this->dirtyEnd)
+            {
+                this->dirtyFirst = entry;
+                this->dirtyEnd = entry + 1;
+            }
+            else
+            {
+                this->dirtyFirst = SRL::Math::Min((uint16_t)this->dirtyFirst, entry);
+                this->dirtyEnd = SRL::Math::Max((uint16_t)this->dirtyEnd, (uint16_t)(entry + 1));
+            }
+
+            set_imask(mask);
+        }
+
+        /** @brief Evaluate light of a single vertex
+         * @param normal Vertex normal
+         * @return Color from the shading table
+         */
+        HighColor Evaluate(const SRL::Math::Types::Vector3D& normal) const
+        {
+            const int32_t* n = (const int32_t*)&normal;
+            const int32_t* l = (const int32_t*)&this->light;
+            const int64_t dot = ((int64_t)n[0] * l[0]) + ((int64_t)n[1] * l[1]) + ((int64_t)n[2] * l[2]);
+
+            if (dot <= 0)
+            {
+                return this->table[0];
+            }
+
+            return this->table[SRL::Math::Min((int32_t)((dot * 31) >> 32), (int32_t)31)];
+        }
+
+    public:
+
+        /** @brief Construct light cache for a smooth mesh
+         * @details Faces lit by the cache are switched to use gouraud table when drawn as flat mesh.
+         * Their original color calculation mode is restored when the cache is destroyed.
+         * @param mesh Mesh to light, must outlive the cache
+         * @param table Light shading table, must contain 32 color entries from the darkest color to the brightest
+         */
+        GouraudLightCache(SmoothMesh& mesh, const HighColor table[32]) :
+            mesh(&mesh),
+            shadow(nullptr),
+            switched(new uint8_t[(mesh.FaceCount + 7) >> 3]()),
+            firstEntry(0xffff),
+            entryCount(0),
+            light(),
+            cursor(0),
+            pending(false),
+            dirtyFirst(0),
+            dirtyEnd(0)
+        {
+            for (uint8_t color = 0; color < 32; color++)
+            {
+                this->table[color] = table[color];
+            }
+
+            // Find range of the gouraud table used by the mesh
+            uint16_t lastEntry = 0;
+
+            for (size_t face = 0; face < mesh.FaceCount; face++)
+            {
+                Attribute& attribute = mesh.Attributes[face];
+
+                if (GouraudLightCache::IsLit(attribute))
+                {
+                    uint16_t entry = attribute.Gouraud - 0xe000;
+                    this->firstEntry = SRL::Math::Min(this->firstEntry, entry);
+                    lastEntry = SRL::Math::Max(lastEntry, entry);
+
+                    if ((attribute.Display & CL_Gouraud) == 0)
+                    {
+                        this->switched[face >> 3] |= 1 << (face & 7);
+                        attribute.Display |= CL_Gouraud;
+                    }
+                }
+            }
+
+            if (this->firstEntry <= lastEntry)
+            {
+                this->entryCount = (lastEntry - this->firstEntry) + 1;
+                this->shadow = new HighColor[this->entryCount << 2];
+
+                for (uint32_t color = 0; color < (uint32_t)(this->entryCount << 2); color++)
+                {
+                    this->shadow[color] = this->table[0];
+                }
+            }
+
+            SRL::Core::OnVblank += &this->vblank;
+        }
+
+        /** @brief Disable copy constructor
+         */
+        GouraudLightCache(const GouraudLightCache&) = delete;
+
+        /** @brief Disable assignment operator
+         */
+        GouraudLightCache& operator=(const GouraudLightCache&) = delete;
+
+        /** @brief Destroy the light cache
+         */
+        ~GouraudLightCache()
+        {
+            SRL::Core::OnVblank -= &this->vblank;
+
+            for (size_t face = 0; face < this->mesh->FaceCount; face++)
+            {
+                if ((this->switched[face >> 3] & (1 << (face & 7))) != 0)
+                {
+                    this->mesh->Attributes[face].Display &= ~CL_Gouraud;
+                }
+            }
+
+            delete[] this->switched;
+            delete[] this->shadow;
+        }
+
+        /** @brief Set light direction
+         * @details Light is recalculated only if direction differs from the cached one.
+         * @param direction Light direction unit vector in mesh space
+         * @return True if cached light is no longer valid
+         */
+        bool SetLight(const SRL::Math::Types::Vector3D& direction)
+        {
+            const int32_t* current = (const int32_t*)&this->light;
+            const int32_t* next = (const int32_t*)&direction;
+
+            if ((current[0] >> GouraudLightCache::KeyShift) == (next[0] >> GouraudLightCache::KeyShift) &&
+                (current[1] >> GouraudLightCache::KeyShift) == (next[1] >> GouraudLightCache::KeyShift) &&
+                (current[2] >> GouraudLightCache::KeyShift) == (next[2] >> GouraudLightCache::KeyShift) &&
+                this->entryCount > 0 && (this->pending || this->cursor > 0))
+            {
+                return false;
+            }
+
+            // Restart recalculation with new light
+            this->light = direction;
+            this->cursor = 0;
+            this->pending = true;
+            return true;
+        }
+
+        /** @brief Set light direction from the direction in the space current matrix transforms into
+         * @details Direction is transformed into mesh space by transposed rotation of the current matrix.
+         * @note Current matrix must not contain scale
+         * @param direction Light direction unit vector
+         * @return True if cached light is no longer valid
+         */
+        bool SetLightFromMatrix(const SRL::Math::Types::Vector3D& direction)
+        {
+            SRL::Math::Matrix43 matrix;
+            SRL::Scene3D::GetMatrix(&matrix);
+
+            const int32_t* rows = (const int32_t*)&matrix;
+            const int32_t* d = (const int32_t*)&direction;
+            int32_t local[3];
+
+            for (uint8_t column = 0; column < 3; column++)
+            {
+                local[column] = (int32_t)((((int64_t)rows[column] * d[0]) + ((int64_t)rows[3 + column] * d[1]) + ((int64_t)rows[6 + column] * d[2])) >> 16);
+            }
+
+            return this->SetLight(*(SRL::Math::Types::Vector3D*)local);
+        }
+
+        /** @brief Recalculate light of faces affected by light change
+         * @param budget Maximal number of faces to recalculate in this call, rest is processed on next calls
+         * @return Number of recalculated faces
+         */
+        size_t Update(const size_t budget = SIZE_MAX)
+        {
+            if (!this->pending)
+            {
+                return 0;
+            }
+
+            const size_t end = SRL::Math::Min(this->mesh->FaceCount, this->cursor + SRL::Math::Min(budget, this->mesh->FaceCount));
+            size_t processed = 0;
+
+            for (; this->cursor < end; this->cursor++)
+            {
+                const Attribute& attribute = this->mesh->Attributes[this->cursor];
+
+                if (!GouraudLightCache::IsLit(attribute))
+                {
+                    continue;
+                }
+
+                const uint16_t entry = (attribute.Gouraud - 0xe000) - this->firstEntry;
+                const uint16_t* vertices = this->mesh->Faces[this->cursor].Vertices;
+                HighColor* colors = this->shadow + (entry << 2);
+                bool changed = false;
+
+                for (uint8_t vertex = 0; vertex < 4; vertex++)
+                {
+                    HighColor color = this->Evaluate(this->mesh->Normals[vertices[vertex]]);
+
+                    if (*(uint16_t*)&colors[vertex] != *(uint16_t*)&color)
+                    {
+                        colors[vertex] = color;
+                        changed = true;
+                    }
+                }
+
+                // Extend range to copy during next v-blank
+                if (changed)
+                {
+                    this->MarkDirty(entry);
+                }
+
+                processed++;
+            }
+
+            this->pending = this->cursor < this->mesh->FaceCount;
+            return processed;
+        }
+
+        /** @brief Copy changed gouraud table entries into VDP1 VRAM
+         * @note Called automatically every v-blank, calling it from the main loop requires interrupts to be masked
+         */
+        void CopyToVRAM()
+        {
+            const uint16_t first = this->dirtyFirst;
+            const uint16_t end = this->dirtyEnd;
+
+            if (first == end)
+            {
+                return;
+            }
+
+            // Each entry is 4 colors, so it is copied as two 32-bit words
+            const uint32_t* source = (const uint32_t*)(this->shadow + (first << 2));
+            uint32_t* target = (uint32_t*)(SRL::VDP1::GetGouraudTable() + ((this->firstEntry + first) << 2));
+
+            for (uint16_t word = 0; word < ((end - first) << 1); word++)
+            {
+                target[word] = source[word];
+            }
+
+            this->dirtyFirst = 0;
+            this->dirtyEnd = 0;
+        }
+
+        /** @brief Check whether light recalculation is still in progress
+         * @return True if some faces still wait for recalculation
+         */
+        bool IsPending() const
+        {
+            return this->pending;
+        }
+
+        /** @brief Draw the mesh with cached light
+         * @param slaveOnly Value indicates whether processing of the mesh should be handled only on the slave CPU
+         * @return True on success
+         */
+        bool Draw(const bool slaveOnly = false)
+        {
+            // Smooth mesh data starts with flat mesh data
+            PDATA* data = (PDATA*)this->mesh->SglPtr();
+
+            if (!(slaveOnly ? slPutPolygonS(data) : slPutPolygon(data)))
+            {
+                return false;
+            }
+
+            SRL::VDP1::Stats::Count(SRL::VDP1::Stats::Command::MeshFace, 0, this->mesh->FaceCount);
+            return true;
+        }
+    };
+}
@@ -0,0 +1,407 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_vdp1.hpp"
+
+namespace SRL
+{
+    /** @brief Adaptive load governor holding the target framerate
+     * @details Governor checks every frame after SRL::Core::Synchronize() whether VDP1 finished drawing the previous frame (see SRL::VDP1::Stats),
+     * whether synchronization waited longer than frame length set by 'SRL_FRAMERATE' and how long CPU worked on the frame (measured by free running timer).
+     * From these it keeps a quality scalar between SRL::Governor::GetMinQuality() and 1.0, which quickly drops when frame overruns and slowly recovers while there is headroom.
+     * Polygon and sprite budgets, level of detail distances, particle counts and culling distances can be scaled by the quality scalar to shed load before frames drop.
+     * Budgets are shared by the whole frame, every consumer draws only what is left after previous consumers and reports what it used, the used counts are reset after each synchronization.
+     * @note Governor must be enabled by SRL::Governor::Enable(), it is updated automatically from SRL::Core::Synchronize()
+     * @code {.cpp}
+     * SRL::Core::Initialize(SRL::Types::HighColor::Colors::Black);
+     * SRL::Governor::Enable();
+     *
+     * while (1)
+     * {
+     *     // Spawn fewer particles at lower quality, both draws share one sprite budget
+     *     emitter.MaxParticles = SRL::Governor::Scale(maxParticles);
+     *     particles.Draw(depth);
+     *     batch.Draw(depth);
+     *     SRL::Core::Synchronize();
+     * }
+     * @endcode
+     */
+    class Governor
+    {
+        /** @brief Disable constructor
+         */
+        Governor() = delete;
+
+        /** @brief Disable destructor
+         */
+        ~Governor() = delete;
+
+    private:
+
+        /** @brief Raw value of the quality step taken while frames are on time and there is headroom (1/64)
+         */
+        static constexpr int32_t RecoverStep = 0x0400;
+
+        /** @brief Number of frames quality is held after an overrun before it starts recovering
+         */
+        static constexpr uint8_t RecoverDelay = 30;
+
+        /** @brief Value indicating whether governor is enabled
+         */
+        inline static bool enabled = false;
+
+        /** @brief Current quality scalar
+         */
+        inline static SRL::Math::Types::Fxp quality = 1.0;
+
+        /** @brief Lowest allowed quality scalar
+         */
+        inline static SRL::Math::Types::Fxp minQuality = 0.25;
+
+        /** @brief CPU load above which quality is lowered even if frame was on time
+         */
+        inline static SRL::Math::Types::Fxp highLoad = 0.9375;
+
+        /** @brief CPU load under which quality is allowed to recover
+         */
+        inline static SRL::Math::Types::Fxp lowLoad = 0.75;
+
+        /** @brief Polygon count at quality 1.0
+         */
+        inline static uint16_t maxPolygons = SGL_MAX_POLYGONS;
+
+        /** @brief Sprite count at quality 1.0
+         */
+        inline static uint16_t maxSprites = SGL_MAX_POLYGONS;
+
+        /** @brief Polygons drawn since last synchronization
+         */
+        inline static uint32_t usedPolygons = 0;
+
+        /** @brief Sprites drawn since last synchronization
+         */
+        inline static uint32_t usedSprites = 0;
+
+        /** @brief Number of v-blanks since last synchronization
+         */
+        inline static volatile uint8_t vblanks = 0;
+
+        /** @brief Timer value at the end of last synchronization
+         */
+        inline static uint16_t frameStart = 0;
+
+        /** @brief Timer ticks spent by CPU on last frame
+         */
+        inline static uint16_t workTicks = 0;
+
+        /** @brief Moving average of timer ticks per v-blank in 12.4 fixed point
+         */
+        inline static uint32_t vblankTicks = 0;
+
+        /** @brief CPU load of the last frame
+         */
+        inline static SRL::Math::Types::Fxp load = 0.0;
+
+        /** @brief Frames left until quality starts recovering
+         */
+        inline static uint8_t holdFrames = 0;
+
+        /** @brief Number of frames where VDP1 did not finish drawing in time
+         */
+        inline static uint32_t vdp1Overruns = 0;
+
+        /** @brief Number of frames where synchronization missed the target frame
+         */
+        inline static uint32_t droppedFrames = 0;
+
+        /** @brief Read free running timer
+         * @return Timer ticks
+         */
+        inline static uint16_t ReadTimer()
+        {
+            return TIM_FRT_GET_16();
+        }
+
+    public:
+
+        /** @name Control
+         * @{
+         */
+
+        /** @brief Enable governor
+         * @details Enables SRL::VDP1::Stats, which switch free running timer of the master CPU to 1/128 clock, so a single frame fits into its 16-bit counter even at 20 FPS.
+         */
+        inline static void Enable()
+        {
+            SRL::VDP1::Stats::Enable();
+            Governor::frameStart = Governor::ReadTimer();
+            Governor::vblanks = 0;
+            Governor::vdp1Overruns = 0;
+            Governor::droppedFrames = 0;
+            Governor::enabled = true;
+        }
+
+        /** @brief Disable governor, quality is reset to 1.0
+         */
+        inline static void Disable()
+        {
+            Governor::enabled = false;
+            Governor::quality = 1.0;
+        }
+
+        /** @brief Check whether governor is enabled
+         * @return True if governor is enabled
+         */
+        inline static bool IsEnabled()
+        {
+            return Governor::enabled;
+        }
+
+        /** @brief Set lowest quality governor can drop to
+         * @param quality Lowest quality scalar between 0.0 and 1.0
+         */
+        inline static void SetMinQuality(const SRL::Math::Types::Fxp& quality)
+        {
+            Governor::minQuality = SRL::Math::Clamp(quality, SRL::Math::Types::Fxp(0.0), SRL::Math::Types::Fxp(1.0));
+            Governor::quality = SRL::Math::Max(Governor::quality, Governor::minQuality);
+        }
+
+        /** @brief Get lowest quality governor can drop to
+         * @return Lowest quality scalar
+         */
+        inline static SRL::Math::Types::Fxp GetMinQuality()
+        {
+            return Governor::minQuality;
+        }
+
+        /** @brief Set CPU load thresholds
+         * @param low Load under which quality recovers
+         * @param high Load above which quality drops
+         */
+        inline static void SetLoadThresholds(const SRL::Math::Types::Fxp& low, const SRL::Math::Types::Fxp& high)
+        {
+            Governor::lowLoad = low;
+            Governor::highLoad = high;
+        }
+
+        /** @brief Set polygon and sprite counts used at full quality
+         * @param polygons Polygon count at quality 1.0
+         * @param sprites Sprite count at quality 1.0
+         */
+        inline static void SetMaxBudget(const uint16_t polygons, const uint16_t sprites)
+        {
+            Governor::maxPolygons = polygons;
+            Governor::maxSprites = sprites;
+        }
+
+        /** @} */
+
+        /** @name Measurement
+         * @{
+         */
+
+        /** @brief Mark start of synchronization, called by SRL::Core::Synchronize()
+         */
+        inline static void BeforeSync()
+        {
+            if (Governor::enabled)
+            {
+                Governor::workTicks = Governor::ReadTimer() - Governor::frameStart;
+            }
+        }
+
+        /** @brief Count v-blank, called from v-blank interrupt
+         */
+        inline static void Vblank()
+        {
+            if (Governor::vblanks < 0xff)
+            {
+                Governor::vblanks++;
+            }
+        }
+
+        /** @brief Evaluate finished frame and update quality, called by SRL::Core::Synchronize()
+         * @details Polygon and sprite counts used by the finished frame are reset here.
+         */
+        inline static void AfterSync()
+        {
+            Governor::usedPolygons = 0;
+            Governor::usedSprites = 0;
+
+            if (!Governor::enabled)
+            {
+                return;
+            }
+
+            const uint16_t now = Governor::ReadTimer();
+            const uint16_t frameTicks = now - Governor::frameStart;
+            const uint8_t elapsed = Governor::vblanks;
+            const uint8_t target = SynchConst > 0 ? SynchConst : 1;
+            Governor::frameStart = now;
+            Governor::vblanks = 0;
+
+            if (elapsed == 0)
+            {
+                return;
+            }
+
+            // Track length of a single v-blank, so load does not depend on resolution or TV standard
+            const uint32_t ticks = ((uint32_t)frameTicks << 4) / elapsed;
+            Governor::vblankTicks = Governor::vblankTicks == 0 ? ticks : Governor::vblankTicks + ((int32_t)(ticks - Governor::vblankTicks) >> 3);
+
+            const uint32_t budgetTicks = (Governor::vblankTicks * target) >> 4;
+            Governor::load = budgetTicks > 0 ? SRL::Math::Types::Fxp::BuildRaw((int32_t)(((uint32_t)Governor::workTicks << 16) / budgetTicks)) : SRL::Math::Types::Fxp(0.0);
+
+            const bool vdp1Late = SRL::VDP1::Stats::IsEnabled() && SRL::VDP1::Stats::GetFrame().Overrun;
+            const bool frameLate = elapsed > target;
+
+            Governor::vdp1Overruns += vdp1Late ? 1 : 0;
+            Governor::droppedFrames += frameLate ? 1 : 0;
+
+            if (vdp1Late || frameLate || Governor::load > Governor::highLoad)
+            {
+                // Drop quickly, missed frames are much more visible than lower detail
+                Governor::quality = SRL::Math::Max(Governor::quality - (Governor::quality >> 3), Governor::minQuality);
+                Governor::holdFrames = Governor::RecoverDelay;
+            }
+            else if (Governor::holdFrames > 0)
+            {
+                Governor::holdFrames--;
+            }
+            else if (Governor::load < Governor::lowLoad)
+            {
+                Governor::quality = SRL::Math::Min(Governor::quality + SRL::Math::Types::Fxp::BuildRaw(Governor::RecoverStep), SRL::Math::Types::Fxp(1.0));
+            }
+        }
+
+        /** @} */
+
+        /** @name Budget
+         * @{
+         */
+
+        /** @brief Get current quality scalar
+         * @return Quality between SRL::Governor::GetMinQuality() and 1.0, always 1.0 while governor is disabled
+         */
+        inline static SRL::Math::Types::Fxp GetQuality()
+        {
+            return Governor::quality;
+        }
+
+        /** @brief Scale count by current quality
+         * @param count Count at full quality
+         * @return Scaled count
+         */
+        inline static uint32_t Scale(const uint32_t count)
+        {
+            return (uint32_t)(((uint64_t)count * Governor::quality.RawValue()) >> 16);
+        }
+
+        /** @brief Scale distance by current quality
+         * @param distance Distance at full quality
+         * @return Scaled distance
+         */
+        inline static SRL::Math::Types::Fxp Scale(const SRL::Math::Types::Fxp& distance)
+        {
+            return distance * Governor::quality;
+        }
+
+        /** @brief Get number of polygons that can be drawn this frame
+         * @return Polygon budget of the whole frame
+         */
+        inline static uint16_t GetPolygonBudget()
+        {
+            return (uint16_t)Governor::Scale((uint32_t)Governor::maxPolygons);
+        }
+
+        /** @brief Get number of sprites that can be drawn this frame
+         * @return Sprite budget of the whole frame
+         */
+        inline static uint16_t GetSpriteBudget()
+        {
+            return (uint16_t)Governor::Scale((uint32_t)Governor::maxSprites);
+        }
+
+        /** @brief Get number of polygons left in the budget of this frame
+         * @return Polygon budget minus polygons already drawn this frame
+         */
+        inline static uint16_t GetRemainingPolygons()
+        {
+            const uint32_t budget = Governor::GetPolygonBudget();
+            return Governor::usedPolygons < budget ? (uint16_t)(budget - Governor::usedPolygons) : 0;
+        }
+
+        /** @brief Get number of sprites left in the budget of this frame
+         * @return Sprite budget minus sprites already drawn this frame
+         */
+        inline static uint16_t GetRemainingSprites()
+        {
+            const uint32_t budget = Governor::GetSpriteBudget();
+            return Governor::usedSprites < budget ? (uint16_t)(budget - Governor::usedSprites) : 0;
+        }
+
+        /** @brief Count polygons drawn this frame against the budget
+         * @param count Number of drawn polygons
+         */
+        inline static void ConsumePolygons(const uint32_t count)
+        {
+            Governor::usedPolygons += count;
+        }
+
+        /** @brief Count sprites drawn this frame against the budget
+         * @param count Number of drawn sprites
+         */
+        inline static void ConsumeSprites(const uint32_t count)
+        {
+            Governor::usedSprites += count;
+        }
+
+        /** @brief Get number of polygons drawn since last synchronization
+         * @return Used polygon count
+         */
+        inline static uint32_t GetUsedPolygons()
+        {
+            return Governor::usedPolygons;
+        }
+
+        /** @brief Get number of sprites drawn since last synchronization
+         * @return Used sprite count
+         */
+        inline static uint32_t GetUsedSprites()
+        {
+            return Governor::usedSprites;
+        }
+
+        /** @} */
+
+        /** @name Statistics
+         * @{
+         */
+
+        /** @brief Get CPU load of the last frame
+         * @return Time CPU worked on the frame relative to the frame length
+         */
+        inline static SRL::Math::Types::Fxp GetLoad()
+        {
+            return Governor::load;
+        }
+
+        /** @brief Get number of frames where VDP1 did not finish drawing before frame change
+         * @return Overrun count since governor was enabled
+         */
+        inline static uint32_t GetVdp1Overruns()
+        {
+            return Governor::vdp1Overruns;
+        }
+
+        /** @brief Get number of frames where synchronization missed the target frame
+         * @return Dropped frame count since governor was enabled
+         */
+        inline static uint32_t GetDroppedFrames()
+        {
+            return Governor::droppedFrames;
+        }
+
+        /** @} */
+    };
+}
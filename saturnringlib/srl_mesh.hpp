@@ -175,7 +175,7 @@ namespace SRL::Types
          * @param sort Indicates sorting option for the drawing of the quad
          * @param texture Texture index or 0 for no texture
          * @param color Quad color (Not in use if quad is textured), or texture palette index
-         * @param gouraudRamOffset Relative address to the first entry from which to write light gouraud data in SRL::VDP1::GetGouraudTable(). Using 0 here would mean first entry, 2 is second entry in the table, where each entry is 4 color long.
+         * @param gouraudRamOffset Relative address to the first entry from which to write light gouraud data in SRL::VDP1::GetGouraudTable(). Using 0 here would mean first entry, 2 is second entry in the table, where each entry is 4 color long. See SRL::GouraudTable::Reserve().
          * @param colorMode Color mode of the quad (RGB555, 256, 128, 64, 16 colors)
          * @param mode Display mode of the quad
          * @param type Display type of the quad
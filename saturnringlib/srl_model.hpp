@@ -0,0 +1,355 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_debug.hpp"
+#include "srl_mesh.hpp"
+#include "srl_cd.hpp"
+#include "srl_vdp1.hpp"
+
+namespace SRL::Types
+{
+    /** @brief Model loaded from a memory-mappable model file
+     * @details Layout of the model file matches layout of SRL::Types::Mesh, SRL::Types::SmoothMesh and SRL::Types::Attribute in memory,
+     * so whole file is loaded with a single read and only pointers, texture indexes and gouraud table addresses are rebased afterwards.
+     * All values are big-endian, pointers in the file are offsets from the start of the file.
+     * Offset                | Type                                      | Description
+     * ----------------------|-------------------------------------------|---------------------------------------------------
+     * 0                     | SRL::Types::Model::Header                 | File header
+     * Header::MeshOffset    | SRL::Types::Mesh[] or SmoothMesh[]        | Mesh table, pointers of each mesh point into the file
+     * Header::TextureOffset | SRL::Types::Model::TextureEntry[]         | Texture table, textures are always RGB555
+     * Header::GouraudOffset | SRL::Types::HighColor[4][]                | Initial gouraud table entries (optional)
+     *
+     * Texture index of textured faces is relative to the first texture of the model,
+     * gouraud table address of faces is relative to the first gouraud table entry of the model.
+     * Files can be created from .NYA models with tools/scripts/model_converter.py
+     * @code {.cpp}
+     * SRL::Types::Model model("TEAPOT.SRM");
+     *
+     * // In game loop
+     * SRL::Scene3D::DrawMesh(*model.GetMesh(0));
+     * @endcode
+     */
+    class Model
+    {
+    public:
+
+        /** @brief Current file format version
+         */
+        static constexpr uint16_t Version = 1;
+
+        /** @brief Model file header
+         */
+        struct Header
+        {
+            /** @brief File identifier, always 'SRLM'
+             */
+            char Magic[4];
+
+            /** @brief File format version
+             */
+            uint16_t Version;
+
+            /** @brief Mesh type, 0 = SRL::Types::Mesh, 1 = SRL::Types::SmoothMesh
+             */
+            uint16_t Type;
+
+            /** @brief Number of meshes
+             */
+            uint32_t MeshCount;
+
+            /** @brief Number of textures
+             */
+            uint32_t TextureCount;
+
+            /** @brief Number of gouraud table entries used by the model
+             */
+            uint32_t GouraudCount;
+
+            /** @brief Offset of the mesh table
+             */
+            uint32_t MeshOffset;
+
+            /** @brief Offset of the texture table
+             */
+            uint32_t TextureOffset;
+
+            /** @brief Offset of the initial gouraud table entries, 0 if gouraud table is only reserved
+             */
+            uint32_t GouraudOffset;
+        };
+
+        /** @brief Texture table entry
+         */
+        struct TextureEntry
+        {
+            /** @brief Texture width
+             */
+            uint16_t Width;
+
+            /** @brief Texture height
+             */
+            uint16_t Height;
+
+            /** @brief Offset of RGB555 texture data
+             */
+            uint32_t DataOffset;
+        };
+
+    private:
+
+        static_assert(sizeof(Mesh) == sizeof(PDATA), "Mesh layout must match PDATA");
+        static_assert(sizeof(SmoothMesh) == sizeof(XPDATA), "SmoothMesh layout must match XPDATA");
+        static_assert(sizeof(Attribute) == sizeof(ATTR), "Attribute layout must match ATTR");
+
+        /** @brief Loaded file
+         */
+        Header* header;
+
+        /** @brief Index of the first texture loaded by the model
+         */
+        int32_t firstTexture;
+
+        /** @brief First gouraud table entry used by the model
+         */
+        uint16_t firstGouraud;
+
+        /** @brief Value indicating whether data is owned by the model
+         */
+        bool owned;
+
+        /** @brief Convert file offset to pointer
+         * @tparam T Pointer type
+         * @param offset Offset from the start of the file
+         * @return Pointer into the loaded file
+         */
+        template<typename T>
+        T* Rebase(T* offset)
+        {
+            return (T*)(((uint8_t*)this->header) + (size_t)offset);
+        }
+
+        /** @brief Rebase pointers, texture indexes and gouraud addresses of a mesh
+         * @param vertices Vertex pointer
+         * @param faces Face pointer
+         * @param attributes Attribute pointer
+         * @param faceCount Number of faces
+         */
+        void RebaseMesh(SRL::Math::Types::Vector3D*& vertices, Polygon*& faces, Attribute*& attributes, const size_t faceCount)
+        {
+            vertices = this->Rebase(vertices);
+            faces = this->Rebase(faces);
+            attributes = this->Rebase(attributes);
+
+            for (size_t face = 0; face < faceCount; face++)
+            {
+                if ((attributes[face].Sort & UseTexture) != 0)
+                {
+                    attributes[face].Texture += this->firstTexture;
+                }
+
+                if (attributes[face].Gouraud >= 0xe000)
+                {
+                    attributes[face].Gouraud += this->firstGouraud;
+                }
+            }
+        }
+
+        /** @brief Fix up loaded model data
+         * @return True on success
+         */
+        bool Map()
+        {
+            if (this->header->Magic[0] != 'S' || this->header->Magic[1] != 'R' ||
+                this->header->Magic[2] != 'L' || this->header->Magic[3] != 'M' ||
+                this->header->Version != Model::Version || this->header->Type > 1)
+            {
+                SRL::Debug::Assert("Unsupported model file");
+                return false;
+            }
+
+            // Load textures
+            const TextureEntry* textures = (const TextureEntry*)(((uint8_t*)this->header) + this->header->TextureOffset);
+            this->firstTexture = SRL::VDP1::GetTextureCount();
+
+            for (uint32_t texture = 0; texture < this->header->TextureCount; texture++)
+            {
+                if (SRL::VDP1::TryLoadTexture(
+                    textures[texture].Width,
+                    textures[texture].Height,
+                    SRL::CRAM::TextureColorMode::RGB555,
+                    0,
+                    ((uint8_t*)this->header) + textures[texture].DataOffset) < 0)
+                {
+                    SRL::Debug::Assert("Not enough texture slots for model");
+                    return false;
+                }
+            }
+
+            // Upload initial gouraud table
+            if (this->header->GouraudOffset != 0)
+            {
+                const uint32_t* source = (const uint32_t*)(((uint8_t*)this->header) + this->header->GouraudOffset);
+                uint32_t* target = (uint32_t*)(SRL::VDP1::GetGouraudTable() + (this->firstGouraud << 2));
+
+                for (uint32_t word = 0; word < (this->header->GouraudCount << 1); word++)
+                {
+                    target[word] = source[word];
+                }
+            }
+
+            // Rebase meshes
+            if (this->header->Type == 1)
+            {
+                SmoothMesh* meshes = this->Rebase((SmoothMesh*)this->header->MeshOffset);
+
+                for (uint32_t mesh = 0; mesh < this->header->MeshCount; mesh++)
+                {
+                    this->RebaseMesh(meshes[mesh].Vertices, meshes[mesh].Faces, meshes[mesh].Attributes, meshes[mesh].FaceCount);
+                    meshes[mesh].Normals = this->Rebase(meshes[mesh].Normals);
+                }
+            }
+            else
+            {
+                Mesh* meshes = this->Rebase((Mesh*)this->header->MeshOffset);
+
+                for (uint32_t mesh = 0; mesh < this->header->MeshCount; mesh++)
+                {
+                    this->RebaseMesh(meshes[mesh].Vertices, meshes[mesh].Faces, meshes[mesh].Attributes, meshes[mesh].FaceCount);
+                }
+            }
+
+            return true;
+        }
+
+    public:
+
+        /** @brief Load model from a file
+         * @param fileName Model file name
+         * @param gouraudEntry First gouraud table entry the model will use
+         */
+        Model(const char* fileName, const uint16_t gouraudEntry = 0) : header(nullptr), firstTexture(-1), firstGouraud(gouraudEntry), owned(true)
+        {
+            SRL::Cd::File file = SRL::Cd::File(fileName);
+
+            if (!file.Exists())
+            {
+                SRL::Debug::Assert("Model '%s' not found", fileName);
+                return;
+            }
+
+            if (file.Size.Bytes < (int32_t)sizeof(Header))
+            {
+                SRL::Debug::Assert("Model '%s' is too small", fileName);
+                return;
+            }
+
+            this->header = (Header*)new uint8_t[file.Size.Bytes];
+
+            if (file.LoadBytes(0, file.Size.Bytes, this->header) < file.Size.Bytes)
+            {
+                SRL::Debug::Assert("Model '%s' could not be read", fileName);
+                delete[] (uint8_t*)this->header;
+                this->header = nullptr;
+                return;
+            }
+
+            if (!this->Map())
+            {
+                delete[] (uint8_t*)this->header;
+                this->header = nullptr;
+            }
+        }
+
+        /** @brief Map model already loaded in memory
+         * @note Data is modified in place and must stay valid for the lifetime of the model
+         * @param data Model file data (must be 4 byte aligned)
+         * @param gouraudEntry First gouraud table entry the model will use
+         */
+        Model(void* data, const uint16_t gouraudEntry = 0) : header((Header*)data), firstTexture(-1), firstGouraud(gouraudEntry), owned(false)
+        {
+            if (!this->Map())
+            {
+                this->header = nullptr;
+            }
+        }
+
+        /** @brief Destroy the model, textures must be freed separately
+         * @note Meshes live inside the loaded file, so their destructors are never called
+         */
+        ~Model()
+        {
+            if (this->owned)
+            {
+                delete[] (uint8_t*)this->header;
+            }
+        }
+
+        /** @brief Get a value indicating whether model was loaded successfully
+         * @return True if model is loaded
+         */
+        bool IsLoaded() const
+        {
+            return this->header != nullptr;
+        }
+
+        /** @brief Get a value indicating whether model contains smooth meshes
+         * @return True if model contains SRL::Types::SmoothMesh data
+         */
+        bool IsSmooth() const
+        {
+            return this->header != nullptr && this->header->Type == 1;
+        }
+
+        /** @brief Gets number of meshes
+         * @return Number of meshes
+         */
+        size_t GetMeshCount() const
+        {
+            return this->header != nullptr ? this->header->MeshCount : 0;
+        }
+
+        /** @brief Gets index of the first texture loaded by the model
+         * @return Texture index or -1 if model has no textures
+         */
+        int32_t GetFirstTextureIndex() const
+        {
+            return this->header != nullptr && this->header->TextureCount > 0 ? this->firstTexture : -1;
+        }
+
+        /** @brief Gets number of gouraud table entries used by the model
+         * @return Number of entries starting at the entry specified when loading
+         */
+        size_t GetGouraudCount() const
+        {
+            return this->header != nullptr ? this->header->GouraudCount : 0;
+        }
+
+        /** @brief Get flat mesh
+         * @param index Mesh index
+         * @return Mesh or nullptr if model does not contain flat meshes
+         */
+        Mesh* GetMesh(const size_t index)
+        {
+            if (this->header == nullptr || this->header->Type != 0 || index >= this->header->MeshCount)
+            {
+                return nullptr;
+            }
+
+            return this->Rebase((Mesh*)this->header->MeshOffset) + index;
+        }
+
+        /** @brief Get smooth mesh
+         * @param index Mesh index
+         * @return Mesh or nullptr if model does not contain smooth meshes
+         */
+        SmoothMesh* GetSmoothMesh(const size_t index)
+        {
+            if (this->header == nullptr || this->header->Type != 1 || index >= this->header->MeshCount)
+            {
+                return nullptr;
+            }
+
+            return this->Rebase((SmoothMesh*)this->header->MeshOffset) + index;
+        }
+    };
+}
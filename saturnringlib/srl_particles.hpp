@@ -0,0 +1,592 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_tv.hpp"
+#include "srl_vdp1.hpp"
+#include "srl_slave.hpp"
+#include "srl_governor.hpp"
+#include "srl_scene2d.hpp"
+
+namespace SRL
+{
+    /** @brief Particle effects
+     * @details Particles of a system are kept in structure of arrays, alive particles are always packed at the start of the arrays,
+     * so the update is a single pass over contiguous memory and a dead particle is removed by moving the last one into its place.
+     * Emitters share the particle pool of their system, each emitter can be limited to a number of slots of the pool.
+     * Update can run on the slave SH2, drawing writes one VDP1 command per particle and rebuilds the command template only when emitter changes.
+     * @code {.cpp}
+     * SRL::Particles::System<256> sparks;
+     * SRL::Particles::Emitter emitter;
+     * emitter.Rate = 4.0;
+     * emitter.Velocity = SRL::Math::Types::Vector2D(0.0, -2.0);
+     * emitter.Spread = SRL::Math::Types::Vector2D(1.0, 0.5);
+     * emitter.Lifetime = 30;
+     * sparks.Gravity = SRL::Math::Types::Vector2D(0.0, 0.1);
+     * int32_t fountain = sparks.AddEmitter(emitter);
+     *
+     * // In game loop
+     * sparks.Update(true);
+     * // ... other work on the master SH2
+     * sparks.Wait();
+     * sparks.Draw(500.0);
+     * SRL::Core::Synchronize();
+     * @endcode
+     */
+    class Particles
+    {
+        /** @brief Disable constructor
+         */
+        Particles() = delete;
+
+        /** @brief Disable destructor
+         */
+        ~Particles() = delete;
+
+    public:
+
+        /** @brief Particle emitter
+         */
+        struct Emitter
+        {
+            /** @brief Spawn location in screen coordinates
+             */
+            SRL::Math::Types::Vector2D Location;
+
+            /** @brief Half size of the area around the location particles spawn in
+             */
+            SRL::Math::Types::Vector2D Area;
+
+            /** @brief Initial velocity of particles in pixels per frame
+             */
+            SRL::Math::Types::Vector2D Velocity;
+
+            /** @brief Maximal random deviation of the initial velocity
+             */
+            SRL::Math::Types::Vector2D Spread;
+
+            /** @brief Number of particles spawned every frame, fractions accumulate over frames
+             */
+            SRL::Math::Types::Fxp Rate;
+
+            /** @brief Scale of textured particles
+             */
+            SRL::Math::Types::Fxp Scale;
+
+            /** @brief Particle lifetime in frames
+             */
+            uint16_t Lifetime;
+
+            /** @brief Maximal random number of frames added to the lifetime
+             */
+            uint16_t LifetimeSpread;
+
+            /** @brief Maximal number of alive particles of the emitter
+             */
+            uint16_t MaxParticles;
+
+            /** @brief Particle texture, -1 draws particles as flat colored squares
+             */
+            int32_t Texture;
+
+            /** @brief Color of untextured particles
+             */
+            SRL::Types::HighColor Color;
+
+            /** @brief Size of untextured particles in pixels
+             */
+            uint8_t Size;
+
+            /** @brief Draw particles half-transparent
+             */
+            bool HalfTransparent;
+
+            /** @brief Gouraud table entry used to tint particles, -1 disables tint
+             */
+            int32_t Gouraud;
+
+            /** @brief Value indicating whether emitter spawns particles
+             */
+            bool Active;
+
+            /** @brief Fractional part of spawned particles carried to the next frame
+             * @note Managed by the particle system
+             */
+            SRL::Math::Types::Fxp Accumulator;
+
+            /** @brief Number of alive particles of the emitter
+             * @note Managed by the particle system
+             */
+            uint16_t Alive;
+
+            /** @brief Construct a new emitter spawning single white pixel per frame
+             */
+            Emitter() :
+                Rate(1.0),
+                Scale(1.0),
+                Lifetime(60),
+                LifetimeSpread(0),
+                MaxParticles(0xffff),
+                Texture(-1),
+                Color(SRL::Types::HighColor::Colors::White),
+                Size(1),
+                HalfTransparent(false),
+                Gouraud(-1),
+                Active(true),
+                Accumulator(0.0),
+                Alive(0)
+            {
+                // Do nothing
+            }
+        };
+
+        /** @brief Move particles by their velocity
+         * @param x Horizontal positions
+         * @param y Vertical positions
+         * @param velocityX Horizontal velocities
+         * @param velocityY Vertical velocities
+         * @param count Number of particles
+         * @param gravity Acceleration added to velocities every frame
+         */
+        static void Integrate(
+            SRL::Math::Types::Fxp* x,
+            SRL::Math::Types::Fxp* y,
+            SRL::Math::Types::Fxp* velocityX,
+            SRL::Math::Types::Fxp* velocityY,
+            const size_t count,
+            const SRL::Math::Types::Vector2D& gravity)
+        {
+            if (gravity.X != 0.0 || gravity.Y != 0.0)
+            {
+                for (size_t index = 0; index < count; index++)
+                {
+                    velocityX[index] += gravity.X;
+                    velocityY[index] += gravity.Y;
+                }
+            }
+
+            for (size_t index = 0; index < count; index++)
+            {
+                x[index] += velocityX[index];
+                y[index] += velocityY[index];
+            }
+        }
+
+        /** @brief Particle system
+         * @note While update runs on the slave SH2, particles must not be spawned, drawn or read, see SRL::Particles::System::Wait()
+         * @tparam Capacity Maximal number of alive particles
+         * @tparam MaxEmitters Maximal number of emitters
+         */
+        template<uint16_t Capacity, uint8_t MaxEmitters = 8>
+        class System : public SRL::Types::ITask
+        {
+        public:
+
+            /** @brief Horizontal positions in screen coordinates
+             */
+            SRL::Math::Types::Fxp X[Capacity];
+
+            /** @brief Vertical positions in screen coordinates
+             */
+            SRL::Math::Types::Fxp Y[Capacity];
+
+            /** @brief Horizontal velocities in pixels per frame
+             */
+            SRL::Math::Types::Fxp VelocityX[Capacity];
+
+            /** @brief Vertical velocities in pixels per frame
+             */
+            SRL::Math::Types::Fxp VelocityY[Capacity];
+
+            /** @brief Remaining lifetimes in frames
+             */
+            uint16_t Life[Capacity];
+
+            /** @brief Emitters of particles
+             */
+            uint8_t Owner[Capacity];
+
+            /** @brief Acceleration applied to all particles every frame
+             */
+            SRL::Math::Types::Vector2D Gravity;
+
+        private:
+
+            /** @brief Emitters
+             */
+            Emitter emitters[MaxEmitters];
+
+            /** @brief Number of emitters
+             */
+            uint8_t emitterCount;
+
+            /** @brief Number of alive particles
+             */
+            uint16_t alive;
+
+            /** @brief Random generator state
+             */
+            uint32_t seed;
+
+            /** @brief Value indicating whether update was sent to the slave SH2
+             */
+            bool dispatched;
+
+            /** @brief Number of commands written by last draw
+             */
+            uint16_t emitted;
+
+            /** @brief Number of particles outside of the screen in last draw
+             */
+            uint16_t culled;
+
+            /** @brief Number of particles not drawn by last draw because of sprite budget or full command buffer
+             */
+            uint16_t dropped;
+
+            /** @brief Get random value
+             * @return Value between -1.0 and 1.0
+             */
+            SRL::Math::Types::Fxp Random()
+            {
+                this->seed ^= this->seed << 13;
+                this->seed ^= this->seed >> 17;
+                this->seed ^= this->seed << 5;
+                return SRL::Math::Types::Fxp::BuildRaw((int32_t)(this->seed & 0x1ffff) - 0x10000);
+            }
+
+            /** @brief Spawn particles
+             * @param emitter Emitter index
+             * @param count Number of particles
+             * @return Number of spawned particles
+             */
+            uint16_t Emit(const uint8_t emitter, uint16_t count)
+            {
+                Emitter& source = this->emitters[emitter];
+                count = SRL::Math::Min(count, (uint16_t)(source.MaxParticles - source.Alive));
+                count = SRL::Math::Min(count, (uint16_t)(Capacity - this->alive));
+
+                for (uint16_t particle = 0; particle < count; particle++)
+                {
+                    const uint16_t index = this->alive++;
+                    this->X[index] = source.Location.X + (source.Area.X * this->Random());
+                    this->Y[index] = source.Location.Y + (source.Area.Y * this->Random());
+                    this->VelocityX[index] = source.Velocity.X + (source.Spread.X * this->Random());
+                    this->VelocityY[index] = source.Velocity.Y + (source.Spread.Y * this->Random());
+                    this->Life[index] = source.Lifetime + (source.LifetimeSpread > 0 ? (this->seed % (source.LifetimeSpread + 1)) : 0);
+                    this->Owner[index] = emitter;
+                }
+
+                source.Alive += count;
+                return count;
+            }
+
+            /** @brief Age particles and remove dead ones
+             */
+            void Age()
+            {
+                uint16_t index = 0;
+
+                while (index < this->alive)
+                {
+                    if (this->Life[index] > 1)
+                    {
+                        this->Life[index]--;
+                        index++;
+                        continue;
+                    }
+
+                    // Move last particle into the place of the dead one
+                    this->emitters[this->Owner[index]].Alive--;
+                    const uint16_t last = --this->alive;
+                    this->X[index] = this->X[last];
+                    this->Y[index] = this->Y[last];
+                    this->VelocityX[index] = this->VelocityX[last];
+                    this->VelocityY[index] = this->VelocityY[last];
+                    this->Life[index] = this->Life[last];
+                    this->Owner[index] = this->Owner[last];
+                }
+            }
+
+        protected:
+
+            /** @brief Update particles on the slave SH2
+             */
+            void Do() override
+            {
+                // Slave cache might hold particles from the previous frame
+                slCashPurge();
+                this->Step();
+            }
+
+        public:
+
+            /** @brief Construct a new empty particle system
+             */
+            System() : emitterCount(0), alive(0), seed(0x2545f491), dispatched(false), emitted(0), culled(0), dropped(0)
+            {
+                // Do nothing
+            }
+
+            /** @name Emitters
+             * @{
+             */
+
+            /** @brief Add emitter
+             * @param emitter Emitter settings
+             * @return Emitter index or -1 if there is no free emitter
+             */
+            int32_t AddEmitter(const Emitter& emitter)
+            {
+                if (this->emitterCount >= MaxEmitters)
+                {
+                    return -1;
+                }
+
+                this->emitters[this->emitterCount] = emitter;
+                this->emitters[this->emitterCount].Accumulator = 0.0;
+                this->emitters[this->emitterCount].Alive = 0;
+                return this->emitterCount++;
+            }
+
+            /** @brief Get emitter
+             * @param index Emitter index
+             * @return Emitter settings, can be changed at any time while update is not running
+             */
+            Emitter& GetEmitter(const uint8_t index)
+            {
+                return this->emitters[index];
+            }
+
+            /** @brief Spawn number of particles at once
+             * @param emitter Emitter index
+             * @param count Number of particles
+             * @return Number of spawned particles, limited by free slots of the system and the emitter
+             */
+            uint16_t Burst(const uint8_t emitter, const uint16_t count)
+            {
+                return this->Emit(emitter, count);
+            }
+
+            /** @brief Remove all particles
+             */
+            void Clear()
+            {
+                this->alive = 0;
+
+                for (uint8_t emitter = 0; emitter < this->emitterCount; emitter++)
+                {
+                    this->emitters[emitter].Alive = 0;
+                }
+            }
+
+            /** @} */
+
+            /** @name Update
+             * @{
+             */
+
+            /** @brief Spawn particles of all active emitters
+             */
+            void Spawn()
+            {
+                for (uint8_t emitter = 0; emitter < this->emitterCount; emitter++)
+                {
+                    Emitter& source = this->emitters[emitter];
+
+                    if (source.Active)
+                    {
+                        source.Accumulator += source.Rate;
+                        const int16_t count = source.Accumulator.As<int16_t>();
+                        source.Accumulator -= count;
+                        this->Emit(emitter, count);
+                    }
+                }
+            }
+
+            /** @brief Age and move all particles
+             */
+            void Step()
+            {
+                this->Age();
+                Particles::Integrate(this->X, this->Y, this->VelocityX, this->VelocityY, this->alive, this->Gravity);
+            }
+
+            /** @brief Spawn new particles and update all of them
+             * @param onSlave Run the update on the slave SH2, SRL::Particles::System::Wait() must be called before particles are used again
+             */
+            void Update(const bool onSlave = false)
+            {
+                this->Wait();
+                this->Spawn();
+
+                if (onSlave)
+                {
+                    this->dispatched = true;
+                    SRL::Slave::ExecuteOnSlave(*this);
+                }
+                else
+                {
+                    this->Step();
+                }
+            }
+
+            /** @brief Wait for update running on the slave SH2 to finish
+             */
+            void Wait()
+            {
+                if (this->dispatched)
+                {
+                    while (!this->IsDone())
+                    {
+                        // Wait for slave
+                    }
+
+                    // Master cache might hold particles from before the update
+                    slCashPurge();
+                    this->dispatched = false;
+                }
+            }
+
+            /** @} */
+
+            /** @name Drawing
+             * @{
+             */
+
+            /** @brief Emit commands of all visible particles
+             * @details Drawing stops once sprite budget of SRL::Governor left for this frame is used up.
+             * @param depth Depth sort value of the whole system
+             * @return Number of emitted commands
+             */
+            uint16_t Draw(const SRL::Math::Types::Fxp& depth)
+            {
+                this->Wait();
+
+                const uint16_t budget = SRL::Governor::IsEnabled() ? SRL::Governor::GetRemainingSprites() : 0xffff;
+                const int32_t halfWidth = SRL::TV::Width >> 1;
+                const int32_t halfHeight = SRL::TV::Height >> 1;
+                SPRITE command = Scene2D::GetSpriteCommand(Scene2D::CommandType::Polygon, Types::HighColor());
+                uint8_t current = 0xff;
+                int32_t width = 0;
+                int32_t height = 0;
+
+                this->emitted = 0;
+                this->culled = 0;
+                this->dropped = 0;
+
+                for (uint16_t index = 0; index < this->alive; index++)
+                {
+                    // Rebuild command template only when emitter changes
+                    if (this->Owner[index] != current)
+                    {
+                        current = this->Owner[index];
+                        const Emitter& source = this->emitters[current];
+
+                        if (source.Texture >= 0)
+                        {
+                            const SPR_ATTR attribute = Scene2D::GetSpriteAttribute(source.Texture, nullptr);
+                            command = Scene2D::GetSpriteCommand(Scene2D::CommandType::RectangleSprite, Types::HighColor());
+                            command.CTRL = (uint16_t)Scene2D::CommandType::RectangleSprite;
+                            command.PMOD = attribute.atrb;
+                            command.COLR = attribute.colno;
+                            command.SRCA = SRL::VDP1::Textures[source.Texture].Address;
+                            command.SIZE = SRL::VDP1::Textures[source.Texture].Size;
+                            width = (SRL::Math::Types::Fxp((int16_t)SRL::VDP1::Textures[source.Texture].Width) * source.Scale).As<int16_t>();
+                            height = (SRL::Math::Types::Fxp((int16_t)SRL::VDP1::Textures[source.Texture].Height) * source.Scale).As<int16_t>();
+                        }
+                        else
+                        {
+                            command = Scene2D::GetSpriteCommand(Scene2D::CommandType::Polygon, source.Color);
+                            command.CTRL = (uint16_t)Scene2D::CommandType::Polygon;
+                            width = source.Size;
+                            height = source.Size;
+                        }
+
+                        // Color calculation, 3 is half-transparency, 4 gouraud shading and 7 both
+                        command.PMOD = (command.PMOD & ~7) | (source.HalfTransparent ? 3 : 0) | (source.Gouraud >= 0 ? 4 : 0);
+                        command.GRDA = source.Gouraud >= 0 ? (uint16_t)((((uint32_t)SRL::VDP1::GetGouraudTable() - SpriteVRAM) >> 3) + source.Gouraud) : 0;
+                    }
+
+                    const int32_t x = this->X[index].template As<int16_t>() - (width >> 1);
+                    const int32_t y = this->Y[index].template As<int16_t>() - (height >> 1);
+
+                    if (x + width <= -halfWidth || x >= halfWidth ||
+                        y + height <= -halfHeight || y >= halfHeight)
+                    {
+                        this->culled++;
+                        continue;
+                    }
+
+                    if (this->emitted >= budget)
+                    {
+                        this->dropped++;
+                        continue;
+                    }
+
+                    // Rectangle sprite uses only first and third corner
+                    command.XA = x;
+                    command.YA = y;
+                    command.XB = x + width - 1;
+                    command.YB = y;
+                    command.XC = x + width - 1;
+                    command.YC = y + height - 1;
+                    command.XD = x;
+                    command.YD = y + height - 1;
+
+                    if (!slSetSprite(&command, depth.RawValue()))
+                    {
+                        // Command buffer is full, rest of the particles is dropped
+                        this->dropped += this->alive - index;
+                        break;
+                    }
+
+                    SRL::VDP1::Stats::Count(command);
+                    this->emitted++;
+                }
+
+                SRL::Governor::ConsumeSprites(this->emitted);
+                return this->emitted;
+            }
+
+            /** @} */
+
+            /** @name Statistics
+             * @{
+             */
+
+            /** @brief Get number of alive particles
+             * @return Alive particle count
+             */
+            uint16_t GetAliveCount() const
+            {
+                return this->alive;
+            }
+
+            /** @brief Get number of commands written by last draw
+             * @return Emitted command count
+             */
+            uint16_t GetEmittedCount() const
+            {
+                return this->emitted;
+            }
+
+            /** @brief Get number of particles outside of the screen in last draw
+             * @return Culled particle count
+             */
+            uint16_t GetCulledCount() const
+            {
+                return this->culled;
+            }
+
+            /** @brief Get number of visible particles not drawn by last draw because of sprite budget or full command buffer
+             * @return Dropped particle count
+             */
+            uint16_t GetDroppedCount() const
+            {
+                return this->dropped;
+            }
+
+            /** @} */
+        };
+    };
+}
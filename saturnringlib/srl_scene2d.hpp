@@ -1,7 +1,11 @@
 #pragma once
 
 #include "srl_base.hpp"
+#include "srl_core.hpp"
 #include "srl_vdp1.hpp"
+#include "srl_tv.hpp"
+#include "srl_governor.hpp"
+#include "srl_scene3d.hpp"
 
 namespace SRL
 {
@@ -29,6 +33,23 @@ namespace SRL
             ClipInside = 3,
         };
 
+        /** @brief Result of testing screen area against the current clipping rectangle, see SRL::Scene2D::TestClipping()
+         */
+        enum class ClipTest : uint8_t
+        {
+            /** @brief Area is drawn whole, or clipping stack is empty
+             */
+            Visible = 0,
+
+            /** @brief Area crosses edge of the clipping rectangle, VDP1 pre-clipping is needed
+             */
+            Partial = 1,
+
+            /** @brief Nothing of the area is drawn
+             */
+            Hidden = 2,
+        };
+
         /** @brief Sprite flip effect
          */
         enum FlipEffect : uint8_t
@@ -293,6 +314,10 @@ namespace SRL
          */
         static const uint16_t GouraudTableBase = 0xe000;
 
+        /** @brief Direction of the zoom point from sprite center, indexed by horizontal or vertical part of SRL::Scene2D::ZoomPoint
+         */
+        static constexpr int8_t ZoomPointOffset[4] = { 0, -1, 0, 1 };
+
         /** @brief Struct to store effect settings
          */
         struct EffectStore {
@@ -350,6 +375,195 @@ namespace SRL
             return Scene2D::Effects.Gouraud >= SRL::Scene2D::GouraudTableBase;
         }
 
+        /** @brief Clipping rectangle in screen coordinates, where top left corner of the screen is (0,0), edges are inclusive
+         */
+        struct ClipRectangle
+        {
+            /** @brief Left edge
+             */
+            int16_t Left;
+
+            /** @brief Top edge
+             */
+            int16_t Top;
+
+            /** @brief Right edge
+             */
+            int16_t Right;
+
+            /** @brief Bottom edge
+             */
+            int16_t Bottom;
+
+            /** @brief Clipping mode set before the rectangle was pushed
+             */
+            uint8_t PreviousMode;
+        };
+
+        /** @brief Maximal number of nested clipping rectangles
+         */
+        static constexpr uint8_t ClipStackSize = 8;
+
+        /** @brief Stack of clipping rectangles
+         */
+        static inline Scene2D::ClipRectangle clipStack[Scene2D::ClipStackSize];
+
+        /** @brief Number of rectangles on the clipping stack
+         */
+        static inline uint8_t clipDepth = 0;
+
+        /** @brief Last clipping rectangle written into the command list this frame
+         */
+        static inline Scene2D::ClipRectangle emittedClip = { 0, 0, 0, 0, 0 };
+
+        /** @brief Depth sort value of the last clipping rectangle written into the command list this frame
+         */
+        static inline int32_t emittedDepth = 0;
+
+        /** @brief Value indicating whether a clipping rectangle was written into the command list this frame
+         */
+        static inline bool clipEmitted = false;
+
+        /** @brief Value indicating whether clipping stack is reset by SRL::Core::Synchronize()
+         */
+        static inline bool clipResetHooked = false;
+
+        /** @brief Drop clipping rectangles at the end of the frame, SGL starts each command list with full screen user clipping
+         */
+        static void ResetClipping()
+        {
+            if (Scene2D::clipDepth > 0)
+            {
+                Scene2D::Effects.Clipping = Scene2D::clipStack[0].PreviousMode;
+                Scene2D::clipDepth = 0;
+            }
+
+            Scene2D::clipEmitted = false;
+        }
+
+        /** @brief Write user clipping command, unless the same rectangle was just written at the same depth
+         * @details Commands are sorted by depth, so rectangle written at another depth does not have to be the one active there.
+         * @param rectangle Clipping rectangle
+         * @param depth Depth sort value
+         * @return True on success
+         */
+        static bool EmitClipping(const Scene2D::ClipRectangle& rectangle, const SRL::Math::Types::Fxp& depth)
+        {
+            if (Scene2D::clipEmitted && Scene2D::emittedDepth == depth.RawValue() &&
+                Scene2D::emittedClip.Left == rectangle.Left && Scene2D::emittedClip.Top == rectangle.Top &&
+                Scene2D::emittedClip.Right == rectangle.Right && Scene2D::emittedClip.Bottom == rectangle.Bottom)
+            {
+                return true;
+            }
+
+            SPRITE sprite;
+            sprite.CTRL = FUNC_UserClip;
+            sprite.XA = rectangle.Left;
+            sprite.YA = rectangle.Top;
+            sprite.XC = rectangle.Right;
+            sprite.YC = rectangle.Bottom;
+
+            if (!Scene2D::Draw(&sprite, depth))
+            {
+                return false;
+            }
+
+            if (!Scene2D::clipResetHooked)
+            {
+                SRL::Core::OnAfterSync += Scene2D::ResetClipping;
+                Scene2D::clipResetHooked = true;
+            }
+
+            Scene2D::emittedClip = rectangle;
+            Scene2D::emittedDepth = depth.RawValue();
+            Scene2D::clipEmitted = true;
+            return true;
+        }
+
+        /** @brief Test bounds against the current clipping rectangle
+         * @param left Left edge (0 is center of the screen)
+         * @param top Top edge (0 is center of the screen)
+         * @param right Right edge
+         * @param bottom Bottom edge
+         * @return Test result
+         */
+        static Scene2D::ClipTest TestBounds(int32_t left, int32_t top, int32_t right, int32_t bottom)
+        {
+            if (Scene2D::clipDepth == 0 || Scene2D::Effects.Clipping < Scene2D::ClippingEffect::ClipOutside)
+            {
+                return Scene2D::ClipTest::Visible;
+            }
+
+            // Sprites are positioned from the center of the screen, clipping rectangle from its top left corner
+            const Scene2D::ClipRectangle& clip = Scene2D::clipStack[Scene2D::clipDepth - 1];
+            const int32_t centerX = SRL::TV::Width >> 1;
+            const int32_t centerY = SRL::TV::Height >> 1;
+            left += centerX;
+            right += centerX;
+            top += centerY;
+            bottom += centerY;
+
+            const bool outside = right < clip.Left || left > clip.Right || bottom < clip.Top || top > clip.Bottom;
+            const bool inside = left >= clip.Left && right <= clip.Right && top >= clip.Top && bottom <= clip.Bottom;
+
+            if (Scene2D::Effects.Clipping == Scene2D::ClippingEffect::ClipOutside)
+            {
+                return outside ? Scene2D::ClipTest::Hidden : (inside ? Scene2D::ClipTest::Visible : Scene2D::ClipTest::Partial);
+            }
+
+            return inside ? Scene2D::ClipTest::Hidden : (outside ? Scene2D::ClipTest::Visible : Scene2D::ClipTest::Partial);
+        }
+
+        /** @brief Test corners of a quad against the current clipping rectangle
+         * @param corners Corners as 4 pairs of fixed point X and Y coordinates
+         * @return Test result
+         */
+        static Scene2D::ClipTest TestCorners(const FIXED* corners)
+        {
+            if (Scene2D::clipDepth == 0)
+            {
+                return Scene2D::ClipTest::Visible;
+            }
+
+            int32_t left = corners[0];
+            int32_t top = corners[1];
+            int32_t right = left;
+            int32_t bottom = top;
+
+            for (uint8_t corner = 2; corner < 8; corner += 2)
+            {
+                left = SRL::Math::Min(left, corners[corner]);
+                right = SRL::Math::Max(right, corners[corner]);
+                top = SRL::Math::Min(top, corners[corner + 1]);
+                bottom = SRL::Math::Max(bottom, corners[corner + 1]);
+            }
+
+            return Scene2D::TestBounds(left >> 16, top >> 16, right >> 16, bottom >> 16);
+        }
+
+        /** @brief Test scaled sprite drawn by slDispSpriteHV() against the current clipping rectangle
+         * @param texture Sprite texture
+         * @param position Sprite position and scale
+         * @param zoomPoint Zoom point of the sprite
+         * @return Test result
+         */
+        static Scene2D::ClipTest TestScaledSprite(const uint16_t texture, const FIXED* position, const uint8_t zoomPoint)
+        {
+            if (Scene2D::clipDepth == 0)
+            {
+                return Scene2D::ClipTest::Visible;
+            }
+
+            int32_t halfWidth = (VDP1::Textures[texture].Width * position[Sh]) >> 17;
+            int32_t halfHeight = (VDP1::Textures[texture].Height * position[Sv]) >> 17;
+            halfWidth = halfWidth < 0 ? -halfWidth : halfWidth;
+            halfHeight = halfHeight < 0 ? -halfHeight : halfHeight;
+
+            const int32_t x = (position[X] >> 16) + (Scene2D::ZoomPointOffset[zoomPoint & 0x3] * halfWidth);
+            const int32_t y = (position[Y] >> 16) + (Scene2D::ZoomPointOffset[(zoomPoint >> 2) & 0x3] * halfHeight);
+            return Scene2D::TestBounds(x - halfWidth, y - halfHeight, x + halfWidth, y + halfHeight);
+        }
+
     public:
 
         /**
@@ -495,7 +709,13 @@ namespace SRL
          */
         static bool Draw(SPRITE* command, const SRL::Math::Types::Fxp& depth)
         {
-            return slSetSprite(command, depth.RawValue());
+            if (!slSetSprite(command, depth.RawValue()))
+            {
+                return false;
+            }
+
+            VDP1::Stats::Count(*command);
+            return true;
         }
 
         /** @brief Draw sprite by using custom attributes
@@ -505,8 +725,23 @@ namespace SRL
          */
         static bool Draw(SPR_ATTR* attributes, const SRL::Math::Types::Fxp* arguments)
         {
+            const Scene2D::ClipTest clip = Scene2D::TestScaledSprite(attributes->texno, (const FIXED*)arguments, attributes->dir >> 8);
+            SPR_ATTR preClipped = *attributes;
+            preClipped.atrb &= ~Pclpoff;
+
+            if (clip == Scene2D::ClipTest::Hidden)
+            {
+                return true;
+            }
+
             // We cannot use slDispSprite, as that seems to be bugged and is drawing images 1px wider than it should
-            return slDispSpriteHV((FIXED*)arguments, attributes, 0) != 0;
+            if (slDispSpriteHV((FIXED*)arguments, clip == Scene2D::ClipTest::Partial ? &preClipped : attributes, 0) == 0)
+            {
+                return false;
+            }
+
+            VDP1::Stats::CountScaledSprite(attributes->texno, arguments[Sh].RawValue(), arguments[Sv].RawValue());
+            return true;
         }
 
         /** @brief Draw sprite by using custom attributes and 4 points
@@ -517,8 +752,23 @@ namespace SRL
          */
         static bool Draw(SPR_ATTR* attributes, const SRL::Math::Types::Vector2D points[4], const SRL::Math::Types::Fxp depth)
         {
+            const Scene2D::ClipTest clip = Scene2D::TestCorners((const FIXED*)points);
+            SPR_ATTR preClipped = *attributes;
+            preClipped.atrb &= ~Pclpoff;
+
+            if (clip == Scene2D::ClipTest::Hidden)
+            {
+                return true;
+            }
+
             // We cannot use slDispSprite, as that seems to be bugged and is drawing images 1px wider than it should
-            return slDispSprite4P((FIXED*)points, depth.RawValue(), attributes) != 0;
+            if (slDispSprite4P((FIXED*)points, depth.RawValue(), clip == Scene2D::ClipTest::Partial ? &preClipped : attributes) == 0)
+            {
+                return false;
+            }
+
+            VDP1::Stats::CountDistortedSprite((const FIXED*)points);
+            return true;
         }
 
         /** @brief Draw sprite from 4 points
@@ -534,9 +784,24 @@ namespace SRL
             const SRL::Math::Types::Vector2D points[4],
             const SRL::Math::Types::Fxp depth)
         {
+            const Scene2D::ClipTest clip = Scene2D::TestCorners((const FIXED*)points);
+
+            if (clip == Scene2D::ClipTest::Hidden)
+            {
+                return true;
+            }
+
             // Sprite attributes and command points
             SPR_ATTR attr = Scene2D::GetSpriteAttribute(texture, texturePalette);
-            return slDispSprite4P((FIXED*)points, depth.RawValue(), &attr);
+            attr.atrb &= clip == Scene2D::ClipTest::Partial ? ~Pclpoff : 0xffff;
+
+            if (slDispSprite4P((FIXED*)points, depth.RawValue(), &attr) == 0)
+            {
+                return false;
+            }
+
+            VDP1::Stats::CountDistortedSprite((const FIXED*)points);
+            return true;
         }
 
         /** @brief Draw sprite from 4 points
@@ -550,11 +815,52 @@ namespace SRL
             return Scene2D::DrawSprite(texture, nullptr, points, depth);
         }
 
-        /** @brief Draw simple sprite
+        /** @brief Calculate corners of a rotated and scaled sprite
+         * @details Rotated half axes of the sprite are calculated once, zoom point offset and all corners are then just their sums.
+         * @param location Location of the sprite zoom point
+         * @param halfSize Half of the scaled sprite size
+         * @param rotation Sinus and cosine of the sprite rotation angle
+         * @param zoomPoint Zoom point of the sprite
+         * @param result Corners of the sprite in screen coordinates
+         */
+        static void RotateScaleCorners(
+            const SRL::Math::Types::Vector2D& location,
+            const SRL::Math::Types::Vector2D& halfSize,
+            const Scene3D::SinCos& rotation,
+            const Scene2D::ZoomPoint zoomPoint,
+            SRL::Math::Types::Vector2D result[4])
+        {
+            const int64_t sin = rotation.Sin.RawValue();
+            const int64_t cos = rotation.Cos.RawValue();
+
+            // Rotated X and Y half axes
+            const int32_t ux = (int32_t)((cos * halfSize.X.RawValue()) >> 16);
+            const int32_t uy = (int32_t)((sin * halfSize.X.RawValue()) >> 16);
+            const int32_t vx = (int32_t)((-sin * halfSize.Y.RawValue()) >> 16);
+            const int32_t vy = (int32_t)((cos * halfSize.Y.RawValue()) >> 16);
+
+            // Zoom point moves the sprite center by one half axis in each direction
+            const int32_t offsetX = Scene2D::ZoomPointOffset[zoomPoint & 0x3];
+            const int32_t offsetY = Scene2D::ZoomPointOffset[(zoomPoint >> 2) & 0x3];
+            const int32_t centerX = location.X.RawValue() + (offsetX * ux) + (offsetY * vx);
+            const int32_t centerY = location.Y.RawValue() + (offsetX * uy) + (offsetY * vy);
+
+            FIXED* corners = (FIXED*)result;
+            corners[0] = centerX - ux - vx;
+            corners[1] = centerY - uy - vy;
+            corners[2] = centerX + ux - vx;
+            corners[3] = centerY + uy - vy;
+            corners[4] = centerX + ux + vx;
+            corners[5] = centerY + uy + vy;
+            corners[6] = centerX - ux + vx;
+            corners[7] = centerY - uy + vy;
+        }
+
+        /** @brief Draw rotated sprite from precomputed sinus and cosine
          * @param texture Sprite texture
          * @param texturePalette Sprite texture color palette override
          * @param location Location of the sprite (Z coordinate is used for sorting)
-         * @param angle Sprite rotation angle
+         * @param rotation Sinus and cosine of the sprite rotation angle
          * @param scale Scale of the sprite
          * @param zoomPoint Zoom point of the sprite
          * @return True on success
@@ -563,94 +869,92 @@ namespace SRL
             const uint16_t texture,
             SRL::CRAM::Palette* texturePalette,
             const SRL::Math::Types::Vector3D& location,
-            const SRL::Math::Types::Angle& angle = SRL::Math::Types::Angle(),
+            const Scene3D::SinCos& rotation,
             const SRL::Math::Types::Vector2D& scale = SRL::Math::Types::Vector2D(1.0, 1.0),
             const Scene2D::ZoomPoint zoomPoint = Scene2D::ZoomPoint::Center)
         {
-            if (angle.RawValue() != 0)
-            {
-                // Due to bug in SGL we can't use slDispSpriteHV or slDispSpriteSZ with angles
-                const SRL::Math::Types::Fxp sin = Math::Trigonometry::Sin(angle);
-                const SRL::Math::Types::Fxp cos = Math::Trigonometry::Cos(angle);
+            const SRL::Math::Types::Vector2D halfSize = SRL::Math::Types::Vector2D(
+                (SRL::Math::Types::Fxp((int16_t)VDP1::Textures[texture].Width) * scale.X) >> 1,
+                (SRL::Math::Types::Fxp((int16_t)VDP1::Textures[texture].Height) * scale.Y) >> 1);
 
-                const SRL::Math::Types::Vector2D size = SRL::Math::Types::Vector2D(
-                    SRL::Math::Types::Fxp((int16_t)VDP1::Textures[texture].Width) * scale.X,
-                    SRL::Math::Types::Fxp((int16_t)VDP1::Textures[texture].Height) * scale.Y);
-
-                const SRL::Math::Types::Vector2D halfSize = SRL::Math::Types::Vector2D(
-                    (SRL::Math::Types::Fxp((int16_t)VDP1::Textures[texture].Width) * scale.X) >> 1,
-                    (SRL::Math::Types::Fxp((int16_t)VDP1::Textures[texture].Height) * scale.Y) >> 1);
+            SRL::Math::Types::Vector2D points[4];
+            Scene2D::RotateScaleCorners(SRL::Math::Types::Vector2D(location.X, location.Y), halfSize, rotation, zoomPoint, points);
+            return Scene2D::DrawSprite(texture, texturePalette, points, location.Z);
+        }
 
-                // Prepare rotation matrix
-                SRL::Math::Matrix43 rotMat = SRL::Math::Matrix43::Identity();
-                rotMat.RotateZ(angle);
+        /** @brief Draw many rotated sprites sharing texture and scale
+         * @details Sprite attributes and size are calculated only once for the whole batch.
+         * @param texture Sprite texture
+         * @param texturePalette Sprite texture color palette override
+         * @param locations Locations of the sprites (Z coordinate is used for sorting)
+         * @param rotations Sinus and cosine of rotation angle of each sprite, see SRL::Scene3D::CalculateSinCos()
+         * @param count Number of sprites
+         * @param scale Scale of the sprites
+         * @param zoomPoint Zoom point of the sprites
+         * @return Number of drawn sprites
+         */
+        static size_t DrawSprites(
+            const uint16_t texture,
+            SRL::CRAM::Palette* texturePalette,
+            const SRL::Math::Types::Vector3D* locations,
+            const Scene3D::SinCos* rotations,
+            const size_t count,
+            const SRL::Math::Types::Vector2D& scale = SRL::Math::Types::Vector2D(1.0, 1.0),
+            const Scene2D::ZoomPoint zoomPoint = Scene2D::ZoomPoint::Center)
+        {
+            SPR_ATTR attr = Scene2D::GetSpriteAttribute(texture, texturePalette);
+            const SRL::Math::Types::Vector2D halfSize = SRL::Math::Types::Vector2D(
+                (SRL::Math::Types::Fxp((int16_t)VDP1::Textures[texture].Width) * scale.X) >> 1,
+                (SRL::Math::Types::Fxp((int16_t)VDP1::Textures[texture].Height) * scale.Y) >> 1);
 
-                // Set zoom
-                SRL::Math::Types::Vector3D points[4]
-                {
-                    SRL::Math::Types::Vector3D(-halfSize.X, -halfSize.Y, 0.0),
-                    SRL::Math::Types::Vector3D(halfSize.X, -halfSize.Y, 0.0),
-                    SRL::Math::Types::Vector3D(halfSize.X, halfSize.Y, 0.0),
-                    SRL::Math::Types::Vector3D(-halfSize.X, halfSize.Y, 0.0)
-                };
+            SPR_ATTR preClipped = attr;
+            preClipped.atrb &= ~Pclpoff;
+            SRL::Math::Types::Vector2D points[4];
 
-                SRL::Math::Types::Vector3D offsetLocation = SRL::Math::Types::Vector3D();
+            for (size_t index = 0; index < count; index++)
+            {
+                Scene2D::RotateScaleCorners(SRL::Math::Types::Vector2D(locations[index].X, locations[index].Y), halfSize, rotations[index], zoomPoint, points);
+                const Scene2D::ClipTest clip = Scene2D::TestCorners((const FIXED*)points);
 
-                switch (zoomPoint)
+                if (clip == Scene2D::ClipTest::Hidden)
                 {
-                    // Corners
-                    // Corners
-                    case Scene2D::ZoomPoint::UpperLeft:
-                        offsetLocation.X -= halfSize.X;
-                        offsetLocation.Y -= halfSize.Y;
-                        break;
-                
-                    case Scene2D::ZoomPoint::UpperRight:
-                        offsetLocation.X += halfSize.X;
-                        offsetLocation.Y -= halfSize.Y;
-                        break;
-
-                    case Scene2D::ZoomPoint::BottomRight:
-                        offsetLocation.X += halfSize.X;
-                        offsetLocation.Y += halfSize.Y;
-                        break;
-
-                    case Scene2D::ZoomPoint::BottomLeft:
-                        offsetLocation.X -= halfSize.X;
-                        offsetLocation.Y += halfSize.Y;
-                        break;
-
-                    // Center sides
-                    case Scene2D::ZoomPoint::CenterLeft:
-                        offsetLocation.X -= halfSize.X;
-                        break;
-                
-                    case Scene2D::ZoomPoint::TopCenter:
-                        offsetLocation.Y -= halfSize.Y;
-                        break;
-
-                    case Scene2D::ZoomPoint::CenterRight:
-                        offsetLocation.X += halfSize.X;
-                        break;
-
-                    case Scene2D::ZoomPoint::BottomCenter:
-                        offsetLocation.Y += halfSize.Y;
-                        break;
+                    continue;
+                }
 
-                    // Sprite center
-                    default:
-                        break;
+                if (slDispSprite4P((FIXED*)points, locations[index].Z.RawValue(), clip == Scene2D::ClipTest::Partial ? &preClipped : &attr) == 0)
+                {
+                    return index;
                 }
 
-                const SRL::Math::Types::Vector2D realPoints[4] = {
-                    SRL::Math::Types::Vector2D(location + (rotMat.TransformPoint(points[0] + offsetLocation))),
-                    SRL::Math::Types::Vector2D(location + (rotMat.TransformPoint(points[1] + offsetLocation))),
-                    SRL::Math::Types::Vector2D(location + (rotMat.TransformPoint(points[2] + offsetLocation))),
-                    SRL::Math::Types::Vector2D(location + (rotMat.TransformPoint(points[3] + offsetLocation)))
-                };
+                VDP1::Stats::CountDistortedSprite((const FIXED*)points);
+            }
+
+            return count;
+        }
 
-                // Calculate new 4 corners
-                return Scene2D::DrawSprite(texture, texturePalette, realPoints, location.Z);
+        /** @brief Draw simple sprite
+         * @param texture Sprite texture
+         * @param texturePalette Sprite texture color palette override
+         * @param location Location of the sprite (Z coordinate is used for sorting)
+         * @param angle Sprite rotation angle
+         * @param scale Scale of the sprite
+         * @param zoomPoint Zoom point of the sprite
+         * @return True on success
+         */
+        static bool DrawSprite(
+            const uint16_t texture,
+            SRL::CRAM::Palette* texturePalette,
+            const SRL::Math::Types::Vector3D& location,
+            const SRL::Math::Types::Angle& angle = SRL::Math::Types::Angle(),
+            const SRL::Math::Types::Vector2D& scale = SRL::Math::Types::Vector2D(1.0, 1.0),
+            const Scene2D::ZoomPoint zoomPoint = Scene2D::ZoomPoint::Center)
+        {
+            if (angle.RawValue() != 0)
+            {
+                // Due to bug in SGL we can't use slDispSpriteHV or slDispSpriteSZ with angles
+                Scene3D::SinCos rotation;
+                Scene3D::CalculateSinCos(&angle, &rotation, 1);
+                return Scene2D::DrawSprite(texture, texturePalette, location, rotation, scale, zoomPoint);
             }
             else
             {
@@ -664,8 +968,23 @@ namespace SRL
                 sgl_pos[Sh] = scale.X.RawValue();
                 sgl_pos[Sv] = scale.Y.RawValue();
 
+                const Scene2D::ClipTest clip = Scene2D::TestScaledSprite(texture, sgl_pos, zoomPoint);
+
+                if (clip == Scene2D::ClipTest::Hidden)
+                {
+                    return true;
+                }
+
+                attr.atrb &= clip == Scene2D::ClipTest::Partial ? ~Pclpoff : 0xffff;
+
                 // We cannot use slDispSprite, as that seems to be bugged and is drawing images 1px wider than it should
-                return slDispSpriteHV(sgl_pos, &attr, 0) != 0;
+                if (slDispSpriteHV(sgl_pos, &attr, 0) == 0)
+                {
+                    return false;
+                }
+
+                VDP1::Stats::CountScaledSprite(texture, sgl_pos[Sh], sgl_pos[Sv]);
+                return true;
             }
         }
 
@@ -734,7 +1053,17 @@ namespace SRL
             line.YA = start.Y.As<int16_t>();
             line.XB = end.X.As<int16_t>();
             line.YB = end.Y.As<int16_t>();
-            return slSetSprite(&line, sort.RawValue()) != 0;
+
+            if (Scene2D::TestBounds(
+                SRL::Math::Min(line.XA, line.XB),
+                SRL::Math::Min(line.YA, line.YB),
+                SRL::Math::Max(line.XA, line.XB),
+                SRL::Math::Max(line.YA, line.YB)) == Scene2D::ClipTest::Hidden)
+            {
+                return true;
+            }
+
+            return Scene2D::Draw(&line, sort);
         }
 
         /** @brief Draws a generic polygon
@@ -754,11 +1083,756 @@ namespace SRL
             polygon.YC = points[2].Y.As<int16_t>();
             polygon.XD = points[3].X.As<int16_t>();
             polygon.YD = points[3].Y.As<int16_t>();
-            return slSetSprite(&polygon, sort.RawValue());
+
+            if (Scene2D::TestCorners((const FIXED*)points) == Scene2D::ClipTest::Hidden)
+            {
+                return true;
+            }
+
+            return Scene2D::Draw(&polygon, sort);
         }
 
         /** @} */
 
+        /**
+         * @name Animated sprite
+         * @{
+         */
+
+        /** @brief Sprite animated from a sprite sheet
+         * @details All frames of the sheet are copied into a single block of sprite VRAM, which uses only two texture slots no matter how many frames there are.
+         * First slot describes the first frame, so the sheet can be drawn with any texture based function, second slot only reserves memory for the rest of the frames.
+         * Address of every frame and its duration are precomputed, so advancing animation and drawing a frame does not do any size calculation.
+         * Animation is advanced from SRL::Core::GetVblankCount(), it does not depend on how often sprite is drawn.
+         * Frames are read from the sheet left to right and top to bottom, frame width must be divisible by 8.
+         * @code {.cpp}
+         * SRL::Bitmap::TGA* sheet = new SRL::Bitmap::TGA("HERO.TGA");
+         * SRL::Scene2D::AnimatedSprite hero(sheet, 32, 48);
+         * delete sheet;
+         *
+         * // Walk cycle is in frames 8 to 15, each frame is shown for 4 v-blanks
+         * hero.SetDuration(8, 8, 4);
+         * hero.Play(8, 8);
+         *
+         * // In game loop
+         * hero.Draw(Vector3D(0.0, 0.0, 500.0));
+         * @endcode
+         */
+        class AnimatedSprite
+        {
+        private:
+
+            /** @brief Texture slot describing the first frame
+             */
+            int32_t texture;
+
+            /** @brief Number of frames
+             */
+            uint16_t frameCount;
+
+            /** @brief Texture address of each frame
+             */
+            uint16_t* addresses;
+
+            /** @brief Duration of each frame in v-blanks
+             */
+            uint8_t* durations;
+
+            /** @brief First frame of the played clip
+             */
+            uint16_t clipStart;
+
+            /** @brief Number of frames of the played clip
+             */
+            uint16_t clipLength;
+
+            /** @brief Duration of the played clip in v-blanks
+             */
+            uint32_t clipDuration;
+
+            /** @brief Currently shown frame
+             */
+            uint16_t current;
+
+            /** @brief V-blank count when current frame was shown
+             */
+            uint32_t frameStart;
+
+            /** @brief Value indicating whether clip starts over after the last frame
+             */
+            bool looping;
+
+            /** @brief Value indicating whether animation is running
+             */
+            bool playing;
+
+            /** @brief Copy frames of the sheet into sprite VRAM
+             * @param sheetWidth Sheet width
+             * @param sheetHeight Sheet height
+             * @param colorMode Sheet color mode
+             * @param palette Palette identifier (not used in RGB555 mode)
+             * @param data Sheet pixel data
+             * @param frameWidth Frame width (must be divisible by 8)
+             * @param frameHeight Frame height
+             * @param frameCount Number of frames, 0 takes all frames of the sheet
+             * @param duration Duration of every frame in v-blanks
+             */
+            void Load(
+                const uint16_t sheetWidth,
+                const uint16_t sheetHeight,
+                const CRAM::TextureColorMode colorMode,
+                const uint16_t palette,
+                const void* data,
+                const uint16_t frameWidth,
+                const uint16_t frameHeight,
+                const uint16_t frameCount,
+                const uint8_t duration)
+            {
+                const uint8_t shifter = VDP1::GetSizeShifter(colorMode);
+                const size_t sheetRowBytes = (sheetWidth << 2) >> shifter;
+
+                if ((frameWidth & 0x7) != 0 || frameWidth == 0 || frameHeight == 0 ||
+                    frameWidth > sheetWidth || frameHeight > sheetHeight || (sheetRowBytes & 1) != 0)
+                {
+                    SRL::Debug::Assert("Sprite sheet frame size %dx%d is not supported", frameWidth, frameHeight);
+                    return;
+                }
+
+                const uint16_t columns = sheetWidth / frameWidth;
+                const uint16_t available = columns * (sheetHeight / frameHeight);
+                const uint16_t count = frameCount == 0 ? available : SRL::Math::Min(frameCount, available);
+                const size_t rowBytes = (frameWidth << 2) >> shifter;
+
+                // Frames are aligned the same way as textures, so reserved memory starts right after the first frame
+                const size_t stride = ((rowBytes * frameHeight) + 0x1f) & ~0x1f;
+                const uint16_t first = VDP1::GetTextureCount();
+                this->texture = VDP1::TryAllocateTexture(frameWidth, frameHeight, colorMode, palette);
+
+                if (this->texture >= 0 && count > 1 &&
+                    VDP1::TryAllocateTexture(frameWidth, (uint16_t)(((stride * (count - 1)) + rowBytes - 1) / rowBytes), colorMode, palette) < 0)
+                {
+                    VDP1::ResetTextureHeap(first);
+                    this->texture = -1;
+                }
+
+                if (this->texture < 0)
+                {
+                    SRL::Debug::Assert("Not enough texture memory for %d frames", count);
+                    return;
+                }
+
+                this->frameCount = count;
+                this->addresses = new uint16_t[count];
+                this->durations = new uint8_t[count];
+
+                const size_t sheetRowWords = sheetRowBytes >> 1;
+                const size_t rowWords = rowBytes >> 1;
+                const uint16_t base = VDP1::Textures[this->texture].Address;
+
+                for (uint16_t frame = 0; frame < count; frame++)
+                {
+                    this->addresses[frame] = base + (uint16_t)((frame * stride) >> 3);
+                    this->durations[frame] = SRL::Math::Max(duration, (uint8_t)1);
+
+                    // Sheet row stride differs from the frame width, so frame is copied row by row
+                    const uint16_t* source = ((const uint16_t*)data) +
+                        ((frame / columns) * frameHeight * sheetRowWords) +
+                        ((frame % columns) * rowWords);
+                    uint16_t* target = (uint16_t*)(SpriteVRAM + (this->addresses[frame] << 3));
+
+                    for (uint16_t row = 0; row < frameHeight; row++)
+                    {
+                        for (size_t word = 0; word < rowWords; word++)
+                        {
+                            target[word] = source[word];
+                        }
+
+                        source += sheetRowWords;
+                        target += rowWords;
+                    }
+                }
+
+                this->Play(0, count);
+            }
+
+            /** @brief Sum durations of the frames of the played clip
+             */
+            void UpdateClipDuration()
+            {
+                this->clipDuration = 0;
+
+                for (uint16_t frame = this->clipStart; frame < this->clipStart + this->clipLength; frame++)
+                {
+                    this->clipDuration += this->durations[frame];
+                }
+            }
+
+        public:
+
+            /** @brief Load sprite sheet from memory
+             * @param sheetWidth Sheet width
+             * @param sheetHeight Sheet height
+             * @param colorMode Sheet color mode
+             * @param palette Palette identifier (not used in RGB555 mode)
+             * @param data Sheet pixel data, can be freed after sprite was constructed
+             * @param frameWidth Frame width (must be divisible by 8)
+             * @param frameHeight Frame height
+             * @param frameCount Number of frames, 0 takes all frames of the sheet
+             * @param duration Duration of every frame in v-blanks
+             */
+            AnimatedSprite(
+                const uint16_t sheetWidth,
+                const uint16_t sheetHeight,
+                const CRAM::TextureColorMode colorMode,
+                const uint16_t palette,
+                const void* data,
+                const uint16_t frameWidth,
+                const uint16_t frameHeight,
+                const uint16_t frameCount = 0,
+                const uint8_t duration = 1) :
+                texture(-1), frameCount(0), addresses(nullptr), durations(nullptr),
+                clipStart(0), clipLength(0), clipDuration(0), current(0), frameStart(0), looping(false), playing(false)
+            {
+                this->Load(sheetWidth, sheetHeight, colorMode, palette, data, frameWidth, frameHeight, frameCount, duration);
+            }
+
+            /** @brief Load sprite sheet from a bitmap
+             * @param sheet Sheet bitmap, can be freed after sprite was constructed
+             * @param frameWidth Frame width (must be divisible by 8)
+             * @param frameHeight Frame height
+             * @param palette Palette identifier (not used in RGB555 mode)
+             * @param frameCount Number of frames, 0 takes all frames of the sheet
+             * @param duration Duration of every frame in v-blanks
+             */
+            AnimatedSprite(
+                SRL::Bitmap::IBitmap* sheet,
+                const uint16_t frameWidth,
+                const uint16_t frameHeight,
+                const uint16_t palette = 0,
+                const uint16_t frameCount = 0,
+                const uint8_t duration = 1) :
+                texture(-1), frameCount(0), addresses(nullptr), durations(nullptr),
+                clipStart(0), clipLength(0), clipDuration(0), current(0), frameStart(0), looping(false), playing(false)
+            {
+                const SRL::Bitmap::BitmapInfo info = sheet->GetInfo();
+                this->Load(info.Width, info.Height, info.ColorMode, palette, sheet->GetData(), frameWidth, frameHeight, frameCount, duration);
+            }
+
+            /** @brief Disable copy constructor
+             */
+            AnimatedSprite(const AnimatedSprite&) = delete;
+
+            /** @brief Free frame tables, sprite VRAM is freed together with the texture heap
+             */
+            ~AnimatedSprite()
+            {
+                delete[] this->addresses;
+                delete[] this->durations;
+            }
+
+            /** @brief Get a value indicating whether sheet was loaded
+             * @return True if sprite can be drawn
+             */
+            bool IsLoaded() const
+            {
+                return this->texture >= 0;
+            }
+
+            /** @brief Get texture slot describing the first frame
+             * @return Texture index or -1 if sheet was not loaded
+             */
+            int32_t GetTextureIndex() const
+            {
+                return this->texture;
+            }
+
+            /** @brief Get number of frames
+             * @return Frame count
+             */
+            uint16_t GetFrameCount() const
+            {
+                return this->frameCount;
+            }
+
+            /** @brief Get texture address of a frame
+             * @param frame Frame index
+             * @return Address in sprite VRAM in 8 byte units (CMDSRCA)
+             */
+            uint16_t GetFrameAddress(const uint16_t frame) const
+            {
+                return this->addresses[frame];
+            }
+
+            /** @brief Get currently shown frame
+             * @return Frame index
+             */
+            uint16_t GetCurrentFrame() const
+            {
+                return this->current;
+            }
+
+            /** @brief Set duration of a frame
+             * @param frame Frame index
+             * @param vblanks Duration in v-blanks (at least 1)
+             */
+            void SetDuration(const uint16_t frame, const uint8_t vblanks)
+            {
+                this->SetDuration(frame, 1, vblanks);
+            }
+
+            /** @brief Set duration of a range of frames
+             * @param first First frame
+             * @param count Number of frames
+             * @param vblanks Duration in v-blanks (at least 1)
+             */
+            void SetDuration(const uint16_t first, const uint16_t count, const uint8_t vblanks)
+            {
+                for (uint16_t frame = first; frame < first + count && frame < this->frameCount; frame++)
+                {
+                    this->durations[frame] = SRL::Math::Max(vblanks, (uint8_t)1);
+                }
+
+                this->UpdateClipDuration();
+            }
+
+            /** @brief Play clip from its first frame
+             * @param first First frame of the clip
+             * @param count Number of frames, 0 plays until the last frame of the sheet
+             * @param loop Start clip over after its last frame
+             */
+            void Play(const uint16_t first, const uint16_t count = 0, const bool loop = true)
+            {
+                if (first >= this->frameCount)
+                {
+                    return;
+                }
+
+                this->clipStart = first;
+                this->clipLength = count == 0 ? this->frameCount - first : SRL::Math::Min(count, (uint16_t)(this->frameCount - first));
+                this->current = first;
+                this->looping = loop;
+                this->playing = true;
+                this->frameStart = SRL::Core::GetVblankCount();
+                this->UpdateClipDuration();
+            }
+
+            /** @brief Stop animation on current frame
+             */
+            void Stop()
+            {
+                this->playing = false;
+            }
+
+            /** @brief Show a frame and stop animation
+             * @param frame Frame index
+             */
+            void SetFrame(const uint16_t frame)
+            {
+                this->current = frame < this->frameCount ? frame : this->current;
+                this->playing = false;
+            }
+
+            /** @brief Get a value indicating whether animation is running
+             * @return False when stopped or when clip without loop reached its last frame
+             */
+            bool IsPlaying() const
+            {
+                return this->playing;
+            }
+
+            /** @brief Advance animation
+             * @param vblank Current v-blank count
+             */
+            void Update(const uint32_t vblank)
+            {
+                if (!this->playing || this->clipDuration == 0)
+                {
+                    return;
+                }
+
+                uint32_t elapsed = vblank - this->frameStart;
+
+                // Whole loops of the clip end on the same frame
+                if (this->looping && elapsed >= this->clipDuration)
+                {
+                    this->frameStart += elapsed - (elapsed % this->clipDuration);
+                    elapsed %= this->clipDuration;
+                }
+
+                while (elapsed >= this->durations[this->current])
+                {
+                    elapsed -= this->durations[this->current];
+                    this->frameStart += this->durations[this->current];
+
+                    if (this->current + 1 < this->clipStart + this->clipLength)
+                    {
+                        this->current++;
+                    }
+                    else if (this->looping)
+                    {
+                        this->current = this->clipStart;
+                    }
+                    else
+                    {
+                        this->playing = false;
+                        break;
+                    }
+                }
+            }
+
+            /** @brief Advance animation to current v-blank
+             */
+            void Update()
+            {
+                this->Update(SRL::Core::GetVblankCount());
+            }
+
+            /** @brief Advance animation and draw current frame
+             * @details Current sprite effects are applied, except for flip, which is given by parameter.
+             * @param location Center of the sprite in screen coordinates, Z is depth sort value
+             * @param scale Sprite scale
+             * @param flip Sprite flip
+             * @return True on success
+             */
+            bool Draw(
+                const SRL::Math::Types::Vector3D& location,
+                const SRL::Math::Types::Fxp& scale = 1.0,
+                const Scene2D::FlipEffect flip = Scene2D::FlipEffect::NoFlip)
+            {
+                if (this->texture < 0)
+                {
+                    return false;
+                }
+
+                this->Update();
+
+                const VDP1::Texture& frame = VDP1::Textures[this->texture];
+                const int32_t factor = scale.RawValue() >> 8;
+                const int32_t width = (frame.Width * factor) >> 8;
+                const int32_t height = (frame.Height * factor) >> 8;
+
+                if (width <= 0 || height <= 0)
+                {
+                    return false;
+                }
+
+                const SPR_ATTR attribute = Scene2D::GetSpriteAttribute(this->texture, nullptr);
+                SPRITE command = Scene2D::GetSpriteCommand(Scene2D::CommandType::RectangleSprite, Types::HighColor());
+                command.CTRL = (uint16_t)Scene2D::CommandType::RectangleSprite | (flip << 4);
+                command.PMOD = attribute.atrb;
+                command.COLR = attribute.colno;
+                command.GRDA = attribute.gstb;
+                command.SRCA = this->addresses[this->current];
+                command.SIZE = frame.Size;
+                command.XA = location.X.As<int16_t>() - (width >> 1);
+                command.YA = location.Y.As<int16_t>() - (height >> 1);
+                command.XC = command.XA + width - 1;
+                command.YC = command.YA + height - 1;
+
+                const Scene2D::ClipTest clip = Scene2D::TestBounds(command.XA, command.YA, command.XC, command.YC);
+
+                if (clip == Scene2D::ClipTest::Hidden)
+                {
+                    return true;
+                }
+
+                command.PMOD &= clip == Scene2D::ClipTest::Partial ? ~Pclpoff : 0xffff;
+                return Scene2D::Draw(&command, location.Z);
+            }
+        };
+
+        /** @} */
+
+        /**
+         * @name Sprite batch
+         * @{
+         */
+
+        /** @brief Sprites stored as structure of arrays and emitted as VDP1 commands in a single pass
+         * @details Every sprite is drawn as a scaled sprite command built directly from texture data, no SPR_ATTR is created and no SGL sprite projection is done per sprite.
+         * Command template is rebuilt only when texture changes between consecutive sprites, so sprites sorted by texture are cheapest.
+         * Frames of an animated sprite (see SRL::Scene2D::AnimatedSprite) share its texture, so they do not break the template either.
+         * Sprites completely outside of the cull rectangle or clipped whole by the clipping stack (see SRL::Scene2D::PushClippingRectangle()) are skipped before any command is written.
+         * Effects (see SRL::Scene2D::SetEffect()) are read once when SRL::Scene2D::SpriteBatch::Draw() is called.
+         * @tparam Capacity Maximal number of sprites
+         * @code {.cpp}
+         * SRL::Scene2D::SpriteBatch<512> bullets;
+         *
+         * // In game loop
+         * bullets.Clear();
+         *
+         * for (Bullet& bullet : activeBullets)
+         * {
+         *     bullets.Add(bullet.Position, bulletTexture);
+         * }
+         *
+         * bullets.Draw(500.0);
+         * @endcode
+         */
+        template<uint16_t Capacity>
+        class SpriteBatch
+        {
+        public:
+
+            /** @brief Sprite X coordinates (sprite center, 0 is center of the screen)
+             */
+            int16_t X[Capacity];
+
+            /** @brief Sprite Y coordinates (sprite center, 0 is center of the screen)
+             */
+            int16_t Y[Capacity];
+
+            /** @brief Sprite textures
+             */
+            uint16_t Texture[Capacity];
+
+            /** @brief Sprite texture addresses in 8 byte units (frame of an animated sprite, otherwise address of the texture)
+             */
+            uint16_t Source[Capacity];
+
+            /** @brief Sprite scales in 8.8 fixed point (256 is original size)
+             */
+            uint16_t Scale[Capacity];
+
+            /** @brief Sprite flip, see SRL::Scene2D::FlipEffect
+             */
+            uint8_t Flip[Capacity];
+
+        private:
+
+            /** @brief Number of sprites in the batch
+             */
+            uint16_t count;
+
+            /** @brief Cull rectangle left edge
+             */
+            int16_t left;
+
+            /** @brief Cull rectangle top edge
+             */
+            int16_t top;
+
+            /** @brief Cull rectangle right edge
+             */
+            int16_t right;
+
+            /** @brief Cull rectangle bottom edge
+             */
+            int16_t bottom;
+
+            /** @brief Number of commands written by last draw
+             */
+            uint16_t emitted;
+
+            /** @brief Number of sprites outside of the cull rectangle in last draw
+             */
+            uint16_t culled;
+
+            /** @brief Number of visible sprites not drawn in last draw because of sprite budget or full command buffer
+             */
+            uint16_t dropped;
+
+        public:
+
+            /** @brief Construct empty batch culled against the whole screen
+             */
+            SpriteBatch() : count(0), emitted(0), culled(0), dropped(0)
+            {
+                this->SetCullRectangle(
+                    SRL::Math::Types::Vector2D(SRL::Math::Types::Fxp((int16_t)(-(SRL::TV::Width >> 1))), SRL::Math::Types::Fxp((int16_t)(-(SRL::TV::Height >> 1)))),
+                    SRL::Math::Types::Vector2D(SRL::Math::Types::Fxp((int16_t)SRL::TV::Width), SRL::Math::Types::Fxp((int16_t)SRL::TV::Height)));
+            }
+
+            /** @brief Set rectangle sprites are culled against
+             * @param location Rectangle top left corner (0 is center of the screen)
+             * @param size Rectangle size
+             */
+            void SetCullRectangle(const SRL::Math::Types::Vector2D& location, const SRL::Math::Types::Vector2D& size)
+            {
+                this->left = location.X.As<int16_t>();
+                this->top = location.Y.As<int16_t>();
+                this->right = (location.X + size.X).As<int16_t>();
+                this->bottom = (location.Y + size.Y).As<int16_t>();
+            }
+
+            /** @brief Remove all sprites from the batch
+             */
+            void Clear()
+            {
+                this->count = 0;
+            }
+
+            /** @brief Get number of sprites in the batch
+             * @return Sprite count
+             */
+            uint16_t Count() const
+            {
+                return this->count;
+            }
+
+            /** @brief Add sprite to the batch
+             * @param location Sprite center
+             * @param texture Sprite texture
+             * @param scale Sprite scale
+             * @param flip Sprite flip
+             * @return Index of the sprite, or Capacity if batch is full
+             */
+            uint16_t Add(
+                const SRL::Math::Types::Vector2D& location,
+                const uint16_t texture,
+                const SRL::Math::Types::Fxp& scale = 1.0,
+                const Scene2D::FlipEffect flip = Scene2D::FlipEffect::NoFlip)
+            {
+                if (this->count >= Capacity)
+                {
+                    return Capacity;
+                }
+
+                const uint16_t index = this->count++;
+                this->X[index] = location.X.As<int16_t>();
+                this->Y[index] = location.Y.As<int16_t>();
+                this->Texture[index] = texture;
+                this->Source[index] = VDP1::Textures[texture].Address;
+                this->Scale[index] = (uint16_t)(scale.RawValue() >> 8);
+                this->Flip[index] = flip;
+                return index;
+            }
+
+            /** @brief Add current frame of an animated sprite to the batch
+             * @details Animation is advanced before the frame is taken. Frames of the same sprite share command template.
+             * @param location Sprite center
+             * @param sprite Animated sprite
+             * @param scale Sprite scale
+             * @param flip Sprite flip
+             * @return Index of the sprite, or Capacity if batch is full or sprite is not loaded
+             */
+            uint16_t Add(
+                const SRL::Math::Types::Vector2D& location,
+                AnimatedSprite& sprite,
+                const SRL::Math::Types::Fxp& scale = 1.0,
+                const Scene2D::FlipEffect flip = Scene2D::FlipEffect::NoFlip)
+            {
+                if (!sprite.IsLoaded())
+                {
+                    return Capacity;
+                }
+
+                sprite.Update();
+                const uint16_t index = this->Add(location, (uint16_t)sprite.GetTextureIndex(), scale, flip);
+
+                if (index < Capacity)
+                {
+                    this->Source[index] = sprite.GetFrameAddress(sprite.GetCurrentFrame());
+                }
+
+                return index;
+            }
+
+            /** @brief Emit commands of all visible sprites
+             * @details Drawing stops once sprite budget of SRL::Governor left for this frame is used up.
+             * @param depth Depth sort value of the whole batch
+             * @return Number of emitted commands
+             */
+            uint16_t Draw(const SRL::Math::Types::Fxp& depth)
+            {
+                const uint16_t budget = SRL::Governor::IsEnabled() ? SRL::Governor::GetRemainingSprites() : 0xffff;
+                SPRITE command = Scene2D::GetSpriteCommand(Scene2D::CommandType::RectangleSprite, Types::HighColor());
+                uint16_t currentTexture = 0xffff;
+                uint16_t mode = 0;
+                int32_t width = 0;
+                int32_t height = 0;
+
+                this->emitted = 0;
+                this->culled = 0;
+                this->dropped = 0;
+
+                for (uint16_t index = 0; index < this->count; index++)
+                {
+                    // Rebuild command template only when texture changes
+                    if (this->Texture[index] != currentTexture)
+                    {
+                        currentTexture = this->Texture[index];
+                        const SPR_ATTR attribute = Scene2D::GetSpriteAttribute(currentTexture, nullptr);
+                        mode = attribute.atrb;
+                        command.COLR = attribute.colno;
+                        command.GRDA = attribute.gstb;
+                        command.SIZE = VDP1::Textures[currentTexture].Size;
+                        width = VDP1::Textures[currentTexture].Width;
+                        height = VDP1::Textures[currentTexture].Height;
+                    }
+
+                    // Two point scaled sprite, lower right corner is inclusive
+                    const int32_t scaledWidth = (width * this->Scale[index]) >> 8;
+                    const int32_t scaledHeight = (height * this->Scale[index]) >> 8;
+                    const int32_t x = this->X[index] - (scaledWidth >> 1);
+                    const int32_t y = this->Y[index] - (scaledHeight >> 1);
+
+                    const Scene2D::ClipTest clip = Scene2D::TestBounds(x, y, x + scaledWidth - 1, y + scaledHeight - 1);
+
+                    if (x + scaledWidth <= this->left || x >= this->right ||
+                        y + scaledHeight <= this->top || y >= this->bottom ||
+                        clip == Scene2D::ClipTest::Hidden)
+                    {
+                        this->culled++;
+                        continue;
+                    }
+
+                    if (this->emitted >= budget)
+                    {
+                        this->dropped++;
+                        continue;
+                    }
+
+                    command.CTRL = (uint16_t)Scene2D::CommandType::RectangleSprite | (this->Flip[index] << 4);
+                    command.PMOD = clip == Scene2D::ClipTest::Partial ? mode & ~Pclpoff : mode;
+                    command.SRCA = this->Source[index];
+                    command.XA = x;
+                    command.YA = y;
+                    command.XC = x + scaledWidth - 1;
+                    command.YC = y + scaledHeight - 1;
+
+                    if (!slSetSprite(&command, depth.RawValue()))
+                    {
+                        // Command buffer is full, rest of the batch is dropped
+                        this->dropped += this->count - index;
+                        break;
+                    }
+
+                    VDP1::Stats::Count(VDP1::Stats::Command::ScaledSprite, (uint32_t)(scaledWidth * scaledHeight));
+                    this->emitted++;
+                }
+
+                SRL::Governor::ConsumeSprites(this->emitted);
+                return this->emitted;
+            }
+
+            /** @brief Get number of commands written by last draw
+             * @return Emitted command count
+             */
+            uint16_t GetEmittedCount() const
+            {
+                return this->emitted;
+            }
+
+            /** @brief Get number of sprites culled by last draw
+             * @return Culled sprite count
+             */
+            uint16_t GetCulledCount() const
+            {
+                return this->culled;
+            }
+
+            /** @brief Get number of visible sprites not drawn by last draw because of sprite budget or full command buffer
+             * @return Dropped sprite count
+             */
+            uint16_t GetDroppedCount() const
+            {
+                return this->dropped;
+            }
+        };
+
+        /** @} */
+
         /**
          * @name Sprite effect functions
          * @{
@@ -771,13 +1845,130 @@ namespace SRL
          */
         static inline bool SetClippingRectangle(const SRL::Math::Types::Vector3D& location, const SRL::Math::Types::Vector2D& size)
         {
-            SPRITE sprite;
-            sprite.CTRL = FUNC_UserClip;
-            sprite.XA = location.X.As<int16_t>();
-            sprite.YA = location.Y.As<int16_t>();
-            sprite.XC = (location.X + size.X).As<int16_t>();
-            sprite.YC = (location.Y + size.Y).As<int16_t>();
-            return slSetSprite(&sprite, location.Z.RawValue());
+            // Always written, so the rectangle replaces whatever clipping stack emitted before
+            Scene2D::clipEmitted = false;
+            const Scene2D::ClipRectangle rectangle = {
+                location.X.As<int16_t>(),
+                location.Y.As<int16_t>(),
+                (location.X + size.X).As<int16_t>(),
+                (location.Y + size.Y).As<int16_t>(),
+                0 };
+
+            return Scene2D::EmitClipping(rectangle, location.Z);
+        }
+
+        /** @brief Push clipping rectangle on the clipping stack
+         * @details User clipping command is skipped only if the same rectangle was just written at the same depth.
+         * While the stack is not empty, sprites, lines and polygons drawn by SRL::Scene2D that would be clipped whole are rejected on CPU,
+         * and sprites crossing the rectangle edge are drawn with pre-clipping enabled even if SRL::Scene2D::SpriteEffect::DisablePreClip is set.
+         * Commands are depth sorted, so the rectangle affects only commands sorted after it. CPU rejection assumes the rectangle on top
+         * of the stack is the one VDP1 uses, so commands drawn between push and pop must sort between the push and pop depths,
+         * and pushes of other rectangles must not sort in between.
+         * Rectangles left on the stack are dropped by SRL::Core::Synchronize().
+         * @code {.cpp}
+         * // Left half of split screen
+         * SRL::Scene2D::PushClippingRectangle(SRL::Math::Types::Vector3D(0.0, 0.0, 500.0), SRL::Math::Types::Vector2D(159.0, 223.0));
+         * DrawPlayerView(0);
+         * SRL::Scene2D::PopClippingRectangle(500.0);
+         * @endcode
+         * @param location Rectangle top left corner location in screen coordinates, where top left corner of the screen is (0,0), Z is depth sort value
+         * @param size Rectangle size
+         * @param mode Clipping mode used while the rectangle is on the stack
+         * @return True on success
+         */
+        static bool PushClippingRectangle(
+            const SRL::Math::Types::Vector3D& location,
+            const SRL::Math::Types::Vector2D& size,
+            const Scene2D::ClippingEffect mode = Scene2D::ClippingEffect::ClipOutside)
+        {
+            if (Scene2D::clipDepth >= Scene2D::ClipStackSize)
+            {
+                SRL::Debug::Assert("Clipping stack is full");
+                return false;
+            }
+
+            const Scene2D::ClipRectangle rectangle = {
+                location.X.As<int16_t>(),
+                location.Y.As<int16_t>(),
+                (location.X + size.X).As<int16_t>(),
+                (location.Y + size.Y).As<int16_t>(),
+                (uint8_t)Scene2D::Effects.Clipping };
+
+            if (!Scene2D::EmitClipping(rectangle, location.Z))
+            {
+                return false;
+            }
+
+            Scene2D::clipStack[Scene2D::clipDepth++] = rectangle;
+            Scene2D::Effects.Clipping = mode & 0x3;
+            return true;
+        }
+
+        /** @brief Pop clipping rectangle from the clipping stack
+         * @details Rectangle below is written again, unless it was just written at the same depth, clipping mode set before the push is restored.
+         * @param depth Depth sort value of the restored rectangle
+         * @return True on success
+         */
+        static bool PopClippingRectangle(const SRL::Math::Types::Fxp& depth)
+        {
+            if (Scene2D::clipDepth == 0)
+            {
+                SRL::Debug::Assert("Clipping stack is empty");
+                return false;
+            }
+
+            Scene2D::clipDepth--;
+            Scene2D::Effects.Clipping = Scene2D::clipStack[Scene2D::clipDepth].PreviousMode;
+            return Scene2D::clipDepth > 0 ? Scene2D::EmitClipping(Scene2D::clipStack[Scene2D::clipDepth - 1], depth) : true;
+        }
+
+        /** @brief Write top of the clipping stack again after something else changed the user clipping rectangle
+         * @param depth Depth sort value
+         * @return True on success
+         */
+        static bool RestoreClippingRectangle(const SRL::Math::Types::Fxp& depth)
+        {
+            return Scene2D::clipDepth > 0 ? Scene2D::EmitClipping(Scene2D::clipStack[Scene2D::clipDepth - 1], depth) : true;
+        }
+
+        /** @brief Get clipping rectangle on top of the clipping stack
+         * @param topLeft Top left corner in screen coordinates, where top left corner of the screen is (0,0)
+         * @param bottomRight Bottom right corner, inclusive
+         * @return True if the stack is not empty and its rectangle limits drawing to its inside (SRL::Scene2D::ClippingEffect::ClipOutside)
+         */
+        static bool GetClippingRectangle(SRL::Math::Types::Vector2D& topLeft, SRL::Math::Types::Vector2D& bottomRight)
+        {
+            if (Scene2D::clipDepth == 0 || Scene2D::Effects.Clipping != Scene2D::ClippingEffect::ClipOutside)
+            {
+                return false;
+            }
+
+            const Scene2D::ClipRectangle& clip = Scene2D::clipStack[Scene2D::clipDepth - 1];
+            topLeft = SRL::Math::Types::Vector2D(clip.Left, clip.Top);
+            bottomRight = SRL::Math::Types::Vector2D(clip.Right, clip.Bottom);
+            return true;
+        }
+
+        /** @brief Get number of rectangles on the clipping stack
+         * @return Stack depth
+         */
+        static uint8_t GetClippingDepth()
+        {
+            return Scene2D::clipDepth;
+        }
+
+        /** @brief Test screen area against the clipping rectangle on top of the clipping stack
+         * @param topLeft Top left corner of the area (0 is center of the screen)
+         * @param bottomRight Bottom right corner of the area, inclusive
+         * @return Test result, always SRL::Scene2D::ClipTest::Visible when the stack is empty
+         */
+        static Scene2D::ClipTest TestClipping(const SRL::Math::Types::Vector2D& topLeft, const SRL::Math::Types::Vector2D& bottomRight)
+        {
+            return Scene2D::TestBounds(
+                topLeft.X.As<int16_t>(),
+                topLeft.Y.As<int16_t>(),
+                bottomRight.X.As<int16_t>(),
+                bottomRight.Y.As<int16_t>());
         }
 
         /** @brief Set sprite effect
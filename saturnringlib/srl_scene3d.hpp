@@ -2,6 +2,7 @@
 
 #include "srl_base.hpp"
 #include "srl_mesh.hpp"
+#include "srl_governor.hpp"
 
 namespace SRL
 {
@@ -31,6 +32,7 @@ namespace SRL
         static void DrawSmoothMesh(Types::SmoothMesh& mesh, SRL::Math::Types::Vector3D& light)
         {
             slPutPolygonX(mesh.SglPtr(), (FIXED*)&light);
+            VDP1::Stats::Count(VDP1::Stats::Command::MeshFace, 0, mesh.FaceCount);
         }
 
         /** @brief Draw SRL::Types::Mesh
@@ -40,12 +42,13 @@ namespace SRL
          */
         static bool DrawMesh(Types::Mesh& mesh, const bool slaveOnly = false)
         {
-            if (slaveOnly)
+            if (!(slaveOnly ? slPutPolygonS(mesh.SglPtr()) : slPutPolygon(mesh.SglPtr())))
             {
-                return slPutPolygonS(mesh.SglPtr());
+                return false;
             }
-            
-            return slPutPolygon(mesh.SglPtr());
+
+            VDP1::Stats::Count(VDP1::Stats::Command::MeshFace, 0, mesh.FaceCount);
+            return true;
         }
         
         /** @brief Draw SRL::Types::Mesh with orthographic projection
@@ -56,7 +59,13 @@ namespace SRL
          */
         static bool DrawOrthographicMesh(Types::Mesh& mesh, uint16_t attribute)
         {
-            return slDispPolygon(mesh.SglPtr(), attribute);
+            if (!slDispPolygon(mesh.SglPtr(), attribute))
+            {
+                return false;
+            }
+
+            VDP1::Stats::Count(VDP1::Stats::Command::MeshFace, 0, mesh.FaceCount);
+            return true;
         }
 
         /** @} */
@@ -78,7 +87,7 @@ namespace SRL
          * 
          * SRL::Scene3D::LightInitGouraudTable(0, vertWork, workTable, MAX_POLYGON);
          * @endcode
-         * @param gouraudRamOffset Relative address to the first entry from which to write light gouraud data in SRL::VDP1::GetGouraudTable(). Using 0 here would mean first entry, 2 is second entry in the table, where each entry is 4 color long.
+         * @param gouraudRamOffset Relative address to the first entry from which to write light gouraud data in SRL::VDP1::GetGouraudTable(). Using 0 here would mean first entry, 2 is second entry in the table, where each entry is 4 color long. See SRL::GouraudTable::Reserve().
          * @param vertexCalculationBuffer Vertex arithmetic work buffer
          * @param tableStorage Work gouraud table with size of maxPolygons
          * @param maxPolygons Maximum number of polygons that can be processed by the light calculation
@@ -162,7 +171,7 @@ namespace SRL
          */
 
         /** @brief Set the gouraud table used for depth shading
-         * @param gouraudRamOffset Relative address to the first entry from which to write light gouraud data in SRL::VDP1::GetGouraudTable(). Using 0 here would mean first entry, 2 is second entry in the table, where each entry is 4 color long.
+         * @param gouraudRamOffset Relative address to the first entry from which to write light gouraud data in SRL::VDP1::GetGouraudTable(). Using 0 here would mean first entry, 2 is second entry in the table, where each entry is 4 color long. See SRL::GouraudTable::Reserve().
          * @param table Custom depth shading table
          */
         static void SetDepthShadingTable(const uint32_t gouraudRamOffset, Types::HighColor table[32])
@@ -493,6 +502,1056 @@ namespace SRL
         }
 
         /** @} */
+
+        /**
+         * @name Precomputed rotation
+         * @{
+         */
+
+        /** @brief Sinus and cosine pair of a single angle
+         */
+        struct SinCos
+        {
+            /** @brief Sinus value
+             */
+            SRL::Math::Types::Fxp Sin;
+
+            /** @brief Cosine value
+             */
+            SRL::Math::Types::Fxp Cos;
+        };
+
+    private:
+
+        /** @brief Quarter-wave sinus table
+         * @details 256 steps from 0 to 90 degrees plus one entry for interpolation, generated at compile time
+         */
+        struct SineTable
+        {
+            /** @brief Raw fixed point sinus values
+             */
+            int32_t Values[257];
+
+            /** @brief Fill the table
+             */
+            constexpr SineTable() : Values()
+            {
+                for (int32_t step = 0; step <= 256; step++)
+                {
+                    // Taylor series converges quickly on the first quadrant
+                    const double x = (step * 1.5707963267948966) / 256.0;
+                    double term = x;
+                    double sum = x;
+
+                    for (int32_t n = 1; n < 10; n++)
+                    {
+                        term *= -(x * x) / ((2.0 * n) * ((2.0 * n) + 1.0));
+                        sum += term;
+                    }
+
+                    this->Values[step] = (int32_t)((sum * 65536.0) + 0.5);
+                }
+            }
+        };
+
+        /** @brief Get quarter-wave sinus table
+         * @details Table is generated at compile time, function body is compiled once SineTable is complete
+         * @return Sinus table
+         */
+        inline static const SineTable& GetSineTable()
+        {
+            static constexpr SineTable table = SineTable();
+            return table;
+        }
+
+        /** @brief Look up sinus of a raw angle
+         * @param angle Raw angle (full circle is 65536)
+         * @return Raw fixed point sinus value
+         */
+        inline static int32_t LookupSin(const uint16_t angle)
+        {
+            // Mirror second and fourth quadrant, negate the lower half-wave
+            const uint16_t quarter = (angle & 0x4000) != 0 ? 0x4000 - (angle & 0x3fff) : (angle & 0x3fff);
+            const int32_t step = quarter >> 6;
+            const int32_t fraction = quarter & 0x3f;
+            const int32_t* table = Scene3D::GetSineTable().Values;
+            const int32_t low = table[step];
+            const int32_t value = step < 256 ? low + (((table[step + 1] - low) * fraction) >> 6) : low;
+            return (angle & 0x8000) != 0 ? -value : value;
+        }
+
+    public:
+
+        /** @brief Calculate sinus and cosine of multiple angles in one pass
+         * @details Values are interpolated from a quarter-wave table, error is under 1/16384.
+         * @param angles Angles to calculate
+         * @param result Sinus and cosine pairs, one per angle
+         * @param count Number of angles
+         */
+        inline static void CalculateSinCos(const SRL::Math::Types::Angle* angles, SinCos* result, const size_t count)
+        {
+            for (size_t index = 0; index < count; index++)
+            {
+                const uint16_t angle = (uint16_t)angles[index].RawValue();
+                result[index].Sin = SRL::Math::Types::Fxp::BuildRaw(Scene3D::LookupSin(angle));
+                result[index].Cos = SRL::Math::Types::Fxp::BuildRaw(Scene3D::LookupSin(angle + 0x4000));
+            }
+        }
+
+        /** @brief Build rotation matrix around X, Y and Z axis directly from sinus and cosine values
+         * @details Result is the same as calling SRL::Scene3D::RotateX(), SRL::Scene3D::RotateY() and SRL::Scene3D::RotateZ() in that order on identity matrix.
+         * @param values Sinus and cosine of rotation around X, Y and Z axis
+         * @param result Rotation matrix with zero translation
+         */
+        inline static void BuildRotation(const SinCos values[3], SRL::Math::Matrix43* result)
+        {
+            const int64_t sx = values[0].Sin.RawValue();
+            const int64_t cx = values[0].Cos.RawValue();
+            const int64_t sy = values[1].Sin.RawValue();
+            const int64_t cy = values[1].Cos.RawValue();
+            const int64_t sz = values[2].Sin.RawValue();
+            const int64_t cz = values[2].Cos.RawValue();
+            const int64_t sxsy = (sx * sy) >> 16;
+            const int64_t cxsy = (cx * sy) >> 16;
+
+            // Rows of Rx * Ry * Rz, last row is translation
+            FIXED* matrix = (FIXED*)result;
+            matrix[0] = (FIXED)((cy * cz) >> 16);
+            matrix[1] = (FIXED)(-((cy * sz) >> 16));
+            matrix[2] = (FIXED)sy;
+            matrix[3] = (FIXED)(((cx * sz) + (sxsy * cz)) >> 16);
+            matrix[4] = (FIXED)(((cx * cz) - (sxsy * sz)) >> 16);
+            matrix[5] = (FIXED)(-((sx * cy) >> 16));
+            matrix[6] = (FIXED)(((sx * sz) - (cxsy * cz)) >> 16);
+            matrix[7] = (FIXED)(((sx * cz) + (cxsy * sz)) >> 16);
+            matrix[8] = (FIXED)((cx * cy) >> 16);
+            matrix[9] = 0;
+            matrix[10] = 0;
+            matrix[11] = 0;
+        }
+
+        /** @brief Rotate current matrix around X, Y and Z axis (in that order) by precomputed sinus and cosine values
+         * @details Single matrix multiplication replaces three separate rotations.
+         * @param values Sinus and cosine of rotation around X, Y and Z axis
+         */
+        inline static void RotateXYZ(const SinCos values[3])
+        {
+            SRL::Math::Matrix43 rotation;
+            Scene3D::BuildRotation(values, &rotation);
+            Scene3D::MultiplyMatrix(rotation);
+        }
+
+        /** @brief Rotation of a single object with cached sinus, cosine and rotation matrix
+         * @details Trigonometry of an axis is recalculated only when its angle changes and rotation matrix only when any angle changed.
+         * @code {.cpp}
+         * SRL::Scene3D::Orientation orientation;
+         *
+         * // In game loop
+         * orientation.Set(pitch, yaw, 0);
+         * SRL::Scene3D::PushMatrix();
+         * {
+         *     SRL::Scene3D::Translate(position);
+         *     SRL::Scene3D::Rotate(orientation);
+         *     SRL::Scene3D::DrawMesh(mesh);
+         * }
+         * SRL::Scene3D::PopMatrix();
+         * @endcode
+         */
+        struct Orientation
+        {
+        private:
+
+            /** @brief Rotation around X, Y and Z axis
+             */
+            SRL::Math::Types::Angle angles[3];
+
+            /** @brief Cached sinus and cosine of each angle
+             */
+            SinCos values[3];
+
+            /** @brief Cached rotation matrix
+             */
+            SRL::Math::Matrix43 matrix;
+
+            /** @brief Value indicating whether matrix needs to be rebuilt
+             */
+            bool dirty;
+
+        public:
+
+            /** @brief Construct orientation with no rotation
+             */
+            Orientation() : matrix(SRL::Math::Matrix43::Identity()), dirty(false)
+            {
+                for (uint8_t axis = 0; axis < 3; axis++)
+                {
+                    this->angles[axis] = SRL::Math::Types::Angle();
+                    this->values[axis].Sin = 0.0;
+                    this->values[axis].Cos = 1.0;
+                }
+            }
+
+            /** @brief Set rotation
+             * @param x Rotation around X axis
+             * @param y Rotation around Y axis
+             * @param z Rotation around Z axis
+             */
+            void Set(const SRL::Math::Types::Angle x, const SRL::Math::Types::Angle y, const SRL::Math::Types::Angle z)
+            {
+                const SRL::Math::Types::Angle angles[3] = { x, y, z };
+
+                for (uint8_t axis = 0; axis < 3; axis++)
+                {
+                    if (angles[axis].RawValue() != this->angles[axis].RawValue())
+                    {
+                        this->angles[axis] = angles[axis];
+                        Scene3D::CalculateSinCos(&this->angles[axis], &this->values[axis], 1);
+                        this->dirty = true;
+                    }
+                }
+            }
+
+            /** @brief Get rotation around an axis
+             * @param axis Axis index (0 = X, 1 = Y, 2 = Z)
+             * @return Rotation angle
+             */
+            SRL::Math::Types::Angle Get(const uint8_t axis) const
+            {
+                return this->angles[axis];
+            }
+
+            /** @brief Get cached sinus and cosine values
+             * @return Sinus and cosine of rotation around X, Y and Z axis
+             */
+            const SinCos* GetSinCos() const
+            {
+                return this->values;
+            }
+
+            /** @brief Get rotation matrix, rebuilt only if rotation changed
+             * @return Rotation matrix
+             */
+            SRL::Math::Matrix43& GetMatrix()
+            {
+                if (this->dirty)
+                {
+                    Scene3D::BuildRotation(this->values, &this->matrix);
+                    this->dirty = false;
+                }
+
+                return this->matrix;
+            }
+        };
+
+        /** @brief Rotate current matrix by cached orientation
+         * @param orientation Object orientation
+         */
+        inline static void Rotate(Orientation& orientation)
+        {
+            Scene3D::MultiplyMatrix(orientation.GetMatrix());
+        }
+
+        /** @} */
+
+        /**
+         * @name Scene graph
+         * @{
+         */
+
+        template<uint16_t Capacity>
+        class SceneGraph;
+
+        /** @brief Node of the SRL::Scene3D::SceneGraph
+         * @details Node holds its local translation, rotation and scale relative to its parent node and a cached world matrix.
+         * Local transformation can only be changed through setters, which mark the node dirty, so world matrix of the node and all its children is recalculated on next SRL::Scene3D::SceneGraph::Update() call.
+         */
+        struct Node
+        {
+            /** @brief Scene graph needs access to the cached state
+             */
+            template<uint16_t> friend class Scene3D::SceneGraph;
+
+        private:
+
+            /** @brief Local position
+             */
+            SRL::Math::Types::Vector3D position;
+
+            /** @brief Local rotation around X, Y and Z axis (applied in that order)
+             */
+            SRL::Math::Types::Angle rotation[3];
+
+            /** @brief Cached sinus and cosine of the local rotation
+             */
+            SinCos rotationValues[3];
+
+            /** @brief Local scale
+             */
+            SRL::Math::Types::Vector3D scale;
+
+            /** @brief Cached world matrix
+             */
+            SRL::Math::Matrix43 world;
+
+            /** @brief Index of the parent node, or SRL::Scene3D::Node::NoParent
+             */
+            uint16_t parent;
+
+            /** @brief Largest scale factor of the world matrix, applied to the bounding radius
+             */
+            SRL::Math::Types::Fxp worldScale;
+
+            /** @brief Value indicating whether local transformation changed since last update
+             */
+            bool dirty;
+
+            /** @brief Value indicating whether world matrix was recalculated during last update
+             */
+            bool updated;
+
+        public:
+
+            /** @brief Parent index of the root nodes
+             */
+            static constexpr uint16_t NoParent = 0xffff;
+
+            /** @brief Mesh drawn at the node location (can be nullptr for pure transformation nodes)
+             */
+            Types::Mesh* Mesh;
+
+            /** @brief Radius of the sphere enclosing the mesh, used for visibility test
+             * @details Radius is in mesh space, it is multiplied by the largest world scale factor of the node before the test.
+             * @note Set to zero to disable the test for this node
+             */
+            SRL::Math::Types::Fxp BoundingRadius;
+
+            /** @brief Value indicating whether node mesh should be drawn
+             */
+            bool Visible;
+
+            /** @brief Construct new scene graph node at origin
+             */
+            Node() :
+                position(),
+                scale(1.0, 1.0, 1.0),
+                world(SRL::Math::Matrix43::Identity()),
+                worldScale(1.0),
+                parent(Node::NoParent),
+                dirty(true),
+                updated(false),
+                Mesh(nullptr),
+                BoundingRadius(),
+                Visible(true)
+            {
+                this->rotation[0] = SRL::Math::Types::Angle();
+                this->rotation[1] = SRL::Math::Types::Angle();
+                this->rotation[2] = SRL::Math::Types::Angle();
+                Scene3D::CalculateSinCos(this->rotation, this->rotationValues, 3);
+            }
+
+            /** @brief Get index of the parent node
+             * @return Parent node index or SRL::Scene3D::Node::NoParent
+             */
+            uint16_t GetParent() const
+            {
+                return this->parent;
+            }
+
+            /** @brief Get local position
+             * @return Position relative to the parent node
+             */
+            const SRL::Math::Types::Vector3D& GetPosition() const
+            {
+                return this->position;
+            }
+
+            /** @brief Set local position
+             * @param position Position relative to the parent node
+             */
+            void SetPosition(const SRL::Math::Types::Vector3D& position)
+            {
+                this->position = position;
+                this->dirty = true;
+            }
+
+            /** @brief Get local rotation
+             * @param axis Axis index (0 = X, 1 = Y, 2 = Z)
+             * @return Rotation around specified axis
+             */
+            SRL::Math::Types::Angle GetRotation(const uint8_t axis) const
+            {
+                return this->rotation[axis];
+            }
+
+            /** @brief Set local rotation
+             * @param x Rotation around X axis
+             * @param y Rotation around Y axis
+             * @param z Rotation around Z axis
+             */
+            void SetRotation(const SRL::Math::Types::Angle x, const SRL::Math::Types::Angle y, const SRL::Math::Types::Angle z)
+            {
+                this->rotation[0] = x;
+                this->rotation[1] = y;
+                this->rotation[2] = z;
+                Scene3D::CalculateSinCos(this->rotation, this->rotationValues, 3);
+                this->dirty = true;
+            }
+
+            /** @brief Get local scale
+             * @return Scale relative to the parent node
+             */
+            const SRL::Math::Types::Vector3D& GetScale() const
+            {
+                return this->scale;
+            }
+
+            /** @brief Set local scale
+             * @param scale Scale relative to the parent node
+             */
+            void SetScale(const SRL::Math::Types::Vector3D& scale)
+            {
+                this->scale = scale;
+                this->dirty = true;
+            }
+
+            /** @brief Get cached world matrix
+             * @note Valid only after SRL::Scene3D::SceneGraph::Update() was called
+             * @return World transformation matrix
+             */
+            const SRL::Math::Matrix43& GetWorldMatrix() const
+            {
+                return this->world;
+            }
+
+            /** @brief Mark node dirty, so its world matrix is recalculated on next update
+             */
+            void Invalidate()
+            {
+                this->dirty = true;
+            }
+
+            /** @brief Check whether node local transformation changed since last update
+             * @return True if world matrix needs to be recalculated
+             */
+            bool IsDirty() const
+            {
+                return this->dirty;
+            }
+        };
+
+        /** @brief Node hierarchy stored as flat array
+         * @details Parent of a node must always be added before the node itself.
+         * This way single forward pass over the array is enough to propagate transformation changes down the hierarchy, without any pointer chasing.
+         * Only dirty nodes and children of nodes rebuilt in the same pass get their world matrix recalculated, static parts of the scene cost nothing.
+         * @code {.cpp}
+         * SRL::Scene3D::SceneGraph<32> graph;
+         * uint16_t body = graph.Add();
+         * uint16_t arm = graph.Add(body);
+         * graph[arm].Mesh = &armMesh;
+         * graph[arm].BoundingRadius = 20.0;
+         *
+         * // In game loop
+         * graph[body].SetRotation(0, angle, 0);
+         * graph.Update();
+         * graph.Draw();
+         * @endcode
+         * @tparam Capacity Maximal number of nodes
+         */
+        template<uint16_t Capacity>
+        class SceneGraph
+        {
+        private:
+
+            /** @brief Node storage
+             */
+            Node nodes[Capacity];
+
+            /** @brief Number of nodes in use
+             */
+            uint16_t count;
+
+            /** @brief Recalculate world matrix of a node from its parent world matrix and its local transformation
+             * @param node Node to rebuild
+             */
+            void Rebuild(Node& node)
+            {
+                Scene3D::PushIdentityMatrix();
+                node.worldScale = SRL::Math::Max(node.scale.X.Abs(), SRL::Math::Max(node.scale.Y.Abs(), node.scale.Z.Abs()));
+
+                if (node.parent != Node::NoParent)
+                {
+                    Scene3D::SetMatrix(this->nodes[node.parent].world);
+                    node.worldScale *= this->nodes[node.parent].worldScale;
+                }
+
+                Scene3D::Translate(node.position);
+                Scene3D::RotateXYZ(node.rotationValues);
+                Scene3D::Scale(node.scale);
+                Scene3D::GetMatrix(&node.world);
+                Scene3D::PopMatrix();
+
+                node.dirty = false;
+                node.updated = true;
+            }
+
+        public:
+
+            /** @brief Distance from camera after which nodes are not drawn, 0 to draw nodes at any distance
+             * @note Distance is scaled by SRL::Governor::GetQuality(), so far nodes are dropped first when frames overrun
+             */
+            SRL::Math::Types::Fxp CullDistance;
+
+            /** @brief Construct empty scene graph
+             */
+            SceneGraph() : count(0), CullDistance(0.0) { }
+
+            /** @brief Add new node to the hierarchy
+             * @param parent Index of the parent node, or SRL::Scene3D::Node::NoParent for root node
+             * @return Index of the new node, SRL::Scene3D::Node::NoParent if node could not be added
+             */
+            uint16_t Add(const uint16_t parent = Node::NoParent)
+            {
+                if (this->count >= Capacity)
+                {
+                    SRL::Debug::Assert("Scene graph is full (%d nodes)", Capacity);
+                    return Node::NoParent;
+                }
+
+                if (parent != Node::NoParent && parent >= this->count)
+                {
+                    SRL::Debug::Assert("Parent node %d must be added before its children", parent);
+                    return Node::NoParent;
+                }
+
+                uint16_t index = this->count++;
+                this->nodes[index] = Node();
+                this->nodes[index].parent = parent;
+                return index;
+            }
+
+            /** @brief Remove all nodes
+             */
+            void Clear()
+            {
+                this->count = 0;
+            }
+
+            /** @brief Get number of nodes in the graph
+             * @return Node count
+             */
+            uint16_t Count() const
+            {
+                return this->count;
+            }
+
+            /** @brief Access node by index
+             * @note Returned reference stays valid until SRL::Scene3D::SceneGraph::Clear() is called, changes made through it are picked up by next update
+             * @param index Node index
+             * @return Node at the index
+             */
+            Node& operator[](const uint16_t index)
+            {
+                return this->nodes[index];
+            }
+
+            /** @brief Access node by index (read only)
+             * @param index Node index
+             * @return Node at the index
+             */
+            const Node& operator[](const uint16_t index) const
+            {
+                return this->nodes[index];
+            }
+
+            /** @brief Recalculate world matrices of changed nodes and their children
+             * @details Every node is checked for its dirty flag, so nodes changed through a held reference are not missed.
+             * @return Number of recalculated world matrices
+             */
+            uint16_t Update()
+            {
+                uint16_t rebuilt = 0;
+
+                for (uint16_t index = 0; index < this->count; index++)
+                {
+                    Node& node = this->nodes[index];
+                    node.updated = false;
+
+                    if (node.dirty || (node.parent != Node::NoParent && this->nodes[node.parent].updated))
+                    {
+                        this->Rebuild(node);
+                        rebuilt++;
+                    }
+                }
+
+                return rebuilt;
+            }
+
+            /** @brief Draw meshes of all visible nodes, current matrix is used as camera transformation
+             * @details Nodes with bounding sphere outside of the screen or farther than SRL::Scene3D::SceneGraph::CullDistance are skipped before any of their vertices is transformed.
+             * @param slaveOnly Value indicates whether processing of the meshes should be handled only on the slave CPU
+             * @return Number of drawn meshes
+             */
+            uint16_t Draw(const bool slaveOnly = false)
+            {
+                const SRL::Math::Types::Fxp distance = SRL::Governor::Scale(this->CullDistance);
+                uint16_t drawn = 0;
+
+                for (uint16_t index = 0; index < this->count; index++)
+                {
+                    Node& node = this->nodes[index];
+
+                    if (node.Mesh == nullptr || !node.Visible)
+                    {
+                        continue;
+                    }
+
+                    Scene3D::PushMatrix();
+                    Scene3D::MultiplyMatrix(node.world);
+
+                    bool visible = node.BoundingRadius == 0.0 && this->CullDistance == 0.0;
+
+                    if (!visible)
+                    {
+                        // Returns depth of the node origin, or negative value if bounding sphere is off screen
+                        const SRL::Math::Types::Vector3D origin;
+                        const SRL::Math::Types::Fxp radius = node.BoundingRadius * node.worldScale;
+                        const FIXED depth = slCheckOnScreen((FIXED*)&origin, radius.RawValue());
+                        visible = depth >= 0 && (this->CullDistance == 0.0 || depth <= distance.RawValue());
+                    }
+
+                    if (visible)
+                    {
+                        Scene3D::DrawMesh(*node.Mesh, slaveOnly);
+                        drawn++;
+                    }
+
+                    Scene3D::PopMatrix();
+                }
+
+                return drawn;
+            }
+        };
+
+        /** @} */
+
+        /**
+         * @name Level geometry
+         * @{
+         */
+
+        /** @brief Static level geometry bucketed into a uniform grid on X/Z plane
+         * @details Each mesh is placed into the cell containing center of its bounding box, cell bounds grow to enclose all of its meshes.
+         * SRL::Scene3D::LevelGrid::Cull() finds cells potentially visible from the camera cell, rejects cells behind the camera or too far away
+         * and orders the rest from the nearest to the farthest. SRL::Scene3D::LevelGrid::Draw() then tests cell and mesh bounding spheres against the screen,
+         * so meshes of hidden sectors are never transformed. Meshes must be in world coordinates.
+         * @tparam Columns Number of cells along X axis
+         * @tparam Rows Number of cells along Z axis
+         * @tparam Capacity Maximal number of meshes
+         * @code {.cpp}
+         * SRL::Scene3D::LevelGrid<8, 8, 128> level(SRL::Math::Types::Vector3D(-256.0, 0.0, -256.0), 64.0);
+         * level.Add(sector, sectorMin, sectorMax);
+         *
+         * // In game loop
+         * SRL::Scene3D::LookAt(camera, target, 0);
+         * level.Cull(camera, target, 200.0);
+         * level.Draw();
+         * @endcode
+         */
+        template<uint8_t Columns, uint8_t Rows, uint16_t Capacity>
+        class LevelGrid
+        {
+        public:
+
+            /** @brief Number of cells in the grid
+             */
+            static constexpr uint16_t CellCount = (uint16_t)Columns * Rows;
+
+            /** @brief Number of 32-bit words of a single cell visibility set
+             */
+            static constexpr uint16_t VisibilityWords = (CellCount + 31) >> 5;
+
+            /** @brief Invalid cell index
+             */
+            static constexpr uint16_t NoCell = 0xffff;
+
+        private:
+
+            /** @brief Mesh stored in the grid
+             */
+            struct Entry
+            {
+                /** @brief Level mesh
+                 */
+                Types::Mesh* Mesh;
+
+                /** @brief Center of the mesh bounding box
+                 */
+                SRL::Math::Types::Vector3D Center;
+
+                /** @brief Radius of the sphere enclosing the bounding box
+                 */
+                SRL::Math::Types::Fxp Radius;
+
+                /** @brief Next mesh in the same cell
+                 */
+                uint16_t Next;
+            };
+
+            /** @brief Single grid cell
+             */
+            struct Cell
+            {
+                /** @brief Minimal corner of bounding box of all meshes in the cell
+                 */
+                SRL::Math::Types::Vector3D Min;
+
+                /** @brief Maximal corner of bounding box of all meshes in the cell
+                 */
+                SRL::Math::Types::Vector3D Max;
+
+                /** @brief First mesh in the cell
+                 */
+                uint16_t First;
+            };
+
+            /** @brief Mesh storage
+             */
+            Entry entries[Capacity];
+
+            /** @brief Grid cells
+             */
+            Cell cells[CellCount];
+
+            /** @brief Potentially visible set of each cell
+             */
+            uint32_t visibility[CellCount][VisibilityWords];
+
+            /** @brief Visible cells ordered from the nearest
+             */
+            uint16_t visible[CellCount];
+
+            /** @brief Squared distances of visible cells
+             */
+            uint32_t distances[CellCount];
+
+            /** @brief Number of stored meshes
+             */
+            uint16_t count;
+
+            /** @brief Number of visible cells
+             */
+            uint16_t visibleCount;
+
+            /** @brief Minimal corner of the grid
+             */
+            SRL::Math::Types::Vector3D origin;
+
+            /** @brief Size of a single cell
+             */
+            SRL::Math::Types::Fxp cellSize;
+
+            /** @brief Get squared distance from a point to the cell bounds on X/Z plane
+             * @param cell Cell to measure
+             * @param x Point X coordinate in 1/256 units
+             * @param z Point Z coordinate in 1/256 units
+             * @return Squared distance in whole units
+             */
+            uint32_t GetDistance(const Cell& cell, const int32_t x, const int32_t z) const
+            {
+                const int32_t minX = cell.Min.X.RawValue() >> 8;
+                const int32_t maxX = cell.Max.X.RawValue() >> 8;
+                const int32_t minZ = cell.Min.Z.RawValue() >> 8;
+                const int32_t maxZ = cell.Max.Z.RawValue() >> 8;
+                const int64_t dx = x < minX ? minX - x : (x > maxX ? x - maxX : 0);
+                const int64_t dz = z < minZ ? minZ - z : (z > maxZ ? z - maxZ : 0);
+                return (uint32_t)SRL::Math::Min(((dx * dx) + (dz * dz)) >> 16, (int64_t)0xffffffff);
+            }
+
+            /** @brief Check whether whole cell lies behind the camera on X/Z plane
+             * @param cell Cell to check
+             * @param x Camera X coordinate in 1/256 units
+             * @param z Camera Z coordinate in 1/256 units
+             * @param forwardX View direction X in 1/256 units
+             * @param forwardZ View direction Z in 1/256 units
+             * @return True if no corner of the cell is in front of the camera
+             */
+            static bool IsBehind(const Cell& cell, const int32_t x, const int32_t z, const int32_t forwardX, const int32_t forwardZ)
+            {
+                // Pick corner farthest along the view direction
+                const int64_t cornerX = (forwardX >= 0 ? cell.Max.X.RawValue() : cell.Min.X.RawValue()) >> 8;
+                const int64_t cornerZ = (forwardZ >= 0 ? cell.Max.Z.RawValue() : cell.Min.Z.RawValue()) >> 8;
+                return (((cornerX - x) * forwardX) + ((cornerZ - z) * forwardZ)) < 0;
+            }
+
+        public:
+
+            /** @brief Construct empty level grid, every cell sees every other cell
+             * @param origin Minimal corner of the grid, only X and Z are used
+             * @param cellSize Size of a single cell
+             */
+            LevelGrid(const SRL::Math::Types::Vector3D& origin, const SRL::Math::Types::Fxp& cellSize) :
+                count(0),
+                visibleCount(0),
+                origin(origin),
+                cellSize(cellSize)
+            {
+                for (uint16_t cell = 0; cell < CellCount; cell++)
+                {
+                    this->cells[cell].First = LevelGrid::NoCell;
+                    this->SetVisibility(cell, true);
+                }
+            }
+
+            /** @brief Get cell containing a point
+             * @param point Point in world space
+             * @return Cell index or SRL::Scene3D::LevelGrid::NoCell if point is outside of the grid
+             */
+            uint16_t GetCell(const SRL::Math::Types::Vector3D& point) const
+            {
+                const SRL::Math::Types::Fxp x = point.X - this->origin.X;
+                const SRL::Math::Types::Fxp z = point.Z - this->origin.Z;
+
+                if (x < 0.0 || z < 0.0)
+                {
+                    return LevelGrid::NoCell;
+                }
+
+                const int32_t column = (x / this->cellSize).RawValue() >> 16;
+                const int32_t row = (z / this->cellSize).RawValue() >> 16;
+
+                if (column >= Columns || row >= Rows)
+                {
+                    return LevelGrid::NoCell;
+                }
+
+                return (uint16_t)((row * Columns) + column);
+            }
+
+            /** @brief Add mesh to the grid
+             * @param mesh Mesh in world coordinates
+             * @param min Minimal corner of the mesh bounding box
+             * @param max Maximal corner of the mesh bounding box
+             * @return Index of the cell mesh was added to, SRL::Scene3D::LevelGrid::NoCell if it could not be added
+             */
+            uint16_t Add(Types::Mesh& mesh, const SRL::Math::Types::Vector3D& min, const SRL::Math::Types::Vector3D& max)
+            {
+                if (this->count >= Capacity)
+                {
+                    SRL::Debug::Assert("Level grid is full (%d meshes)", Capacity);
+                    return LevelGrid::NoCell;
+                }
+
+                const SRL::Math::Types::Vector3D center((min.X + max.X) >> 1, (min.Y + max.Y) >> 1, (min.Z + max.Z) >> 1);
+                const uint16_t index = this->GetCell(center);
+
+                if (index == LevelGrid::NoCell)
+                {
+                    SRL::Debug::Assert("Mesh is outside of the level grid");
+                    return LevelGrid::NoCell;
+                }
+
+                Cell& cell = this->cells[index];
+
+                if (cell.First == LevelGrid::NoCell)
+                {
+                    cell.Min = min;
+                    cell.Max = max;
+                }
+                else
+                {
+                    cell.Min = SRL::Math::Types::Vector3D(SRL::Math::Min(cell.Min.X, min.X), SRL::Math::Min(cell.Min.Y, min.Y), SRL::Math::Min(cell.Min.Z, min.Z));
+                    cell.Max = SRL::Math::Types::Vector3D(SRL::Math::Max(cell.Max.X, max.X), SRL::Math::Max(cell.Max.Y, max.Y), SRL::Math::Max(cell.Max.Z, max.Z));
+                }
+
+                // Half of the box diagonal, sum of half extents is cheap upper bound
+                Entry& entry = this->entries[this->count];
+                entry.Mesh = &mesh;
+                entry.Center = center;
+                entry.Radius = ((max.X - min.X) + (max.Y - min.Y) + (max.Z - min.Z)) >> 1;
+                entry.Next = cell.First;
+                cell.First = this->count++;
+                return index;
+            }
+
+            /** @brief Get number of meshes in the grid
+             * @return Mesh count
+             */
+            uint16_t Count() const
+            {
+                return this->count;
+            }
+
+            /** @brief Make cell see all other cells or none of them
+             * @param from Cell index
+             * @param visible Value indicating whether all cells are visible from the cell
+             */
+            void SetVisibility(const uint16_t from, const bool visible)
+            {
+                for (uint16_t word = 0; word < LevelGrid::VisibilityWords; word++)
+                {
+                    this->visibility[from][word] = visible ? 0xffffffff : 0;
+                }
+
+                // Cell always sees itself
+                this->SetVisible(from, from, true);
+            }
+
+            /** @brief Set whether one cell is visible from another cell
+             * @param from Cell the camera is in
+             * @param to Cell to show or hide
+             * @param visible Value indicating whether cell is visible
+             */
+            void SetVisible(const uint16_t from, const uint16_t to, const bool visible)
+            {
+                if (visible)
+                {
+                    this->visibility[from][to >> 5] |= 1 << (to & 31);
+                }
+                else
+                {
+                    this->visibility[from][to >> 5] &= ~(1 << (to & 31));
+                }
+            }
+
+            /** @brief Check whether one cell is visible from another cell
+             * @param from Cell the camera is in
+             * @param to Cell to check
+             * @return True if cell is in the potentially visible set
+             */
+            bool IsVisible(const uint16_t from, const uint16_t to) const
+            {
+                return (this->visibility[from][to >> 5] & (1 << (to & 31))) != 0;
+            }
+
+            /** @brief Load precomputed visibility sets
+             * @param data SRL::Scene3D::LevelGrid::VisibilityWords words for each cell, bit N of a set marks cell N visible
+             */
+            void LoadVisibility(const uint32_t* data)
+            {
+                for (uint16_t cell = 0; cell < CellCount; cell++)
+                {
+                    for (uint16_t word = 0; word < LevelGrid::VisibilityWords; word++)
+                    {
+                        this->visibility[cell][word] = *data++;
+                    }
+                }
+            }
+
+            /** @brief Find cells visible from the camera and order them from the nearest
+             * @param camera Camera location, same as passed to SRL::Scene3D::LookAt()
+             * @param target Camera target point, same as passed to SRL::Scene3D::LookAt()
+             * @param maxDistance Maximal distance of visible cells, 0 for unlimited
+             * @return Number of visible cells
+             */
+            uint16_t Cull(const SRL::Math::Types::Vector3D& camera, const SRL::Math::Types::Vector3D& target, const SRL::Math::Types::Fxp& maxDistance = 0.0)
+            {
+                const uint16_t from = this->GetCell(camera);
+                const int32_t x = camera.X.RawValue() >> 8;
+                const int32_t z = camera.Z.RawValue() >> 8;
+                const int32_t forwardX = (target.X - camera.X).RawValue() >> 8;
+                const int32_t forwardZ = (target.Z - camera.Z).RawValue() >> 8;
+                const int64_t limit = maxDistance.RawValue() >> 8;
+                const uint32_t limitSquared = maxDistance == 0.0 ? 0xffffffff : (uint32_t)SRL::Math::Min((limit * limit) >> 16, (int64_t)0xffffffff);
+                this->visibleCount = 0;
+
+                for (uint16_t index = 0; index < CellCount; index++)
+                {
+                    const Cell& cell = this->cells[index];
+
+                    // Camera outside of the grid has no visibility set
+                    if (cell.First == LevelGrid::NoCell || (from != LevelGrid::NoCell && !this->IsVisible(from, index)))
+                    {
+                        continue;
+                    }
+
+                    const uint32_t distance = this->GetDistance(cell, x, z);
+
+                    if (distance > limitSquared || (distance > 0 && LevelGrid::IsBehind(cell, x, z, forwardX, forwardZ)))
+                    {
+                        continue;
+                    }
+
+                    // Insertion sort, number of visible cells is small
+                    uint16_t position = this->visibleCount++;
+
+                    while (position > 0 && this->distances[position - 1] > distance)
+                    {
+                        this->visible[position] = this->visible[position - 1];
+                        this->distances[position] = this->distances[position - 1];
+                        position--;
+                    }
+
+                    this->visible[position] = index;
+                    this->distances[position] = distance;
+                }
+
+                return this->visibleCount;
+            }
+
+            /** @brief Get number of cells found by last SRL::Scene3D::LevelGrid::Cull() call
+             * @return Visible cell count
+             */
+            uint16_t GetVisibleCount() const
+            {
+                return this->visibleCount;
+            }
+
+            /** @brief Get visible cell
+             * @param index Index in the visible list, 0 is the nearest cell
+             * @return Cell index
+             */
+            uint16_t GetVisibleCell(const uint16_t index) const
+            {
+                return this->visible[index];
+            }
+
+            /** @brief Draw meshes of cells found by last SRL::Scene3D::LevelGrid::Cull() call, current matrix must be the camera matrix
+             * @details Cells are drawn from the nearest, drawing stops once polygon budget of SRL::Governor left for this frame is used up.
+             * @param slaveOnly Value indicates whether processing of the meshes should be handled only on the slave CPU
+             * @return Number of drawn meshes
+             */
+            uint16_t Draw(const bool slaveOnly = false)
+            {
+                const uint32_t budget = SRL::Governor::IsEnabled() ? SRL::Governor::GetRemainingPolygons() : UINT32_MAX;
+                uint32_t polygons = 0;
+                uint16_t drawn = 0;
+
+                for (uint16_t index = 0; index < this->visibleCount; index++)
+                {
+                    const Cell& cell = this->cells[this->visible[index]];
+                    const SRL::Math::Types::Vector3D center((cell.Min.X + cell.Max.X) >> 1, (cell.Min.Y + cell.Max.Y) >> 1, (cell.Min.Z + cell.Max.Z) >> 1);
+
+                    if (!Scene3D::IsOnScreen(center, ((cell.Max.X - cell.Min.X) + (cell.Max.Y - cell.Min.Y) + (cell.Max.Z - cell.Min.Z)) >> 1))
+                    {
+                        continue;
+                    }
+
+                    for (uint16_t entry = cell.First; entry != LevelGrid::NoCell; entry = this->entries[entry].Next)
+                    {
+                        const Entry& item = this->entries[entry];
+
+                        if (!Scene3D::IsOnScreen(item.Center, item.Radius))
+                        {
+                            continue;
+                        }
+
+                        if (polygons + item.Mesh->FaceCount > budget)
+                        {
+                            return drawn;
+                        }
+
+                        Scene3D::DrawMesh(*item.Mesh, slaveOnly);
+                        SRL::Governor::ConsumePolygons(item.Mesh->FaceCount);
+                        polygons += item.Mesh->FaceCount;
+                        drawn++;
+                    }
+                }
+
+                return drawn;
+            }
+        };
+
+        /** @} */
     };
 }
 
@@ -0,0 +1,672 @@
+#pragma once
+
+#include "srl_core.hpp"
+
+namespace SRL::Types
+{
+    /** @brief Texture residency cache streaming VDP1 textures on demand
+     * @details Cache reserves a fixed number of equally sized texture slots in sprite VRAM and maps logical texture identifiers onto them.
+     * Textures are loaded only when they are requested by SRL::Types::TextureCache::Get(), on a miss the least recently used texture is evicted.
+     * Texture data is read either from main RAM, LWRAM or cart RAM staging copy (copied into VRAM right away), or asynchronously from CD.
+     * Only one CD read is in flight at a time, it is driven every frame from SRL::Core::Synchronize().
+     *
+     * Texture used in the current or previous frame is never evicted, as VDP1 might still be drawing it.
+     * Slots are followed by an empty texture marking the end of the reserve, so textures allocated after the cache never overlap a slot
+     * holding a smaller texture. All of them are freed by SRL::VDP1::ResetTextureHeap(cache.GetFirstTexture()).
+     * Texture files on CD contain only raw pixel data in the color mode of the cache, same as data passed to SRL::VDP1::TryLoadTexture().
+     * @code {.cpp}
+     * // 8 slots of at most 64x64 pixels
+     * SRL::Types::TextureCache cache(8, 64, 64);
+     * int32_t rock = cache.Add("ROCK.BIN", 32, 32);
+     *
+     * // In game loop
+     * int32_t texture = cache.Get(rock);
+     *
+     * if (texture >= 0)
+     * {
+     *     SRL::Scene2D::DrawSprite(texture, location);
+     * }
+     * @endcode
+     */
+    class TextureCache
+    {
+    public:
+
+        /** @brief Returned by SRL::Types::TextureCache::Get() when texture is not in VRAM yet
+         */
+        static constexpr int32_t NotResident = -1;
+
+        /** @brief Maximal number of textures waiting to be loaded
+         */
+        static constexpr uint8_t QueueSize = 16;
+
+        /** @brief Size of CD sector
+         */
+        static constexpr uint16_t SectorSize = 2048;
+
+        /** @brief Cache statistics
+         */
+        struct Statistics
+        {
+            /** @brief Number of requests of a texture already in VRAM
+             */
+            uint32_t Hits;
+
+            /** @brief Number of requests of a texture not in VRAM
+             */
+            uint32_t Misses;
+
+            /** @brief Number of textures removed from VRAM to make space for another one
+             */
+            uint32_t Evictions;
+
+            /** @brief Number of bytes read from CD
+             */
+            uint32_t BytesFromCd;
+
+            /** @brief Number of bytes copied from RAM
+             */
+            uint32_t BytesFromRam;
+        };
+
+    private:
+
+        /** @brief Residency state of a texture
+         */
+        enum class State : uint8_t
+        {
+            /** @brief Texture is not in VRAM
+             */
+            Unloaded,
+
+            /** @brief Texture waits in the load queue
+             */
+            Queued,
+
+            /** @brief Texture is being read from CD
+             */
+            Loading,
+
+            /** @brief Texture is in VRAM
+             */
+            Resident
+        };
+
+        /** @brief Logical texture
+         */
+        struct Entry
+        {
+            /** @brief CD file identifier, -1 if texture is read from RAM
+             */
+            int32_t FileId;
+
+            /** @brief Texture data in RAM, nullptr if texture is read from CD
+             */
+            void* Data;
+
+            /** @brief Texture width
+             */
+            uint16_t Width;
+
+            /** @brief Texture height
+             */
+            uint16_t Height;
+
+            /** @brief Palette identifier (not used in RGB555 mode)
+             */
+            uint16_t Palette;
+
+            /** @brief Slot holding the texture, -1 if not resident
+             */
+            int16_t Slot;
+
+            /** @brief Residency state
+             */
+            State Status;
+
+            /** @brief Value indicating whether data was staged by the cache and must be freed
+             */
+            bool Owned;
+        };
+
+        /** @brief Texture slot in VRAM
+         */
+        struct Slot
+        {
+            /** @brief Index of VDP1 texture
+             */
+            uint16_t Texture;
+
+            /** @brief Logical texture in the slot, -1 if slot is free
+             */
+            int16_t Entry;
+
+            /** @brief Frame the texture was last used in
+             */
+            uint32_t LastUse;
+        };
+
+        /** @brief Color mode of all textures
+         */
+        CRAM::TextureColorMode colorMode;
+
+        /** @brief Number of bytes of a single slot
+         */
+        size_t slotBytes;
+
+        /** @brief Texture slots
+         */
+        Slot* slots;
+
+        /** @brief Index of the first VDP1 texture reserved by the cache
+         */
+        uint16_t firstTexture;
+
+        /** @brief Number of texture slots
+         */
+        uint16_t slotCount;
+
+        /** @brief Logical textures
+         */
+        Entry* entries;
+
+        /** @brief Number of logical textures
+         */
+        uint16_t entryCount;
+
+        /** @brief Maximal number of logical textures
+         */
+        uint16_t maxEntries;
+
+        /** @brief Textures waiting to be loaded
+         */
+        uint16_t queue[TextureCache::QueueSize];
+
+        /** @brief First queued texture
+         */
+        uint8_t queueHead;
+
+        /** @brief Number of queued textures
+         */
+        uint8_t queueCount;
+
+        /** @brief Handle of the file being read
+         */
+        GfsHn handle;
+
+        /** @brief Buffer CD reads land in
+         */
+        uint8_t* readBuffer;
+
+        /** @brief Current frame
+         */
+        uint32_t frame;
+
+        /** @brief Cache statistics
+         */
+        TextureCache::Statistics statistics;
+
+        /** @brief Frame update proxy
+         */
+        MemberProxy<> afterSync = MemberProxy<>(this, &TextureCache::Update);
+
+        /** @brief Get number of bytes of a texture
+         * @param entry Logical texture
+         * @return Number of bytes
+         */
+        size_t GetByteCount(const Entry& entry) const
+        {
+            return ((entry.Width * entry.Height) << 2) >> SRL::VDP1::GetSizeShifter(this->colorMode);
+        }
+
+        /** @brief Find slot to load texture into
+         * @return Free slot, least recently used slot not used in the last two frames, or -1 if there is none
+         */
+        int16_t FindVictim() const
+        {
+            int16_t victim = -1;
+
+            for (uint16_t slot = 0; slot < this->slotCount; slot++)
+            {
+                if (this->slots[slot].Entry < 0)
+                {
+                    return slot;
+                }
+
+                if (this->slots[slot].LastUse + 1 < this->frame &&
+                    (victim < 0 || this->slots[slot].LastUse < this->slots[victim].LastUse))
+                {
+                    victim = slot;
+                }
+            }
+
+            return victim;
+        }
+
+        /** @brief Copy texture into VRAM
+         * @param id Logical texture
+         * @param data Texture data
+         * @return True if there was a slot to load texture into
+         */
+        bool Upload(const uint16_t id, const void* data)
+        {
+            const int16_t slot = this->FindVictim();
+
+            if (slot < 0)
+            {
+                return false;
+            }
+
+            Slot& target = this->slots[slot];
+
+            if (target.Entry >= 0)
+            {
+                this->entries[target.Entry].Slot = -1;
+                this->entries[target.Entry].Status = State::Unloaded;
+                this->statistics.Evictions++;
+            }
+
+            Entry& entry = this->entries[id];
+            const size_t bytes = this->GetByteCount(entry);
+
+            // Slot keeps its address, only drawn size changes, end of the reserve is kept by the marker texture
+            SRL::VDP1::Textures[target.Texture] = SRL::VDP1::Texture(entry.Width, entry.Height, SRL::VDP1::Textures[target.Texture].Address);
+            SRL::VDP1::Metadata[target.Texture].PaletteId = entry.Palette;
+            slDMACopy((void*)data, SRL::VDP1::Textures[target.Texture].GetData(), bytes);
+            slDMAWait();
+
+            target.Entry = id;
+            target.LastUse = this->frame;
+            entry.Slot = slot;
+            entry.Status = State::Resident;
+            return true;
+        }
+
+        /** @brief Add texture to the load queue
+         * @param id Logical texture
+         */
+        void Enqueue(const uint16_t id)
+        {
+            if (this->queueCount < TextureCache::QueueSize)
+            {
+                this->queue[(this->queueHead + this->queueCount++) % TextureCache::QueueSize] = id;
+                this->entries[id].Status = State::Queued;
+            }
+        }
+
+        /** @brief Register logical texture
+         * @param fileId CD file identifier
+         * @param data Texture data in RAM
+         * @param width Texture width
+         * @param height Texture height
+         * @param palette Palette identifier
+         * @return Logical texture identifier or -1 on failure
+         */
+        int32_t Register(const int32_t fileId, void* data, const uint16_t width, const uint16_t height, const uint16_t palette)
+        {
+            if (this->entryCount >= this->maxEntries)
+            {
+                return -1;
+            }
+
+            Entry& entry = this->entries[this->entryCount];
+            entry.FileId = fileId;
+            entry.Data = data;
+            entry.Width = width;
+            entry.Height = height;
+            entry.Palette = palette;
+            entry.Slot = -1;
+            entry.Status = State::Unloaded;
+            entry.Owned = false;
+
+            if ((width & 7) != 0 || this->GetByteCount(entry) > this->slotBytes)
+            {
+                SRL::Debug::Assert("Texture %dx%d does not fit into cache slot", width, height);
+                return -1;
+            }
+
+            return this->entryCount++;
+        }
+
+    public:
+
+        /** @brief Create texture cache and reserve its slots in sprite VRAM
+         * @param slotCount Number of textures that can be in VRAM at once
+         * @param slotWidth Width of the largest texture (must be divisible by 8)
+         * @param slotHeight Height of the largest texture
+         * @param colorMode Color mode of all textures
+         * @param maxEntries Maximal number of logical textures
+         */
+        TextureCache(
+            const uint16_t slotCount,
+            const uint16_t slotWidth,
+            const uint16_t slotHeight,
+            const CRAM::TextureColorMode colorMode = CRAM::TextureColorMode::RGB555,
+            const uint16_t maxEntries = 64) :
+            colorMode(colorMode),
+            slotBytes(((slotWidth * slotHeight) << 2) >> SRL::VDP1::GetSizeShifter(colorMode)),
+            firstTexture(SRL::VDP1::GetTextureCount()),
+            slotCount(0),
+            entryCount(0),
+            maxEntries(maxEntries),
+            queueHead(0),
+            queueCount(0),
+            handle(nullptr),
+            frame(0),
+            statistics({ 0, 0, 0, 0, 0 })
+        {
+            this->slots = new Slot[slotCount];
+            this->entries = new Entry[maxEntries];
+            this->readBuffer = new uint8_t[((this->slotBytes + TextureCache::SectorSize - 1) / TextureCache::SectorSize) * TextureCache::SectorSize];
+
+            for (uint16_t slot = 0; slot < slotCount; slot++)
+            {
+                const int32_t texture = SRL::VDP1::TryAllocateTexture(slotWidth, slotHeight, colorMode, 0);
+
+                if (texture < 0)
+                {
+                    SRL::Debug::Assert("Not enough texture memory for cache slot %d", slot);
+                    break;
+                }
+
+                this->slots[slot].Texture = texture;
+                this->slots[slot].Entry = -1;
+                this->slots[slot].LastUse = 0;
+                this->slotCount++;
+            }
+
+            // Heap computes the next free address from the last texture, which must not be a shrunk slot
+            if (SRL::VDP1::TryAllocateTexture(0, 0, colorMode, 0) < 0)
+            {
+                SRL::Debug::Assert("Not enough texture slots for cache reserve marker");
+            }
+
+            SRL::Core::OnAfterSync += &this->afterSync;
+        }
+
+        /** @brief Destroy the cache
+         * @note Texture slots stay reserved, they are freed by SRL::VDP1::ResetTextureHeap(cache.GetFirstTexture())
+         */
+        ~TextureCache()
+        {
+            SRL::Core::OnAfterSync -= &this->afterSync;
+
+            if (this->handle != nullptr)
+            {
+                GFS_Close(this->handle);
+            }
+
+            for (uint16_t id = 0; id < this->entryCount; id++)
+            {
+                if (this->entries[id].Owned)
+                {
+                    SRL::Memory::Free(this->entries[id].Data);
+                }
+            }
+
+            delete[] this->readBuffer;
+            delete[] this->entries;
+            delete[] this->slots;
+        }
+
+        /** @name Textures
+         * @{
+         */
+
+        /** @brief Add texture read from CD
+         * @param fileName File with raw texture data
+         * @param width Texture width (must be divisible by 8)
+         * @param height Texture height
+         * @param palette Palette identifier (not used in RGB555 mode)
+         * @return Logical texture identifier or -1 on failure
+         */
+        int32_t Add(const char* fileName, const uint16_t width, const uint16_t height, const uint16_t palette = 0)
+        {
+            const int32_t fileId = GFS_NameToId((int8_t*)fileName);
+
+            if (fileId < 0)
+            {
+                SRL::Debug::Assert("Texture '%s' not found", fileName);
+                return -1;
+            }
+
+            return this->Register(fileId, nullptr, width, height, palette);
+        }
+
+        /** @brief Add texture kept in RAM
+         * @param data Raw texture data, must stay valid for the lifetime of the cache
+         * @param width Texture width (must be divisible by 8)
+         * @param height Texture height
+         * @param palette Palette identifier (not used in RGB555 mode)
+         * @return Logical texture identifier or -1 on failure
+         */
+        int32_t Add(void* data, const uint16_t width, const uint16_t height, const uint16_t palette = 0)
+        {
+            return this->Register(-1, data, width, height, palette);
+        }
+
+        /** @brief Read texture from CD into RAM staging copy
+         * @details Later misses of the texture are served from RAM without waiting for CD. Read is blocking, so it should be done while loading a level.
+         * @param id Logical texture identifier
+         * @param zone Memory zone of the staging copy, usually LWRAM or cart RAM
+         * @return True on success
+         */
+        bool Stage(const uint16_t id, const SRL::Memory::Zone zone = SRL::Memory::Zone::LWRam)
+        {
+            Entry& entry = this->entries[id];
+
+            if (entry.Data != nullptr || entry.Status == State::Loading)
+            {
+                return entry.Data != nullptr;
+            }
+
+            const size_t bytes = this->GetByteCount(entry);
+            void* data = SRL::Memory::Malloc(bytes, zone);
+
+            if (data == nullptr)
+            {
+                return false;
+            }
+
+            if (GFS_Load(entry.FileId, 0, data, bytes) < 0)
+            {
+                SRL::Memory::Free(data);
+                return false;
+            }
+
+            entry.Data = data;
+            entry.Owned = true;
+            return true;
+        }
+
+        /** @brief Get texture for drawing in the current frame
+         * @details Texture kept in RAM is loaded right away if there is a slot for it, texture on CD is queued and will be available in one of the following frames.
+         * @param id Logical texture identifier
+         * @return Index of VDP1 texture or SRL::Types::TextureCache::NotResident
+         */
+        int32_t Get(const uint16_t id)
+        {
+            Entry& entry = this->entries[id];
+
+            if (entry.Status == State::Resident)
+            {
+                this->statistics.Hits++;
+                this->slots[entry.Slot].LastUse = this->frame;
+                return this->slots[entry.Slot].Texture;
+            }
+
+            if (entry.Status != State::Unloaded)
+            {
+                return TextureCache::NotResident;
+            }
+
+            this->statistics.Misses++;
+
+            if (entry.Data != nullptr && this->Upload(id, entry.Data))
+            {
+                this->statistics.BytesFromRam += this->GetByteCount(entry);
+                return this->slots[entry.Slot].Texture;
+            }
+
+            this->Enqueue(id);
+            return TextureCache::NotResident;
+        }
+
+        /** @brief Queue texture to be loaded without using it
+         * @param id Logical texture identifier
+         */
+        void Prefetch(const uint16_t id)
+        {
+            if (this->entries[id].Status == State::Unloaded)
+            {
+                this->Enqueue(id);
+            }
+        }
+
+        /** @brief Check whether texture is in VRAM
+         * @param id Logical texture identifier
+         * @return True if texture is resident
+         */
+        bool IsResident(const uint16_t id) const
+        {
+            return this->entries[id].Status == State::Resident;
+        }
+
+        /** @} */
+
+        /** @name Streaming
+         * @{
+         */
+
+        /** @brief Advance frame and drive queued loads, called from SRL::Core::Synchronize()
+         */
+        void Update()
+        {
+            this->frame++;
+
+            // Finish running CD read
+            if (this->handle != nullptr)
+            {
+                GFS_NwExecOne(this->handle);
+
+                if (!GFS_NwIsComplete(this->handle))
+                {
+                    return;
+                }
+
+                const uint16_t id = this->queue[this->queueHead];
+
+                // Keep the data in the read buffer until there is a free slot
+                if (!this->Upload(id, this->readBuffer))
+                {
+                    return;
+                }
+
+                GFS_Close(this->handle);
+                this->handle = nullptr;
+                this->statistics.BytesFromCd += this->GetByteCount(this->entries[id]);
+                this->queueHead = (this->queueHead + 1) % TextureCache::QueueSize;
+                this->queueCount--;
+            }
+
+            // Serve queued textures kept in RAM, stop at the first one read from CD
+            while (this->queueCount > 0)
+            {
+                const uint16_t id = this->queue[this->queueHead];
+                Entry& entry = this->entries[id];
+
+                if (entry.Data == nullptr)
+                {
+                    const int32_t sectors = (this->GetByteCount(entry) + TextureCache::SectorSize - 1) / TextureCache::SectorSize;
+                    this->handle = GFS_Open(entry.FileId);
+
+                    if (this->handle == nullptr || GFS_NwFread(this->handle, sectors, this->readBuffer, sectors * TextureCache::SectorSize) < 0)
+                    {
+                        if (this->handle != nullptr)
+                        {
+                            GFS_Close(this->handle);
+                            this->handle = nullptr;
+                        }
+
+                        // Try again next frame
+                        return;
+                    }
+
+                    entry.Status = State::Loading;
+                    return;
+                }
+
+                if (!this->Upload(id, entry.Data))
+                {
+                    return;
+                }
+
+                this->statistics.BytesFromRam += this->GetByteCount(entry);
+                this->queueHead = (this->queueHead + 1) % TextureCache::QueueSize;
+                this->queueCount--;
+            }
+        }
+
+        /** @brief Check whether any texture waits to be loaded
+         * @return True if load queue is not empty
+         */
+        bool IsLoading() const
+        {
+            return this->queueCount > 0;
+        }
+
+        /** @} */
+
+        /** @name Statistics
+         * @{
+         */
+
+        /** @brief Get index of the first VDP1 texture reserved by the cache
+         * @return Index of the first slot texture
+         */
+        uint16_t GetFirstTexture() const
+        {
+            return this->firstTexture;
+        }
+
+        /** @brief Get number of texture slots
+         * @return Number of textures that can be in VRAM at once
+         */
+        uint16_t GetSlotCount() const
+        {
+            return this->slotCount;
+        }
+
+        /** @brief Get number of textures in VRAM
+         * @return Number of occupied slots
+         */
+        uint16_t GetResidentCount() const
+        {
+            uint16_t count = 0;
+
+            for (uint16_t slot = 0; slot < this->slotCount; slot++)
+            {
+                count += this->slots[slot].Entry >= 0 ? 1 : 0;
+            }
+
+            return count;
+        }
+
+        /** @brief Get cache statistics
+         * @return Statistics since creation or last reset
+         */
+        const TextureCache::Statistics& GetStatistics() const
+        {
+            return this->statistics;
+        }
+
+        /** @brief Reset cache statistics
+         */
+        void ResetStatistics()
+        {
+            this->statistics = { 0, 0, 0, 0, 0 };
+        }
+
+        /** @} */
+    };
+}
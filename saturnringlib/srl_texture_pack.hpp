@@ -0,0 +1,409 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_debug.hpp"
+#include "srl_cd.hpp"
+#include "srl_vdp1.hpp"
+
+namespace SRL::Types
+{
+    /** @brief Compressed texture pack decompressed straight into sprite VRAM
+     * @details Pack keeps textures compressed on disc and in RAM, each texture is decompressed into its VDP1 texture slot while loading,
+     * so neither CD bandwidth nor staging RAM is spent on uncompressed data.
+     * Decoder writes into a small ring buffer in work RAM, which doubles as LZ window, and DMAs filled halves of it into VRAM while it decodes the next one.
+     * All values are big-endian.
+     * Offset                   | Type                                      | Description
+     * -------------------------|-------------------------------------------|---------------------------------------------------
+     * 0                        | SRL::Types::TexturePack::Header           | File header
+     * Header::EntryOffset      | SRL::Types::TexturePack::Entry[]          | Texture table
+     * Entry::DataOffset        | uint8_t[]                                 | Compressed texture data
+     *
+     * LZ stream is a sequence of tokens, high nibble of a token is number of literals and low nibble is match length - 4,
+     * value 15 of either nibble is extended by following bytes until a byte other than 255. Literals follow the token,
+     * then 2 byte offset of the match follows, unless texture is already complete.
+     * RLE stream consists of packets, where packet byte 0-127 is followed by (packet + 1) literal bytes
+     * and packet byte 128-255 is followed by a single byte repeated (packet - 127) times.
+     * Files can be created from .TGA images with tools/scripts/texture_packer.py
+     * @code {.cpp}
+     * SRL::Types::TexturePack pack("LEVEL1.SRP");
+     *
+     * // In game loop
+     * SRL::Scene2D::DrawSprite(pack.GetFirstTextureIndex() + 2, location);
+     * @endcode
+     */
+    class TexturePack
+    {
+    public:
+
+        /** @brief Current file format version
+         */
+        static constexpr uint16_t Version = 1;
+
+        /** @brief Size of the decoder ring buffer, maximal LZ match offset is one less
+         */
+        static constexpr size_t RingSize = 4096;
+
+        /** @brief Texture compression
+         */
+        enum class Compression : uint8_t
+        {
+            /** @brief Raw texture data
+             */
+            None = 0,
+
+            /** @brief LZ compressed data
+             */
+            Lz = 1,
+
+            /** @brief Run length encoded bytes, suited for palette indexes
+             */
+            Rle = 2
+        };
+
+        /** @brief Pack file header
+         */
+        struct Header
+        {
+            /** @brief File identifier, always 'SRLP'
+             */
+            char Magic[4];
+
+            /** @brief File format version
+             */
+            uint16_t Version;
+
+            /** @brief Number of textures
+             */
+            uint16_t TextureCount;
+
+            /** @brief Offset of the texture table
+             */
+            uint32_t EntryOffset;
+        };
+
+        /** @brief Texture table entry
+         */
+        struct Entry
+        {
+            /** @brief Texture width
+             */
+            uint16_t Width;
+
+            /** @brief Texture height
+             */
+            uint16_t Height;
+
+            /** @brief Color mode (SRL::CRAM::TextureColorMode)
+             */
+            uint8_t ColorMode;
+
+            /** @brief Texture compression
+             */
+            Compression Type;
+
+            /** @brief Palette identifier relative to the first palette of the pack (not used in RGB555 mode)
+             */
+            uint16_t Palette;
+
+            /** @brief Size of the compressed data
+             */
+            uint32_t Size;
+
+            /** @brief Offset of the compressed data
+             */
+            uint32_t DataOffset;
+        };
+
+    private:
+
+        /** @brief Decoder ring buffer
+         */
+        inline static uint8_t ring[TexturePack::RingSize] __attribute__((aligned(4)));
+
+        /** @brief Writes decoded bytes through the ring buffer into the destination
+         */
+        struct RingWriter
+        {
+            /** @brief Destination of decoded data
+             */
+            uint8_t* destination;
+
+            /** @brief Number of decoded bytes
+             */
+            size_t written;
+
+            /** @brief Number of bytes already sent to the destination
+             */
+            size_t flushed;
+
+            /** @brief Construct a new ring writer
+             * @param destination Destination of decoded data
+             */
+            RingWriter(void* destination) : destination((uint8_t*)destination), written(0), flushed(0)
+            {
+                // Do nothing
+            }
+
+            /** @brief Send decoded bytes to the destination, transfer runs while the other half of the ring is being filled
+             */
+            void Flush()
+            {
+                slDMAWait();
+
+                if (this->written > this->flushed)
+                {
+                    slDMACopy(
+                        TexturePack::ring + (this->flushed & (TexturePack::RingSize - 1)),
+                        this->destination + this->flushed,
+                        this->written - this->flushed);
+                    this->flushed = this->written;
+                }
+            }
+
+            /** @brief Write decoded byte
+             * @param value Decoded byte
+             */
+            inline void Put(const uint8_t value)
+            {
+                TexturePack::ring[this->written & (TexturePack::RingSize - 1)] = value;
+
+                if ((++this->written & ((TexturePack::RingSize >> 1) - 1)) == 0)
+                {
+                    this->Flush();
+                }
+            }
+
+            /** @brief Copy already decoded bytes
+             * @param offset Distance back from the current position
+             * @param length Number of bytes, can be larger than offset
+             */
+            inline void Copy(const size_t offset, size_t length)
+            {
+                while (length-- > 0)
+                {
+                    this->Put(TexturePack::ring[(this->written - offset) & (TexturePack::RingSize - 1)]);
+                }
+            }
+
+            /** @brief Send the rest of the data and wait for the transfer to finish
+             */
+            void Finish()
+            {
+                this->Flush();
+                slDMAWait();
+
+                // Destination in work RAM might still be in CPU cache from before the transfer
+                slCashPurge();
+            }
+        };
+
+        /** @brief Read extended length
+         * @param source Compressed data
+         * @param length Length from the token nibble
+         * @return Full length
+         */
+        inline static size_t ReadLength(const uint8_t*& source, size_t length)
+        {
+            if (length == 15)
+            {
+                uint8_t extra;
+
+                do
+                {
+                    extra = *source++;
+                    length += extra;
+                }
+                while (extra == 255);
+            }
+
+            return length;
+        }
+
+        /** @brief Index of the first texture of the pack
+         */
+        int32_t firstTexture;
+
+        /** @brief Number of loaded textures
+         */
+        uint16_t textureCount;
+
+        /** @brief Value indicating whether all textures were loaded
+         */
+        bool loaded;
+
+        /** @brief Load all textures of the pack
+         * @param header Pack file
+         * @param palette First palette of the pack
+         */
+        void Load(const Header* header, const uint16_t palette)
+        {
+            if (header->Magic[0] != 'S' || header->Magic[1] != 'R' ||
+                header->Magic[2] != 'L' || header->Magic[3] != 'P' ||
+                header->Version != TexturePack::Version)
+            {
+                SRL::Debug::Assert("Unsupported texture pack");
+                return;
+            }
+
+            const Entry* entries = (const Entry*)(((uint8_t*)header) + header->EntryOffset);
+            this->firstTexture = SRL::VDP1::GetTextureCount();
+
+            for (uint16_t texture = 0; texture < header->TextureCount; texture++)
+            {
+                const Entry& entry = entries[texture];
+                const CRAM::TextureColorMode colorMode = (CRAM::TextureColorMode)entry.ColorMode;
+                const int32_t index = SRL::VDP1::TryAllocateTexture(entry.Width, entry.Height, colorMode, palette + entry.Palette);
+
+                if (index < 0)
+                {
+                    SRL::Debug::Assert("Not enough texture memory for texture pack");
+                    return;
+                }
+
+                const size_t size = ((entry.Width * entry.Height) << 2) >> SRL::VDP1::GetSizeShifter(colorMode);
+
+                if (TexturePack::Decompress(entry.Type, ((uint8_t*)header) + entry.DataOffset, entry.Size, SRL::VDP1::Textures[index].GetData(), size) != size)
+                {
+                    SRL::Debug::Assert("Texture %d of the pack is corrupted", texture);
+                    return;
+                }
+
+                this->textureCount++;
+            }
+
+            this->loaded = true;
+        }
+
+    public:
+
+        /** @brief Decompress data
+         * @param type Compression of the data
+         * @param source Compressed data
+         * @param size Size of the compressed data
+         * @param destination Destination, can be in VRAM or work RAM (must be 4 byte aligned), CPU cache is purged after the transfer
+         * @param outputSize Size of the decompressed data
+         * @return Number of decompressed bytes
+         */
+        static size_t Decompress(const Compression type, const void* source, const size_t size, void* destination, const size_t outputSize)
+        {
+            const uint8_t* input = (const uint8_t*)source;
+            const uint8_t* end = input + size;
+
+            if (type == Compression::None)
+            {
+                slDMACopy((void*)source, destination, SRL::Math::Min(size, outputSize));
+                slDMAWait();
+                slCashPurge();
+                return SRL::Math::Min(size, outputSize);
+            }
+
+            RingWriter output(destination);
+
+            if (type == Compression::Lz)
+            {
+                while (input < end && output.written < outputSize)
+                {
+                    const uint8_t token = *input++;
+                    size_t literals = SRL::Math::Min(TexturePack::ReadLength(input, token >> 4), outputSize - output.written);
+
+                    while (literals-- > 0)
+                    {
+                        output.Put(*input++);
+                    }
+
+                    // Last sequence has no match
+                    if (output.written >= outputSize || input >= end)
+                    {
+                        break;
+                    }
+
+                    const size_t offset = (input[0] << 8) | input[1];
+                    input += 2;
+                    const size_t length = TexturePack::ReadLength(input, token & 0xf) + 4;
+                    output.Copy(offset, SRL::Math::Min(length, outputSize - output.written));
+                }
+            }
+            else
+            {
+                while (input < end && output.written < outputSize)
+                {
+                    const uint8_t packet = *input++;
+                    const size_t count = SRL::Math::Min((size_t)(packet < 128 ? packet + 1 : packet - 127), outputSize - output.written);
+
+                    if (packet < 128)
+                    {
+                        for (size_t literal = 0; literal < count; literal++)
+                        {
+                            output.Put(*input++);
+                        }
+                    }
+                    else
+                    {
+                        const uint8_t value = *input++;
+
+                        for (size_t repeat = 0; repeat < count; repeat++)
+                        {
+                            output.Put(value);
+                        }
+                    }
+                }
+            }
+
+            output.Finish();
+            return output.written;
+        }
+
+        /** @brief Load texture pack from a file
+         * @param fileName Pack file name
+         * @param palette First palette of the pack (not used in RGB555 mode)
+         */
+        TexturePack(const char* fileName, const uint16_t palette = 0) : firstTexture(-1), textureCount(0), loaded(false)
+        {
+            SRL::Cd::File file = SRL::Cd::File(fileName);
+
+            if (!file.Exists())
+            {
+                SRL::Debug::Assert("Texture pack '%s' not found", fileName);
+                return;
+            }
+
+            uint8_t* data = new uint8_t[file.Size.Bytes];
+            file.LoadBytes(0, file.Size.Bytes, data);
+            this->Load((const Header*)data, palette);
+            delete[] data;
+        }
+
+        /** @brief Load texture pack already loaded in memory
+         * @param data Pack file data (must be 4 byte aligned), can be freed after the pack was loaded
+         * @param palette First palette of the pack (not used in RGB555 mode)
+         */
+        TexturePack(const void* data, const uint16_t palette = 0) : firstTexture(-1), textureCount(0), loaded(false)
+        {
+            this->Load((const Header*)data, palette);
+        }
+
+        /** @brief Get a value indicating whether all textures were loaded
+         * @return True if pack is loaded
+         */
+        bool IsLoaded() const
+        {
+            return this->loaded;
+        }
+
+        /** @brief Gets index of the first texture loaded by the pack
+         * @return Texture index or -1 if pack was not loaded
+         */
+        int32_t GetFirstTextureIndex() const
+        {
+            return this->textureCount > 0 ? this->firstTexture : -1;
+        }
+
+        /** @brief Gets number of loaded textures
+         * @return Number of textures
+         */
+        uint16_t GetTextureCount() const
+        {
+            return this->textureCount;
+        }
+    };
+}
@@ -8,7 +8,9 @@ namespace SRL::Tilemap::Interfaces
 {
     /** @brief Interface to Convert Bitmap Image into Tilemap
      * @note Maximum Size of bitmap to convert is 0x20000 bytes (512x512 @ 4bpp, 512x256 @ 8bpp, or 256x256 @ 16bpp).
-     * @note Empty tiles in the source image are detected and removed from the tileset, but duplicate and mirrored tiles are not.
+     * Larger maps can be displayed with SRL::Tilemap::StreamingTilemap.
+     * @note Empty tiles in the source image are detected and removed from the tileset. Duplicate tiles are stored once,
+     * and so are tiles that only differ by horizontal, vertical or both flips, when map mode has flip bits (2 word or 1 word with 10 bit character number).
      * @note In cases where bitmap is below maximum size or contains empty tiles, a default empty tile is written at start
      * of tileset.
      */
@@ -43,6 +45,221 @@ namespace SRL::Tilemap::Interfaces
          */
         uint8_t dataAccumulator = 0;
 
+        /** @brief Number of non-empty tiles stored in the tileset.
+         */
+        uint16_t uniqueCells = 0;
+
+        /** @brief Number of non-empty tiles that reuse a stored tile.
+         */
+        uint16_t duplicateCells = 0;
+
+        /** @brief Number of duplicate tiles that reuse a stored tile flipped.
+         */
+        uint16_t flippedCells = 0;
+
+        /** @brief Number of cell data bytes removed from the tileset by dropping empty and duplicate tiles.
+         */
+        int32_t savedBytes = 0;
+
+        /** @brief Hash table of stored tiles, each bucket holds index of a stored tile + 1 or 0 when empty.
+         */
+        uint16_t* cellBuckets = nullptr;
+
+        /** @brief Hash of each stored tile.
+         */
+        uint32_t* cellHashes = nullptr;
+
+        /** @brief Character number of each stored tile.
+         */
+        uint16_t* cellEntries = nullptr;
+
+        /** @brief Mask of a bucket index in the hash table.
+         */
+        uint16_t bucketMask = 0;
+
+        /** @brief Gets single pixel of a tile in the tileset.
+         * @param tile Start of the tile.
+         * @param x X coordinate of the pixel.
+         * @param y Y coordinate of the pixel.
+         * @param dataWidth number of bytes in 8 pixel line of a cel.
+         * @param large Tile is a 2x2 cel character.
+         * @return Color index or RGB value of the pixel.
+         */
+        static uint16_t GetPixel(const uint8_t* tile, uint8_t x, uint8_t y, uint8_t dataWidth, bool large)
+        {
+            if (large) // Characters are stored as 4 cels: top left, top right, bottom left, bottom right
+            {
+                tile += (((y >> 3) << 1) | (x >> 3)) * (dataWidth << 3);
+                x &= 7;
+                y &= 7;
+            }
+
+            const uint8_t* line = tile + (y * dataWidth);
+
+            if (dataWidth == 4) return (line[x >> 1] >> ((x & 1) ? 0 : 4)) & 0xf;
+            else if (dataWidth == 16) return (line[x << 1] << 8) | line[(x << 1) + 1];
+            return line[x];
+        }
+
+        /** @brief Computes hash of a tile that does not change when the tile is flipped.
+         * @details Each pixel is mixed with its distance to the nearest vertical and horizontal edge, which is same for the pixel and its mirror,
+         * and the results are summed, so order of the pixels does not matter.
+         * @param tile Start of the tile.
+         * @param dataWidth number of bytes in 8 pixel line of a cel.
+         * @param large Tile is a 2x2 cel character.
+         * @return Hash of the tile.
+         */
+        static uint32_t HashCell(const uint8_t* tile, uint8_t dataWidth, bool large)
+        {
+            const uint8_t size = large ? 16 : 8;
+            uint32_t hash = 0;
+
+            for (uint8_t y = 0; y < size; ++y)
+            {
+                const uint32_t edgeY = SRL::Math::Min(y, (uint8_t)(size - 1 - y));
+
+                for (uint8_t x = 0; x < size; ++x)
+                {
+                    const uint32_t edgeX = SRL::Math::Min(x, (uint8_t)(size - 1 - x));
+                    uint32_t key = ((Bmp2Tile::GetPixel(tile, x, y, dataWidth, large) + 1) * 0x9e3779b1) ^ (((edgeX << 4) | edgeY) * 0x85ebca77);
+                    key ^= key >> 15;
+                    key *= 0x2c1b3c6d;
+                    hash += key ^ (key >> 12);
+                }
+            }
+
+            return hash;
+        }
+
+        /** @brief Compares stored tile with a flipped tile.
+         * @param stored Start of the stored tile.
+         * @param tile Start of the compared tile.
+         * @param dataWidth number of bytes in 8 pixel line of a cel.
+         * @param large Tile is a 2x2 cel character.
+         * @param flip Flip applied to the compared tile (bit 0 horizontal, bit 1 vertical).
+         * @return True if stored tile equals the flipped tile.
+         */
+        static bool CompareCell(const uint8_t* stored, const uint8_t* tile, uint8_t dataWidth, bool large, uint8_t flip)
+        {
+            const uint8_t size = large ? 16 : 8;
+
+            if (!flip) // Plain duplicate, compare whole words
+            {
+                const uint32_t words = ((uint32_t)dataWidth << 1) << (large ? 2 : 0);
+
+                for (uint32_t i = 0; i < words; ++i)
+                {
+                    if (((const uint32_t*)stored)[i] != ((const uint32_t*)tile)[i]) return false;
+                }
+
+                return true;
+            }
+
+            for (uint8_t y = 0; y < size; ++y)
+            {
+                const uint8_t flippedY = (flip & 2) ? size - 1 - y : y;
+
+                for (uint8_t x = 0; x < size; ++x)
+                {
+                    const uint8_t flippedX = (flip & 1) ? size - 1 - x : x;
+
+                    if (Bmp2Tile::GetPixel(stored, x, y, dataWidth, large) != Bmp2Tile::GetPixel(tile, flippedX, flippedY, dataWidth, large))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        /** @brief Finds stored tile equal to a tile or to one of its flips.
+         * @param tile Start of the tile to look for.
+         * @param hash Hash of the tile.
+         * @param dataWidth number of bytes in 8 pixel line of a cel.
+         * @param large Tile is a 2x2 cel character.
+         * @param flips Whether flipped tiles can be reused.
+         * @param flip Flip that maps the stored tile onto this one (bit 0 horizontal, bit 1 vertical).
+         * @return Character number of the stored tile or -1 if it is not in the tileset yet.
+         */
+        int32_t FindCell(const uint8_t* tile, uint32_t hash, uint8_t dataWidth, bool large, bool flips, uint8_t& flip)
+        {
+            for (uint16_t bucket = hash & this->bucketMask; this->cellBuckets[bucket] != 0; bucket = (bucket + 1) & this->bucketMask)
+            {
+                const uint16_t stored = this->cellBuckets[bucket] - 1;
+
+                if (this->cellHashes[stored] == hash)
+                {
+                    const uint8_t* data = this->cellData + ((uint32_t)this->cellEntries[stored] << (large ? 7 : 5));
+
+                    for (flip = 0; flip < (flips ? 4 : 1); ++flip)
+                    {
+                        if (Bmp2Tile::CompareCell(data, tile, dataWidth, large, flip)) return this->cellEntries[stored];
+                    }
+                }
+            }
+
+            flip = 0;
+            return -1;
+        }
+
+        /** @brief Adds tile to the hash table of stored tiles.
+         * @param hash Hash of the tile.
+         * @param entry Character number of the tile.
+         */
+        void AddCell(uint32_t hash, uint16_t entry)
+        {
+            uint16_t bucket = hash & this->bucketMask;
+            while (this->cellBuckets[bucket] != 0) bucket = (bucket + 1) & this->bucketMask;
+
+            this->cellHashes[this->uniqueCells] = hash;
+            this->cellEntries[this->uniqueCells] = entry;
+            this->cellBuckets[bucket] = ++this->uniqueCells;
+        }
+
+        /** @brief Keeps the converted tile in the tileset unless it is empty or already stored, and writes its map data.
+         * @param tile Start of the converted tile, which is also the end of the tileset.
+         * @param config Data configuration of the tilemap.
+         * @param flags Word of 2 word map data holding flip bits.
+         * @param map Map data of the tile.
+         * @param dataWidth number of bytes in 8 pixel line of a cel.
+         * @param flips Whether flipped tiles can be reused.
+         * @return True if tile was kept in the tileset.
+         */
+        bool KeepCell(uint8_t* tile, TilemapInfo& config, uint16_t* flags, uint16_t* map, uint8_t dataWidth, bool flips)
+        {
+            if (!this->dataAccumulator) // Set map to index 0 and do not retain the tile
+            {
+                *map = 0;
+                return false;
+            }
+
+            const bool large = config.CharSize != CHAR_SIZE_1x1;
+            const uint32_t hash = Bmp2Tile::HashCell(tile, dataWidth, large);
+            uint8_t flip;
+            int32_t found = this->FindCell(tile, hash, dataWidth, large, flips, flip);
+
+            if (found < 0) // New tile, keep it
+            {
+                *map = this->numCells;
+                this->AddCell(hash, this->numCells);
+                this->numCells += (dataWidth >> 2);
+                return true;
+            }
+
+            // Flip bits are bits 10-11 of 1 word data, or bits 14-15 of the first word of 2 word data
+            if (config.MapMode) *map = found | (flip << 10);
+            else
+            {
+                *flags = flip << 14;
+                *map = found;
+            }
+
+            this->duplicateCells++;
+            this->flippedCells += flip ? 1 : 0;
+            return false;
+        }
+
         /** @brief Extracts 8x8 pixel region of bitmap image and converts to a cell (8x8 tile)
          * @param start Top left pixel of the tile in bitmap.
          * @param Cell start of the cell to write data to in the tileset.
@@ -135,6 +352,23 @@ namespace SRL::Tilemap::Interfaces
                 return;
             }
 
+            // Prepare hash table of stored tiles with at most half of the buckets used
+            uint16_t maxCells = (config.CharSize == CHAR_SIZE_1x1 ? xCells * yCells : (xCells >> 1) * (yCells >> 1)) + 1;
+            uint16_t buckets = 16;
+            while (buckets < (maxCells << 1)) buckets <<= 1;
+
+            this->cellBuckets = new uint16_t[buckets];
+            this->cellHashes = new uint32_t[maxCells];
+            this->cellEntries = new uint16_t[maxCells];
+            this->bucketMask = buckets - 1;
+            this->uniqueCells = 0;
+            this->duplicateCells = 0;
+            this->flippedCells = 0;
+            for (uint16_t i = 0; i < buckets; ++i) this->cellBuckets[i] = 0;
+
+            // 12 bit character number leaves no room for flip bits in 1 word map data
+            bool flips = !config.MapMode || !(config.MapMode & CN_12BIT);
+
             int32_t pix = ((8 * (1 + config.CharSize)) * (byteCell * (1 + config.CharSize)));
             if (tile0)
             {
@@ -154,21 +388,15 @@ namespace SRL::Tilemap::Interfaces
                     for (int32_t j = 0; j < xCells; ++j)
                     {
                         this->dataAccumulator = 0;
+                        uint8_t* tile = currentCell;
                         currentCell = this->Bitmap2Cell(currentData, currentCell, byteWidth, byteCell);
                         currentData += byteCell;
 
+                        uint16_t* flags = currentMap;
                         if (!config.MapMode) ++currentMap; // Add extra word of spacing to character pattern data
 
-                        if (this->dataAccumulator) // If this tile was not blank keep it
-                        {
-                            *currentMap++ = this->numCells;
-                            this->numCells += (byteCell >> 2);
-                        }
-                        else // Set map to index 0 and do not retain the tile
-                        {
-                            *currentMap++ = 0;
-                            currentCell -= (byteCell << 3);
-                        }
+                        // Keep only tiles that are neither blank nor already stored
+                        if (!this->KeepCell(tile, config, flags, currentMap++, byteCell, flips)) currentCell = tile;
                     }
 
                     currentData += (byteWidth * 7);
@@ -182,28 +410,34 @@ namespace SRL::Tilemap::Interfaces
                     for (int32_t j = 0; j < (xCells >> 1); ++j)
                     {
                         this->dataAccumulator = 0;
+                        uint8_t* tile = currentCell;
                         currentCell = this->Bitmap2Char2x2(currentData, currentCell, byteWidth, byteCell);
                         currentData += (byteCell << 1);
 
                         // Add extra word of spacing to character pattern data when 32 bit
+                        uint16_t* flags = currentMap;
                         if (!config.MapMode) ++currentMap;
 
-                        if (this->dataAccumulator) // If this tile was not empty
-                        {
-                            *currentMap++ = this->numCells;
-                            this->numCells += (byteCell >> 2);
-                        }
-                        else // Set to index 0 and do not retain this tile
-                        {
-                            *currentMap++ = 0;
-                            currentCell -= (byteCell << 5);
-                        }
+                        // Keep only tiles that are neither empty nor already stored
+                        if (!this->KeepCell(tile, config, flags, currentMap++, byteCell, flips)) currentCell = tile;
                     }
 
                     currentData += (byteWidth * 15); // Increment to next line of Characters in image
                     currentMap += (32 - (xCells >> 1));// Increment to next line of the page
                 }
             }
+
+            // Only stored tiles need VRAM
+            int32_t usedBytes = (int32_t)(currentCell - this->cellData);
+            this->savedBytes = config.CellByteSize - usedBytes;
+            config.CellByteSize = usedBytes;
+
+            delete[] this->cellBuckets;
+            delete[] this->cellHashes;
+            delete[] this->cellEntries;
+            this->cellBuckets = nullptr;
+            this->cellHashes = nullptr;
+            this->cellEntries = nullptr;
         }
     public:
 
@@ -223,7 +457,8 @@ namespace SRL::Tilemap::Interfaces
             this->numPages = pages;
             this->numCells = 0;
             this->info.CharSize = CHAR_SIZE_2x2;
-            this->info.MapMode = PNB_1WORD | CN_12BIT;
+            // 10 bit character number leaves bits for flips, 2x2 characters still reach 0x20000 bytes of cell data
+            this->info.MapMode = PNB_1WORD | ((this->info.CharSize) ? CN_10BIT : CN_12BIT);
             this->info.PlaneSize = PL_SIZE_1x1;
             this->info.MapHeight = (this->info.CharSize) ? (32 * pages) : (64 * pages);
             this->info.MapWidth = (this->info.CharSize) ? 32 : 64;
@@ -279,6 +514,9 @@ namespace SRL::Tilemap::Interfaces
                 this->cellData = autonew uint8_t[this->info.CellByteSize];
                 this->ConvertBitmap(this->info, bmp, 0, false);
             }
+
+            // 10 bit character number only reaches cell data within 0x20000 byte region, keep 12 bits when no tile needs flip bits
+            if (this->info.CharSize && this->flippedCells == 0) this->info.MapMode = PNB_1WORD | CN_12BIT;
         }
 
         /** @brief Free allocated resources and destroy Bmp2Tile object
@@ -322,6 +560,38 @@ namespace SRL::Tilemap::Interfaces
             return this->info;
         }
 
+        /** @brief Get number of non-empty tiles stored in the tileset
+         * @return Unique tile count (not including the default empty tile)
+         */
+        uint16_t GetUniqueCells()
+        {
+            return this->uniqueCells;
+        }
+
+        /** @brief Get number of non-empty tiles that reuse a stored tile
+         * @return Duplicate tile count, including flipped ones
+         */
+        uint16_t GetDuplicateCells()
+        {
+            return this->duplicateCells;
+        }
+
+        /** @brief Get number of tiles that reuse a stored tile through flip bits
+         * @return Flipped tile count
+         */
+        uint16_t GetFlippedCells()
+        {
+            return this->flippedCells;
+        }
+
+        /** @brief Get number of bytes of VRAM saved by dropping empty and duplicate tiles
+         * @return Difference between size of the whole image and size of the stored tileset
+         */
+        int32_t GetSavedBytes()
+        {
+            return this->savedBytes;
+        }
+
         /** @brief Copies a rectangular selection of Tilemap data between  2 pages in the tilemap
         * @param sourcePage Index of the Tilemap Page to copy from
         * @param topLeft Page Coordinates of Top left of region to Copy
@@ -0,0 +1,932 @@
+#pragma once
+
+#include "srl_vdp2.hpp"
+#include "srl_cd.hpp"
+#include "srl_tv.hpp"
+
+namespace SRL::Tilemap
+{
+    /** @brief Virtual interface for map data of a streaming tilemap
+     * @details Map data is a grid of tile indexes into the tileset of SRL::Tilemap::StreamingTilemap.
+     * Streaming tilemap asks only for the row or column of tiles that became exposed since the last update,
+     * so the source does not need to keep the whole map in RAM.
+     */
+    struct IStreamSource
+    {
+        /** @brief Get width of the map
+         * @return Width in tile units
+         */
+        virtual uint16_t GetWidth()
+        {
+            return 0;
+        }
+
+        /** @brief Get height of the map
+         * @return Height in tile units
+         */
+        virtual uint16_t GetHeight()
+        {
+            return 0;
+        }
+
+        /** @brief Read line of tile indexes
+         * @param x X coordinate of the first tile (always inside of the map)
+         * @param y Y coordinate of the first tile (always inside of the map)
+         * @param count Number of tiles to read (line never crosses edge of the map)
+         * @param vertical Read column going down if true, row going right otherwise
+         * @param tiles Buffer to read tile indexes into
+         */
+        virtual void Read(uint16_t x, uint16_t y, uint16_t count, bool vertical, uint16_t* tiles)
+        {
+            for (uint16_t i = 0; i < count; i++) tiles[i] = 0;
+        }
+    };
+
+    /** @brief Streaming tilemap source with whole map kept in RAM
+     * @note Map data is stored in rows, first row being the top of the map.
+     */
+    struct MemoryStreamSource : public IStreamSource
+    {
+    private:
+        /** @brief Tile indexes of the whole map
+         */
+        const uint16_t* tiles;
+
+        /** @brief Width of the map
+         */
+        uint16_t width;
+
+        /** @brief Height of the map
+         */
+        uint16_t height;
+
+    public:
+        /** @brief Construct source over map data in RAM
+         * @param tiles Tile indexes stored in rows (data is not copied)
+         * @param width Width in tile units
+         * @param height Height in tile units
+         */
+        MemoryStreamSource(const uint16_t* tiles, uint16_t width, uint16_t height) : tiles(tiles), width(width), height(height)
+        {
+        }
+
+        /** @brief Get width of the map
+         * @return Width in tile units
+         */
+        uint16_t GetWidth() override
+        {
+            return this->width;
+        }
+
+        /** @brief Get height of the map
+         * @return Height in tile units
+         */
+        uint16_t GetHeight() override
+        {
+            return this->height;
+        }
+
+        /** @brief Read line of tile indexes
+         * @param x X coordinate of the first tile
+         * @param y Y coordinate of the first tile
+         * @param count Number of tiles to read
+         * @param vertical Read column going down if true, row going right otherwise
+         * @param tiles Buffer to read tile indexes into
+         */
+        void Read(uint16_t x, uint16_t y, uint16_t count, bool vertical, uint16_t* tiles) override
+        {
+            const uint16_t* source = this->tiles + ((uint32_t)y * this->width) + x;
+            const uint32_t step = vertical ? this->width : 1;
+
+            for (uint16_t i = 0; i < count; i++)
+            {
+                tiles[i] = *source;
+                source += step;
+            }
+        }
+    };
+
+    /** @brief Streaming tilemap source reading map from a file on CD
+     * @details Map is stored in columns, so a window of neighboring columns is a single continuous read.
+     * Only the window is kept in RAM, when a line outside of it is requested, window is re-centered on that line and loaded again.
+     * This suits horizontally scrolling levels of any length, where window reload happens once every few screens.
+     * @note Window must be wider than the number of columns streaming tilemap keeps loaded (at most 64).
+     * @note Loading is blocking, keep the window wide enough so reloads are rare.
+     */
+    struct CdStreamSource : public IStreamSource
+    {
+    private:
+        /** @brief Size of a CD sector in bytes
+         */
+        static constexpr uint32_t SectorSize = 2048;
+
+        /** @brief Map file
+         */
+        SRL::Cd::File file;
+
+        /** @brief Width of the map
+         */
+        uint16_t width;
+
+        /** @brief Height of the map
+         */
+        uint16_t height;
+
+        /** @brief Number of columns kept in RAM
+         */
+        uint16_t windowColumns;
+
+        /** @brief First column in the window
+         */
+        int32_t windowStart;
+
+        /** @brief Read buffer, includes space for unaligned start of the first sector
+         */
+        uint8_t* buffer;
+
+        /** @brief Tile indexes of the first column in the window
+         */
+        uint16_t* window;
+
+        /** @brief Number of window loads
+         */
+        uint32_t loads;
+
+        /** @brief Make sure columns are in the window
+         * @param first First column
+         * @param last Column after the last one
+         */
+        void Ensure(uint16_t first, uint16_t last)
+        {
+            if (this->windowStart >= 0 && first >= this->windowStart && last <= this->windowStart + this->windowColumns)
+            {
+                return;
+            }
+
+            int32_t start = (int32_t)first - ((this->windowColumns - (last - first)) >> 1);
+            start = SRL::Math::Min(start, (int32_t)this->width - this->windowColumns);
+            start = SRL::Math::Max(start, (int32_t)0);
+
+            // Read from the first sector the window starts in
+            const uint32_t offset = ((uint32_t)start * this->height) << 1;
+            const uint32_t skip = offset & (CdStreamSource::SectorSize - 1);
+
+            this->file.LoadBytes(offset / CdStreamSource::SectorSize, skip + ((this->windowColumns * this->height) << 1), this->buffer);
+            this->window = (uint16_t*)(this->buffer + skip);
+            this->windowStart = start;
+            this->loads++;
+        }
+
+    public:
+        /** @brief Construct source over map file on CD
+         * @param fileName Map file, tile indexes stored in columns, first column being the left edge of the map
+         * @param width Width in tile units
+         * @param height Height in tile units
+         * @param windowColumns Number of columns to keep in RAM
+         */
+        CdStreamSource(const char* fileName, uint16_t width, uint16_t height, uint16_t windowColumns = 128) :
+            file(fileName),
+            width(width),
+            height(height),
+            windowColumns(SRL::Math::Min(windowColumns, width)),
+            windowStart(-1),
+            window(nullptr),
+            loads(0)
+        {
+            if (!this->file.Exists())
+            {
+                SRL::Debug::Assert("Streaming tilemap file '%s' not found", fileName);
+            }
+
+            this->buffer = new uint8_t[((this->windowColumns * this->height) << 1) + CdStreamSource::SectorSize];
+        }
+
+        /** @brief Destroy the source and free the window
+         */
+        ~CdStreamSource()
+        {
+            delete[] this->buffer;
+        }
+
+        /** @brief Get width of the map
+         * @return Width in tile units
+         */
+        uint16_t GetWidth() override
+        {
+            return this->width;
+        }
+
+        /** @brief Get height of the map
+         * @return Height in tile units
+         */
+        uint16_t GetHeight() override
+        {
+            return this->height;
+        }
+
+        /** @brief Read line of tile indexes
+         * @param x X coordinate of the first tile
+         * @param y Y coordinate of the first tile
+         * @param count Number of tiles to read
+         * @param vertical Read column going down if true, row going right otherwise
+         * @param tiles Buffer to read tile indexes into
+         */
+        void Read(uint16_t x, uint16_t y, uint16_t count, bool vertical, uint16_t* tiles) override
+        {
+            this->Ensure(x, vertical ? x + 1 : x + count);
+
+            const uint16_t* source = this->window + ((uint32_t)(x - this->windowStart) * this->height) + y;
+            const uint32_t step = vertical ? 1 : this->height;
+
+            for (uint16_t i = 0; i < count; i++)
+            {
+                tiles[i] = *source;
+                source += step;
+            }
+        }
+
+        /** @brief Get number of times window was loaded from CD
+         * @return Load count
+         */
+        uint32_t GetLoadCount()
+        {
+            return this->loads;
+        }
+    };
+
+    /** @brief Reference counted LRU cache of tiles stored in fixed number of slots
+     * @details Every tile shown on screen holds a reference to its slot. Once the last reference is released,
+     * slot keeps its tile and goes to the end of the eviction list, so tiles that come back into view are found again without upload.
+     * New tiles take slots that were never used first, then the least recently released ones.
+     * Slots that are still referenced are never evicted.
+     */
+    class CellCache
+    {
+    public:
+        /** @brief Value of an unused slot or tile
+         */
+        static constexpr uint16_t None = 0xffff;
+
+    private:
+        /** @brief Number of slots
+         */
+        uint16_t slotCount;
+
+        /** @brief Number of tiles in the tileset
+         */
+        uint16_t tileCount;
+
+        /** @brief Number of slots handed out at least once
+         */
+        uint16_t used;
+
+        /** @brief Slot of each tile
+         */
+        uint16_t* tileSlots;
+
+        /** @brief Tile of each slot
+         */
+        uint16_t* slotTiles;
+
+        /** @brief Reference count of each slot
+         */
+        uint16_t* references;
+
+        /** @brief Previous slot in the eviction list
+         */
+        uint16_t* previous;
+
+        /** @brief Next slot in the eviction list
+         */
+        uint16_t* next;
+
+        /** @brief Least recently released slot
+         */
+        uint16_t head;
+
+        /** @brief Most recently released slot
+         */
+        uint16_t tail;
+
+        /** @brief Remove slot from the eviction list
+         * @param slot Slot to remove
+         */
+        void Unlink(uint16_t slot)
+        {
+            if (this->previous[slot] != CellCache::None) this->next[this->previous[slot]] = this->next[slot];
+            else this->head = this->next[slot];
+
+            if (this->next[slot] != CellCache::None) this->previous[this->next[slot]] = this->previous[slot];
+            else this->tail = this->previous[slot];
+
+            this->previous[slot] = CellCache::None;
+            this->next[slot] = CellCache::None;
+        }
+
+        /** @brief Append slot to the end of the eviction list
+         * @param slot Slot to append
+         */
+        void Append(uint16_t slot)
+        {
+            this->previous[slot] = this->tail;
+            this->next[slot] = CellCache::None;
+
+            if (this->tail != CellCache::None) this->next[this->tail] = slot;
+            else this->head = slot;
+
+            this->tail = slot;
+        }
+
+    public:
+        /** @brief Construct cache
+         * @param slotCount Number of slots
+         * @param tileCount Number of tiles in the tileset
+         */
+        CellCache(uint16_t slotCount, uint16_t tileCount) : slotCount(slotCount), tileCount(tileCount)
+        {
+            this->tileSlots = new uint16_t[tileCount];
+            this->slotTiles = new uint16_t[slotCount];
+            this->references = new uint16_t[slotCount];
+            this->previous = new uint16_t[slotCount];
+            this->next = new uint16_t[slotCount];
+            this->Clear();
+        }
+
+        /** @brief Disable copy constructor
+         */
+        CellCache(const CellCache&) = delete;
+
+        /** @brief Disable assignment operator
+         */
+        CellCache& operator=(const CellCache&) = delete;
+
+        /** @brief Destroy the cache
+         */
+        ~CellCache()
+        {
+            delete[] this->tileSlots;
+            delete[] this->slotTiles;
+            delete[] this->references;
+            delete[] this->previous;
+            delete[] this->next;
+        }
+
+        /** @brief Forget all tiles and references
+         */
+        void Clear()
+        {
+            for (uint16_t tile = 0; tile < this->tileCount; tile++) this->tileSlots[tile] = CellCache::None;
+
+            for (uint16_t slot = 0; slot < this->slotCount; slot++)
+            {
+                this->slotTiles[slot] = CellCache::None;
+                this->references[slot] = 0;
+                this->previous[slot] = CellCache::None;
+                this->next[slot] = CellCache::None;
+            }
+
+            this->used = 0;
+            this->head = CellCache::None;
+            this->tail = CellCache::None;
+        }
+
+        /** @brief Get slot holding a tile and add reference to it
+         * @param tile Tile index
+         * @param load Set to true if tile was not in the cache and its data must be copied into the slot
+         * @return Slot index or -1 if tile index is invalid or all slots are referenced
+         */
+        int32_t Acquire(uint16_t tile, bool& load)
+        {
+            load = false;
+
+            if (tile >= this->tileCount)
+            {
+                return -1;
+            }
+
+            uint16_t slot = this->tileSlots[tile];
+
+            if (slot != CellCache::None)
+            {
+                if (this->references[slot] == 0) this->Unlink(slot);
+            }
+            else
+            {
+                if (this->used < this->slotCount)
+                {
+                    slot = this->used++;
+                }
+                else if (this->head != CellCache::None)
+                {
+                    // Evict least recently released tile
+                    slot = this->head;
+                    this->Unlink(slot);
+                    this->tileSlots[this->slotTiles[slot]] = CellCache::None;
+                }
+                else
+                {
+                    return -1;
+                }
+
+                this->slotTiles[slot] = tile;
+                this->tileSlots[tile] = slot;
+                load = true;
+            }
+
+            this->references[slot]++;
+            return slot;
+        }
+
+        /** @brief Release reference to a slot
+         * @param slot Slot index
+         */
+        void Release(uint16_t slot)
+        {
+            if (slot < this->slotCount && this->references[slot] > 0 && --this->references[slot] == 0)
+            {
+                this->Append(slot);
+            }
+        }
+
+        /** @brief Find slot holding a tile
+         * @param tile Tile index
+         * @return Slot index or -1 if tile is not in the cache
+         */
+        int32_t Find(uint16_t tile) const
+        {
+            return tile < this->tileCount && this->tileSlots[tile] != CellCache::None ? this->tileSlots[tile] : -1;
+        }
+
+        /** @brief Get tile stored in a slot
+         * @param slot Slot index
+         * @return Tile index or SRL::Tilemap::CellCache::None
+         */
+        uint16_t GetTile(uint16_t slot) const
+        {
+            return this->slotTiles[slot];
+        }
+
+        /** @brief Get number of references to a slot
+         * @param slot Slot index
+         * @return Reference count
+         */
+        uint16_t GetReferenceCount(uint16_t slot) const
+        {
+            return this->references[slot];
+        }
+
+        /** @brief Get number of slots
+         * @return Slot count
+         */
+        uint16_t GetSlotCount() const
+        {
+            return this->slotCount;
+        }
+    };
+
+    /** @brief Tilemap streamed into a single page of a NBG scroll screen
+     * @details Map of any size is provided by SRL::Tilemap::IStreamSource as tile indexes into a tileset kept in RAM.
+     * Scroll screen shows a single page on all four planes, so VDP2 wraps it around like a ring buffer
+     * (64x64 tiles for 8x8 tiles, 32x32 tiles for 16x16 tiles, 512x512 pixels either way).
+     * Only a window of tiles covering the screen plus one tile is kept in the page. When the camera moves,
+     * only the row or column of map entries that became exposed is written and the one that left the window is released.
+     * @details Tile patterns are not uploaded all at once either. Character cells in VRAM are slots of SRL::Tilemap::CellCache,
+     * a tile is copied into a slot when it first enters the window and stays there until the slot is needed by another tile.
+     * Tiles are only evicted once no map entry in the window refers to them, so eviction never changes what is on screen.
+     * @tparam ScreenType NBG scroll screen to stream into (SRL::VDP2::NBG0 to SRL::VDP2::NBG3)
+     * @note Slot count must cover the number of different tiles that can be visible at once, tiles over that are shown as a blank cell reserved after the slots and counted by GetMissCount().
+     * @note Map entries are 1 word without flip bits, tile 0 is shown outside of the map.
+     * @code {.cpp}
+     * SRL::Tilemap::MemoryStreamSource level(levelTiles, 2048, 32);
+     * SRL::Tilemap::StreamingTilemap<SRL::VDP2::NBG0> map(level, tileset, 256, SRL::CRAM::TextureColorMode::Paletted256, CHAR_SIZE_1x1, 1024, palette);
+     * SRL::VDP2::NBG0::ScrollEnable();
+     *
+     * while (1)
+     * {
+     *     map.Update(cameraX, cameraY);
+     *     SRL::Core::Synchronize();
+     * }
+     * @endcode
+     */
+    template<class ScreenType>
+    class StreamingTilemap
+    {
+    private:
+        /** @brief Map data source
+         */
+        IStreamSource& source;
+
+        /** @brief Tile patterns in RAM
+         */
+        const uint8_t* tileset;
+
+        /** @brief Number of bytes of a single tile pattern
+         */
+        uint16_t tileBytes;
+
+        /** @brief Map entry step between two slots
+         */
+        uint16_t slotStep;
+
+        /** @brief Map entry offset of the first slot including palette bank
+         */
+        uint16_t entryBase;
+
+        /** @brief Map entry of the blank cell shown for tiles that did not fit into the cache
+         */
+        uint16_t blankEntry;
+
+        /** @brief Tile size as a power of two
+         */
+        uint8_t tileShift;
+
+        /** @brief Page width and height as a power of two
+         */
+        uint8_t pageShift;
+
+        /** @brief Number of columns in the window
+         */
+        uint16_t columns;
+
+        /** @brief Number of rows in the window
+         */
+        uint16_t rows;
+
+        /** @brief Left column of the window
+         */
+        int32_t left;
+
+        /** @brief Top row of the window
+         */
+        int32_t top;
+
+        /** @brief Value indicating whether window is loaded
+         */
+        bool valid;
+
+        /** @brief Character cache slots
+         */
+        CellCache cache;
+
+        /** @brief Slot used by each entry of the page
+         */
+        uint16_t* entrySlots;
+
+        /** @brief Buffer for a single line of tile indexes
+         */
+        uint16_t line[64];
+
+        /** @brief Map entries written during last update
+         */
+        uint16_t writtenEntries;
+
+        /** @brief Tile patterns uploaded during last update
+         */
+        uint16_t uploadedCells;
+
+        /** @brief Tiles that did not fit into the cache since the start
+         */
+        uint32_t misses;
+
+        /** @brief Release all entries of a line in the window
+         * @param x X coordinate of the first tile
+         * @param y Y coordinate of the first tile
+         * @param vertical Line is a column if true, row otherwise
+         */
+        void ReleaseLine(int32_t x, int32_t y, bool vertical)
+        {
+            const uint16_t count = vertical ? this->rows : this->columns;
+            const int32_t mask = (1 << this->pageShift) - 1;
+
+            for (uint16_t i = 0; i < count; i++)
+            {
+                const int32_t tileX = vertical ? x : x + i;
+                const int32_t tileY = vertical ? y + i : y;
+                const uint16_t entry = ((tileY & mask) << this->pageShift) | (tileX & mask);
+
+                this->cache.Release(this->entrySlots[entry]);
+                this->entrySlots[entry] = CellCache::None;
+            }
+        }
+
+        /** @brief Write all entries of a line in the window
+         * @param x X coordinate of the first tile
+         * @param y Y coordinate of the first tile
+         * @param vertical Line is a column if true, row otherwise
+         */
+        void WriteLine(int32_t x, int32_t y, bool vertical)
+        {
+            const uint16_t count = vertical ? this->rows : this->columns;
+            const int32_t mask = (1 << this->pageShift) - 1;
+            const int32_t start = vertical ? y : x;
+            const int32_t fixed = vertical ? x : y;
+            const int32_t length = vertical ? this->source.GetHeight() : this->source.GetWidth();
+            const int32_t across = vertical ? this->source.GetWidth() : this->source.GetHeight();
+
+            for (uint16_t i = 0; i < count; i++) this->line[i] = 0;
+
+            // Read only the part of the line inside of the map
+            if (fixed >= 0 && fixed < across)
+            {
+                const int32_t first = SRL::Math::Max(start, (int32_t)0);
+                const int32_t last = SRL::Math::Min(start + count, length);
+
+                if (first < last)
+                {
+                    this->source.Read(
+                        vertical ? x : first,
+                        vertical ? first : y,
+                        last - first,
+                        vertical,
+                        this->line + (first - start));
+                }
+            }
+
+            uint16_t* map = (uint16_t*)ScreenType::MapAddress;
+            uint8_t* cells = (uint8_t*)ScreenType::CellAddress;
+
+            for (uint16_t i = 0; i < count; i++)
+            {
+                const int32_t tileX = vertical ? x : x + i;
+                const int32_t tileY = vertical ? y + i : y;
+                const uint16_t entry = ((tileY & mask) << this->pageShift) | (tileX & mask);
+
+                bool load;
+                int32_t slot = this->cache.Acquire(this->line[i], load);
+                this->cache.Release(this->entrySlots[entry]);
+
+                if (slot < 0)
+                {
+                    // Old slot of the entry was released and can be refilled by another tile, so entry must not keep pointing at it
+                    this->misses++;
+                    this->entrySlots[entry] = CellCache::None;
+                    map[entry] = this->blankEntry;
+                    this->writtenEntries++;
+                    continue;
+                }
+
+                if (load)
+                {
+                    const uint32_t* from = (const uint32_t*)(this->tileset + ((uint32_t)this->line[i] * this->tileBytes));
+                    uint32_t* to = (uint32_t*)(cells + ((uint32_t)slot * this->tileBytes));
+
+                    for (uint16_t word = 0; word < (this->tileBytes >> 2); word++) *to++ = *from++;
+
+                    this->uploadedCells++;
+                }
+
+                this->entrySlots[entry] = (uint16_t)slot;
+                map[entry] = this->entryBase + ((uint16_t)slot * this->slotStep);
+                this->writtenEntries++;
+            }
+        }
+
+    public:
+        /** @brief Construct streaming tilemap and set up the scroll screen
+         * @details Map page and character cells are allocated in VRAM unless scroll screen already has them allocated,
+         * palette is loaded into CRAM same way as by SRL::VDP2::ScrollScreen::LoadTilemap().
+         * @param source Map data source
+         * @param tileset Tile patterns in RAM, laid out the same way as cell data of SRL::Tilemap::ITilemap
+         * @param tileCount Number of tiles in the tileset
+         * @param colorMode Color mode of the tileset
+         * @param charSize Tile size (CHAR_SIZE_1x1 or CHAR_SIZE_2x2)
+         * @param slotCount Number of tiles kept in VRAM at once
+         * @param palette Palette data (ignored for RGB555)
+         */
+        StreamingTilemap(
+            IStreamSource& source,
+            const void* tileset,
+            uint16_t tileCount,
+            SRL::CRAM::TextureColorMode colorMode,
+            uint16_t charSize,
+            uint16_t slotCount,
+            SRL::Types::HighColor* palette = nullptr) :
+            source(source),
+            tileset((const uint8_t*)tileset),
+            entryBase(0),
+            blankEntry(0),
+            left(0),
+            top(0),
+            valid(false),
+            cache(slotCount, tileCount),
+            writtenEntries(0),
+            uploadedCells(0),
+            misses(0)
+        {
+            // Bytes in a single line of 8 pixels
+            uint8_t lineBytes = 8;
+            if (colorMode == SRL::CRAM::TextureColorMode::Paletted16) lineBytes = 4;
+            else if (colorMode == SRL::CRAM::TextureColorMode::RGB555) lineBytes = 16;
+
+            this->tileShift = charSize == CHAR_SIZE_1x1 ? 3 : 4;
+            this->pageShift = charSize == CHAR_SIZE_1x1 ? 6 : 5;
+            this->tileBytes = (lineBytes << 3) << (charSize == CHAR_SIZE_1x1 ? 0 : 2);
+            this->slotStep = lineBytes >> 2;
+            this->columns = ((SRL::TV::Width - 1) >> this->tileShift) + 2;
+            this->rows = ((SRL::TV::Height - 1) >> this->tileShift) + 2;
+
+            if (this->columns > (1 << this->pageShift) || this->rows > (1 << this->pageShift))
+            {
+                SRL::Debug::Assert("Streaming tilemap does not fit the screen into a single page");
+                this->columns = SRL::Math::Min(this->columns, (uint16_t)(1 << this->pageShift));
+                this->rows = SRL::Math::Min(this->rows, (uint16_t)(1 << this->pageShift));
+            }
+
+            const uint16_t pageSize = 1 << this->pageShift;
+            this->entrySlots = new uint16_t[pageSize * pageSize];
+            for (uint16_t entry = 0; entry < pageSize * pageSize; entry++) this->entrySlots[entry] = CellCache::None;
+
+            // One cell after the slots stays blank for tiles that did not fit into the cache
+            SRL::Tilemap::TilemapInfo info(colorMode, PNB_1WORD | CN_12BIT, charSize, PL_SIZE_1x1, pageSize, pageSize, ((int32_t)slotCount + 1) * this->tileBytes);
+            info.MapByteSize = (pageSize * pageSize) << 1;
+            ScreenType::Info = info;
+
+            if ((uint32_t)ScreenType::MapAddress < VDP2_VRAM_A0)
+            {
+                int autoMapSize = 0;
+                ScreenType::MapAddress = SRL::VDP2::VRAM::AutoAllocateMap(info, ScreenType::ScreenID, &autoMapSize);
+                if ((uint32_t)ScreenType::MapAddress < VDP2_VRAM_A0) return;
+                ScreenType::MapAllocSize = autoMapSize;
+            }
+            else if (ScreenType::MapAllocSize < info.MapByteSize)
+            {
+                SRL::Debug::Assert("Streaming tilemap failed- MAP DATA exceeds existing VRAM allocation");
+                return;
+            }
+
+            if ((uint32_t)ScreenType::CellAddress < VDP2_VRAM_A0)
+            {
+                ScreenType::CellAddress = SRL::VDP2::VRAM::AutoAllocateCell(info, ScreenType::ScreenID);
+                if ((uint32_t)ScreenType::CellAddress < VDP2_VRAM_A0) return;
+                ScreenType::CellAllocSize = info.CellByteSize;
+            }
+            else if (ScreenType::CellAllocSize < info.CellByteSize)
+            {
+                SRL::Debug::Assert("Streaming tilemap failed- CEL DATA exceeds existing VRAM allocation");
+                return;
+            }
+
+            if (colorMode != SRL::CRAM::TextureColorMode::RGB555)
+            {
+                if (ScreenType::TilePalette.GetData() == nullptr)
+                {
+                    int colorID = SRL::CRAM::GetFreeBank(colorMode);
+
+                    if (colorID < 0)
+                    {
+                        SRL::Debug::Assert("Streaming tilemap palette load failed- no CRAM Palettes available");
+                        return;
+                    }
+
+                    SRL::CRAM::SetBankUsedState(colorID, colorMode, true);
+                    ScreenType::TilePalette = SRL::CRAM::Palette(colorMode, colorID);
+                }
+
+                if (palette != nullptr)
+                {
+                    ScreenType::TilePalette.Load(palette, colorMode == SRL::CRAM::TextureColorMode::Paletted16 ? 16 : 256);
+                }
+            }
+
+            this->entryBase = (uint16_t)(ScreenType::GetCellOffset(ScreenType::Info, ScreenType::CellAddress) | ScreenType::GetPalOffset());
+            this->blankEntry = this->entryBase + (slotCount * this->slotStep);
+
+            uint32_t* blank = (uint32_t*)(((uint8_t*)ScreenType::CellAddress) + ((uint32_t)slotCount * this->tileBytes));
+            for (uint16_t word = 0; word < (this->tileBytes >> 2); word++) blank[word] = 0;
+
+            // All four planes show the same page, so it repeats every 512 pixels
+            ScreenType::SetMapLayout(0, 0, 0, 0);
+            SRL::VDP2::CyclePlanner::SetTilemap(ScreenType::ScreenID, ScreenType::Info, ScreenType::CellAddress, ScreenType::MapAddress);
+            ScreenType::Init(ScreenType::Info);
+        }
+
+        /** @brief Disable copy constructor
+         */
+        StreamingTilemap(const StreamingTilemap&) = delete;
+
+        /** @brief Disable assignment operator
+         */
+        StreamingTilemap& operator=(const StreamingTilemap&) = delete;
+
+        /** @brief Destroy streaming tilemap
+         * @note VRAM allocated for the scroll screen is kept, it can be reused by another tilemap on the same screen.
+         */
+        ~StreamingTilemap()
+        {
+            delete[] this->entrySlots;
+        }
+
+        /** @brief Move camera and stream exposed tiles
+         * @details Writes only rows and columns that entered the window since last update.
+         * When camera jumps further than the window size, whole window is written again.
+         * @param x Left edge of the screen in map pixels
+         * @param y Top edge of the screen in map pixels
+         */
+        void Update(int32_t x, int32_t y)
+        {
+            const int32_t newLeft = x >> this->tileShift;
+            const int32_t newTop = y >> this->tileShift;
+
+            this->writtenEntries = 0;
+            this->uploadedCells = 0;
+
+            if (!this->valid ||
+                SRL::Math::Abs(newLeft - this->left) >= this->columns ||
+                SRL::Math::Abs(newTop - this->top) >= this->rows)
+            {
+                if (this->valid)
+                {
+                    for (uint16_t row = 0; row < this->rows; row++) this->ReleaseLine(this->left, this->top + row, false);
+                }
+
+                this->left = newLeft;
+                this->top = newTop;
+
+                for (uint16_t row = 0; row < this->rows; row++) this->WriteLine(this->left, this->top + row, false);
+
+                this->valid = true;
+            }
+            else
+            {
+                while (this->left < newLeft)
+                {
+                    this->ReleaseLine(this->left, this->top, true);
+                    this->WriteLine(this->left + this->columns, this->top, true);
+                    this->left++;
+                }
+
+                while (this->left > newLeft)
+                {
+                    this->left--;
+                    this->ReleaseLine(this->left + this->columns, this->top, true);
+                    this->WriteLine(this->left, this->top, true);
+                }
+
+                while (this->top < newTop)
+                {
+                    this->ReleaseLine(this->left, this->top, false);
+                    this->WriteLine(this->left, this->top + this->rows, false);
+                    this->top++;
+                }
+
+                while (this->top > newTop)
+                {
+                    this->top--;
+                    this->ReleaseLine(this->left, this->top + this->rows, false);
+                    this->WriteLine(this->left, this->top, false);
+                }
+            }
+
+            // Page repeats every 512 pixels, so position can be wrapped to stay in range of the scroll registers
+            SRL::Math::Types::Vector2D position(
+                SRL::Math::Types::Fxp::BuildRaw((x & 0x3ff) << 16),
+                SRL::Math::Types::Fxp::BuildRaw((y & 0x3ff) << 16));
+            ScreenType::SetPosition(position);
+        }
+
+        /** @brief Write whole window again on next update
+         * @details Use after tiles in the map source were changed.
+         */
+        void Invalidate()
+        {
+            if (this->valid)
+            {
+                for (uint16_t row = 0; row < this->rows; row++) this->ReleaseLine(this->left, this->top + row, false);
+            }
+
+            this->valid = false;
+        }
+
+        /** @brief Get character cache
+         * @return Cache of tiles stored in VRAM
+         */
+        const CellCache& GetCache() const
+        {
+            return this->cache;
+        }
+
+        /** @brief Get number of map entries written during last update
+         * @return Entry count
+         */
+        uint16_t GetWrittenEntries() const
+        {
+            return this->writtenEntries;
+        }
+
+        /** @brief Get number of tile patterns uploaded to VRAM during last update
+         * @return Tile count
+         */
+        uint16_t GetUploadedCells() const
+        {
+            return this->uploadedCells;
+        }
+
+        /** @brief Get number of tiles that did not fit into the cache
+         * @return Miss count since construction
+         */
+        uint32_t GetMissCount() const
+        {
+            return this->misses;
+        }
+    };
+}
@@ -16,7 +16,10 @@ namespace SRL
          */
         inline static uint16_t HeapPointer = 0;
 
+    public:
+
         /** @brief Get the number of bits to shift to the right
+         * @details Size of texture data in bytes is ((width * height) << 2) >> shifter
          * @param colorMode Color mode
          * @return Number of bits to shift
          */
@@ -44,8 +47,6 @@ namespace SRL
             return pixelSizeShifter;
         }
 
-    public:
-
         /** @brief VDP1 front buffer address
          */
         inline static const uint32_t FrontBuffer = 0x25C80000;
@@ -301,5 +302,492 @@ namespace SRL
         {
             VDP1::HeapPointer = VDP1::HeapPointer > index ? index : VDP1::HeapPointer;
         }
+
+        /** @brief VDP1 frame statistics
+         * @details Counts commands submitted through SRL::Scene2D and SRL::Scene3D per command type together with estimated number of drawn pixels,
+         * and measures how long VDP1 took to draw each command list. Draw time is measured by free running timer from frame change, when VDP1 starts drawing,
+         * until VDP1 end status register (EDSR) reports drawing has ended. Status is polled on every v-blank and before synchronization,
+         * SRL::VDP1::Stats::Poll() can be called during long CPU work to measure draw time more precisely.
+         * When drawing did not end before the next frame change, frame is flagged as overrun, as the frame had to be shown again.
+         * Finished frames are kept in a short history, which can be drawn as an on-screen graph.
+         * @note Statistics must be enabled by SRL::VDP1::Stats::Enable() (SRL::Governor::Enable() enables them too), they are updated automatically from SRL::Core::Synchronize()
+         * @code {.cpp}
+         * SRL::VDP1::Stats::Enable();
+         *
+         * while (1)
+         * {
+         *     // Graph of draw time of last frames
+         *     for (uint8_t age = 0; age < SRL::VDP1::Stats::GetHistoryLength(); age++)
+         *     {
+         *         const SRL::VDP1::Stats::Frame& frame = SRL::VDP1::Stats::GetFrame(age);
+         *         DrawBar(age, frame.DrawTicks, frame.Overrun);
+         *     }
+         *
+         *     SRL::Core::Synchronize();
+         * }
+         * @endcode
+         */
+        class Stats
+        {
+            /** @brief Disable constructor
+             */
+            Stats() = delete;
+
+            /** @brief Disable destructor
+             */
+            ~Stats() = delete;
+
+        public:
+
+            /** @brief Number of finished frames kept in history (must be power of 2)
+             */
+            static constexpr uint8_t HistorySize = 64;
+
+            /** @brief Counted command type
+             */
+            enum class Command : uint8_t
+            {
+                /** @brief Normal sprite
+                 */
+                NormalSprite = 0,
+
+                /** @brief Scaled sprite
+                 */
+                ScaledSprite = 1,
+
+                /** @brief Distorted sprite
+                 */
+                DistortedSprite = 2,
+
+                /** @brief Filled polygon
+                 */
+                Polygon = 3,
+
+                /** @brief Polyline
+                 */
+                PolyLine = 4,
+
+                /** @brief Line segment
+                 */
+                LineSegment = 5,
+
+                /** @brief Clipping and local coordinate commands
+                 */
+                Control = 6,
+
+                /** @brief Face of a 3D mesh, command type and size are decided by SGL
+                 */
+                MeshFace = 7,
+
+                /** @brief Number of command types
+                 */
+                Count = 8
+            };
+
+            /** @brief Statistics of a single command list
+             */
+            struct Frame
+            {
+                /** @brief Number of commands per command type
+                 */
+                uint16_t Commands[(uint8_t)Command::Count];
+
+                /** @brief Estimated number of drawn pixels
+                 */
+                uint32_t Pixels;
+
+                /** @brief Timer ticks from frame change until VDP1 finished drawing the list
+                 * @note Whole frame length is reported when drawing ended after last poll or did not end at all
+                 */
+                uint16_t DrawTicks;
+
+                /** @brief Timer ticks between frame changes while the list was drawn
+                 */
+                uint16_t FrameTicks;
+
+                /** @brief Value indicating whether VDP1 did not finish drawing the list before next frame change
+                 */
+                bool Overrun;
+
+                /** @brief Construct empty frame
+                 */
+                Frame() : Pixels(0), DrawTicks(0), FrameTicks(0), Overrun(false)
+                {
+                    for (uint8_t type = 0; type < (uint8_t)Command::Count; type++)
+                    {
+                        this->Commands[type] = 0;
+                    }
+                }
+
+                /** @brief Get number of all commands
+                 * @return Command count
+                 */
+                uint32_t GetCommandCount() const
+                {
+                    uint32_t count = 0;
+
+                    for (uint8_t type = 0; type < (uint8_t)Command::Count; type++)
+                    {
+                        count += this->Commands[type];
+                    }
+
+                    return count;
+                }
+            };
+
+        private:
+
+            /** @brief VDP1 end status register
+             */
+            static constexpr uintptr_t EndStatusRegister = 0x25d00010;
+
+            /** @brief Bit of the end status register indicating drawing of the previous frame ended
+             */
+            static constexpr uint16_t PreviousFrameEnded = 0x0001;
+
+            /** @brief Bit of the end status register indicating drawing of the current frame ended
+             */
+            static constexpr uint16_t CurrentFrameEnded = 0x0002;
+
+            /** @brief Value indicating whether statistics are enabled
+             */
+            inline static bool enabled = false;
+
+            /** @brief Statistics of the command list being submitted
+             */
+            inline static Frame current;
+
+            /** @brief Statistics of the command list being drawn
+             */
+            inline static Frame drawn;
+
+            /** @brief Finished frames
+             */
+            inline static Frame history[Stats::HistorySize];
+
+            /** @brief Index of the next history entry
+             */
+            inline static uint8_t head = 0;
+
+            /** @brief Number of valid history entries
+             */
+            inline static uint8_t length = 0;
+
+            /** @brief Timer value at the last frame change
+             */
+            inline static uint16_t drawStart = 0;
+
+            /** @brief Timer value when drawing was seen ended
+             */
+            inline static volatile uint16_t drawEnd = 0;
+
+            /** @brief Value indicating whether drawing of the current list was seen ended
+             */
+            inline static volatile bool drawEnded = false;
+
+            /** @brief Number of overrun frames since statistics were enabled
+             */
+            inline static uint32_t overruns = 0;
+
+            /** @brief Get length of a line in pixels
+             * @param x Horizontal distance
+             * @param y Vertical distance
+             * @return Number of pixels
+             */
+            inline static uint32_t LineLength(const int32_t x, const int32_t y)
+            {
+                const int32_t absX = x < 0 ? -x : x;
+                const int32_t absY = y < 0 ? -y : y;
+                return (uint32_t)((absX > absY ? absX : absY) + 1);
+            }
+
+            /** @brief Get area of a quad in pixels
+             * @param x Corner X coordinates
+             * @param y Corner Y coordinates
+             * @return Number of pixels
+             */
+            inline static uint32_t QuadArea(const int32_t x[4], const int32_t y[4])
+            {
+                // Half of the cross product of diagonals
+                const int32_t area = (((x[2] - x[0]) * (y[3] - y[1])) - ((y[2] - y[0]) * (x[3] - x[1]))) >> 1;
+                return (uint32_t)(area < 0 ? -area : area);
+            }
+
+        public:
+
+            /** @name Control
+             * @{
+             */
+
+            /** @brief Enable statistics
+             * @details Free running timer of the master CPU is switched to 1/128 clock, so a single frame fits into its 16-bit counter even at 20 FPS.
+             */
+            inline static void Enable()
+            {
+                TIM_FRT_INIT(TIM_CKS_128);
+                Stats::current = Frame();
+                Stats::drawn = Frame();
+                Stats::head = 0;
+                Stats::length = 0;
+                Stats::overruns = 0;
+                Stats::drawStart = TIM_FRT_GET_16();
+                Stats::drawEnded = false;
+                Stats::enabled = true;
+            }
+
+            /** @brief Disable statistics
+             */
+            inline static void Disable()
+            {
+                Stats::enabled = false;
+            }
+
+            /** @brief Check whether statistics are enabled
+             * @return True if statistics are enabled
+             */
+            inline static bool IsEnabled()
+            {
+                return Stats::enabled;
+            }
+
+            /** @} */
+
+            /** @name Counting
+             * @{
+             */
+
+            /** @brief Get command type from command control word
+             * @param control Command control word (CMDCTRL)
+             * @return Command type
+             */
+            inline static Command GetCommandType(const uint16_t control)
+            {
+                switch (control & 0xf)
+                {
+                case 0x0:
+                    return Command::NormalSprite;
+
+                case 0x1:
+                    return Command::ScaledSprite;
+
+                case 0x2:
+                case 0x3:
+                    return Command::DistortedSprite;
+
+                case 0x4:
+                    return Command::Polygon;
+
+                case 0x5:
+                    return Command::PolyLine;
+
+                case 0x6:
+                case 0x7:
+                    return Command::LineSegment;
+
+                default:
+                    return Command::Control;
+                }
+            }
+
+            /** @brief Estimate number of pixels drawn by a command
+             * @details Normal sprites use texture size, scaled sprites their on-screen rectangle, distorted sprites and polygons area of their quad and lines their length.
+             * @param command VDP1 command
+             * @return Estimated number of pixels
+             */
+            inline static uint32_t EstimatePixels(const SPRITE& command)
+            {
+                const int32_t x[4] = { command.XA, command.XB, command.XC, command.XD };
+                const int32_t y[4] = { command.YA, command.YB, command.YC, command.YD };
+
+                switch (Stats::GetCommandType(command.CTRL))
+                {
+                case Command::NormalSprite:
+                    return (uint32_t)(((command.SIZE >> 8) & 0x3f) << 3) * (command.SIZE & 0xff);
+
+                case Command::ScaledSprite:
+                    // Without zoom point, sprite is given by two corners, otherwise by size
+                    if (((command.CTRL >> 8) & 0xf) == 0)
+                    {
+                        return Stats::LineLength(x[2] - x[0], 0) * Stats::LineLength(y[2] - y[0], 0);
+                    }
+
+                    return (uint32_t)((x[1] < 0 ? -x[1] : x[1]) * (y[1] < 0 ? -y[1] : y[1]));
+
+                case Command::DistortedSprite:
+                case Command::Polygon:
+                    return Stats::QuadArea(x, y);
+
+                case Command::PolyLine:
+                    return Stats::LineLength(x[1] - x[0], y[1] - y[0]) +
+                        Stats::LineLength(x[2] - x[1], y[2] - y[1]) +
+                        Stats::LineLength(x[3] - x[2], y[3] - y[2]) +
+                        Stats::LineLength(x[0] - x[3], y[0] - y[3]);
+
+                case Command::LineSegment:
+                    return Stats::LineLength(x[1] - x[0], y[1] - y[0]);
+
+                default:
+                    return 0;
+                }
+            }
+
+            /** @brief Estimate number of pixels drawn by a distorted sprite
+             * @param corners Corners of the sprite in 16.16 fixed point (X and Y of each corner)
+             * @return Estimated number of pixels
+             */
+            inline static uint32_t EstimatePixels(const FIXED corners[8])
+            {
+                const int32_t x[4] = { corners[0] >> 16, corners[2] >> 16, corners[4] >> 16, corners[6] >> 16 };
+                const int32_t y[4] = { corners[1] >> 16, corners[3] >> 16, corners[5] >> 16, corners[7] >> 16 };
+                return Stats::QuadArea(x, y);
+            }
+
+            /** @brief Count submitted commands
+             * @param type Command type
+             * @param pixels Estimated number of pixels drawn by all of the commands
+             * @param count Number of commands
+             */
+            inline static void Count(const Command type, const uint32_t pixels, const uint16_t count = 1)
+            {
+                if (Stats::enabled)
+                {
+                    Stats::current.Commands[(uint8_t)type] += count;
+                    Stats::current.Pixels += pixels;
+                }
+            }
+
+            /** @brief Count submitted command
+             * @param command VDP1 command
+             */
+            inline static void Count(const SPRITE& command)
+            {
+                if (Stats::enabled)
+                {
+                    Stats::Count(Stats::GetCommandType(command.CTRL), Stats::EstimatePixels(command));
+                }
+            }
+
+            /** @brief Count submitted scaled sprite
+             * @param texture Sprite texture
+             * @param scaleX Horizontal scale in 16.16 fixed point
+             * @param scaleY Vertical scale in 16.16 fixed point
+             */
+            inline static void CountScaledSprite(const uint16_t texture, const FIXED scaleX, const FIXED scaleY)
+            {
+                if (Stats::enabled)
+                {
+                    const int32_t width = (VDP1::Textures[texture].Width * (scaleX < 0 ? -scaleX : scaleX)) >> 16;
+                    const int32_t height = (VDP1::Textures[texture].Height * (scaleY < 0 ? -scaleY : scaleY)) >> 16;
+                    Stats::Count(Command::ScaledSprite, (uint32_t)(width * height));
+                }
+            }
+
+            /** @brief Count submitted distorted sprite
+             * @param corners Corners of the sprite in 16.16 fixed point (X and Y of each corner)
+             */
+            inline static void CountDistortedSprite(const FIXED corners[8])
+            {
+                if (Stats::enabled)
+                {
+                    Stats::Count(Command::DistortedSprite, Stats::EstimatePixels(corners));
+                }
+            }
+
+            /** @} */
+
+            /** @name Measurement
+             * @{
+             */
+
+            /** @brief Check whether VDP1 finished drawing, called from v-blank interrupt and SRL::Core::Synchronize()
+             */
+            inline static void Poll()
+            {
+                if (Stats::enabled && !Stats::drawEnded &&
+                    (*(volatile uint16_t*)Stats::EndStatusRegister & Stats::CurrentFrameEnded) != 0)
+                {
+                    Stats::drawEnd = TIM_FRT_GET_16();
+                    Stats::drawEnded = true;
+                }
+            }
+
+            /** @brief Finish frame after frame change, called by SRL::Core::Synchronize()
+             * @details List drawn since last frame change is moved into history and list submitted during last frame starts being drawn.
+             */
+            inline static void AfterSync()
+            {
+                if (!Stats::enabled)
+                {
+                    return;
+                }
+
+                const uint16_t now = TIM_FRT_GET_16();
+                const bool ended = (*(volatile uint16_t*)Stats::EndStatusRegister & Stats::PreviousFrameEnded) != 0;
+
+                Stats::drawn.FrameTicks = now - Stats::drawStart;
+                Stats::drawn.DrawTicks = ended && Stats::drawEnded ? Stats::drawEnd - Stats::drawStart : Stats::drawn.FrameTicks;
+                Stats::drawn.Overrun = !ended;
+                Stats::overruns += ended ? 0 : 1;
+
+                Stats::history[Stats::head] = Stats::drawn;
+                Stats::head = (Stats::head + 1) & (Stats::HistorySize - 1);
+                Stats::length += Stats::length < Stats::HistorySize ? 1 : 0;
+
+                Stats::drawn = Stats::current;
+                Stats::current = Frame();
+                Stats::drawStart = now;
+                Stats::drawEnded = false;
+            }
+
+            /** @} */
+
+            /** @name Statistics
+             * @{
+             */
+
+            /** @brief Get statistics of the command list being submitted
+             * @return Counters of the current frame, draw time is not known yet
+             */
+            inline static const Frame& GetCurrentFrame()
+            {
+                return Stats::current;
+            }
+
+            /** @brief Get statistics of a finished frame
+             * @param age Age of the frame, 0 is the last finished frame
+             * @return Frame statistics
+             */
+            inline static const Frame& GetFrame(const uint8_t age = 0)
+            {
+                return Stats::history[(Stats::head - 1 - age) & (Stats::HistorySize - 1)];
+            }
+
+            /** @brief Get number of finished frames in history
+             * @return Number of frames, at most SRL::VDP1::Stats::HistorySize
+             */
+            inline static uint8_t GetHistoryLength()
+            {
+                return Stats::length;
+            }
+
+            /** @brief Get number of frames where VDP1 did not finish drawing before frame change
+             * @return Overrun count since statistics were enabled
+             */
+            inline static uint32_t GetOverrunCount()
+            {
+                return Stats::overruns;
+            }
+
+            /** @brief Convert timer ticks to microseconds
+             * @param ticks Timer ticks
+             * @return Time in microseconds
+             */
+            inline static int32_t ToMicroseconds(const uint16_t ticks)
+            {
+                return (int32_t)TIM_FRT_CNT_TO_MCR(ticks);
+            }
+
+            /** @} */
+        };
     };
 }
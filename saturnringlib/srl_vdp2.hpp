@@ -7,6 +7,7 @@
 #include "srl_debug.hpp"
 #include "srl_cd.hpp"
 #include "srl_tilemap_interfaces.hpp"
+#include "srl_slave.hpp"
 
 /*I'm running into an issue with getting Bitmaps working for RBG0. Does anyone know 
 what SGL function if any is supposed to set the RAM contol register associated with reserving
@@ -74,6 +75,579 @@ namespace SRL
             return (uint16_t)sglColor[(uint16_t)colorMode];
         }
 
+        /** @brief Smallest scale NBG0 or NBG1 can display
+         * @details Each halving of the limit doubles the character data reads the screen needs during display.
+         */
+        enum class ScaleLimit : uint16_t
+        {
+            /** @brief Scale can go down to 1.0
+             */
+            Full = ZOOM_1,
+
+            /** @brief Scale can go down to 0.5
+             */
+            Half = ZOOM_HALF,
+
+            /** @brief Scale can go down to 0.25
+             */
+            Quarter = ZOOM_QUARTER,
+        };
+
+        /** @brief Number of lines sharing one entry of a line scroll table
+         */
+        enum class LineInterval : uint16_t
+        {
+            /** @brief Entry for every line
+             */
+            Line1 = lineSZ1,
+
+            /** @brief Entry for every 2 lines
+             */
+            Line2 = lineSZ2,
+
+            /** @brief Entry for every 4 lines
+             */
+            Line4 = lineSZ4,
+
+            /** @brief Entry for every 8 lines
+             */
+            Line8 = lineSZ8,
+        };
+
+        /** @brief Plans VRAM access cycle patterns of NBG0-NBG3
+         * @details In normal resolution every VRAM bank can be read 8 times per character of display (timings T0-T7).
+         * A tilemap needs one pattern name (map) read, and both tilemaps and bitmaps need 1, 2 or 4 character pattern (cell) reads
+         * for 16 colors, 256 colors or RGB data, multiplied by 2 or 4 when NBG0 or NBG1 scale limit is set to 1/2 or 1/4.
+         * Character reads of a tilemap must fall into a window of timings that depends on when its pattern name is read.
+         * @details Planner tracks the banks and reads of every loaded screen, tries every pattern name timing until all reads fit,
+         * and writes the result with slScrCycleSet() over the pattern computed by slScrAutoDisp(). Banks used by RBG0 are reserved whole
+         * and left out of the plan, timings nobody reads are given to CPU access, which speeds up VRAM writes during display.
+         * VRAM auto allocation asks the planner which bank can still fit reads of a screen.
+         * @note Only normal resolution (320 or 352 pixels wide) is planned, in high resolution pattern of slScrAutoDisp() is kept.
+         */
+        class CyclePlanner
+        {
+            /** @brief Disable constructor
+             */
+            CyclePlanner() = delete;
+
+            /** @brief Disable destructor
+             */
+            ~CyclePlanner() = delete;
+
+        public:
+
+            /** @brief Access codes of the cycle pattern registers
+             */
+            enum class Access : uint8_t
+            {
+                /** @brief Pattern name read of NBG0 (add NBG number for other screens)
+                 */
+                PatternName = 0x0,
+
+                /** @brief Character pattern read of NBG0 (add NBG number for other screens)
+                 */
+                Character = 0x4,
+
+                /** @brief Vertical cell scroll table read of NBG0 (add NBG number for NBG1)
+                 */
+                VerticalScroll = 0xc,
+
+                /** @brief CPU access
+                 */
+                Cpu = 0xe,
+
+                /** @brief No access
+                 */
+                None = 0xf,
+            };
+
+        private:
+
+            /** @brief Access needs of a NBG screen
+             */
+            struct Layer
+            {
+                /** @brief Bank holding map data, -1 for none
+                 */
+                int8_t MapBank;
+
+                /** @brief Banks holding cell or bitmap data, one bit per bank
+                 */
+                uint8_t CellBanks;
+
+                /** @brief Character reads in each cell bank at full scale
+                 */
+                uint8_t Reads;
+
+                /** @brief Read multiplier of the scale limit (1, 2 or 4)
+                 */
+                uint8_t Reduction;
+
+                /** @brief Bank holding vertical cell scroll table, -1 for none
+                 */
+                int8_t ScrollBank;
+            };
+
+            /** @brief Number of timings per bank in normal resolution
+             */
+            static constexpr uint8_t Timings = 8;
+
+            /** @brief Timing of a bank reserved by RBG0
+             */
+            static constexpr uint8_t Blocked = 0x10;
+
+            /** @brief Free timing
+             */
+            static constexpr uint8_t Free = 0x20;
+
+            /** @brief Character read timings allowed for each pattern name timing, one bit per timing
+             */
+            static constexpr uint8_t CharacterWindow[Timings] = { 0xf7, 0xef, 0xcf, 0x8f, 0x0f, 0x0e, 0x0c, 0x08 };
+
+            /** @brief Access needs of NBG0-NBG3
+             */
+            inline static Layer layers[4] = { { -1, 0, 0, 1, -1 }, { -1, 0, 0, 1, -1 }, { -1, 0, 0, 1, -1 }, { 3, 1 << 3, 1, 1, -1 } };
+
+            /** @brief Banks reserved by RBG0, one bit per bank
+             */
+            inline static uint8_t rotationBanks = 0;
+
+            /** @brief Last applied cycle pattern
+             */
+            inline static uint8_t pattern[4][Timings];
+
+            /** @brief Value indicating whether last applied pattern came from the planner
+             */
+            inline static bool planned = false;
+
+            /** @brief Get NBG number of a screen
+             * @param screen SGL screen identifier
+             * @return NBG number or -1 for other screens
+             */
+            inline static int8_t GetLayer(int16_t screen)
+            {
+                switch (screen)
+                {
+                case scnNBG0: return 0;
+                case scnNBG1: return 1;
+                case scnNBG2: return 2;
+                case scnNBG3: return 3;
+                default: return -1;
+                }
+            }
+
+            /** @brief Get bank of VRAM address
+             * @param address VRAM address
+             * @return Bank index or -1 if address is not in VRAM
+             */
+            inline static int8_t GetBank(void* address)
+            {
+                if ((uint32_t)address < VDP2_VRAM_A0 || (uint32_t)address >= VDP2_VRAM_B1 + 0x20000) return -1;
+                return ((uint32_t)address - VDP2_VRAM_A0) >> 17;
+            }
+
+            /** @brief Remove all reads of a screen from a plan
+             * @param plan Plan to change
+             * @param layer NBG number
+             */
+            inline static void Remove(uint8_t plan[4][Timings], uint8_t layer)
+            {
+                for (uint8_t bank = 0; bank < 4; bank++)
+                {
+                    for (uint8_t timing = 0; timing < Timings; timing++)
+                    {
+                        if (plan[bank][timing] == (uint8_t)Access::PatternName + layer ||
+                            plan[bank][timing] == (uint8_t)Access::Character + layer)
+                        {
+                            plan[bank][timing] = CyclePlanner::Free;
+                        }
+                    }
+                }
+            }
+
+            /** @brief Place character reads of a screen into free timings of all its cell banks
+             * @param plan Plan to change
+             * @param layer NBG number
+             * @param needs Access needs of the screen
+             * @param window Allowed timings, one bit per timing
+             * @return True if all reads fit
+             */
+            inline static bool PlaceCharacters(uint8_t plan[4][Timings], uint8_t layer, const Layer& needs, uint8_t window)
+            {
+                for (uint8_t bank = 0; bank < 4; bank++)
+                {
+                    if (!(needs.CellBanks & (1 << bank))) continue;
+
+                    uint8_t reads = needs.Reads * needs.Reduction;
+
+                    for (uint8_t timing = 0; timing < Timings && reads > 0; timing++)
+                    {
+                        if ((window & (1 << timing)) && plan[bank][timing] == CyclePlanner::Free)
+                        {
+                            plan[bank][timing] = (uint8_t)Access::Character + layer;
+                            reads--;
+                        }
+                    }
+
+                    if (reads > 0) return false;
+                }
+
+                return true;
+            }
+
+            /** @brief Place screens into a plan, trying every pattern name timing of each screen
+             * @param plan Plan to change
+             * @param needs Access needs of NBG0-NBG3
+             * @param order NBG numbers in order of placement
+             * @param count Number of screens to place
+             * @param index Index of the screen to place now
+             * @return True if all remaining screens fit
+             */
+            inline static bool PlaceLayers(uint8_t plan[4][Timings], const Layer* needs, const uint8_t* order, uint8_t count, uint8_t index)
+            {
+                if (index == count) return true;
+
+                const uint8_t layer = order[index];
+                const Layer& current = needs[layer];
+
+                if (current.MapBank < 0) // Bitmap or cells only, reads can go anywhere
+                {
+                    if (CyclePlanner::PlaceCharacters(plan, layer, current, 0xff) &&
+                        CyclePlanner::PlaceLayers(plan, needs, order, count, index + 1))
+                    {
+                        return true;
+                    }
+
+                    CyclePlanner::Remove(plan, layer);
+                    return false;
+                }
+
+                for (uint8_t timing = 0; timing < Timings; timing++)
+                {
+                    if (plan[current.MapBank][timing] != CyclePlanner::Free) continue;
+
+                    plan[current.MapBank][timing] = (uint8_t)Access::PatternName + layer;
+
+                    if (CyclePlanner::PlaceCharacters(plan, layer, current, CyclePlanner::CharacterWindow[timing]) &&
+                        CyclePlanner::PlaceLayers(plan, needs, order, count, index + 1))
+                    {
+                        return true;
+                    }
+
+                    CyclePlanner::Remove(plan, layer);
+                }
+
+                return false;
+            }
+
+            /** @brief Compute cycle pattern
+             * @param needs Access needs of NBG0-NBG3
+             * @param screens Screens to include, one bit per NBG number
+             * @param plan Resulting plan
+             * @return True if all reads of the screens fit
+             */
+            inline static bool Plan(const Layer* needs, uint16_t screens, uint8_t plan[4][Timings])
+            {
+                uint8_t order[4];
+                uint8_t count = 0;
+
+                for (uint8_t bank = 0; bank < 4; bank++)
+                {
+                    for (uint8_t timing = 0; timing < Timings; timing++)
+                    {
+                        plan[bank][timing] = (CyclePlanner::rotationBanks & (1 << bank)) ? CyclePlanner::Blocked : CyclePlanner::Free;
+                    }
+                }
+
+                // Vertical cell scroll tables are read before pattern names, take the earliest timing
+                for (uint8_t layer = 0; layer < 2; layer++)
+                {
+                    if (!(screens & (1 << layer)) || needs[layer].ScrollBank < 0) continue;
+
+                    uint8_t timing = 0;
+                    while (timing < Timings && plan[needs[layer].ScrollBank][timing] != CyclePlanner::Free) timing++;
+                    if (timing == Timings) return false;
+
+                    plan[needs[layer].ScrollBank][timing] = (uint8_t)Access::VerticalScroll + layer;
+                }
+
+                // Screens with most reads go first, they have the fewest options
+                for (uint8_t layer = 0; layer < 4; layer++)
+                {
+                    if (!(screens & (1 << layer)) || (needs[layer].MapBank < 0 && needs[layer].CellBanks == 0)) continue;
+                    if (needs[layer].Reads * needs[layer].Reduction > Timings) return false;
+
+                    uint8_t position = count++;
+
+                    while (position > 0 && needs[order[position - 1]].Reads * needs[order[position - 1]].Reduction < needs[layer].Reads * needs[layer].Reduction)
+                    {
+                        order[position] = order[position - 1];
+                        position--;
+                    }
+
+                    order[position] = layer;
+                }
+
+                return CyclePlanner::PlaceLayers(plan, needs, order, count, 0);
+            }
+
+            /** @brief Check whether planner handles current resolution
+             * @return True in normal resolution
+             */
+            inline static bool IsSupported()
+            {
+                return SRL::TV::Width <= 352;
+            }
+
+        public:
+
+            /** @brief Get character reads of a color mode at full scale
+             * @param mode Color mode
+             * @return Number of reads
+             */
+            inline static uint8_t GetReads(CRAM::TextureColorMode mode)
+            {
+                if (mode == CRAM::TextureColorMode::Paletted16) return 1;
+                else if (mode == CRAM::TextureColorMode::RGB555) return 4;
+                return 2;
+            }
+
+            /** @brief Forget all screens except debug text on NBG3 and release banks reserved by RBG0
+             */
+            inline static void Reset()
+            {
+                for (uint8_t layer = 0; layer < 4; layer++)
+                {
+                    CyclePlanner::layers[layer] = { -1, 0, 0, CyclePlanner::layers[layer].Reduction, -1 };
+                }
+
+                // Debug text font and map are in bank B1
+                CyclePlanner::layers[3] = { 3, 1 << 3, 1, 1, -1 };
+                CyclePlanner::rotationBanks = 0;
+            }
+
+            /** @brief Set banks and reads of a NBG screen
+             * @param screen SGL screen identifier
+             * @param mapBank Bank of map data, negative to keep current
+             * @param cellBanks Banks of cell data (one bit per bank), 0 to keep current
+             * @param reads Character reads at full scale, 0 to keep current
+             */
+            inline static void Assign(int16_t screen, int8_t mapBank, uint8_t cellBanks, uint8_t reads)
+            {
+                const int8_t layer = CyclePlanner::GetLayer(screen);
+                if (layer < 0) return;
+
+                if (mapBank >= 0) CyclePlanner::layers[layer].MapBank = mapBank;
+                if (cellBanks != 0) CyclePlanner::layers[layer].CellBanks = cellBanks;
+                if (reads != 0) CyclePlanner::layers[layer].Reads = reads;
+            }
+
+            /** @brief Record tilemap of a NBG screen and update cycle pattern if the screen is displayed
+             * @param screen SGL screen identifier
+             * @param info Tilemap info
+             * @param cellAddress VRAM address of cell data
+             * @param mapAddress VRAM address of map data
+             */
+            inline static void SetTilemap(int16_t screen, Tilemap::TilemapInfo& info, void* cellAddress, void* mapAddress)
+            {
+                const int8_t layer = CyclePlanner::GetLayer(screen);
+                const int8_t cellBank = CyclePlanner::GetBank(cellAddress);
+                if (layer < 0) return;
+
+                CyclePlanner::layers[layer].MapBank = CyclePlanner::GetBank(mapAddress);
+                CyclePlanner::layers[layer].CellBanks = cellBank < 0 ? 0 : 1 << cellBank;
+                CyclePlanner::layers[layer].Reads = CyclePlanner::GetReads(info.ColorMode);
+
+                if (VDP2::ActiveScrolls & (1 << layer)) CyclePlanner::Apply(VDP2::ActiveScrolls);
+            }
+
+            /** @brief Record bitmap of a NBG screen and update cycle pattern if the screen is displayed
+             * @param screen SGL screen identifier
+             * @param info Bitmap info
+             * @param address VRAM address of bitmap data
+             * @param size Size of bitmap data in bytes
+             */
+            inline static void SetBitmap(int16_t screen, Bitmap::BitmapInfo& info, void* address, uint32_t size)
+            {
+                const int8_t layer = CyclePlanner::GetLayer(screen);
+                const int8_t first = CyclePlanner::GetBank(address);
+                const int8_t last = CyclePlanner::GetBank((uint8_t*)address + (size > 0 ? size - 1 : 0));
+                if (layer < 0) return;
+
+                CyclePlanner::layers[layer].MapBank = -1;
+                CyclePlanner::layers[layer].CellBanks = 0;
+                CyclePlanner::layers[layer].Reads = CyclePlanner::GetReads(info.ColorMode);
+
+                for (int8_t bank = first; bank >= 0 && bank <= last; bank++) CyclePlanner::layers[layer].CellBanks |= 1 << bank;
+
+                if (VDP2::ActiveScrolls & (1 << layer)) CyclePlanner::Apply(VDP2::ActiveScrolls);
+            }
+
+            /** @brief Record scale limit of NBG0 or NBG1
+             * @param screen SGL screen identifier
+             * @param limit Scale limit
+             */
+            inline static void SetReduction(int16_t screen, VDP2::ScaleLimit limit)
+            {
+                const int8_t layer = CyclePlanner::GetLayer(screen);
+                if (layer < 0) return;
+
+                CyclePlanner::layers[layer].Reduction = 1 << (uint16_t)limit;
+                if (VDP2::ActiveScrolls & (1 << layer)) CyclePlanner::Apply(VDP2::ActiveScrolls);
+            }
+
+            /** @brief Record vertical cell scroll table of NBG0 or NBG1
+             * @param screen SGL screen identifier
+             * @param address VRAM address of the table, nullptr if vertical cell scroll is disabled
+             */
+            inline static void SetCellScroll(int16_t screen, void* address)
+            {
+                const int8_t layer = CyclePlanner::GetLayer(screen);
+                if (layer < 0 || layer > 1) return;
+
+                CyclePlanner::layers[layer].ScrollBank = address != nullptr ? CyclePlanner::GetBank(address) : -1;
+                if (VDP2::ActiveScrolls & (1 << layer)) CyclePlanner::Apply(VDP2::ActiveScrolls);
+            }
+
+            /** @brief Check whether bank is reserved by RBG0
+             * @param bank VRAM bank
+             * @return True if reserved
+             */
+            inline static bool IsRotationBank(VramBank bank)
+            {
+                return CyclePlanner::rotationBanks & (1 << (uint16_t)bank);
+            }
+
+            /** @brief Reserve whole bank for RBG0
+             * @param bank VRAM bank
+             * @return False if bank is already reserved or holds data of a NBG screen
+             */
+            inline static bool ReserveRotationBank(VramBank bank)
+            {
+                const uint8_t mask = 1 << (uint16_t)bank;
+                if (CyclePlanner::rotationBanks & mask) return false;
+
+                for (uint8_t layer = 0; layer < 4; layer++)
+                {
+                    if (CyclePlanner::layers[layer].MapBank == (int8_t)bank ||
+                        CyclePlanner::layers[layer].ScrollBank == (int8_t)bank ||
+                        (CyclePlanner::layers[layer].CellBanks & mask))
+                    {
+                        return false;
+                    }
+                }
+
+                CyclePlanner::rotationBanks |= mask;
+                return true;
+            }
+
+            /** @brief Check whether all loaded screens still fit when data of a screen is placed in given banks
+             * @param screen SGL screen identifier
+             * @param mapBank Bank of map data, negative to keep current
+             * @param cellBanks Banks of cell data (one bit per bank), 0 to keep current
+             * @param reads Character reads at full scale, 0 to keep current
+             * @return True if placement leaves a valid cycle pattern
+             */
+            inline static bool CanPlace(int16_t screen, int8_t mapBank, uint8_t cellBanks, uint8_t reads)
+            {
+                const int8_t layer = CyclePlanner::GetLayer(screen);
+                if (layer < 0) return true;
+                if (mapBank >= 0 && (CyclePlanner::rotationBanks & (1 << mapBank))) return false;
+                if (CyclePlanner::rotationBanks & cellBanks) return false;
+                if (!CyclePlanner::IsSupported()) return true;
+
+                Layer trial[4];
+                uint8_t plan[4][Timings];
+
+                for (uint8_t index = 0; index < 4; index++) trial[index] = CyclePlanner::layers[index];
+
+                if (mapBank >= 0) trial[layer].MapBank = mapBank;
+                if (cellBanks != 0) trial[layer].CellBanks = cellBanks;
+                if (reads != 0) trial[layer].Reads = reads;
+
+                return CyclePlanner::Plan(trial, 0xf, plan);
+            }
+
+            /** @brief Get number of timings of a bank no loaded screen needs
+             * @param bank VRAM bank
+             * @return Number of free timings, 0 for banks reserved by RBG0
+             */
+            inline static uint8_t GetFreeTimings(VramBank bank)
+            {
+                uint8_t plan[4][Timings];
+                if (!CyclePlanner::Plan(CyclePlanner::layers, 0xf, plan)) return 0;
+
+                uint8_t free = 0;
+                for (uint8_t timing = 0; timing < Timings; timing++) free += plan[(uint16_t)bank][timing] == CyclePlanner::Free ? 1 : 0;
+                return free;
+            }
+
+            /** @brief Compute and write cycle pattern of displayed screens
+             * @param screens Displayed screens (SGL screen flags)
+             * @return True if pattern was written, false if screens do not fit or resolution is not supported
+             */
+            inline static bool Apply(uint16_t screens)
+            {
+                uint8_t plan[4][Timings];
+                CyclePlanner::planned = CyclePlanner::IsSupported() && CyclePlanner::Plan(CyclePlanner::layers, screens & 0xf, plan);
+                if (!CyclePlanner::planned) return false;
+
+                uint32_t registers[4];
+
+                for (uint8_t bank = 0; bank < 4; bank++)
+                {
+                    registers[bank] = 0;
+
+                    for (uint8_t timing = 0; timing < Timings; timing++)
+                    {
+                        uint8_t access = plan[bank][timing];
+                        if (access == CyclePlanner::Free) access = (uint8_t)Access::Cpu;
+                        else if (access == CyclePlanner::Blocked) access = (uint8_t)Access::None;
+
+                        CyclePlanner::pattern[bank][timing] = access;
+                        registers[bank] |= (uint32_t)access << (28 - (timing << 2));
+                    }
+                }
+
+                // Split both VRAM pairs, so each bank uses its own pattern
+                VDP2_RAMCTL |= 0x0300;
+                slScrCycleSet(registers[0], registers[1], registers[2], registers[3]);
+                return true;
+            }
+
+            /** @brief Check whether last cycle pattern came from the planner
+             * @return True if planner wrote the pattern, false if slScrAutoDisp() pattern is used
+             */
+            inline static bool IsPlanned()
+            {
+                return CyclePlanner::planned;
+            }
+
+            /** @brief Get access of a timing in the last planned pattern
+             * @param bank VRAM bank
+             * @param timing Timing (0-7)
+             * @return Access code
+             */
+            inline static uint8_t GetAccess(VramBank bank, uint8_t timing)
+            {
+                return CyclePlanner::pattern[(uint16_t)bank][timing & 7];
+            }
+
+            /** @brief Get number of timings in the last planned pattern no screen reads
+             * @param bank VRAM bank
+             * @return Number of timings given to CPU access
+             */
+            inline static uint8_t GetUnusedSlots(VramBank bank)
+            {
+                if (!CyclePlanner::planned) return 0;
+
+                uint8_t unused = 0;
+                for (uint8_t timing = 0; timing < Timings; timing++) unused += CyclePlanner::pattern[(uint16_t)bank][timing] == (uint8_t)Access::Cpu ? 1 : 0;
+                return unused;
+            }
+        };
+
         /** @brief Manages VDP2 VRAM allocation
          */
         class VRAM
@@ -100,10 +674,26 @@ namespace SRL
              */
             inline static uint8_t* currentTop[4] = { (uint8_t*)VDP2_VRAM_A1,(uint8_t*)VDP2_VRAM_B0,(uint8_t*)VDP2_VRAM_B1,(uint8_t*)(VDP2_VRAM_B1 + 0x18000) };
 
-            /** @brief Number of cycles available for each bank
-             * @note Indicates number of cycles that are free in the VRAM bank for per pixel operations
+            /** @brief Allocates data of a NBG screen in a bank, if all loaded screens still fit the cycle pattern with it
+             * @param size Number of bytes to allocate
+             * @param boundary Byte boundary that the allocation should be aligned to
+             * @param bank The VRAM bank to allocate in
+             * @param screen The screen identifier
+             * @param map True for map data, false for cell or bitmap data
+             * @param reads Character reads of cell or bitmap data at full scale
+             * @return void* start of the allocated region in VRAM (nullptr if allocation failed)
              */
-            inline static int8_t bankCycles[4] = { -1,-1,-1,2 };//why will init to 0 not work?
+            inline static void* AllocateLayer(uint32_t size, uint32_t boundary, VDP2::VramBank bank, int16_t screen, bool map, uint8_t reads)
+            {
+                const int8_t mapBank = map ? (int8_t)bank : -1;
+                const uint8_t cellBanks = map ? 0 : 1 << (uint16_t)bank;
+
+                if (!CyclePlanner::CanPlace(screen, mapBank, cellBanks, reads)) return nullptr;
+
+                void* alloc = VRAM::Allocate(size, boundary, bank);
+                if (alloc != nullptr) CyclePlanner::Assign(screen, mapBank, cellBanks, reads);
+                return alloc;
+            }
 
         public:
             /** @brief Gets current amount of free VRAM in a bank
@@ -121,6 +711,7 @@ namespace SRL
             * @param boundary Byte Boundary that the allocation should be aligned to (must be multiple of 32 for all VDP2 Data types)
             * @param bank The VRAM bank to allocate in
             * @param cycles (Optional) Number of Bank Cycles this data will require to access during frame(0-8).
+            * 8 reserves the whole bank for RBG0, fewer must still be free in the cycle pattern of loaded screens.
             * @return void* start of the Allocated region in VRAM (nullptr if allocation failed)
             * @note  Any VRAM padded to maintain alignment to a requested boundary is rendered inaccessible to further
             * allocations until VRAM is cleared and reset.
@@ -139,11 +730,15 @@ namespace SRL
 
                 if (VDP2::VRAM::GetAvailable(bank) >= size + addrOffset)
                 {
-                    if ((VRAM::bankCycles[(uint16_t)bank] + cycles) < 8)
+                    bool fits = true;
+
+                    if (cycles >= 8) fits = CyclePlanner::ReserveRotationBank(bank);
+                    else if (cycles > 0) fits = !CyclePlanner::IsRotationBank(bank) && CyclePlanner::GetFreeTimings(bank) >= cycles;
+
+                    if (fits)
                     {
                         myAddress = VRAM::currentBot[(uint16_t)bank] + addrOffset;
                         VRAM::currentBot[(uint16_t)bank] += size + addrOffset;
-                        VRAM::bankCycles[(uint16_t)bank] += cycles;
                     }
                 }
 
@@ -167,27 +762,14 @@ namespace SRL
                     if (alloc == nullptr) alloc = VRAM::Allocate(info.CellByteSize, 32, VramBank::B1, 8);
                     if (alloc == nullptr) SRL::Debug::Assert("RBG Cell Allocation failed: insufficient VRAM");
                 }
-                else // Base cycle requirement on color type
+                else // Use first bank where cycle planner can still fit reads of the color type
                 {
-                    uint8_t reqCycles = 0;
-
-                    switch (info.ColorMode)
-                    {
-                    case CRAM::TextureColorMode::Paletted16:
-                        reqCycles = 1;
-                        break;
-                    case CRAM::TextureColorMode::Paletted256:
-                        reqCycles = 2;
-                        break;
-                    case CRAM::TextureColorMode::RGB555:
-                        reqCycles = 4;
-                        break;
-                    }
+                    const uint8_t reads = CyclePlanner::GetReads(info.ColorMode);
 
-                    alloc = VRAM::Allocate(info.CellByteSize, 32, VramBank::B0, reqCycles);
-                    if (alloc == nullptr) alloc = VRAM::Allocate(info.CellByteSize, 32, VramBank::A1, reqCycles);
-                    if (alloc == nullptr) alloc = VRAM::Allocate(info.CellByteSize, 32, VramBank::A0, reqCycles);
-                    if (alloc == nullptr) alloc = VRAM::Allocate(info.CellByteSize, 32, VramBank::B1, reqCycles);
+                    alloc = VRAM::AllocateLayer(info.CellByteSize, 32, VramBank::B0, screen, false, reads);
+                    if (alloc == nullptr) alloc = VRAM::AllocateLayer(info.CellByteSize, 32, VramBank::A1, screen, false, reads);
+                    if (alloc == nullptr) alloc = VRAM::AllocateLayer(info.CellByteSize, 32, VramBank::A0, screen, false, reads);
+                    if (alloc == nullptr) alloc = VRAM::AllocateLayer(info.CellByteSize, 32, VramBank::B1, screen, false, reads);
                     if (alloc == nullptr) SRL::Debug::Assert("NBG Cell Allocation failed: insufficient VRAM");
                 }
 
@@ -223,10 +805,10 @@ namespace SRL
                     if (alloc == nullptr) Debug::Assert("RBG Map Allocation failed: insufficient VRAM");
                     else if(size!=nullptr)*size = sz;
                 }
-                else // Reserve 1 cycle in bank B1 (or B0 if it doesn't conflict with RBG0 map)
+                else // Use bank A0 (or B1 if A0 is used by RBG0 or has no pattern name timing left)
                 {
-                    if (bankCycles[0]!=7) alloc = VRAM::Allocate(sz, page_sz, VramBank::A0, 1);
-                    if(!alloc) alloc = VRAM::Allocate(sz, page_sz, VramBank::B1, 1);
+                    alloc = VRAM::AllocateLayer(sz, page_sz, VramBank::A0, screen, true, 0);
+                    if(!alloc) alloc = VRAM::AllocateLayer(sz, page_sz, VramBank::B1, screen, true, 0);
                     if (alloc == nullptr) SRL::Debug::Assert("NBG Map Allocation failed: insufficient VRAM");
                     else if(size!=nullptr)*size = sz;
                 }
@@ -266,7 +848,8 @@ namespace SRL
                     numCycles<<=1;
                 }
 
-                if (screen == scnRBG0) numCycles = 8;
+                const bool rotation = screen == scnRBG0;
+                if (rotation) numCycles = 8;
 
                 if(sz>262144) //case: bmp is too large for allocator at this color depth
                 {
@@ -275,67 +858,994 @@ namespace SRL
                 }
                 else if(sz>131072)//case: bmp requires 2 out of the 4 VRAM banks
                 { 
-                    if((uint32_t)bankBot[0]==VDP2_VRAM_A0 && (uint32_t)bankBot[1]==VDP2_VRAM_A1)
+                    if((uint32_t)currentBot[0]==VDP2_VRAM_A0 && (uint32_t)currentBot[1]==VDP2_VRAM_A1 &&
+                        (rotation || CyclePlanner::CanPlace(screen, -1, 0x3, numCycles)))
                     {
-                        alloc = VRAM::Allocate(131072, 32, VramBank::A0, numCycles);
-                        VRAM::Allocate(131072, 32, VramBank::A1, numCycles);
+                        alloc = VRAM::Allocate(131072, 32, VramBank::A0, rotation ? numCycles : 0);
+                        VRAM::Allocate(131072, 32, VramBank::A1, rotation ? numCycles : 0);
+                        if (!rotation) CyclePlanner::Assign(screen, -1, 0x3, numCycles);
                     }
-                    else if((uint32_t)bankBot[1]==VDP2_VRAM_A1 && (uint32_t)bankBot[2]==VDP2_VRAM_B0)
+                    else if((uint32_t)currentBot[1]==VDP2_VRAM_A1 && (uint32_t)currentBot[2]==VDP2_VRAM_B0 &&
+                        (rotation || CyclePlanner::CanPlace(screen, -1, 0x6, numCycles)))
                     {
-                        alloc = VRAM::Allocate(131072, 32, VramBank::A1, numCycles);
-                        VRAM::Allocate(131072, 32, VramBank::B0, numCycles);
+                        alloc = VRAM::Allocate(131072, 32, VramBank::A1, rotation ? numCycles : 0);
+                        VRAM::Allocate(131072, 32, VramBank::B0, rotation ? numCycles : 0);
+                        if (!rotation) CyclePlanner::Assign(screen, -1, 0x6, numCycles);
                     }
                     else 
                     {
-                        Debug::Assert("Bmp Allocation Failed: Insufficient VRAM");
-                        return nullptr;
+                        Debug::Assert("Bmp Allocation Failed: Insufficient VRAM");
+                        return nullptr;
+                    }
+                }
+                else if (rotation)//case: bmp requires 1 or 1/2 VRAM bank
+                {   
+                    
+                    alloc = VRAM::Allocate(sz, 32, VramBank::A0, numCycles);
+                    if (alloc == nullptr) alloc = VRAM::Allocate(sz, 32, VramBank::B0,numCycles);
+                    if (alloc == nullptr) alloc = VRAM::Allocate(sz, 32, VramBank::A1, numCycles);
+                    if (alloc == nullptr) alloc = VRAM::Allocate(sz, 32, VramBank::B1, numCycles);
+                    if (alloc == nullptr) SRL::Debug::Assert("Bmp Allocation failed: insufficient VRAM");
+                }
+                else
+                {
+                    alloc = VRAM::AllocateLayer(sz, 32, VramBank::A0, screen, false, numCycles);
+                    if (alloc == nullptr) alloc = VRAM::AllocateLayer(sz, 32, VramBank::B0, screen, false, numCycles);
+                    if (alloc == nullptr) alloc = VRAM::AllocateLayer(sz, 32, VramBank::A1, screen, false, numCycles);
+                    if (alloc == nullptr) alloc = VRAM::AllocateLayer(sz, 32, VramBank::B1, screen, false, numCycles);
+                    if (alloc == nullptr) SRL::Debug::Assert("Bmp Allocation failed: insufficient VRAM");
+                }
+                if(size) *size = sz;
+               // SRL::Debug::Print(3,17,"Size = %d",size);
+               // SRL::Debug::Print(3,18,"Address: %x",(uint32_t)alloc-VDP2_VRAM_A0);
+                return alloc;
+            }
+
+            /** @brief Overwrites a specified VRAM region with 0 data.
+             *  @param Address The vram address of the area to blank.
+             *  @param Size The size of area to overwrite in bytes.
+             */
+            static void Blank(void* address, uint32_t size)
+            {
+                if(address<(void*)VDP2_VRAM_A0||(uint8_t*)address+size> bankTop[3])return;                
+                for(uint8_t* current = (uint8_t*)address; current< (uint8_t*)address+size; current++) *current = 0; 
+            }
+    
+        };
+
+        /** @brief Bitfield recording all Currently enabled Scroll Screens*/
+        inline static uint16_t ActiveScrolls =  NBG3ON| SPRON;
+
+        /** @brief Bitfield recording all Scroll Screens with VDP2 Color Calculation enabled
+         */
+        inline static uint16_t ColorCalcScrolls =  NBG3ON | SPRON;
+        
+        /** @brief Bitfield recording all Scroll Screens using Color Offset A
+         */
+        inline static uint16_t OffsetAScrolls = NBG3ON;
+        
+        /** @brief Bitfield recording all Scroll Screens using Color Offset B
+          */
+        inline static uint16_t OffsetBScrolls =  NBG3ON;
+        
+        /** @brief Bitfield recording all Scroll Screens That Disable transparent pixels
+          */
+        inline static uint16_t TransparentScrolls = 0;
+
+        /** @brief Double buffered raster scroll table of NBG0 or NBG1
+         * @details Table has two buffers in VRAM. Update() runs the generator into the buffer that is not displayed, optionally on the slave SH2,
+         * and SRL::Core::Synchronize() swaps buffers of attached tables through VDP2::Shadow, so the new table is used from the next v-blank
+         * and a displayed table is never written.
+         * @note VRAM of the buffers is only released by VDP2::ClearVRAM()
+         */
+        class ScrollTable : public SRL::Types::ITask
+        {
+        protected:
+
+            /** @brief Slot of vertical cell scroll table in attached tables
+             */
+            static constexpr uint8_t CellSlot = 2;
+
+            /** @brief Tables attached to NBG0 line scroll, NBG1 line scroll and vertical cell scroll
+             */
+            inline static ScrollTable* attached[3] = { nullptr, nullptr, nullptr };
+
+            /** @brief Line scroll mode bits of NBG0 and NBG1
+             */
+            inline static uint16_t modes[2] = { 0, 0 };
+
+            /** @brief Screens using attached vertical cell scroll table (NBG0ON, NBG1ON)
+             */
+            inline static uint16_t cellScreens = 0;
+
+            /** @brief Buffers in VRAM
+             */
+            int32_t* buffers[2];
+
+            /** @brief Number of values in one buffer
+             */
+            uint16_t size;
+
+            /** @brief Index of buffer written by generator
+             */
+            uint8_t back;
+
+            /** @brief Value indicating whether back buffer was generated since last swap
+             */
+            bool generated;
+
+            /** @brief Value indicating whether generator was started on slave SH2
+             */
+            bool dispatched;
+
+            /** @brief Allocate both buffers
+             * @param size Number of values in one buffer
+             * @param cellScroll Value indicating whether table is read through cycle pattern (vertical cell scroll)
+             */
+            ScrollTable(const uint16_t size, const bool cellScroll) : size(size), back(1), generated(false), dispatched(false)
+            {
+                const VDP2::VramBank banks[4] = { VramBank::B1, VramBank::B0, VramBank::A1, VramBank::A0 };
+                void* alloc = nullptr;
+
+                for (uint8_t index = 0; index < 4 && alloc == nullptr; index++)
+                {
+                    if (CyclePlanner::IsRotationBank(banks[index])) continue;
+                    if (cellScroll && CyclePlanner::GetFreeTimings(banks[index]) == 0) continue;
+
+                    alloc = VRAM::Allocate(size << 3, 32, banks[index]);
+                }
+
+                if (alloc == nullptr) SRL::Debug::Assert("Scroll Table Allocation failed: insufficient VRAM");
+
+                this->buffers[0] = (int32_t*)alloc;
+                this->buffers[1] = alloc != nullptr ? (int32_t*)alloc + size : nullptr;
+            }
+
+            /** @brief Set line scroll mode bits of NBG0 or NBG1
+             * @param screen Normal scroll screen number (0 for NBG0, 1 for NBG1)
+             * @param mask Bits to change
+             * @param bits New value of the bits
+             */
+            inline static void SetMode(const uint8_t screen, const uint16_t mask, const uint16_t bits)
+            {
+                ScrollTable::modes[screen & 1] = (ScrollTable::modes[screen & 1] & ~mask) | bits;
+                slLineScrollMode(screen & 1 ? scnNBG1 : scnNBG0, ScrollTable::modes[screen & 1]);
+            }
+
+            /** @brief Pass displayed buffer of an attached table to VDP2::Shadow
+             * @param slot Slot of attached table
+             */
+            inline static void Publish(const uint8_t slot)
+            {
+                void* front = ScrollTable::attached[slot]->GetFront();
+
+                if (slot == ScrollTable::CellSlot)
+                {
+                    VDP2::Shadow::SetCellTable(front);
+                }
+                else
+                {
+                    VDP2::Shadow::SetLineTable(slot, front);
+                    if (slot == 0) VDP2::NBG0::LineAddress = front;
+                    else VDP2::NBG1::LineAddress = front;
+                }
+            }
+
+            /** @brief Fill back buffer on the slave SH2
+             */
+            void Do() override
+            {
+                // Slave cache might hold generator data from the previous frame
+                if (this->dispatched) slCashPurge();
+                this->Generate();
+            }
+
+            /** @brief Fill back buffer
+             */
+            virtual void Generate() = 0;
+
+        public:
+
+            /** @brief Detach table from all screens
+             */
+            virtual ~ScrollTable()
+            {
+                this->Wait();
+
+                for (uint8_t slot = 0; slot < ScrollTable::CellSlot; slot++)
+                {
+                    if (ScrollTable::attached[slot] == this)
+                    {
+                        ScrollTable::attached[slot] = nullptr;
+                        ScrollTable::SetMode(slot, 0x3e, 0);
+                    }
+                }
+
+                if (ScrollTable::attached[ScrollTable::CellSlot] == this)
+                {
+                    ScrollTable::attached[ScrollTable::CellSlot] = nullptr;
+                    ScrollTable::cellScreens = 0;
+                    ScrollTable::SetMode(0, VCellScroll, 0);
+                    ScrollTable::SetMode(1, VCellScroll, 0);
+                    CyclePlanner::SetCellScroll(scnNBG0, nullptr);
+                    CyclePlanner::SetCellScroll(scnNBG1, nullptr);
+                }
+            }
+
+            /** @brief Generate table for next frame
+             * @param onSlave Run the generator on the slave SH2, buffers are swapped by SRL::Core::Synchronize() after it finishes
+             */
+            void Update(const bool onSlave = false)
+            {
+                this->Wait();
+
+                if (this->buffers[0] == nullptr) return;
+
+                this->generated = true;
+
+                if (onSlave)
+                {
+                    this->dispatched = true;
+                    SRL::Slave::ExecuteOnSlave(*this);
+                }
+                else
+                {
+                    this->Generate();
+                }
+            }
+
+            /** @brief Wait for generator running on the slave SH2 to finish
+             */
+            void Wait()
+            {
+                if (this->dispatched)
+                {
+                    while (!this->IsDone())
+                    {
+                        // Wait for slave
+                    }
+
+                    this->dispatched = false;
+                }
+            }
+
+            /** @brief Get buffer currently displayed
+             * @return VRAM address of the buffer
+             */
+            int32_t* GetFront() const
+            {
+                return this->buffers[this->back ^ 1];
+            }
+
+            /** @brief Get buffer filled by generator
+             * @return VRAM address of the buffer
+             */
+            int32_t* GetBack() const
+            {
+                return this->buffers[this->back];
+            }
+
+            /** @brief Get number of values in one buffer
+             * @return Number of values
+             */
+            uint16_t GetSize() const
+            {
+                return this->size;
+            }
+
+            /** @brief Swap buffers of all attached tables generated since last call, called by VDP2::Shadow::Flush()
+             */
+            inline static void SwapAttached()
+            {
+                for (uint8_t slot = 0; slot <= ScrollTable::CellSlot; slot++)
+                {
+                    ScrollTable* table = ScrollTable::attached[slot];
+                    if (table == nullptr) continue;
+
+                    table->Wait();
+
+                    // Same table can be attached to both screens, it is swapped only once
+                    if (table->generated)
+                    {
+                        table->back ^= 1;
+                        table->generated = false;
+                    }
+
+                    ScrollTable::Publish(slot);
+                }
+            }
+        };
+
+        /** @brief Line scroll table of NBG0 or NBG1
+         * @details Each entry holds the enabled values in order horizontal scroll, vertical scroll and horizontal zoom,
+         * entries are read during horizontal blank and do not need VRAM cycle pattern.
+         * @code {.cpp}
+         * // Water wobble
+         * void Wobble(SRL::VDP2::LineScrollTable& table, void* context)
+         * {
+         *     uint16_t frame = *(uint16_t*)context;
+         *
+         *     for (uint16_t line = 0; line < table.GetLineCount(); line++)
+         *     {
+         *         table.SetHorizontal(line, SRL::Math::Trigonometry::Sin(SRL::Math::Types::Angle::BuildRaw((line + frame) << 10)) * SRL::Math::Types::Fxp(4.0));
+         *     }
+         * }
+         *
+         * SRL::VDP2::LineScrollTable wobble(Wobble, &frame);
+         * SRL::VDP2::NBG0::SetLineScroll(&wobble);
+         *
+         * while (1)
+         * {
+         *     frame++;
+         *     wobble.Update(true);
+         *     SRL::Core::Synchronize();
+         * }
+         * @endcode
+         */
+        class LineScrollTable : public ScrollTable
+        {
+        public:
+
+            /** @brief Function filling back buffer of the table
+             * @param table Table to fill
+             * @param context User data given to the constructor
+             */
+            using Generator = void (*)(LineScrollTable& table, void* context);
+
+        private:
+
+            /** @brief Table generator
+             */
+            Generator generator;
+
+            /** @brief User data of generator
+             */
+            void* context;
+
+            /** @brief Line scroll mode bits
+             */
+            uint16_t mode;
+
+            /** @brief Number of values per entry
+             */
+            uint8_t stride;
+
+            /** @brief Offset of vertical scroll value in entry
+             */
+            uint8_t vertical;
+
+            /** @brief Offset of horizontal zoom value in entry
+             */
+            uint8_t zoom;
+
+            /** @brief Fill back buffer
+             */
+            void Generate() override
+            {
+                if (this->generator != nullptr) this->generator(*this, this->context);
+            }
+
+            /** @brief Get number of values per entry
+             * @param horizontal Horizontal scroll enabled
+             * @param vertical Vertical scroll enabled
+             * @param zoom Horizontal zoom enabled
+             * @return Number of values
+             */
+            inline static uint8_t GetStride(const bool horizontal, const bool vertical, const bool zoom)
+            {
+                return (horizontal ? 1 : 0) + (vertical ? 1 : 0) + (zoom ? 1 : 0);
+            }
+
+            /** @brief Get number of entries covering the screen
+             * @param interval Lines per entry
+             * @return Number of entries
+             */
+            inline static uint16_t GetEntries(const VDP2::LineInterval interval)
+            {
+                const uint8_t shift = (uint16_t)interval >> 4;
+                return (SRL::TV::Height + (1 << shift) - 1) >> shift;
+            }
+
+        public:
+
+            /** @brief Create line scroll table
+             * @param generator Function filling the table, can be nullptr when values are set directly on the back buffer
+             * @param context User data passed to generator
+             * @param horizontal Scroll each entry horizontally
+             * @param vertical Scroll each entry vertically
+             * @param zoom Scale each entry horizontally
+             * @param interval Number of lines sharing one entry
+             */
+            LineScrollTable(Generator generator,
+                void* context = nullptr,
+                const bool horizontal = true,
+                const bool vertical = false,
+                const bool zoom = false,
+                const VDP2::LineInterval interval = VDP2::LineInterval::Line1) :
+                ScrollTable(LineScrollTable::GetEntries(interval) * LineScrollTable::GetStride(horizontal, vertical, zoom), false),
+                generator(generator),
+                context(context),
+                mode((uint16_t)interval | (horizontal ? lineHScroll : 0) | (vertical ? lineVScroll : 0) | (zoom ? lineZoom : 0)),
+                stride(LineScrollTable::GetStride(horizontal, vertical, zoom)),
+                vertical(horizontal ? 1 : 0),
+                zoom((horizontal ? 1 : 0) + (vertical ? 1 : 0))
+            {
+                if (this->buffers[0] == nullptr) return;
+
+                // Start with unchanged screen
+                for (uint16_t entry = 0; entry < this->GetLineCount(); entry++)
+                {
+                    for (uint8_t buffer = 0; buffer < 2; buffer++)
+                    {
+                        int32_t* values = this->buffers[buffer] + (entry * this->stride);
+                        if (horizontal) values[0] = 0;
+                        if (vertical) values[this->vertical] = 0;
+                        if (zoom) values[this->zoom] = Math::Types::Fxp(1.0).RawValue();
+                    }
+                }
+            }
+
+            /** @brief Get number of entries
+             * @return Number of entries covering the screen height
+             */
+            uint16_t GetLineCount() const
+            {
+                return this->stride > 0 ? this->size / this->stride : 0;
+            }
+
+            /** @brief Set horizontal scroll of an entry in the back buffer
+             * @param line Entry index
+             * @param value Horizontal scroll added to screen position
+             */
+            void SetHorizontal(const uint16_t line, const Math::Types::Fxp& value)
+            {
+                if (this->mode & lineHScroll) this->GetBack()[line * this->stride] = value.RawValue();
+            }
+
+            /** @brief Set vertical scroll of an entry in the back buffer
+             * @param line Entry index
+             * @param value Vertical scroll value
+             */
+            void SetVertical(const uint16_t line, const Math::Types::Fxp& value)
+            {
+                if (this->mode & lineVScroll) this->GetBack()[(line * this->stride) + this->vertical] = value.RawValue();
+            }
+
+            /** @brief Set horizontal zoom of an entry in the back buffer
+             * @param line Entry index
+             * @param value Horizontal coordinate increment per pixel (1.0 for unscaled)
+             */
+            void SetZoom(const uint16_t line, const Math::Types::Fxp& value)
+            {
+                if (this->mode & lineZoom) this->GetBack()[(line * this->stride) + this->zoom] = value.RawValue();
+            }
+
+            /** @brief Attach table to NBG0 or NBG1, used by VDP2::NBG0::SetLineScroll() and VDP2::NBG1::SetLineScroll()
+             * @param screen Normal scroll screen number (0 for NBG0, 1 for NBG1)
+             * @param table Table to attach, nullptr disables line scroll
+             */
+            inline static void Attach(const uint8_t screen, LineScrollTable* table)
+            {
+                ScrollTable::attached[screen & 1] = table;
+                ScrollTable::SetMode(screen, 0x3e, table != nullptr ? table->mode : 0);
+                if (table != nullptr) ScrollTable::Publish(screen & 1);
+            }
+        };
+
+        /** @brief Vertical cell scroll table of NBG0 and NBG1
+         * @details One vertical scroll value per 8 pixel wide column of screen. When table is created for both NBG0 and NBG1,
+         * values of both screens alternate in each column. Table is read through VRAM cycle pattern, so it is placed in a bank
+         * VDP2::CyclePlanner has a free timing in.
+         * @note VDP2 has one vertical cell scroll table, attaching a table replaces the previous one on both screens
+         */
+        class CellScrollTable : public ScrollTable
+        {
+        public:
+
+            /** @brief Function filling back buffer of the table
+             * @param table Table to fill
+             * @param context User data given to the constructor
+             */
+            using Generator = void (*)(CellScrollTable& table, void* context);
+
+        private:
+
+            /** @brief Table generator
+             */
+            Generator generator;
+
+            /** @brief User data of generator
+             */
+            void* context;
+
+            /** @brief Number of values per column
+             */
+            uint8_t stride;
+
+            /** @brief Screens using the table (NBG0ON, NBG1ON)
+             */
+            uint16_t screens;
+
+            /** @brief Fill back buffer
+             */
+            void Generate() override
+            {
+                if (this->generator != nullptr) this->generator(*this, this->context);
+            }
+
+            /** @brief Get number of columns covering the screen
+             * @return Number of columns, including one partially scrolled in
+             */
+            inline static uint16_t GetColumns()
+            {
+                return (SRL::TV::Width >> 3) + 1;
+            }
+
+        public:
+
+            /** @brief Create vertical cell scroll table
+             * @param generator Function filling the table, can be nullptr when values are set directly on the back buffer
+             * @param context User data passed to generator
+             * @param screens Screens that will use the table (NBG0ON, NBG1ON or both)
+             */
+            CellScrollTable(Generator generator, void* context = nullptr, const uint16_t screens = NBG0ON) :
+                ScrollTable(CellScrollTable::GetColumns() * ((screens & (NBG0ON | NBG1ON)) == (NBG0ON | NBG1ON) ? 2 : 1), true),
+                generator(generator),
+                context(context),
+                stride((screens & (NBG0ON | NBG1ON)) == (NBG0ON | NBG1ON) ? 2 : 1),
+                screens(screens & (NBG0ON | NBG1ON))
+            {
+                if (this->buffers[0] != nullptr)
+                {
+                    for (uint16_t value = 0; value < this->size; value++)
+                    {
+                        this->buffers[0][value] = 0;
+                        this->buffers[1][value] = 0;
+                    }
+                }
+            }
+
+            /** @brief Get number of columns
+             * @return Number of columns covering the screen width
+             */
+            uint16_t GetColumnCount() const
+            {
+                return this->size / this->stride;
+            }
+
+            /** @brief Set vertical scroll of a column in the back buffer
+             * @param column Column index
+             * @param value Vertical scroll added to screen position
+             * @param screen Normal scroll screen number (0 for NBG0, 1 for NBG1), used only by tables created for both screens
+             */
+            void SetColumn(const uint16_t column, const Math::Types::Fxp& value, const uint8_t screen = 0)
+            {
+                this->GetBack()[(column * this->stride) + (this->stride > 1 ? screen & 1 : 0)] = value.RawValue();
+            }
+
+            /** @brief Attach table to NBG0 or NBG1, used by VDP2::NBG0::SetCellScroll() and VDP2::NBG1::SetCellScroll()
+             * @param screen Normal scroll screen number (0 for NBG0, 1 for NBG1)
+             * @param table Table to attach, nullptr disables vertical cell scroll of the screen
+             */
+            inline static void Attach(const uint8_t screen, CellScrollTable* table)
+            {
+                const uint16_t bit = 1 << (screen & 1);
+                const int16_t id = screen & 1 ? scnNBG1 : scnNBG0;
+
+                if (table != nullptr && (table->screens & bit))
+                {
+                    ScrollTable::attached[ScrollTable::CellSlot] = table;
+                    ScrollTable::cellScreens |= bit;
+                    ScrollTable::SetMode(screen, VCellScroll, VCellScroll);
+                    CyclePlanner::SetCellScroll(id, table->GetFront());
+                    ScrollTable::Publish(ScrollTable::CellSlot);
+                }
+                else
+                {
+                    if (table != nullptr) SRL::Debug::Assert("Cell Scroll Table was not created for this screen");
+
+                    ScrollTable::cellScreens &= ~bit;
+                    ScrollTable::SetMode(screen, VCellScroll, 0);
+                    CyclePlanner::SetCellScroll(id, nullptr);
+                    if (ScrollTable::cellScreens == 0) ScrollTable::attached[ScrollTable::CellSlot] = nullptr;
+                }
+            }
+        };
+
+        /** @brief Shadow of VDP2 display settings applied once per frame
+         * @details Priorities, color calculation ratios, color offsets, transparency, NBG scroll positions and scales and scroll table addresses are only stored when set,
+         * repeated changes within a frame collapse into one value and values equal to the already applied ones are skipped.
+         * All changed settings are passed to SGL together by SRL::Core::Synchronize(), SGL then sends its register buffer to VDP2 in the following v-blank.
+         * Settings are not flushed from SRL::Core::OnVblank, SGL writes its own register buffer in the same interrupt and flushing there would race with it,
+         * as well as with code of the main loop still changing the shadow.
+         * @note Settings changed outside of a frame loop take effect only after the next SRL::Core::Synchronize(), use SRL::VDP2::Shadow::Flush() to apply them earlier.
+         */
+        class Shadow
+        {
+            /** @brief Disable constructor
+             */
+            Shadow() = delete;
+
+            /** @brief Disable destructor
+             */
+            ~Shadow() = delete;
+
+            /** @brief First slot of screen priorities, indexed by SGL screen identifier + 8
+             */
+            static constexpr uint8_t PrioritySlot = 0;
+
+            /** @brief First slot of color calculation ratios, indexed by SGL screen identifier + 8
+             */
+            static constexpr uint8_t ColorRateSlot = 16;
+
+            /** @brief First slot of NBG0-NBG3 scroll positions
+             */
+            static constexpr uint8_t PositionSlot = 32;
+
+            /** @brief First slot of NBG0-NBG1 scales
+             */
+            static constexpr uint8_t ScaleSlot = 36;
+
+            /** @brief Slot of screens using color calculation
+             */
+            static constexpr uint8_t ColorCalcSlot = 38;
+
+            /** @brief Slot of screens using color offsets
+             */
+            static constexpr uint8_t OffsetUseSlot = 39;
+
+            /** @brief First slot of color offset A and B values
+             */
+            static constexpr uint8_t OffsetSlot = 40;
+
+            /** @brief Slot of screens with transparency disabled
+             */
+            static constexpr uint8_t TransparentSlot = 42;
+
+            /** @brief First slot of NBG0-NBG1 line scroll tables
+             */
+            static constexpr uint8_t LineTableSlot = 43;
+
+            /** @brief Slot of vertical cell scroll table
+             */
+            static constexpr uint8_t CellTableSlot = 45;
+
+            /** @brief Settings changed since last flush, one bit per slot
+             */
+            inline static uint64_t dirty = 0;
+
+            /** @brief Settings already applied at least once, one bit per slot
+             */
+            inline static uint64_t known = 0;
+
+            /** @brief Screen priorities
+             */
+            inline static uint16_t priorities[16];
+
+            /** @brief Color calculation ratios
+             */
+            inline static uint16_t colorRates[16];
+
+            /** @brief Scroll positions of NBG0-NBG3
+             */
+            inline static int32_t positions[4][2];
+
+            /** @brief Scales of NBG0-NBG1
+             */
+            inline static int32_t scales[2][2];
+
+            /** @brief Screens using color calculation
+             */
+            inline static uint16_t colorCalc = 0;
+
+            /** @brief Screens using color offset A and B
+             */
+            inline static uint16_t offsetUse[2];
+
+            /** @brief Red, green and blue values of color offset A and B
+             */
+            inline static int16_t offsets[2][3];
+
+            /** @brief Screens with transparency disabled
+             */
+            inline static uint16_t transparent = 0;
+
+            /** @brief Line scroll tables of NBG0-NBG1
+             */
+            inline static void* lineTables[2] = { nullptr, nullptr };
+
+            /** @brief Vertical cell scroll table
+             */
+            inline static void* cellTable = nullptr;
+
+            /** @brief Number of setting changes since last flush
+             */
+            inline static uint16_t requests = 0;
+
+            /** @brief Number of setting changes collapsed into the last flush
+             */
+            inline static uint16_t flushedRequests = 0;
+
+            /** @brief Number of settings written by the last flush
+             */
+            inline static uint16_t flushedWrites = 0;
+
+            /** @brief Mark setting as changed
+             * @param slot Setting slot
+             * @param changed Whether value differs from the stored one
+             */
+            inline static void Mark(const uint8_t slot, const bool changed)
+            {
+                const uint64_t bit = (uint64_t)1 << slot;
+                Shadow::requests++;
+
+                if (changed || (Shadow::known & bit) == 0)
+                {
+                    Shadow::dirty |= bit;
+                }
+            }
+
+            /** @brief Write single setting through SGL
+             * @param slot Setting slot
+             */
+            inline static void Write(const uint8_t slot)
+            {
+                if (slot < Shadow::ColorRateSlot)
+                {
+                    slPriority((int16_t)slot - 8, Shadow::priorities[slot]);
+                }
+                else if (slot < Shadow::PositionSlot)
+                {
+                    slColRate((int16_t)(slot - Shadow::ColorRateSlot) - 8, Shadow::colorRates[slot - Shadow::ColorRateSlot]);
+                }
+                else if (slot < Shadow::ScaleSlot)
+                {
+                    const int32_t* position = Shadow::positions[slot - Shadow::PositionSlot];
+
+                    switch (slot - Shadow::PositionSlot)
+                    {
+                    case 0:
+                        slScrPosNbg0(position[0], position[1]);
+                        break;
+
+                    case 1:
+                        slScrPosNbg1(position[0], position[1]);
+                        break;
+
+                    case 2:
+                        slScrPosNbg2(position[0], position[1]);
+                        break;
+
+                    default:
+                        slScrPosNbg3(position[0], position[1]);
+                        break;
+                    }
+                }
+                else if (slot < Shadow::ColorCalcSlot)
+                {
+                    const int32_t* scale = Shadow::scales[slot - Shadow::ScaleSlot];
+
+                    if (slot == Shadow::ScaleSlot)
+                    {
+                        slScrScaleNbg0(scale[0], scale[1]);
+                    }
+                    else
+                    {
+                        slScrScaleNbg1(scale[0], scale[1]);
+                    }
+                }
+                else if (slot == Shadow::ColorCalcSlot)
+                {
+                    slColorCalcOn(Shadow::colorCalc);
+                }
+                else if (slot == Shadow::OffsetUseSlot)
+                {
+                    slColOffsetOn(0);
+                    slColOffsetAUse(Shadow::offsetUse[0]);
+                    slColOffsetBUse(Shadow::offsetUse[1]);
+                }
+                else if (slot == Shadow::OffsetSlot)
+                {
+                    slColOffsetA(Shadow::offsets[0][0], Shadow::offsets[0][1], Shadow::offsets[0][2]);
+                }
+                else if (slot == Shadow::OffsetSlot + 1)
+                {
+                    slColOffsetB(Shadow::offsets[1][0], Shadow::offsets[1][1], Shadow::offsets[1][2]);
+                }
+                else if (slot == Shadow::TransparentSlot)
+                {
+                    slScrTransparent(Shadow::transparent);
+                }
+                else if (slot == Shadow::LineTableSlot)
+                {
+                    slLineScrollTable0(Shadow::lineTables[0]);
+                }
+                else if (slot == Shadow::LineTableSlot + 1)
+                {
+                    slLineScrollTable1(Shadow::lineTables[1]);
+                }
+                else
+                {
+                    slVCellTable(Shadow::cellTable);
+                }
+            }
+
+        public:
+
+            /** @name Settings
+             * @{
+             */
+
+            /** @brief Set display priority of a screen
+             * @param screen SGL screen identifier (scnNBG0 to scnRBG0, or scnSPR0 to scnSPR7 for sprite priority banks)
+             * @param priority Priority layer
+             */
+            inline static void SetPriority(const int16_t screen, const uint16_t priority)
+            {
+                const uint8_t index = (screen + 8) & 0xf;
+                Shadow::Mark(Shadow::PrioritySlot + index, Shadow::priorities[index] != priority);
+                Shadow::priorities[index] = priority;
+            }
+
+            /** @brief Set color calculation ratio of a screen
+             * @param screen SGL screen identifier (scnNBG0 to scnBACK, or scnSPR0 to scnSPR7 for sprite ratio banks)
+             * @param rate Ratio between 0 and 31
+             */
+            inline static void SetColorRate(const int16_t screen, const uint16_t rate)
+            {
+                const uint8_t index = (screen + 8) & 0xf;
+                Shadow::Mark(Shadow::ColorRateSlot + index, Shadow::colorRates[index] != rate);
+                Shadow::colorRates[index] = rate;
+            }
+
+            /** @brief Set screens using color calculation
+             * @param screens Screen bits (NBG0ON, SPRON, ...)
+             */
+            inline static void SetColorCalc(const uint16_t screens)
+            {
+                Shadow::Mark(Shadow::ColorCalcSlot, Shadow::colorCalc != screens);
+                Shadow::colorCalc = screens;
+            }
+
+            /** @brief Set screens using color offsets
+             * @param offsetA Screen bits using color offset A
+             * @param offsetB Screen bits using color offset B
+             */
+            inline static void SetColorOffsetUse(const uint16_t offsetA, const uint16_t offsetB)
+            {
+                Shadow::Mark(Shadow::OffsetUseSlot, Shadow::offsetUse[0] != offsetA || Shadow::offsetUse[1] != offsetB);
+                Shadow::offsetUse[0] = offsetA;
+                Shadow::offsetUse[1] = offsetB;
+            }
+
+            /** @brief Set value of a color offset
+             * @param channel Color offset (0 for A, 1 for B)
+             * @param red Red offset
+             * @param green Green offset
+             * @param blue Blue offset
+             */
+            inline static void SetColorOffset(const uint8_t channel, const int16_t red, const int16_t green, const int16_t blue)
+            {
+                int16_t* offset = Shadow::offsets[channel & 1];
+                Shadow::Mark(Shadow::OffsetSlot + (channel & 1), offset[0] != red || offset[1] != green || offset[2] != blue);
+                offset[0] = red;
+                offset[1] = green;
+                offset[2] = blue;
+            }
+
+            /** @brief Set screens with transparency disabled
+             * @param screens Screen bits (NBG0ON, RBG0ON, ...)
+             */
+            inline static void SetTransparent(const uint16_t screens)
+            {
+                Shadow::Mark(Shadow::TransparentSlot, Shadow::transparent != screens);
+                Shadow::transparent = screens;
+            }
+
+            /** @brief Set scroll position of a normal scroll screen
+             * @param screen Normal scroll screen number (0 for NBG0 to 3 for NBG3)
+             * @param x Fixed point horizontal position
+             * @param y Fixed point vertical position
+             */
+            inline static void SetPosition(const uint8_t screen, const int32_t x, const int32_t y)
+            {
+                int32_t* position = Shadow::positions[screen & 0x3];
+                Shadow::Mark(Shadow::PositionSlot + (screen & 0x3), position[0] != x || position[1] != y);
+                position[0] = x;
+                position[1] = y;
+            }
+
+            /** @brief Set scale of a normal scroll screen
+             * @param screen Normal scroll screen number (0 for NBG0, 1 for NBG1)
+             * @param x Fixed point horizontal scale
+             * @param y Fixed point vertical scale
+             */
+            inline static void SetScale(const uint8_t screen, const int32_t x, const int32_t y)
+            {
+                int32_t* scale = Shadow::scales[screen & 0x1];
+                Shadow::Mark(Shadow::ScaleSlot + (screen & 0x1), scale[0] != x || scale[1] != y);
+                scale[0] = x;
+                scale[1] = y;
+            }
+
+            /** @brief Set line scroll table of a normal scroll screen
+             * @param screen Normal scroll screen number (0 for NBG0, 1 for NBG1)
+             * @param address VRAM address of the table
+             */
+            inline static void SetLineTable(const uint8_t screen, void* address)
+            {
+                Shadow::Mark(Shadow::LineTableSlot + (screen & 0x1), Shadow::lineTables[screen & 0x1] != address);
+                Shadow::lineTables[screen & 0x1] = address;
+            }
+
+            /** @brief Set vertical cell scroll table
+             * @param address VRAM address of the table
+             */
+            inline static void SetCellTable(void* address)
+            {
+                Shadow::Mark(Shadow::CellTableSlot, Shadow::cellTable != address);
+                Shadow::cellTable = address;
+            }
+
+            /** @} */
+
+            /** @name Flush
+             * @{
+             */
+
+            /** @brief Pass all changed settings to SGL, called by SRL::Core::Synchronize()
+             */
+            inline static void Flush()
+            {
+                uint16_t writes = 0;
+
+                // Tables generated during this frame replace the displayed ones
+                VDP2::ScrollTable::SwapAttached();
+
+                for (uint8_t slot = 0; Shadow::dirty != 0; slot++)
+                {
+                    const uint64_t bit = (uint64_t)1 << slot;
+
+                    if ((Shadow::dirty & bit) != 0)
+                    {
+                        Shadow::Write(slot);
+                        Shadow::dirty &= ~bit;
+                        Shadow::known |= bit;
+                        writes++;
                     }
                 }
-                else//case: bmp requires 1 or 1/2 VRAM bank
-                {   
-                    
-                    alloc = VRAM::Allocate(sz, 32, VramBank::A0, numCycles);
-                    if (alloc == nullptr) alloc = VRAM::Allocate(sz, 32, VramBank::B0,numCycles);
-                    if (alloc == nullptr) alloc = VRAM::Allocate(sz, 32, VramBank::A1, numCycles);
-                    if (alloc == nullptr) alloc = VRAM::Allocate(sz, 32, VramBank::B1, numCycles);
-                    if (alloc == nullptr) SRL::Debug::Assert("Bmp Allocation failed: insufficient VRAM");
-                }
-                if(size) *size = sz;
-               // SRL::Debug::Print(3,17,"Size = %d",size);
-               // SRL::Debug::Print(3,18,"Address: %x",(uint32_t)alloc-VDP2_VRAM_A0);
-                return alloc;
+
+                Shadow::flushedWrites = writes;
+                Shadow::flushedRequests = Shadow::requests;
+                Shadow::requests = 0;
             }
 
-            /** @brief Overwrites a specified VRAM region with 0 data.
-             *  @param Address The vram address of the area to blank.
-             *  @param Size The size of area to overwrite in bytes.
+            /** @brief Check whether any setting waits for flush
+             * @return True if there are changed settings
              */
-            static void Blank(void* address, uint32_t size)
+            inline static bool IsDirty()
             {
-                if(address<(void*)VDP2_VRAM_A0||(uint8_t*)address+size> bankTop[3])return;                
-                for(uint8_t* current = (uint8_t*)address; current< (uint8_t*)address+size; current++) *current = 0; 
+                return Shadow::dirty != 0;
             }
-    
-        };
 
-        /** @brief Bitfield recording all Currently enabled Scroll Screens*/
-        inline static uint16_t ActiveScrolls =  NBG3ON| SPRON;
+            /** @brief Get number of settings written by the last flush
+             * @return Written setting count
+             */
+            inline static uint16_t GetWriteCount()
+            {
+                return Shadow::flushedWrites;
+            }
 
-        /** @brief Bitfield recording all Scroll Screens with VDP2 Color Calculation enabled
-         */
-        inline static uint16_t ColorCalcScrolls =  NBG3ON | SPRON;
-        
-        /** @brief Bitfield recording all Scroll Screens using Color Offset A
-         */
-        inline static uint16_t OffsetAScrolls = NBG3ON;
-        
-        /** @brief Bitfield recording all Scroll Screens using Color Offset B
-          */
-        inline static uint16_t OffsetBScrolls =  NBG3ON;
-        
-        /** @brief Bitfield recording all Scroll Screens That Disable transparent pixels
-          */
-        inline static uint16_t TransparentScrolls = 0;
+            /** @brief Get number of setting changes collapsed into the last flush
+             * @return Change count, including changes that did not differ from the applied value
+             */
+            inline static uint16_t GetRequestCount()
+            {
+                return Shadow::flushedRequests;
+            }
+
+            /** @} */
+        };
 
         /** @brief Functionality available to all Scroll Screen interfaces
          */
@@ -476,6 +1986,14 @@ namespace SRL
                     return;
                 }
 
+                // 10 bit character number of 2x2 characters counts 128 byte cells from the start of a 0x20000 byte region
+                if (ScreenType::Info.MapMode == (PNB_1WORD | CN_10BIT) && ScreenType::Info.CharSize &&
+                    (((uint32_t)ScreenType::CellAddress - VDP2_VRAM_A0) & 0x1FFFF) + ScreenType::Info.CellByteSize > 0x20000)
+                {
+                    SRL::Debug::Assert("Tilemap Load Failed- CEL DATA crosses 0x20000 byte boundary of 10 bit character number");
+                    return;
+                }
+
                 int colorID = 0;
                 if (ScreenType::Info.ColorMode != SRL::CRAM::TextureColorMode::RGB555)
                 {
@@ -503,6 +2021,7 @@ namespace SRL
                     ScreenType::MapAddress,
                     ScreenType::TilePalette.GetId(),
                     VDP2::ScrollScreen<ScreenType, Id, On>::GetCellOffset(ScreenType::Info, ScreenType::CellAddress));
+                VDP2::CyclePlanner::SetTilemap(ScreenType::ScreenID, ScreenType::Info, ScreenType::CellAddress, ScreenType::MapAddress);
                 ScreenType::Init(ScreenType::Info);
             }
 
@@ -552,6 +2071,8 @@ namespace SRL
              *     -NBG Data was stored in a bank reserved by RBG0
              * Potential conflicts are minimized when using Automatic Allocation and setting the
              * desired scale limits of NBG0/NBG1 beforehand.
+             * The cycle pattern is computed by VDP2::CyclePlanner whenever loaded scrolls fit, otherwise the pattern of
+             * SGL's slScrAutoDisp() is kept.
              * @note Even when registration is successful, some scrolls may be unable to  display simultaneously
              * when the color depth of NBG0 or NBG1 is too High:
              *        -When NBG0 > 8bpp, NBG2 will not display
@@ -563,7 +2084,13 @@ namespace SRL
             {
                 VDP2::ActiveScrolls |= ScreenType::ScreenON;
                 int check = slScrAutoDisp(VDP2::ActiveScrolls);
-                if (check < 0) SRL::Debug::Assert("Scroll Registration Failed- Invalid cycle pattern");
+
+                // Planner can fit layouts slScrAutoDisp() rejects, display is then turned on directly
+                if (VDP2::CyclePlanner::Apply(VDP2::ActiveScrolls))
+                {
+                    if (check < 0) slScrDisp(VDP2::ActiveScrolls);
+                }
+                else if (check < 0) SRL::Debug::Assert("Scroll Registration Failed- Invalid cycle pattern");
             }
 
             /** @brief Removes the Scroll Screen from VDP2 cycle pattern register to disable display
@@ -576,7 +2103,13 @@ namespace SRL
             {
                 VDP2::ActiveScrolls &= ~(ScreenType::ScreenON);
                 int check = slScrAutoDisp(VDP2::ActiveScrolls);
-                if (check < 0) SRL::Debug::Assert("Scroll Registration Failed- Invalid cycle pattern");
+
+                // Planner can fit layouts slScrAutoDisp() rejects, display is then turned on directly
+                if (VDP2::CyclePlanner::Apply(VDP2::ActiveScrolls))
+                {
+                    if (check < 0) slScrDisp(VDP2::ActiveScrolls);
+                }
+                else if (check < 0) SRL::Debug::Assert("Scroll Registration Failed- Invalid cycle pattern");
             }
           
             /** @brief Gets the starting address in VRAM of Map data allocated to this scroll
@@ -655,13 +2188,13 @@ namespace SRL
                 else if (opacity >= Math::Fxp(1.0))
                 {
                     VDP2::ColorCalcScrolls &= ~(ScreenType::ScreenON);
-                    slColorCalcOn(VDP2::ColorCalcScrolls);
+                    VDP2::Shadow::SetColorCalc(VDP2::ColorCalcScrolls);
                 }
                 else
                 {
-                    slColRate(ScreenType::ScreenID, 31 - (uint16_t)(opacity.RawValue() >> 11));
+                    VDP2::Shadow::SetColorRate(ScreenType::ScreenID, 31 - (uint16_t)(opacity.RawValue() >> 11));
                     VDP2::ColorCalcScrolls |= ScreenType::ScreenON;
-                    slColorCalcOn(VDP2::ColorCalcScrolls);
+                    VDP2::Shadow::SetColorCalc(VDP2::ColorCalcScrolls);
                 }
             }
 
@@ -671,7 +2204,7 @@ namespace SRL
              * SPRITE>RBG0>NBG0>NBG1>NBG2>NBG3.
              * @param pr The Priority Layer for the Scroll Screen
              */
-            inline static void SetPriority(SRL::VDP2::Priority pr) { slPriority(ScreenType::ScreenID, (uint16_t)pr); }
+            inline static void SetPriority(SRL::VDP2::Priority pr) { VDP2::Shadow::SetPriority(ScreenType::ScreenID, (uint16_t)pr); }
 
             /** @brief Sets Which Color Offset that a scroll Screen should use
             *  @details Scroll Screens can optionally apply one of 2 registered RGB color offsets
@@ -699,9 +2232,7 @@ namespace SRL
                     OffsetBScrolls &= ~ScreenType::ScreenON;
                 }
 
-                slColOffsetOn(0);//clear all offsets  
-                slColOffsetAUse(OffsetAScrolls);//re register offsets for A 
-                slColOffsetBUse(OffsetBScrolls);//re register offsets for B
+                VDP2::Shadow::SetColorOffsetUse(OffsetAScrolls, OffsetBScrolls);
             }
 
             /** @brief Enable transparent pixels for a scroll screen
@@ -713,7 +2244,7 @@ namespace SRL
             {
                 VDP2::TransparentScrolls &= ~ScreenType::ScreenON;
                 //SGLs naming convention is reversed- flagging ScreenON turns OFF transparency
-                slScrTransparent(VDP2::TransparentScrolls);
+                VDP2::Shadow::SetTransparent(VDP2::TransparentScrolls);
             }
 
             /** @brief Disable transparent pixels for a scroll screen
@@ -725,7 +2256,7 @@ namespace SRL
             {    
                 VDP2::TransparentScrolls |= ScreenType::ScreenON;
                 //SGLs naming convention is reversed- flagging ScreenON turns OFF transparency
-                slScrTransparent(VDP2::TransparentScrolls);
+                VDP2::Shadow::SetTransparent(VDP2::TransparentScrolls);
             }
 
             /** @brief Compute the offset that must be added to map data When Corresponding Cell Data does not start on a VRAM bank boundary
@@ -890,6 +2421,7 @@ namespace SRL
                     }   
                     ScreenType::TilePalette.Load(myInfo.Palette->Colors, myInfo.Palette->Count);    
                 }
+                VDP2::CyclePlanner::SetBitmap(ScreenType::ScreenID, myInfo, ScreenType::CellAddress, ScreenType::CellAllocSize);
                 ScreenType::Init(myInfo);
             } 
 
@@ -980,14 +2512,37 @@ namespace SRL
             /** @brief Sets the Screen Position of NBG Scroll Screen
              * @param pos Fixed Point X and Y Screen Position
              */
-            static void SetPosition(Math::Vector2D& pos) { slScrPosNbg0(pos.X.RawValue(), pos.Y.RawValue()); }
+            static void SetPosition(Math::Vector2D& pos) { VDP2::Shadow::SetPosition(0, pos.X.RawValue(), pos.Y.RawValue()); }
 
             /** @brief Sets the Scale of NBG0 Screen display
              *  @param scl Fixed Point X an Y scaling values
              *  @note The minimum scale that can be displayed is determined by The Scale Limit, Scaling values
              *  lower than the minimum will be clamped to the minimum
              */
-            static void SetScale(Math::Vector2D& scl) { slScrScaleNbg0(scl.X.RawValue(), scl.Y.RawValue()); }
+            static void SetScale(Math::Vector2D& scl) { VDP2::Shadow::SetScale(0, scl.X.RawValue(), scl.Y.RawValue()); }
+
+            /** @brief Sets the Scale Limit of NBG0 Screen display
+             * @param limit Smallest scale that can be displayed
+             * @note Lower limits need 2 or 4 times more character reads, which are accounted for by VRAM allocation and cycle pattern
+             * of the following loads, set limit before loading screen data
+             */
+            static void SetScaleLimit(VDP2::ScaleLimit limit)
+            {
+                slZoomModeNbg0((uint16_t)limit);
+                VDP2::CyclePlanner::SetReduction(scnNBG0, limit);
+            }
+
+            /** @brief Sets line scroll table of NBG0
+             * @param table Line scroll table, nullptr to disable line scroll
+             * @note Table buffers are swapped by SRL::Core::Synchronize() after VDP2::ScrollTable::Update()
+             */
+            static void SetLineScroll(VDP2::LineScrollTable* table) { VDP2::LineScrollTable::Attach(0, table); }
+
+            /** @brief Sets vertical cell scroll table of NBG0
+             * @param table Vertical cell scroll table created for NBG0, nullptr to disable vertical cell scroll
+             * @note Table is read through VRAM cycle pattern, which VDP2::CyclePlanner updates when the screen is displayed
+             */
+            static void SetCellScroll(VDP2::CellScrollTable* table) { VDP2::CellScrollTable::Attach(0, table); }
         };
 
         /** @brief NBG1 interface
@@ -1040,14 +2595,37 @@ namespace SRL
             /** @brief Sets the Screen Position of NBG Scroll Screen
              * @param pos Fixed Point X and Y Screen Position
              */
-            static void SetPosition(Math::Vector2D& pos) { slScrPosNbg1(pos.X.RawValue(), pos.Y.RawValue()); }
+            static void SetPosition(Math::Vector2D& pos) { VDP2::Shadow::SetPosition(1, pos.X.RawValue(), pos.Y.RawValue()); }
 
             /** @brief Sets the Scale of NBG1 Screen display
              * @param scl Fixed Point X an Y scaling values
              * @note The minimum scale that can be displayed is determined by The Scale Limit, Scaling values
              * lower than the minimum will be clamped to the minimum
              */
-            static void SetScale(Math::Vector2D& scl) { slScrScaleNbg1(scl.X.RawValue(), scl.Y.RawValue()); }
+            static void SetScale(Math::Vector2D& scl) { VDP2::Shadow::SetScale(1, scl.X.RawValue(), scl.Y.RawValue()); }
+
+            /** @brief Sets the Scale Limit of NBG1 Screen display
+             * @param limit Smallest scale that can be displayed
+             * @note Lower limits need 2 or 4 times more character reads, which are accounted for by VRAM allocation and cycle pattern
+             * of the following loads, set limit before loading screen data
+             */
+            static void SetScaleLimit(VDP2::ScaleLimit limit)
+            {
+                slZoomModeNbg1((uint16_t)limit);
+                VDP2::CyclePlanner::SetReduction(scnNBG1, limit);
+            }
+
+            /** @brief Sets line scroll table of NBG1
+             * @param table Line scroll table, nullptr to disable line scroll
+             * @note Table buffers are swapped by SRL::Core::Synchronize() after VDP2::ScrollTable::Update()
+             */
+            static void SetLineScroll(VDP2::LineScrollTable* table) { VDP2::LineScrollTable::Attach(1, table); }
+
+            /** @brief Sets vertical cell scroll table of NBG1
+             * @param table Vertical cell scroll table created for NBG1, nullptr to disable vertical cell scroll
+             * @note Table is read through VRAM cycle pattern, which VDP2::CyclePlanner updates when the screen is displayed
+             */
+            static void SetCellScroll(VDP2::CellScrollTable* table) { VDP2::CellScrollTable::Attach(1, table); }
         };
 
         /** @brief  NBG2 interface
@@ -1083,7 +2661,7 @@ namespace SRL
             /** @brief Sets the Screen Position of NBG Scroll Screen
              * @param pos Fixed Point X and Y Screen Position
              */
-            static void SetPosition(Math::Vector2D& pos) { slScrPosNbg2(pos.X.RawValue(), pos.Y.RawValue()); }
+            static void SetPosition(Math::Vector2D& pos) { VDP2::Shadow::SetPosition(2, pos.X.RawValue(), pos.Y.RawValue()); }
         };
 
         /** @brief NBG3 interface
@@ -1120,7 +2698,7 @@ namespace SRL
             /** @brief Sets the Screen Position of NBG Scroll Screen
              * @param pos Fixed Point X and Y  Screen Position
              */
-            static void SetPosition(Math::Vector2D& pos) { slScrPosNbg3(pos.X.RawValue(), pos.Y.RawValue()); }
+            static void SetPosition(Math::Vector2D& pos) { VDP2::Shadow::SetPosition(3, pos.X.RawValue(), pos.Y.RawValue()); }
         };
 
         /** @brief setting for RBG0,1 rotation constraints
@@ -1144,6 +2722,316 @@ namespace SRL
             ThreeAxis,
         };
 
+        /** @brief Double buffered per line coefficient table of RBG0 for perspective floors
+         * @details Each line gets scale coefficient Height / (line - Horizon), lines at and above the horizon are transparent.
+         * Reciprocals of line distances are computed once, so a line costs one multiplication, and only lines whose coefficient differs
+         * from the one already in the buffer are written to VRAM. Update() fills the buffer that is not displayed, optionally on the slave SH2,
+         * and the buffers are swapped in the following v-blank, together with the coefficient addresses of RBG0 rotation parameters.
+         * Rotation and position of the floor are still set with VDP2::RBG0::SetCurrentTransform().
+         * @code {.cpp}
+         * SRL::VDP2::CoefficientTable floor;
+         * SRL::VDP2::RBG0::SetCoefficientTable(&floor);
+         *
+         * while (1)
+         * {
+         *     floor.Update(height, horizon, true);
+         *     SRL::VDP2::RBG0::SetCurrentTransform();
+         *     SRL::Core::Synchronize();
+         * }
+         * @endcode
+         * @note Table takes a whole empty VRAM bank, its VRAM is only released by VDP2::ClearVRAM()
+         */
+        class CoefficientTable : public SRL::Types::ITask
+        {
+        private:
+
+            /** @brief Coefficient of transparent line
+             */
+            static constexpr int32_t Transparent = (int32_t)0x80000000;
+
+            /** @brief Mirror value that never matches a coefficient
+             */
+            static constexpr int32_t Unknown = 0x7f000000;
+
+            /** @brief Largest coefficient (signed 8.16 fixed point)
+             */
+            static constexpr int64_t MaxCoefficient = 0x7fffff;
+
+            /** @brief Buffers in VRAM
+             */
+            int32_t* buffers[2];
+
+            /** @brief Copies of buffer contents in work RAM
+             */
+            int32_t* mirrors[2];
+
+            /** @brief Reciprocals of line distances 1 to 2 * lines (2.30 fixed point)
+             */
+            uint32_t* reciprocals;
+
+            /** @brief Number of lines
+             */
+            uint16_t lines;
+
+            /** @brief Index of buffer written by generator
+             */
+            uint8_t back;
+
+            /** @brief Value indicating whether back buffer was generated since last swap
+             */
+            volatile bool generated;
+
+            /** @brief Value indicating whether generator was started on slave SH2
+             */
+            volatile bool dispatched;
+
+            /** @brief Camera height of the generation in progress
+             */
+            int32_t height;
+
+            /** @brief Horizon line of the generation in progress
+             */
+            int16_t horizon;
+
+            /** @brief Camera heights each buffer was generated for
+             */
+            int32_t heights[2];
+
+            /** @brief Horizon lines each buffer was generated for
+             */
+            int16_t horizons[2];
+
+            /** @brief Number of lines written by last generation
+             */
+            uint16_t written;
+
+            /** @brief Fill back buffer, only changed lines are written
+             */
+            void Generate()
+            {
+                const uint8_t back = this->back;
+                this->written = 0;
+
+                if (this->heights[back] == this->height && this->horizons[back] == this->horizon) return;
+
+                int32_t* vram = this->buffers[back];
+                int32_t* mirror = this->mirrors[back];
+
+                for (uint16_t line = 0; line < this->lines; line++)
+                {
+                    const int32_t distance = (int32_t)line - this->horizon;
+                    int32_t value = CoefficientTable::Transparent;
+
+                    if (distance > 0)
+                    {
+                        int64_t scaled = ((int64_t)this->height * this->reciprocals[distance - 1]) >> 30;
+
+                        if (scaled > CoefficientTable::MaxCoefficient) scaled = CoefficientTable::MaxCoefficient;
+                        else if (scaled < -CoefficientTable::MaxCoefficient) scaled = -CoefficientTable::MaxCoefficient;
+
+                        value = (int32_t)scaled & 0x00ffffff;
+                    }
+
+                    if (mirror[line] != value)
+                    {
+                        vram[line] = value;
+                        mirror[line] = value;
+                        this->written++;
+                    }
+                }
+
+                this->heights[back] = this->height;
+                this->horizons[back] = this->horizon;
+            }
+
+        protected:
+
+            /** @brief Fill back buffer on the slave SH2
+             */
+            void Do() override
+            {
+                // Slave cache might hold buffer copies from the previous frame
+                slCashPurge();
+                this->Generate();
+            }
+
+        public:
+
+            /** @brief Create coefficient table covering the screen height
+             */
+            CoefficientTable() :
+                reciprocals(nullptr),
+                lines(SRL::TV::Height),
+                back(1),
+                generated(false),
+                dispatched(false),
+                height(0),
+                horizon(0),
+                written(0)
+            {
+                const VDP2::VramBank banks[3] = { VramBank::B0, VramBank::A1, VramBank::A0 };
+                void* alloc = nullptr;
+
+                // RAMCTL hands whole banks to coefficient reads, so the table reserves an empty bank for itself
+                for (uint8_t index = 0; index < 3 && alloc == nullptr; index++)
+                {
+                    alloc = VRAM::Allocate(this->lines << 3, 0x20000, banks[index], 8);
+                }
+
+                this->buffers[0] = (int32_t*)alloc;
+                this->buffers[1] = alloc != nullptr ? (int32_t*)alloc + this->lines : nullptr;
+                this->mirrors[0] = nullptr;
+                this->mirrors[1] = nullptr;
+
+                if (alloc == nullptr)
+                {
+                    SRL::Debug::Assert("Coefficient Table Allocation failed: insufficient VRAM");
+                    return;
+                }
+
+                this->mirrors[0] = new int32_t[this->lines << 1];
+                this->mirrors[1] = this->mirrors[0] + this->lines;
+                this->reciprocals = new uint32_t[this->lines << 1];
+
+                for (uint16_t distance = 1; distance <= (this->lines << 1); distance++)
+                {
+                    this->reciprocals[distance - 1] = (uint32_t)(0x40000000 / distance);
+                }
+
+                // Start with transparent screen
+                for (uint16_t line = 0; line < this->lines; line++)
+                {
+                    for (uint8_t buffer = 0; buffer < 2; buffer++)
+                    {
+                        this->buffers[buffer][line] = CoefficientTable::Transparent;
+                        this->mirrors[buffer][line] = CoefficientTable::Transparent;
+                    }
+                }
+
+                this->heights[0] = this->heights[1] = 0;
+                this->horizons[0] = this->horizons[1] = this->lines;
+            }
+
+            /** @brief Destroy coefficient table, RBG0 stops using it if it is attached
+             */
+            ~CoefficientTable();
+
+            /** @brief Generate table for next frame
+             * @details Lines keep their coefficients when pose did not change since the buffer was last generated.
+             * @param height Camera height above the floor, larger values show the floor further away
+             * @param horizon Screen line of the horizon, can be negative or below the screen
+             * @param onSlave Run the generator on the slave SH2, buffers are swapped in the v-blank after it finishes
+             */
+            void Update(const Math::Types::Fxp& height, const int16_t horizon, const bool onSlave = false)
+            {
+                this->Wait();
+
+                if (this->buffers[0] == nullptr) return;
+
+                // Generation not swapped yet is replaced, so v-blank does not swap a buffer being written
+                this->generated = false;
+                this->height = height.RawValue();
+                this->horizon = horizon < -(int16_t)this->lines ? -(int16_t)this->lines : (horizon > (int16_t)this->lines ? this->lines : horizon);
+
+                if (onSlave)
+                {
+                    this->dispatched = true;
+                    SRL::Slave::ExecuteOnSlave(*this);
+                }
+                else
+                {
+                    this->Generate();
+                }
+
+                this->generated = true;
+            }
+
+            /** @brief Wait for generator running on the slave SH2 to finish
+             */
+            void Wait()
+            {
+                if (this->dispatched)
+                {
+                    while (!this->IsDone())
+                    {
+                        // Wait for slave
+                    }
+
+                    // Master cache might hold buffer copies from before the update
+                    slCashPurge();
+                    this->dispatched = false;
+                }
+            }
+
+            /** @brief Force next generations to write all lines of both buffers
+             */
+            void Invalidate()
+            {
+                this->Wait();
+
+                if (this->mirrors[0] == nullptr) return;
+
+                for (uint16_t line = 0; line < (this->lines << 1); line++)
+                {
+                    this->mirrors[0][line] = CoefficientTable::Unknown;
+                }
+
+                this->horizons[0] = this->horizons[1] = INT16_MIN;
+            }
+
+            /** @brief Swap buffers if a generation finished, called by VDP2::RBG0 in v-blank
+             * @return True if buffers were swapped
+             */
+            bool Swap()
+            {
+                if (!this->generated || (this->dispatched && !this->IsDone())) return false;
+
+                this->back ^= 1;
+                this->generated = false;
+                return true;
+            }
+
+            /** @brief Get VRAM address of the table
+             * @return Address of the first buffer, start of the bank
+             */
+            void* GetAddress() const
+            {
+                return this->buffers[0];
+            }
+
+            /** @brief Get index of the first coefficient of the displayed buffer
+             * @return Coefficient index from table address
+             */
+            uint16_t GetFrontOffset() const
+            {
+                return (this->back ^ 1) * this->lines;
+            }
+
+            /** @brief Get displayed buffer
+             * @return VRAM address of the buffer
+             */
+            int32_t* GetFront() const
+            {
+                return this->buffers[this->back ^ 1];
+            }
+
+            /** @brief Get number of lines
+             * @return Number of coefficients in one buffer
+             */
+            uint16_t GetLineCount() const
+            {
+                return this->lines;
+            }
+
+            /** @brief Get number of lines written by last generation
+             * @return Number of written lines
+             */
+            uint16_t GetWrittenLines() const
+            {
+                return this->written;
+            }
+        };
+
         /** @brief RBG0 interface
          * @details Rotating Background Scroll 0:
          *      -Available color depths: Paletted16, Paletted256, RBG555
@@ -1159,6 +3047,18 @@ namespace SRL
              */
             inline static void* KtableAddress = (void*)(VDP2_VRAM_A0 - 1);
 
+        private:
+
+            /** @brief Generated coefficient table in use
+             */
+            inline static VDP2::CoefficientTable* coefficients = nullptr;
+
+            /** @brief Coefficient start address of the attached table, same as computed by slKtableRA()
+             */
+            inline static uint32_t coefficientStart = 0;
+
+        public:
+
             /** @brief Initializes the ScrollScreen's tilemap specifications
              * @param info Tile map info
              */
@@ -1243,6 +3143,52 @@ namespace SRL
                 }
             }
 
+            /** @brief Use generated per line coefficient table instead of the one selected by SetRotationMode()
+             * @param table Coefficient table, nullptr to disable coefficients
+             * @note Coefficient addresses of rotation parameters are written in every v-blank, after SGL sent the parameters set
+             * by SetCurrentTransform()
+             */
+            inline static void SetCoefficientTable(VDP2::CoefficientTable* table)
+            {
+                VDP2::RBG0::coefficients = table;
+
+                if (table != nullptr && table->GetAddress() != nullptr)
+                {
+                    // In 2 word mode KTAOF selects 0x40000 byte half of VRAM, start counts 4 byte coefficients within it
+                    VDP2::RBG0::KtableAddress = table->GetAddress();
+                    VDP2::RBG0::coefficientStart = (((uint32_t)table->GetAddress() - VDP2_VRAM_A0) & 0x3ffff) << 14;
+                    slKtableRA(table->GetAddress(), K_FIX | K_LINE | K_MODE0 | K_2WORD | K_ON);
+                }
+                else
+                {
+                    VDP2::RBG0::coefficients = nullptr;
+                    slKtableRA(nullptr, K_OFF);
+                }
+            }
+
+            /** @brief Get generated coefficient table in use
+             * @return Coefficient table or nullptr
+             */
+            inline static VDP2::CoefficientTable* GetCoefficientTable()
+            {
+                return VDP2::RBG0::coefficients;
+            }
+
+            /** @brief Swap generated coefficient table and point rotation parameters to the displayed buffer, called by SRL::Core in v-blank
+             */
+            inline static void VblankRefresh()
+            {
+                if (VDP2::RBG0::coefficients == nullptr) return;
+
+                VDP2::RBG0::coefficients->Swap();
+
+                // Parameter table set by slRparaInitSet() in VDP2::Initialize(), one coefficient per line
+                ROTSCROLL* parameters = (ROTSCROLL*)(VDP2_VRAM_B1 + 0x1ff00);
+                parameters->KAST = VDP2::RBG0::coefficientStart + ((uint32_t)VDP2::RBG0::coefficients->GetFrontOffset() << 16);
+                parameters->DKAST = 1 << 16;
+                parameters->DKA = 0;
+            }
+
             /** @brief Writes the current matrix transform to RBG0RA Rotation parameters
              * to update its position and perspective
              */
@@ -1334,7 +3280,7 @@ namespace SRL
             inline static void ColorCalcON()
             {
                 VDP2::ColorCalcScrolls |= SPRON;
-                slColorCalcOn(VDP2::ColorCalcScrolls);
+                VDP2::Shadow::SetColorCalc(VDP2::ColorCalcScrolls);
             }
 
             /** @brief Turns VDP2 Color Calculation Off for Sprite Layer
@@ -1342,7 +3288,7 @@ namespace SRL
             inline static void ColorCalcOFF()
             {
                 VDP2::ColorCalcScrolls &= (~SPRON);
-                slColorCalcOn(VDP2::ColorCalcScrolls);
+                VDP2::Shadow::SetColorCalc(VDP2::ColorCalcScrolls);
             }
 
             /** @brief Set the opacities that sprites can select from in CC registers
@@ -1367,7 +3313,7 @@ namespace SRL
                 }
                 else
                 {
-                    slColRate((int16_t)bank, 31 - (uint16_t)(opacity.RawValue() >> 11));
+                    VDP2::Shadow::SetColorRate((int16_t)bank, 31 - (uint16_t)(opacity.RawValue() >> 11));
                 }
             }
 
@@ -1383,7 +3329,7 @@ namespace SRL
              */
             inline static void SetPriority(SRL::VDP2::Priority pr, VDP2::SpriteBank bank = VDP2::SpriteBank::Bank0)
             {
-                slPriority((int16_t)bank, (uint16_t)pr);
+                VDP2::Shadow::SetPriority((int16_t)bank, (uint16_t)pr);
             }
 
             /** @brief Set conditions under which VDP2 color calculation is performed on sprites based on their priority.
@@ -1410,6 +3356,12 @@ namespace SRL
          */
         inline static void ClearVRAM()
         {
+            // Scroll tables are in VRAM too
+            VDP2::NBG0::SetLineScroll(nullptr);
+            VDP2::NBG1::SetLineScroll(nullptr);
+            VDP2::NBG0::SetCellScroll(nullptr);
+            VDP2::NBG1::SetCellScroll(nullptr);
+
             //reset ScrollScreen VRAM References
             VDP2::NBG0::MapAddress = (void*)(VDP2_VRAM_A0 - 1);
             VDP2::NBG0::CellAddress = (void*)(VDP2_VRAM_A0 - 1);
@@ -1449,6 +3401,7 @@ namespace SRL
                 VDP2::NBG3::TilePalette = SRL::CRAM::Palette();
             }
 
+            VDP2::RBG0::SetCoefficientTable(nullptr);
             VDP2::RBG0::MapAddress = (void*)(VDP2_VRAM_A0 - 1);
             VDP2::RBG0::CellAddress = (void*)(VDP2_VRAM_A0 - 1);
             VDP2::RBG0::KtableAddress = (void*)(VDP2_VRAM_A0 - 1);
@@ -1464,12 +3417,11 @@ namespace SRL
             {
                 VDP2::VRAM::currentTop[i] = VDP2::VRAM::bankTop[i];
                 VDP2::VRAM::currentBot[i] = VDP2::VRAM::bankBot[i];
-                VDP2::VRAM::bankCycles[i] = -1;
             }
             // Clear Rotation control bits of VDP2_RAMCTL 
             VDP2_RAMCTL &= 0xff00;
-            //leave cylces reserved for ASCII 
-            VDP2::VRAM::bankCycles[3] = 1;
+            // Leave cycles reserved for ASCII 
+            VDP2::CyclePlanner::Reset();
         }
 
         /** @brief Set the back color
@@ -1625,7 +3577,7 @@ namespace SRL
          */
         static void SetColorOffsetA(VDP2::ColorOffset & offset) //int16_t red, int16_t green, int16_t blue)
         {
-            slColOffsetA(offset.Red, offset.Green, offset.Blue);
+            VDP2::Shadow::SetColorOffset(0, offset.Red, offset.Green, offset.Blue);
         }
 
         /** @brief Sets RGB color channel offset B
@@ -1637,7 +3589,7 @@ namespace SRL
          */
         static void SetColorOffsetB(VDP2::ColorOffset & offset) 
         {
-            slColOffsetB(offset.Red, offset.Green, offset.Blue);
+            VDP2::Shadow::SetColorOffset(1, offset.Red, offset.Green, offset.Blue);
         }
 
         /** @brief Basic Options for behavior of VDP2 Half Transparent Color Calculation
@@ -1671,4 +3623,20 @@ namespace SRL
             slColorCalc((uint16_t)flags);
         }
     };
+
+    /** @brief Coefficient table destructor definition, needs VDP2::RBG0
+     */
+    inline VDP2::CoefficientTable::~CoefficientTable()
+    {
+        this->Wait();
+
+        // V-blank must not swap a freed table
+        if (VDP2::RBG0::GetCoefficientTable() == this)
+        {
+            VDP2::RBG0::SetCoefficientTable(nullptr);
+        }
+
+        delete[] this->mirrors[0];
+        delete[] this->reciprocals;
+    }
 }
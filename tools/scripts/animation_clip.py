@@ -0,0 +1,61 @@
+import json
+import struct
+import argparse
+
+# Writes rigid bone animation clips read by SRL::Types::AnimationClip
+#
+# Input is a JSON file in following format, angles are in degrees:
+# {
+#     "bones": 2,
+#     "keyframes": [
+#         [ { "rotation": [0, 0, 0], "translation": [0, 0, 0] }, { "rotation": [0, 45, 0] } ],
+#         [ { "rotation": [0, 90, 0] }, { "rotation": [0, 0, 0], "translation": [0, -2.5, 0] } ]
+#     ]
+# }
+
+def angle_to_raw(degrees):
+    return int(round(degrees * 65536.0 / 360.0)) & 0xffff
+
+def translation_to_raw(value):
+    raw = int(round(value * 16.0))
+
+    if raw < -32768 or raw > 32767:
+        raise ValueError("Translation {} does not fit into 12.4 fixed point".format(value))
+
+    return raw
+
+def write_clip(clip, output_file):
+    bones = clip["bones"]
+    keyframes = clip["keyframes"]
+
+    with open(output_file, 'wb') as file:
+        file.write(struct.pack(">HH", bones, len(keyframes)))
+
+        for index, keyframe in enumerate(keyframes):
+            if len(keyframe) != bones:
+                raise ValueError("Keyframe {} has {} bones, expected {}".format(index, len(keyframe), bones))
+
+            for key in keyframe:
+                rotation = key.get("rotation", [0, 0, 0])
+                translation = key.get("translation", [0, 0, 0])
+                file.write(struct.pack(">HHH", *[angle_to_raw(value) for value in rotation]))
+                file.write(struct.pack(">hhh", *[translation_to_raw(value) for value in translation]))
+
+    return 4 + (len(keyframes) * bones * 12)
+
+def main():
+    # Set up argument parser
+    parser = argparse.ArgumentParser(description="Convert JSON animation description to SRL animation clip.")
+    parser.add_argument("input_file", help="Path to the JSON clip description")
+    parser.add_argument("output_file", help="Path to the output clip file")
+
+    args = parser.parse_args()
+
+    with open(args.input_file, 'r') as file:
+        clip = json.load(file)
+
+    size = write_clip(clip, args.output_file)
+    print("Clip written to {} ({} bones, {} keyframes, {} bytes)".format(args.output_file, clip["bones"], len(clip["keyframes"]), size))
+
+if __name__ == "__main__":
+    main()
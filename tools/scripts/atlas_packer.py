@@ -0,0 +1,181 @@
+import argparse
+import struct
+
+# Packs true color .TGA images into a single RGB555 texture atlas read by SRL::Types::TextureAtlas.
+# Images are placed with shelf packing, pixel data is written in the same layout as in the sprite VRAM,
+# so the whole atlas is uploaded with a single DMA transfer. All values are written big-endian.
+
+HEADER_SIZE = 24
+REGION_SIZE = 8
+
+# Atlas width must be multiple of 16 and horizontal position of every image is aligned to 4 pixels, same as in SRL::Types::TextureAtlas
+WIDTH_ALIGNMENT = 16
+POSITION_ALIGNMENT = 4
+MAX_WIDTH = 496
+MAX_HEIGHT = 255
+
+# SRL::CRAM::TextureColorMode::RGB555
+COLOR_MODE_RGB555 = 1
+
+OPAQUE = 0x8000
+
+def align(value, alignment):
+    return (value + alignment - 1) & ~(alignment - 1)
+
+def to_rgb555(red, green, blue):
+    return OPAQUE | ((blue >> 3) << 10) | ((green >> 3) << 5) | (red >> 3)
+
+def read_tga(path, transparent):
+    with open(path, 'rb') as file:
+        data = file.read()
+
+    id_length, color_map_type, image_type = struct.unpack_from("<BBB", data, 0)
+    width, height, depth, descriptor = struct.unpack_from("<HHBB", data, 12)
+
+    if color_map_type != 0 or image_type not in (2, 10) or depth not in (16, 24, 32):
+        raise ValueError("{}: only uncompressed or RLE true color images are supported".format(path))
+
+    offset = 18 + id_length
+    pixel_size = depth // 8
+    raw = []
+
+    # Decode pixels to (red, green, blue, alpha)
+    def decode(position):
+        if depth == 16:
+            value = struct.unpack_from("<H", data, position)[0]
+            return (((value >> 10) & 0x1f) << 3, ((value >> 5) & 0x1f) << 3, (value & 0x1f) << 3, 255 if value & 0x8000 else 0)
+
+        alpha = data[position + 3] if depth == 32 else 255
+        return (data[position + 2], data[position + 1], data[position], alpha)
+
+    while len(raw) < width * height:
+        if image_type == 2:
+            raw.append(decode(offset))
+            offset += pixel_size
+            continue
+
+        packet = data[offset]
+        offset += 1
+        count = (packet & 0x7f) + 1
+
+        if packet & 0x80:
+            raw.extend([decode(offset)] * count)
+            offset += pixel_size
+        else:
+            for _ in range(count):
+                raw.append(decode(offset))
+                offset += pixel_size
+
+    # Origin is bottom left unless descriptor says otherwise
+    rows = [raw[row * width:(row + 1) * width] for row in range(height)]
+
+    if not descriptor & 0x20:
+        rows.reverse()
+
+    if descriptor & 0x10:
+        rows = [list(reversed(row)) for row in rows]
+
+    pixels = []
+
+    for row in rows:
+        for red, green, blue, alpha in row:
+            if alpha < 128 or (transparent is not None and (red, green, blue) == transparent):
+                pixels.append(0)
+            else:
+                pixels.append(to_rgb555(red, green, blue))
+
+    return width, height, pixels
+
+def pack(images, width, height):
+    # Taller images first, so shelves are filled with images of similar height
+    order = sorted(range(len(images)), key=lambda index: (-images[index][1], -images[index][0]))
+    shelves = []
+    placement = [None] * len(images)
+
+    for index in order:
+        image_width, image_height = images[index][0], images[index][1]
+        aligned_width = align(image_width, POSITION_ALIGNMENT)
+        best = None
+
+        for shelf in shelves:
+            if shelf[1] >= image_height and width - shelf[2] >= aligned_width:
+                if best is None or shelf[1] < best[1]:
+                    best = shelf
+
+        if best is None:
+            top = shelves[-1][0] + shelves[-1][1] if shelves else 0
+
+            if top + image_height > height or aligned_width > width:
+                return None
+
+            best = [top, image_height, 0]
+            shelves.append(best)
+
+        placement[index] = (best[2], best[0])
+        best[2] += aligned_width
+
+    used_height = shelves[-1][0] + shelves[-1][1] if shelves else 0
+    return placement, used_height
+
+def write_atlas(path, width, height, images, placement):
+    pixels = [0] * (width * height)
+
+    for (image_width, image_height, data), (x, y) in zip(images, placement):
+        for row in range(image_height):
+            start = ((y + row) * width) + x
+            pixels[start:start + image_width] = data[row * image_width:(row + 1) * image_width]
+
+    region_offset = HEADER_SIZE
+    data_offset = align(region_offset + (len(images) * REGION_SIZE), 4)
+
+    with open(path, 'wb') as file:
+        file.write(struct.pack(">4sHHHHHHII", b"SRLA", 1, COLOR_MODE_RGB555, width, height, len(images), 0, region_offset, data_offset))
+
+        for (image_width, image_height, _), (x, y) in zip(images, placement):
+            file.write(struct.pack(">HHHH", x, y, image_width, image_height))
+
+        file.write(bytes(data_offset - region_offset - (len(images) * REGION_SIZE)))
+        file.write(struct.pack(">{}H".format(len(pixels)), *pixels))
+
+    return data_offset + (len(pixels) * 2)
+
+def main():
+    # Set up argument parser
+    parser = argparse.ArgumentParser(description="Pack .TGA images into SRL texture atlas file.")
+    parser.add_argument("output_file", help="Path to the output atlas file")
+    parser.add_argument("input_files", nargs="+", help="Paths to the .TGA images, region indexes follow their order")
+    parser.add_argument("--width", type=int, default=256, help="Atlas width, rounded up to multiple of 16 (at most 496)")
+    parser.add_argument("--height", type=int, default=0, help="Atlas height (at most 255), 0 uses only as many rows as needed")
+    parser.add_argument("--transparent", default=None, help="Color written as transparent, as RRGGBB hex value")
+
+    args = parser.parse_args()
+
+    width = align(args.width, WIDTH_ALIGNMENT)
+    height = args.height if args.height > 0 else MAX_HEIGHT
+    transparent = None
+
+    if args.transparent is not None:
+        value = int(args.transparent, 16)
+        transparent = ((value >> 16) & 0xff, (value >> 8) & 0xff, value & 0xff)
+
+    if width > MAX_WIDTH or height > MAX_HEIGHT:
+        parser.error("Atlas can be at most {}x{} pixels".format(MAX_WIDTH, MAX_HEIGHT))
+
+    images = [read_tga(path, transparent) for path in args.input_files]
+    result = pack([(image[0], image[1]) for image in images], width, height)
+
+    if result is None:
+        parser.error("Images do not fit into {}x{} atlas".format(width, height))
+
+    placement, used_height = result
+
+    if args.height == 0:
+        height = used_height
+
+    size = write_atlas(args.output_file, width, height, images, placement)
+    used = sum(image[0] * image[1] for image in images)
+    print("Atlas written to {} ({}x{}, {} images, {}% used, {} bytes)".format(
+        args.output_file, width, height, len(images), (used * 100) // max(width * height, 1), size))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,280 @@
+import struct
+import argparse
+
+# Converts .NYA models (see https://github.com/ReyeMe/ModelConverter-linux) into memory-mappable
+# model files read by SRL::Types::Model. All values are written big-endian with 4 byte pointers,
+# same as they are laid out in the Saturn memory.
+
+# SGL constants used to build face attributes
+SORT_CEN = 3
+CL32KRGB = 5 << 3
+CL_HALF = 2
+CL_TRANS = 3
+CL_GOURAUD = 4
+MESH_ON = 1 << 8
+USE_LIGHT = 1 << 3
+USE_GOURAUD = 1 << 7
+ECDIS = 1 << 7
+SPDIS = 1 << 6
+USE_TEXTURE = 1 << 2
+FUNC_TEXTURE = 2
+FUNC_POLYGON = 4
+FUNC_POLYLINE = 5
+GOURAUD_TABLE = 0xe000
+
+# Layout of SRL::Types::Model::Header
+HEADER_FORMAT = ">4sHHIIIIII"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+VECTOR_SIZE = 12
+POLYGON_SIZE = 20
+ATTRIBUTE_SIZE = 12
+TEXTURE_ENTRY_SIZE = 8
+
+class Attribute:
+    def __init__(self, flags, extra, color, texture):
+        self.has_texture = (flags >> 7) & 1
+        self.has_mesh_effect = (flags >> 6) & 1
+        self.is_double_sided = (flags >> 5) & 1
+        self.has_transparency = (flags >> 4) & 1
+        self.has_flat_shading = (flags >> 3) & 1
+        self.has_half_brightness = (flags >> 2) & 1
+        self.sort_mode = flags & 3
+        self.is_wireframe = (extra >> 7) & 1
+        self.no_light = (extra >> 6) & 1
+        self.color = color
+        self.texture = texture
+
+    def key(self):
+        return (self.has_texture, self.has_mesh_effect, self.is_double_sided, self.has_transparency,
+                self.has_flat_shading, self.has_half_brightness, self.sort_mode, self.is_wireframe,
+                self.no_light, self.color, self.texture)
+
+    def pack_nya(self):
+        flags = (self.has_texture << 7) | (self.has_mesh_effect << 6) | (self.is_double_sided << 5) | \
+            (self.has_transparency << 4) | (self.has_flat_shading << 3) | (self.has_half_brightness << 2) | self.sort_mode
+        extra = (self.is_wireframe << 7) | (self.no_light << 6)
+        return struct.pack(">BBHi", flags, extra, self.color, self.texture)
+
+    def pack_srl(self, smooth, gouraud):
+        # Same as SRL::Types::Attribute constructor used by the .NYA loader in the samples
+        if self.is_wireframe:
+            kind = FUNC_POLYLINE | ((ECDIS | SPDIS) << 24)
+        elif self.has_texture:
+            kind = FUNC_TEXTURE | (USE_TEXTURE << 16)
+        else:
+            kind = FUNC_POLYGON | ((ECDIS | SPDIS) << 24)
+
+        gouraud_shaded = smooth and not self.has_flat_shading
+        mode = CL32KRGB
+        mode |= MESH_ON if self.has_mesh_effect else 0
+        mode |= CL_GOURAUD if gouraud_shaded else 0
+        mode |= CL_TRANS if self.has_transparency else 0
+        mode |= CL_HALF if self.has_half_brightness else 0
+
+        if self.no_light:
+            option = 0
+        elif gouraud_shaded:
+            option = USE_GOURAUD
+        else:
+            option = USE_LIGHT
+
+        sort = (SORT_CEN - self.sort_mode) | ((kind >> 16) & 0x1c) | option
+        display = mode | ((kind >> 24) & 0xc0)
+        texture = self.texture if self.has_texture else 0
+        color = 0 if self.has_texture else self.color
+        gouraud_address = GOURAUD_TABLE + gouraud if gouraud_shaded else CL32KRGB
+        return struct.pack(">BBHHHHH", self.is_double_sided, sort & 0xff, texture, display, color, gouraud_address, kind & 0x3f)
+
+class Mesh:
+    def __init__(self):
+        self.points = []
+        self.faces = []
+        self.attributes = []
+        self.normals = None
+
+class Model:
+    def __init__(self, smooth):
+        self.smooth = smooth
+        self.meshes = []
+        self.textures = []
+
+def read_nya(path):
+    with open(path, 'rb') as file:
+        data = file.read()
+
+    offset = 0
+
+    def read(fmt):
+        nonlocal offset
+        values = struct.unpack_from(fmt, data, offset)
+        offset += struct.calcsize(fmt)
+        return values
+
+    model_type, mesh_count, texture_count = read(">III")
+    model = Model(model_type == 1)
+
+    for _ in range(mesh_count):
+        mesh = Mesh()
+        point_count, polygon_count = read(">II")
+        mesh.points = [read(">iii") for _ in range(point_count)]
+
+        for _ in range(polygon_count):
+            values = read(">iiiHHHH")
+            mesh.faces.append((values[0:3], list(values[3:7])))
+
+        mesh.attributes = [Attribute(*read(">BBHi")) for _ in range(polygon_count)]
+
+        if model.smooth:
+            mesh.normals = [read(">iii") for _ in range(point_count)]
+
+        model.meshes.append(mesh)
+
+    for _ in range(texture_count):
+        width, height = read(">HH")
+        model.textures.append((width, height, data[offset:offset + (width * height * 2)]))
+        offset += width * height * 2
+
+    return model
+
+def write_nya(model, path):
+    with open(path, 'wb') as file:
+        file.write(struct.pack(">III", 1 if model.smooth else 0, len(model.meshes), len(model.textures)))
+
+        for mesh in model.meshes:
+            file.write(struct.pack(">II", len(mesh.points), len(mesh.faces)))
+
+            for point in mesh.points:
+                file.write(struct.pack(">iii", *point))
+
+            for normal, vertices in mesh.faces:
+                file.write(struct.pack(">iiiHHHH", *normal, *vertices))
+
+            for attribute in mesh.attributes:
+                file.write(attribute.pack_nya())
+
+            if model.smooth:
+                for normal in mesh.normals:
+                    file.write(struct.pack(">iii", *normal))
+
+        for width, height, pixels in model.textures:
+            file.write(struct.pack(">HH", width, height))
+            file.write(pixels)
+
+def align(value):
+    return (value + 3) & ~3
+
+def write_srlm(model, path):
+    mesh_entry_size = 24 if model.smooth else 20
+    offset = HEADER_SIZE + (len(model.meshes) * mesh_entry_size)
+    mesh_table = bytearray()
+    mesh_data = bytearray()
+    gouraud = 0
+
+    for mesh in model.meshes:
+        vertex_offset = offset + len(mesh_data)
+        for point in mesh.points:
+            mesh_data += struct.pack(">iii", *point)
+
+        face_offset = offset + len(mesh_data)
+        for normal, vertices in mesh.faces:
+            mesh_data += struct.pack(">iiiHHHH", *normal, *vertices)
+
+        attribute_offset = offset + len(mesh_data)
+        for attribute in mesh.attributes:
+            mesh_data += attribute.pack_srl(model.smooth, gouraud)
+
+            # Every face of smooth model reserves one gouraud table entry
+            if model.smooth:
+                gouraud += 1
+
+        mesh_table += struct.pack(">IIIII", vertex_offset, len(mesh.points), face_offset, len(mesh.faces), attribute_offset)
+
+        if model.smooth:
+            normal_offset = offset + len(mesh_data)
+            for normal in mesh.normals:
+                mesh_data += struct.pack(">iii", *normal)
+
+            mesh_table += struct.pack(">I", normal_offset)
+
+    texture_offset = offset + len(mesh_data)
+    texture_data_offset = texture_offset + (len(model.textures) * TEXTURE_ENTRY_SIZE)
+    texture_table = bytearray()
+    texture_data = bytearray()
+
+    for width, height, pixels in model.textures:
+        texture_table += struct.pack(">HHI", width, height, texture_data_offset + len(texture_data))
+        texture_data += pixels
+        texture_data += bytes(align(len(texture_data)) - len(texture_data))
+
+    header = struct.pack(HEADER_FORMAT, b"SRLM", 1, 1 if model.smooth else 0, len(model.meshes), len(model.textures),
+                         gouraud, HEADER_SIZE, texture_offset, 0)
+
+    with open(path, 'wb') as file:
+        file.write(header)
+        file.write(mesh_table)
+        file.write(mesh_data)
+        file.write(texture_table)
+        file.write(texture_data)
+
+    return len(header) + len(mesh_table) + len(mesh_data) + len(texture_table) + len(texture_data)
+
+def verify_srlm(path):
+    """Read written model back the same way SRL::Types::Model maps it, raises ValueError on mismatch"""
+    with open(path, 'rb') as file:
+        data = file.read()
+
+    if len(data) < HEADER_SIZE:
+        raise ValueError("Model file is shorter than its header")
+
+    magic, version, smooth, mesh_count, texture_count, gouraud, mesh_offset, texture_offset, gouraud_offset = struct.unpack_from(HEADER_FORMAT, data, 0)
+
+    if magic != b"SRLM" or version != 1:
+        raise ValueError("Unsupported model header")
+
+    if mesh_offset != HEADER_SIZE:
+        raise ValueError("Mesh table at {} does not follow the {} byte header".format(mesh_offset, HEADER_SIZE))
+
+    def check(name, start, size):
+        if start < HEADER_SIZE or start + size > len(data):
+            raise ValueError("{} at {} ({} bytes) is outside of the {} byte file".format(name, start, size, len(data)))
+
+    mesh_entry_format = ">IIIIII" if smooth else ">IIIII"
+    mesh_entry_size = struct.calcsize(mesh_entry_format)
+    check("Mesh table", mesh_offset, mesh_count * mesh_entry_size)
+
+    for mesh in range(mesh_count):
+        entry = struct.unpack_from(mesh_entry_format, data, mesh_offset + (mesh * mesh_entry_size))
+        vertex_offset, vertex_count, face_offset, face_count, attribute_offset = entry[:5]
+        check("Vertices of mesh {}".format(mesh), vertex_offset, vertex_count * VECTOR_SIZE)
+        check("Faces of mesh {}".format(mesh), face_offset, face_count * POLYGON_SIZE)
+        check("Attributes of mesh {}".format(mesh), attribute_offset, face_count * ATTRIBUTE_SIZE)
+
+        if smooth:
+            check("Normals of mesh {}".format(mesh), entry[5], vertex_count * VECTOR_SIZE)
+
+    check("Texture table", texture_offset, texture_count * TEXTURE_ENTRY_SIZE)
+
+    for texture in range(texture_count):
+        width, height, data_offset = struct.unpack_from(">HHI", data, texture_offset + (texture * TEXTURE_ENTRY_SIZE))
+        check("Texture {}".format(texture), data_offset, width * height * 2)
+
+    if gouraud_offset != 0:
+        check("Gouraud table", gouraud_offset, gouraud * 8)
+
+    return mesh_count, texture_count
+
+def main():
+    # Set up argument parser
+    parser = argparse.ArgumentParser(description="Convert .NYA model to memory-mappable SRL model file.")
+    parser.add_argument("input_file", help="Path to the .NYA model")
+    parser.add_argument("output_file", help="Path to the output model file")
+
+    args = parser.parse_args()
+
+    model = read_nya(args.input_file)
+    size = write_srlm(model, args.output_file)
+    verify_srlm(args.output_file)
+    print("Model written to {} ({} meshes, {} textures, {} bytes)".format(args.output_file, len(model.meshes), len(model.textures), size))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,287 @@
+import argparse
+import math
+
+from model_converter import Mesh, read_nya, write_nya, write_srlm, verify_srlm
+
+# Optimizes .NYA models before they are converted for SRL::Types::Model
+#  - welds duplicate vertices
+#  - drops degenerate faces
+#  - merges coplanar triangle pairs into quads (Polygon always has 4 vertices, so a triangle wastes a whole VDP1 command)
+#  - reorders faces and vertices so neighbouring faces are drawn and transformed together
+
+FIXED_ONE = 65536.0
+
+# Sort mode of faces drawn before last drawn face, their order must be kept
+SORT_MODE_BEFORE = 3
+
+def unique_vertices(vertices):
+    result = []
+
+    for vertex in vertices:
+        if vertex not in result:
+            result.append(vertex)
+
+    return result
+
+def weld(mesh, tolerance):
+    remap = []
+    points = []
+    normals = [] if mesh.normals is not None else None
+    lookup = {}
+
+    for index, point in enumerate(mesh.points):
+        # Vertices of smooth meshes can be welded only if their normals match as well
+        key = tuple(value // (tolerance + 1) for value in point)
+
+        if normals is not None:
+            key += tuple(mesh.normals[index])
+
+        if key not in lookup:
+            lookup[key] = len(points)
+            points.append(point)
+
+            if normals is not None:
+                normals.append(mesh.normals[index])
+
+        remap.append(lookup[key])
+
+    mesh.points = points
+    mesh.normals = normals
+    mesh.faces = [(normal, [remap[vertex] for vertex in vertices]) for normal, vertices in mesh.faces]
+
+def area(mesh, vertices):
+    points = [mesh.points[vertex] for vertex in vertices]
+    total = [0.0, 0.0, 0.0]
+
+    for index in range(1, len(points) - 1):
+        a = [points[index][axis] - points[0][axis] for axis in range(3)]
+        b = [points[index + 1][axis] - points[0][axis] for axis in range(3)]
+        total[0] += (a[1] * b[2]) - (a[2] * b[1])
+        total[1] += (a[2] * b[0]) - (a[0] * b[2])
+        total[2] += (a[0] * b[1]) - (a[1] * b[0])
+
+    return math.sqrt(sum(value * value for value in total))
+
+def drop_degenerate(mesh):
+    faces = []
+    attributes = []
+
+    for face, attribute in zip(mesh.faces, mesh.attributes):
+        vertices = unique_vertices(face[1])
+
+        if len(vertices) >= 3 and area(mesh, vertices) > 0.0:
+            faces.append(face)
+            attributes.append(attribute)
+
+    dropped = len(mesh.faces) - len(faces)
+    mesh.faces = faces
+    mesh.attributes = attributes
+    return dropped
+
+def is_convex(mesh, vertices, normal):
+    points = [mesh.points[vertex] for vertex in vertices]
+    sign = 0
+
+    for index in range(4):
+        a = points[index]
+        b = points[(index + 1) % 4]
+        c = points[(index + 2) % 4]
+        ab = [b[axis] - a[axis] for axis in range(3)]
+        bc = [c[axis] - b[axis] for axis in range(3)]
+        cross = [(ab[1] * bc[2]) - (ab[2] * bc[1]), (ab[2] * bc[0]) - (ab[0] * bc[2]), (ab[0] * bc[1]) - (ab[1] * bc[0])]
+        direction = sum(cross[axis] * normal[axis] for axis in range(3))
+
+        if direction == 0:
+            return False
+
+        if sign == 0:
+            sign = 1 if direction > 0 else -1
+        elif (direction > 0) != (sign > 0):
+            return False
+
+    return True
+
+def merge_triangles(mesh, threshold):
+    triangles = {}
+
+    for index, (normal, vertices) in enumerate(mesh.faces):
+        corners = unique_vertices(vertices)
+
+        # Textured faces map whole texture onto the quad, merging them would change the mapping
+        if len(corners) == 3 and not mesh.attributes[index].has_texture:
+            triangles[index] = corners
+
+    edges = {}
+
+    for index, corners in triangles.items():
+        for corner in range(3):
+            edges.setdefault((corners[corner], corners[(corner + 1) % 3]), []).append(index)
+
+    merged = {}
+    removed = set()
+
+    for index, corners in triangles.items():
+        if index in removed or index in merged:
+            continue
+
+        normal = [value / FIXED_ONE for value in mesh.faces[index][0]]
+
+        for corner in range(3):
+            u = corners[corner]
+            v = corners[(corner + 1) % 3]
+            opposite = corners[(corner + 2) % 3]
+
+            # Neighbour must have the same edge in opposite direction
+            for other in edges.get((v, u), []):
+                if other == index or other in removed or other in merged:
+                    continue
+
+                if mesh.attributes[other].key() != mesh.attributes[index].key():
+                    continue
+
+                other_normal = [value / FIXED_ONE for value in mesh.faces[other][0]]
+
+                if sum(normal[axis] * other_normal[axis] for axis in range(3)) < threshold:
+                    continue
+
+                other_opposite = [vertex for vertex in triangles[other] if vertex != u and vertex != v][0]
+                quad = [v, opposite, u, other_opposite]
+
+                if not is_convex(mesh, quad, normal):
+                    continue
+
+                merged[index] = quad
+                removed.add(other)
+                break
+
+            if index in merged:
+                break
+
+    faces = []
+    attributes = []
+
+    for index, (normal, vertices) in enumerate(mesh.faces):
+        if index in removed:
+            continue
+
+        faces.append((normal, merged.get(index, vertices)))
+        attributes.append(mesh.attributes[index])
+
+    mesh.faces = faces
+    mesh.attributes = attributes
+    return len(removed)
+
+def reorder(mesh):
+    # Faces drawn before last drawn face depend on the original order
+    if any(attribute.sort_mode == SORT_MODE_BEFORE for attribute in mesh.attributes):
+        return
+
+    # Walk faces through shared vertices, so consecutive faces reuse transformed vertices
+    users = {}
+
+    for index, (_, vertices) in enumerate(mesh.faces):
+        for vertex in set(vertices):
+            users.setdefault(vertex, []).append(index)
+
+    order = []
+    visited = set()
+
+    for start in range(len(mesh.faces)):
+        if start in visited:
+            continue
+
+        queue = [start]
+        visited.add(start)
+
+        while queue:
+            face = queue.pop(0)
+            order.append(face)
+
+            for vertex in mesh.faces[face][1]:
+                for neighbour in users[vertex]:
+                    if neighbour not in visited:
+                        visited.add(neighbour)
+                        queue.append(neighbour)
+
+    mesh.faces = [mesh.faces[index] for index in order]
+    mesh.attributes = [mesh.attributes[index] for index in order]
+
+    # Number vertices in order of their first use, unused vertices are dropped
+    remap = {}
+
+    for _, vertices in mesh.faces:
+        for vertex in vertices:
+            if vertex not in remap:
+                remap[vertex] = len(remap)
+
+    points = [None] * len(remap)
+    normals = [None] * len(remap) if mesh.normals is not None else None
+
+    for old, new in remap.items():
+        points[new] = mesh.points[old]
+
+        if normals is not None:
+            normals[new] = mesh.normals[old]
+
+    mesh.points = points
+    mesh.normals = normals
+    mesh.faces = [(normal, [remap[vertex] for vertex in vertices]) for normal, vertices in mesh.faces]
+
+def mesh_size(mesh, smooth):
+    vertex_size = 24 if smooth else 12
+    return (len(mesh.points) * vertex_size) + (len(mesh.faces) * 32)
+
+def main():
+    # Set up argument parser
+    parser = argparse.ArgumentParser(description="Optimize .NYA model for SRL.")
+    parser.add_argument("input_file", help="Path to the .NYA model")
+    parser.add_argument("output_file", help="Path to the output model, .NYA extension keeps the .NYA format, anything else writes SRL model file")
+    parser.add_argument("--weld-tolerance", type=int, default=0, help="Grid size in raw fixed point units used to weld nearby vertices (0 welds only identical vertices)")
+    parser.add_argument("--merge-angle", type=float, default=2.0, help="Maximal angle in degrees between normals of merged triangles")
+    parser.add_argument("--no-merge", action="store_true", help="Do not merge triangles into quads")
+    parser.add_argument("--no-reorder", action="store_true", help="Keep original face and vertex order")
+
+    args = parser.parse_args()
+
+    model = read_nya(args.input_file)
+    threshold = math.cos(math.radians(args.merge_angle))
+
+    total_before = [0, 0, 0]
+    total_after = [0, 0, 0]
+    total_dropped = 0
+    total_merged = 0
+
+    for index, mesh in enumerate(model.meshes):
+        before = [len(mesh.points), len(mesh.faces), mesh_size(mesh, model.smooth)]
+
+        weld(mesh, args.weld_tolerance)
+        dropped = drop_degenerate(mesh)
+        merged = 0 if args.no_merge else merge_triangles(mesh, threshold)
+
+        if not args.no_reorder:
+            reorder(mesh)
+
+        after = [len(mesh.points), len(mesh.faces), mesh_size(mesh, model.smooth)]
+        print("Mesh {}: vertices {} -> {}, polygons {} -> {} ({} degenerate, {} merged), bytes {} -> {}".format(
+            index, before[0], after[0], before[1], after[1], dropped, merged, before[2], after[2]))
+
+        total_before = [a + b for a, b in zip(total_before, before)]
+        total_after = [a + b for a, b in zip(total_after, after)]
+        total_dropped += dropped
+        total_merged += merged
+
+    print("Total: vertices {} -> {}, polygons {} -> {} ({} degenerate, {} merged), bytes {} -> {} ({} saved)".format(
+        total_before[0], total_after[0], total_before[1], total_after[1], total_dropped, total_merged,
+        total_before[2], total_after[2], total_before[2] - total_after[2]))
+
+    if args.output_file.lower().endswith(".nya"):
+        write_nya(model, args.output_file)
+    else:
+        write_srlm(model, args.output_file)
+        mesh_count, texture_count = verify_srlm(args.output_file)
+
+        if mesh_count != len(model.meshes) or texture_count != len(model.textures):
+            raise ValueError("Written model does not match the optimized model")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,240 @@
+import argparse
+import struct
+
+from atlas_packer import read_tga
+
+# Packs .TGA images into a compressed texture pack read by SRL::Types::TexturePack.
+# True color images are converted to RGB555, color mapped images keep their 8-bit palette indexes.
+# Every texture is stored with the compression giving the smallest size. All values are written big-endian.
+
+HEADER_SIZE = 12
+ENTRY_SIZE = 16
+
+# SRL::Types::TexturePack::Compression
+COMPRESSION_NONE = 0
+COMPRESSION_LZ = 1
+COMPRESSION_RLE = 2
+
+COMPRESSION_NAMES = {"none": COMPRESSION_NONE, "lz": COMPRESSION_LZ, "rle": COMPRESSION_RLE}
+
+# SRL::CRAM::TextureColorMode
+COLOR_MODE_PALETTED256 = 6
+COLOR_MODE_RGB555 = 1
+
+# LZ parameters, must match SRL::Types::TexturePack decoder
+MIN_MATCH = 4
+MAX_OFFSET = 4095
+MAX_CHAIN = 64
+
+def read_paletted_tga(path):
+    with open(path, 'rb') as file:
+        data = file.read()
+
+    id_length, color_map_type, image_type = struct.unpack_from("<BBB", data, 0)
+    _, color_map_length, color_map_depth = struct.unpack_from("<HHB", data, 3)
+    width, height, depth, descriptor = struct.unpack_from("<HHBB", data, 12)
+
+    if color_map_type != 1 or image_type not in (1, 9) or depth != 8:
+        return None
+
+    offset = 18 + id_length + (color_map_length * ((color_map_depth + 7) // 8))
+    raw = bytearray()
+
+    while len(raw) < width * height:
+        if image_type == 1:
+            raw += data[offset:offset + (width * height)]
+            offset += width * height
+            continue
+
+        packet = data[offset]
+        offset += 1
+        count = (packet & 0x7f) + 1
+
+        if packet & 0x80:
+            raw += bytes([data[offset]]) * count
+            offset += 1
+        else:
+            raw += data[offset:offset + count]
+            offset += count
+
+    rows = [raw[row * width:(row + 1) * width] for row in range(height)]
+
+    if not descriptor & 0x20:
+        rows.reverse()
+
+    if descriptor & 0x10:
+        rows = [bytes(reversed(row)) for row in rows]
+
+    return width, height, b"".join(rows)
+
+def write_length(output, length):
+    while length >= 255:
+        output.append(255)
+        length -= 255
+
+    output.append(length)
+
+def write_sequence(output, literals, length, offset):
+    literal_nibble = min(len(literals), 15)
+    match_nibble = min(length - MIN_MATCH, 15) if length > 0 else 0
+    output.append((literal_nibble << 4) | match_nibble)
+
+    if literal_nibble == 15:
+        write_length(output, len(literals) - 15)
+
+    output += literals
+
+    if length > 0:
+        output += struct.pack(">H", offset)
+
+        if match_nibble == 15:
+            write_length(output, length - MIN_MATCH - 15)
+
+def compress_lz(data):
+    output = bytearray()
+    chains = {}
+    start = 0
+    position = 0
+
+    def remember(index):
+        if index + MIN_MATCH <= len(data):
+            chains.setdefault(data[index:index + MIN_MATCH], []).append(index)
+
+    while position < len(data):
+        best_length = 0
+        best_offset = 0
+
+        for candidate in reversed(chains.get(data[position:position + MIN_MATCH], [])[-MAX_CHAIN:]):
+            offset = position - candidate
+
+            if offset > MAX_OFFSET:
+                break
+
+            # Match can overlap the data it produces
+            length = 0
+
+            while position + length < len(data) and data[candidate + length] == data[position + length]:
+                length += 1
+
+            if length > best_length:
+                best_length = length
+                best_offset = offset
+
+        if best_length >= MIN_MATCH:
+            write_sequence(output, data[start:position], best_length, best_offset)
+
+            for index in range(position, position + best_length):
+                remember(index)
+
+            position += best_length
+            start = position
+        else:
+            remember(position)
+            position += 1
+
+    # Last sequence carries only literals, decoder stops once texture is complete
+    if start < len(data):
+        write_sequence(output, data[start:], 0, 0)
+
+    return bytes(output)
+
+def compress_rle(data):
+    output = bytearray()
+    literals = bytearray()
+    position = 0
+
+    def flush_literals():
+        while literals:
+            chunk = literals[:128]
+            output.append(len(chunk) - 1)
+            output.extend(chunk)
+            del literals[:128]
+
+    while position < len(data):
+        run = 1
+
+        while position + run < len(data) and run < 128 and data[position + run] == data[position]:
+            run += 1
+
+        if run >= 3:
+            flush_literals()
+            output.append(127 + run)
+            output.append(data[position])
+            position += run
+        else:
+            literals.append(data[position])
+            position += 1
+
+    flush_literals()
+    return bytes(output)
+
+def compress(data, allowed):
+    candidates = [(COMPRESSION_NONE, data)]
+
+    if COMPRESSION_LZ in allowed:
+        candidates.append((COMPRESSION_LZ, compress_lz(data)))
+
+    if COMPRESSION_RLE in allowed:
+        candidates.append((COMPRESSION_RLE, compress_rle(data)))
+
+    return min(candidates, key=lambda candidate: len(candidate[1]))
+
+def load_texture(path):
+    paletted = read_paletted_tga(path)
+
+    if paletted is not None:
+        return paletted[0], paletted[1], COLOR_MODE_PALETTED256, paletted[2]
+
+    width, height, pixels = read_tga(path, None)
+    return width, height, COLOR_MODE_RGB555, struct.pack(">{}H".format(len(pixels)), *pixels)
+
+def align(value):
+    return (value + 3) & ~3
+
+def main():
+    # Set up argument parser
+    parser = argparse.ArgumentParser(description="Pack .TGA images into compressed SRL texture pack.")
+    parser.add_argument("output_file", help="Path to the output texture pack")
+    parser.add_argument("input_files", nargs="+", help="Paths to the .TGA images, texture indexes follow their order")
+    parser.add_argument("--compression", default="lz,rle", help="Comma separated list of allowed compressions (lz, rle), the smallest result is used")
+    parser.add_argument("--palette", type=int, default=0, help="Palette identifier of paletted textures, relative to the first palette of the pack")
+    parser.add_argument("--raw", default=None, help="Also write uncompressed texture data into this file, for comparison")
+
+    args = parser.parse_args()
+    allowed = [COMPRESSION_NAMES[name.strip()] for name in args.compression.split(",") if name.strip()]
+
+    entries = bytearray()
+    blobs = bytearray()
+    raw = bytearray()
+    data_offset = align(HEADER_SIZE + (len(args.input_files) * ENTRY_SIZE))
+
+    for path in args.input_files:
+        width, height, color_mode, data = load_texture(path)
+
+        if width % 8 != 0:
+            parser.error("{}: texture width must be divisible by 8".format(path))
+
+        compression, packed = compress(data, allowed)
+        palette = args.palette if color_mode != COLOR_MODE_RGB555 else 0
+        entries += struct.pack(">HHBBHII", width, height, color_mode, compression, palette, len(packed), data_offset + len(blobs))
+        blobs += packed
+        blobs += bytes(align(len(blobs)) - len(blobs))
+        raw += data
+
+        print("{}: {}x{}, {} -> {} bytes ({})".format(
+            path, width, height, len(data), len(packed), [name for name, value in COMPRESSION_NAMES.items() if value == compression][0]))
+
+    with open(args.output_file, 'wb') as file:
+        file.write(struct.pack(">4sHHI", b"SRLP", 1, len(args.input_files), HEADER_SIZE))
+        file.write(entries)
+        file.write(bytes(data_offset - HEADER_SIZE - len(entries)))
+        file.write(blobs)
+
+    if args.raw is not None:
+        with open(args.raw, 'wb') as file:
+            file.write(raw)
+
+    print("Texture pack written to {} ({} textures, {} -> {} bytes)".format(args.output_file, len(args.input_files), len(raw), data_offset + len(blobs)))
+
+if __name__ == "__main__":
+    main()